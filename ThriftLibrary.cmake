@@ -238,6 +238,16 @@ macro(thrift_generate
       ${output_path}/gen-${language}/${service}.cpp
       ${output_path}/gen-${language}/${service}AsyncClient.cpp
     )
+    if("${options}" MATCHES "client_cpp_splits=([0-9]+)"
+        AND CMAKE_MATCH_1 GREATER 1)
+      math(EXPR last_split "${CMAKE_MATCH_1} - 1")
+      foreach(split RANGE 1 ${last_split})
+        set("${file_name}-${language}-SOURCES"
+          ${${file_name}-${language}-SOURCES}
+          ${output_path}/gen-${language}/${service}AsyncClient_${split}.cpp
+        )
+      endforeach()
+    endif()
   endforeach()
   if("${include_prefix}" STREQUAL "")
     set(include_prefix_text "")
@@ -29,7 +29,13 @@
 #else
 #include <unistd.h>
 #endif
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <ctime>
+#include <exception>
+#include <memory>
+#include <thread>
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -51,6 +57,7 @@ using namespace apache::thrift::compiler;
  * Flags to control code generation
  */
 bool gen_recurse = false;
+size_t gen_jobs = 1;
 
 ofstream genfile_file;
 bool record_genfiles = false;
@@ -73,6 +80,7 @@ static void usage() {
   fprintf(stderr, "  -strict     Strict compiler warnings on\n");
   fprintf(stderr, "  -v[erbose]  Verbose mode\n");
   fprintf(stderr, "  -r[ecurse]  Also generate included files\n");
+  fprintf(stderr, "  -j N        Run up to N mstch generators in parallel\n");
   fprintf(stderr, "  -debug      Parse debug trace to stdout\n");
   fprintf(
       stderr,
@@ -111,6 +119,22 @@ static void usage() {
   }
 }
 
+/**
+ * Collects the programs included by a program which haven't been generated
+ * yet, in the order they should be generated
+ */
+static void collect_included_programs(
+    t_program* program,
+    std::set<std::string>& already_generated,
+    vector<t_program*>& programs) {
+  for (const auto& include : program->get_included_programs()) {
+    if (already_generated.insert(include->get_path()).second) {
+      collect_included_programs(include, already_generated, programs);
+      programs.push_back(include);
+    }
+  }
+}
+
 /**
  * Generate code
  */
@@ -120,47 +144,90 @@ static bool generate(
     vector<string>& generator_strings,
     std::set<std::string>& already_generated) {
   // Oooohh, recursive code generation, hot!!
+  vector<t_program*> programs;
   if (gen_recurse) {
-    const vector<t_program*>& includes = program->get_included_programs();
-    for (const auto& include : includes) {
-      if (already_generated.count(include->get_path())) {
-        continue;
+    collect_included_programs(program, already_generated, programs);
+  }
+  programs.push_back(program);
+
+  // Generators are all created before any of them runs, as some set options
+  // on their program which the generators of its includers read.
+  vector<std::pair<std::string, std::unique_ptr<t_generator>>> generators;
+  try {
+    for (auto* p : programs) {
+      pverbose("Program: %s\n", p->get_path().c_str());
+
+      if (dump_docs) {
+        dump_docstrings(p);
       }
 
-      if (!generate(include, context, generator_strings, already_generated)) {
-        return false;
-      } else {
-        already_generated.insert(include->get_path());
+      for (const auto& gen_string : generator_strings) {
+        std::unique_ptr<t_generator> generator{
+            t_generator_registry::get_generator(p, context, gen_string)};
+        if (generator) {
+          generators.emplace_back(gen_string, std::move(generator));
+        }
       }
     }
+  } catch (const string& s) {
+    printf("Error: %s\n", s.c_str());
+    return false;
+  } catch (const char* exc) {
+    printf("Error: %s\n", exc);
+    return false;
   }
 
-  // Generate code!
-  try {
-    pverbose("Program: %s\n", program->get_path().c_str());
-
-    if (dump_docs) {
-      dump_docstrings(program);
+  // Generate code! Generators run in the order they were given, because
+  // some of them modify the programs while they generate and the later ones
+  // see the changes. Consecutive generators which only read the programs
+  // and write their own files run together on up to gen_jobs threads.
+  vector<std::exception_ptr> errors(generators.size());
+  std::atomic<bool> failed{false};
+  auto generate_one = [&](size_t i) {
+    try {
+      pverbose("Generating \"%s\"\n", generators[i].first.c_str());
+      generators[i].second->generate_program();
+    } catch (...) {
+      errors[i] = std::current_exception();
+      failed = true;
+    }
+  };
+  for (size_t begin = 0; begin < generators.size() && !failed;) {
+    size_t end = begin + 1;
+    if (generators[begin].second->can_generate_concurrently()) {
+      while (end < generators.size() &&
+             generators[end].second->can_generate_concurrently()) {
+        ++end;
+      }
+    }
+    std::atomic<size_t> next{begin};
+    auto run = [&] {
+      for (size_t i; !failed && (i = next++) < end;) {
+        generate_one(i);
+      }
+    };
+    vector<std::thread> threads;
+    for (size_t i = 1; i < std::min(gen_jobs, end - begin); ++i) {
+      threads.emplace_back(run);
+    }
+    run();
+    for (auto& thread : threads) {
+      thread.join();
     }
+    begin = end;
+  }
 
-    for (auto gen_string : generator_strings) {
-      auto pos = gen_string.find(":");
-      std::string lang = gen_string.substr(0, pos);
-
-      t_generator* generator =
-          t_generator_registry::get_generator(program, context, gen_string);
-      if (generator) {
-        pverbose("Generating \"%s\"\n", gen_string.c_str());
-        generator->generate_program();
-        if (record_genfiles) {
-          for (const std::string& s : generator->get_genfiles()) {
-            genfile_file << s << "\n";
-          }
+  try {
+    for (size_t i = 0; i < generators.size(); ++i) {
+      if (errors[i]) {
+        std::rethrow_exception(errors[i]);
+      }
+      if (record_genfiles) {
+        for (const std::string& s : generators[i].second->get_genfiles()) {
+          genfile_file << s << "\n";
         }
-        delete generator;
       }
     }
-
   } catch (const string& s) {
     printf("Error: %s\n", s.c_str());
     return false;
@@ -258,6 +325,17 @@ int compile(std::vector<std::string> arguments) {
       g_verbose = 1;
     } else if (arguments[i] == "-r" || arguments[i] == "-recurse") {
       gen_recurse = true;
+    } else if (arguments[i] == "-j") {
+      if (i + 1 == arguments.size() - 1) {
+        fprintf(
+            stderr,
+            "!!! Missing number of jobs between %s and '%s'\n",
+            arguments[i].c_str(),
+            arguments[i + 1].c_str());
+        usage();
+        return 1;
+      }
+      gen_jobs = std::max(std::atoi(arguments[++i].c_str()), 1);
     } else if (arguments[i] == "-allow-neg-keys") {
       allow_neg_field_keys = true;
     } else if (arguments[i] == "-allow-neg-enum-vals") {
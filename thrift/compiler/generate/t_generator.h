@@ -74,6 +74,16 @@ class t_generator {
   // generation.
   virtual void generate_program() = 0;
 
+  /**
+   * Whether generate_program() may run alongside other generators, which
+   * requires it to leave the programs, and any state shared with other
+   * generators, unchanged. Many generators temporarily rename or modify the
+   * program while they generate, so this is opt-in.
+   */
+  virtual bool can_generate_concurrently() const {
+    return false;
+  }
+
   /**
    * Method to get the program name, may be overridden
    */
@@ -16,7 +16,11 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <boost/algorithm/string/replace.hpp>
@@ -119,6 +123,130 @@ bool same_types(const t_type* a, const t_type* b) {
   return true;
 }
 
+// Structs with at least this many fields get a field dispatch table.
+constexpr size_t kFieldDispatchMinFields = 8;
+
+// Perfect hash of the ids of the fields of a struct, mapping each to its own
+// slot of a table of mask + 1 slots as ((uint16_t(id) * mult) >> shift) & mask,
+// matching apache::thrift::detail::fieldDispatchHash.
+struct field_dispatch {
+  uint32_t mult{1};
+  uint32_t shift{0};
+  uint32_t mask{0};
+  // the id of the field hashed to each slot, INT32_MIN if none
+  std::vector<int32_t> slots;
+};
+
+bool find_field_dispatch(
+    std::vector<int32_t> const& ids,
+    field_dispatch& dispatch) {
+  auto try_hash = [&](uint32_t mult, uint32_t shift, uint32_t mask) {
+    dispatch.slots.assign(mask + 1, std::numeric_limits<int32_t>::min());
+    for (auto id : ids) {
+      auto& slot = dispatch.slots
+          [((uint32_t(uint16_t(id)) * mult) >> shift) & mask];
+      if (slot != std::numeric_limits<int32_t>::min()) {
+        return false;
+      }
+      slot = id;
+    }
+    dispatch.mult = mult;
+    dispatch.shift = shift;
+    dispatch.mask = mask;
+    return true;
+  };
+  uint32_t bits = 1;
+  while ((size_t(1) << bits) < ids.size()) {
+    ++bits;
+  }
+  // allow the table to be up to 4 times as large as needed
+  for (uint32_t max_bits = bits + 2; bits <= max_bits; ++bits) {
+    uint32_t mask = (uint32_t(1) << bits) - 1;
+    // dense ids hash to themselves
+    if (try_hash(1, 0, mask)) {
+      return true;
+    }
+    constexpr uint32_t kMultTries = 1 << 14;
+    for (uint32_t i = 0; i < kMultTries; ++i) {
+      if (try_hash(0x9E3779B1u + 2 * i, 32 - bits, mask)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Computes the Binary protocol encoding of 'strct' with all its fields set,
+// as 'layout', and which of its bytes are field headers, as 'mask'. Returns
+// false unless all of its fields are fixed size scalars, whose values then
+// are at fixed offsets.
+bool get_fixed_layout(
+    t_struct const* strct,
+    std::vector<uint8_t>& layout,
+    std::vector<uint8_t>& mask) {
+  auto const& fields = strct->get_members();
+  if (fields.size() < 2 || strct->is_union()) {
+    return false;
+  }
+  layout.clear();
+  mask.clear();
+  for (auto const* field : fields) {
+    if (cpp2::is_cpp_ref(field)) {
+      return false;
+    }
+    auto const* type = field->get_type()->get_true_type();
+    // TType and size of the value
+    uint8_t ttype;
+    size_t size;
+    if (type->is_bool()) {
+      ttype = 2;
+      size = 1;
+    } else if (type->is_byte()) {
+      ttype = 3;
+      size = 1;
+    } else if (type->is_double()) {
+      ttype = 4;
+      size = 8;
+    } else if (type->is_i16()) {
+      ttype = 6;
+      size = 2;
+    } else if (type->is_i32() || type->is_enum()) {
+      ttype = 8;
+      size = 4;
+    } else if (type->is_i64()) {
+      ttype = 10;
+      size = 8;
+    } else if (type->is_float()) {
+      ttype = 19;
+      size = 4;
+    } else {
+      return false;
+    }
+    auto id = uint16_t(field->get_key());
+    layout.insert(layout.end(), {ttype, uint8_t(id >> 8), uint8_t(id & 0xff)});
+    mask.insert(mask.end(), 3, 0xff);
+    layout.insert(layout.end(), size, 0);
+    mask.insert(mask.end(), size, 0);
+  }
+  // T_STOP
+  layout.push_back(0);
+  mask.push_back(0xff);
+  return true;
+}
+
+std::string format_bytes(std::vector<uint8_t> const& bytes) {
+  std::string out;
+  char hex[8];
+  for (auto byte : bytes) {
+    if (!out.empty()) {
+      out += ", ";
+    }
+    snprintf(hex, sizeof(hex), "0x%02x", byte);
+    out += hex;
+  }
+  return out;
+}
+
 template <typename Node>
 const std::string& get_cpp_name(const Node* node) {
   auto name = node->annotations_.find("cpp.name");
@@ -784,6 +912,15 @@ class mstch_cpp2_struct : public mstch_struct {
             {"struct:fatal_annotations", &mstch_cpp2_struct::fatal_annotations},
             {"struct:legacy_type_id", &mstch_cpp2_struct::get_legacy_type_id},
             {"struct:metadata_name", &mstch_cpp2_struct::metadata_name},
+            {"struct:field_dispatch?", &mstch_cpp2_struct::has_field_dispatch},
+            {"struct:field_dispatch_table",
+             &mstch_cpp2_struct::field_dispatch_table},
+            {"struct:field_dispatch_hash",
+             &mstch_cpp2_struct::field_dispatch_hash},
+            {"struct:fixed_layout?", &mstch_cpp2_struct::has_fixed_layout},
+            {"struct:fixed_layout", &mstch_cpp2_struct::fixed_layout},
+            {"struct:fixed_layout_mask",
+             &mstch_cpp2_struct::fixed_layout_mask},
         });
   }
   mstch::node filtered_fields() {
@@ -956,6 +1093,40 @@ class mstch_cpp2_struct : public mstch_struct {
   mstch::node metadata_name() {
     return strct_->get_program()->get_name() + "_" + strct_->get_name();
   }
+  mstch::node has_field_dispatch() {
+    return get_field_dispatch() != nullptr;
+  }
+  mstch::node field_dispatch_table() {
+    std::string table;
+    for (auto id : get_field_dispatch()->slots) {
+      if (!table.empty()) {
+        table += ", ";
+      }
+      table += id == std::numeric_limits<int32_t>::min() ? "INT32_MIN"
+                                                         : std::to_string(id);
+    }
+    return table;
+  }
+  mstch::node field_dispatch_hash() {
+    auto const* dispatch = get_field_dispatch();
+    return std::to_string(dispatch->mult) + "u, " +
+        std::to_string(dispatch->shift) + "u, " +
+        std::to_string(dispatch->mask) + "u";
+  }
+  mstch::node has_fixed_layout() {
+    std::vector<uint8_t> layout, mask;
+    return get_fixed_layout(strct_, layout, mask);
+  }
+  mstch::node fixed_layout() {
+    std::vector<uint8_t> layout, mask;
+    get_fixed_layout(strct_, layout, mask);
+    return format_bytes(layout);
+  }
+  mstch::node fixed_layout_mask() {
+    std::vector<uint8_t> layout, mask;
+    get_fixed_layout(strct_, layout, mask);
+    return format_bytes(mask);
+  }
 
  protected:
   // Computes the alignment of field on the target platform.
@@ -1067,9 +1238,28 @@ class mstch_cpp2_struct : public mstch_struct {
         cache_);
   }
 
+  // The field dispatch table of large structs, null for others.
+  field_dispatch const* get_field_dispatch() {
+    if (!field_dispatch_computed_) {
+      field_dispatch_computed_ = true;
+      std::vector<int32_t> ids;
+      for (auto const* field : strct_->get_members()) {
+        ids.push_back(field->get_key());
+      }
+      auto dispatch = std::make_unique<field_dispatch>();
+      if (!strct_->is_union() && ids.size() >= kFieldDispatchMinFields &&
+          find_field_dispatch(ids, *dispatch)) {
+        field_dispatch_ = std::move(dispatch);
+      }
+    }
+    return field_dispatch_.get();
+  }
+
   std::shared_ptr<cpp2_generator_context> context_;
 
   std::vector<t_field*> fields_in_layout_order_;
+  bool field_dispatch_computed_{false};
+  std::unique_ptr<field_dispatch> field_dispatch_;
 };
 
 class mstch_cpp2_function : public mstch_function {
@@ -1112,8 +1302,16 @@ class mstch_cpp2_service : public mstch_service {
       t_service const* service,
       std::shared_ptr<mstch_generators const> generators,
       std::shared_ptr<mstch_cache> cache,
-      ELEMENT_POSITION const pos)
+      ELEMENT_POSITION const pos,
+      size_t split_id = 0,
+      size_t split_count = 1)
       : mstch_service(service, generators, cache, pos) {
+    // Split split_id of split_count only covers its contiguous share of the
+    // functions, so that a large client can be compiled in several pieces.
+    const auto& all = service->get_functions();
+    functions_.assign(
+        all.begin() + all.size() * split_id / split_count,
+        all.begin() + all.size() * (split_id + 1) / split_count);
     register_methods(
         this,
         {
@@ -1130,6 +1328,9 @@ class mstch_cpp2_service : public mstch_service {
   std::string get_service_namespace(t_program const* program) override {
     return t_mstch_cpp2_generator::get_cpp2_namespace(program);
   }
+  const std::vector<t_function*>& get_functions() const override {
+    return functions_;
+  }
   mstch::node program_name() {
     return service_->get_program()->get_name();
   }
@@ -1181,6 +1382,9 @@ class mstch_cpp2_service : public mstch_service {
   mstch::node metadata_name() {
     return service_->get_program()->get_name() + "_" + service_->get_name();
   }
+
+ private:
+  std::vector<t_function*> functions_;
 };
 
 class mstch_cpp2_annotation : public mstch_annotation {
@@ -2037,10 +2241,38 @@ void t_mstch_cpp2_generator::generate_service(t_service const* service) {
       cache_->services_[service_id],
       "ServiceAsyncClient.h",
       name + "AsyncClient.h");
-  render_to_file(
-      cache_->services_[service_id],
-      "ServiceAsyncClient.cpp",
-      name + "AsyncClient.cpp");
+  // client_cpp_splits=N spreads the client's function definitions over
+  // nameAsyncClient.cpp and nameAsyncClient_1.cpp .. nameAsyncClient_<N-1>.cpp
+  // so that large services compile in parallel.
+  size_t splits = 1;
+  auto it = cache_->parsed_options_.find("client_cpp_splits");
+  if (it != cache_->parsed_options_.end()) {
+    const std::string& value = it->second;
+    if (value.empty() || value.size() > 4 ||
+        !std::all_of(value.begin(), value.end(), [](char c) {
+          return c >= '0' && c <= '9';
+        })) {
+      throw std::string("mstch_cpp2: client_cpp_splits must be a number ") +
+          "below 10000, got '" + value + "'";
+    }
+    splits = std::max(std::stoi(value), 1);
+  }
+  if (splits == 1) {
+    render_to_file(
+        cache_->services_[service_id],
+        "ServiceAsyncClient.cpp",
+        name + "AsyncClient.cpp");
+  } else {
+    for (size_t i = 0; i < splits; ++i) {
+      std::shared_ptr<mstch_base> split = std::make_shared<mstch_cpp2_service>(
+          service, generators_, cache_, ELEMENT_POSITION::NONE, i, splits);
+      render_to_file(
+          split,
+          "ServiceAsyncClient.cpp",
+          name + "AsyncClient" + (i == 0 ? "" : "_" + std::to_string(i)) +
+              ".cpp");
+    }
+  }
   render_to_file(cache_->services_[service_id], "service.cpp", name + ".cpp");
   render_to_file(cache_->services_[service_id], "service.h", name + ".h");
   render_to_file(cache_->services_[service_id], "service.tcc", name + ".tcc");
@@ -19,9 +19,12 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include <thrift/compiler/mustache/mstch.h>
 
@@ -59,6 +62,29 @@ void chomp_last_char(string* data, char c) {
   }
 }
 
+bool has_contents(const fs::path& path, const string& data) {
+  boost::system::error_code ec;
+  if (fs::file_size(path, ec) != data.size() || ec) {
+    return false;
+  }
+  std::ifstream ifs{path.string(), std::ios::binary};
+  return std::equal(
+      data.begin(),
+      data.end(),
+      std::istreambuf_iterator<char>{ifs},
+      std::istreambuf_iterator<char>{});
+}
+
+// Leaves files whose contents don't change untouched, so that builds going by
+// modification times don't rebuild their dependents.
+void write_if_changed(const fs::path& path, const string& data) {
+  if (has_contents(path, data)) {
+    return;
+  }
+  std::ofstream ofs{path.string()};
+  ofs << data;
+}
+
 } // namespace
 
 t_mstch_generator::t_mstch_generator(
@@ -429,6 +455,22 @@ mstch::map t_mstch_generator::extend_annotation(const annotation&) {
 }
 
 void t_mstch_generator::gen_template_map(const boost::filesystem::path& root) {
+  // Every generator of a run, one per program and language, renders from the
+  // same templates, so they're parsed by the first one only.
+  static std::mutex mutex;
+  static std::map<
+      std::pair<std::string, bool>,
+      std::shared_ptr<const std::map<std::string, mstch::template_type>>>
+      parsed;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& templates = parsed[{root.generic_string(), convert_delimiter_}];
+  if (templates) {
+    template_map_ = templates;
+    return;
+  }
+
+  auto template_map =
+      std::make_shared<std::map<std::string, mstch::template_type>>();
   for (size_t i = 0; i < templates_size; ++i) {
     auto name = boost::filesystem::path(
         templates_name_datas[i],
@@ -448,15 +490,17 @@ void t_mstch_generator::gen_template_map(const boost::filesystem::path& root) {
         tpl = "{{=<% %>=}}\n" + tpl;
       }
 
-      template_map_.emplace(name.generic_string(), std::move(tpl));
+      template_map->emplace(name.generic_string(), mstch::template_type{tpl});
     }
   }
+  templates = template_map;
+  template_map_ = std::move(template_map);
 }
 
-const std::string& t_mstch_generator::get_template(
+const mstch::template_type& t_mstch_generator::get_template(
     const std::string& template_name) {
-  auto itr = template_map_.find(template_name);
-  if (itr == template_map_.end()) {
+  auto itr = template_map_->find(template_name);
+  if (itr == template_map_->end()) {
     std::ostringstream err;
     err << "Could not find template \"" << template_name << "\"";
     throw std::runtime_error{err.str()};
@@ -469,11 +513,11 @@ void t_mstch_generator::write_output(
     const std::string& data) {
   auto abs_path = boost::filesystem::path{get_out_dir()} / path;
   boost::filesystem::create_directories(abs_path.parent_path());
-  std::ofstream ofs{abs_path.string()};
-  ofs << data;
-  if (!is_last_char(data, '\n')) {
+  if (is_last_char(data, '\n')) {
+    write_if_changed(abs_path, data);
+  } else {
     // Terminate with newline.
-    ofs << '\n';
+    write_if_changed(abs_path, data + '\n');
   }
   record_genfile(abs_path.string());
 }
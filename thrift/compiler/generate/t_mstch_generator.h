@@ -23,6 +23,7 @@
 
 #include <boost/filesystem.hpp>
 #include <thrift/compiler/mustache/mstch.h>
+#include <thrift/compiler/mustache/template_type.h>
 
 #include <thrift/compiler/generate/t_generator.h>
 #include <thrift/compiler/generate/t_mstch_objects.h>
@@ -40,6 +41,11 @@ class t_mstch_generator : public t_generator {
       std::map<std::string, std::string> parsed_options,
       bool convert_delimiter = false);
 
+  // mstch generators only read the programs, through their mstch objects
+  bool can_generate_concurrently() const override {
+    return true;
+  }
+
  protected:
   /**
    * Option pairs specified on command line for influencing generation behavior
@@ -55,17 +61,17 @@ class t_mstch_generator : public t_generator {
   }
 
   /**
-   * Fetches a particular template from the template map, throwing an error
-   * if the template doesn't exist
+   * Fetches a particular parsed template from the template map, throwing an
+   * error if the template doesn't exist
    */
-  const std::string& get_template(const std::string& template_name);
+  const mstch::template_type& get_template(const std::string& template_name);
 
   /**
-   * Returns the map of (file_name, template_contents) for each template
-   * file for this generator
+   * Returns the map of (file_name, parsed_template) for each template file
+   * for this generator
    */
-  const std::map<std::string, std::string>& get_template_map() {
-    return template_map_;
+  const std::map<std::string, mstch::template_type>& get_template_map() {
+    return *template_map_;
   }
 
   /**
@@ -77,7 +83,8 @@ class t_mstch_generator : public t_generator {
 
   /**
    * Write an output file with the given contents to a path
-   * under the output directory.
+   * under the output directory. An existing file with the same contents is
+   * left untouched, keeping its modification time.
    */
   void write_output(
       const boost::filesystem::path& path,
@@ -210,8 +217,10 @@ class t_mstch_generator : public t_generator {
   std::unique_ptr<std::string> get_option(const std::string& key);
 
  private:
-  std::map<std::string, std::string> template_map_;
   bool convert_delimiter_;
+  // Parsed once per template prefix and shared by the generators of a run.
+  std::shared_ptr<const std::map<std::string, mstch::template_type>>
+      template_map_;
 
   void gen_template_map(const boost::filesystem::path& root);
 
@@ -564,7 +564,7 @@ mstch::node mstch_function::returns_stream() {
 
 mstch::node mstch_service::functions() {
   return generate_elements(
-      service_->get_functions(),
+      get_functions(),
       generators_->function_generator_.get(),
       generators_,
       cache_);
@@ -1014,6 +1014,11 @@ class mstch_service : public mstch_base {
     return "";
   }
 
+  // The functions service:functions iterates over, all of them by default.
+  virtual const std::vector<t_function*>& get_functions() const {
+    return service_->get_functions();
+  }
+
   mstch::node name() {
     return service_->get_name();
   }
@@ -33,7 +33,7 @@ namespace apache {
 namespace thrift {
 namespace mstch {
 
-std::function<std::string(const std::string&)> config::escape;
+thread_local std::function<std::string(const std::string&)> config::escape;
 
 std::string render(
     const std::string& tmplt,
@@ -47,6 +47,13 @@ std::string render(
   return render_context(root, partial_templates).render(tmplt);
 }
 
+std::string render(
+    const template_type& tmplt,
+    const node& root,
+    const std::map<std::string, template_type>& partials) {
+  return render_context(root, partials).render(tmplt);
+}
+
 } // namespace mstch
 } // namespace thrift
 } // namespace apache
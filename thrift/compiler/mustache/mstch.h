@@ -41,7 +41,8 @@ namespace thrift {
 namespace mstch {
 
 struct config {
-  static std::function<std::string(const std::string&)> escape;
+  // Per thread, so that generators running concurrently can each set theirs.
+  static thread_local std::function<std::string(const std::string&)> escape;
 };
 
 namespace internal {
@@ -147,6 +148,15 @@ std::string render(
     const std::map<std::string, std::string>& partials =
         std::map<std::string, std::string>());
 
+class template_type;
+
+// Renders a template with partials parsed beforehand, for callers rendering
+// the same templates many times.
+std::string render(
+    const template_type& tmplt,
+    const node& root,
+    const std::map<std::string, template_type>& partials);
+
 } // namespace mstch
 } // namespace thrift
 } // namespace apache
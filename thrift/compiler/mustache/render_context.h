@@ -75,7 +75,8 @@ class render_context {
   const node& find_node(
       const std::string& token,
       std::list<node const*> current_nodes);
-  std::map<std::string, template_type> m_partials;
+  // Outlives the context, which only renders a single template.
+  const std::map<std::string, template_type>& m_partials;
   std::deque<node> m_nodes;
   std::list<const node*> m_node_ptrs;
   std::stack<std::unique_ptr<render_state>> m_state;
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include <thrift/compiler/mustache/mstch.h>
+#include <thrift/compiler/mustache/template_type.h>
 
 using namespace apache::thrift;
 // The greater-than operator should expand to the named partial.
@@ -103,3 +104,26 @@ TEST(PartialsTEST, PaddingWhitespace) {
           mstch::map{{"boolean", true}},
           {{"partial", "[]"}}));
 }
+// Parsed templates and partials should render as their sources do, and stay
+// reusable across renders.
+TEST(PartialsTEST, Parsed) {
+  std::map<std::string, mstch::template_type> partials{
+      {"node", std::string("{{content}}<{{#nodes}}{{>node}}{{/nodes}}>")},
+      {"partial", std::string("|\n{{{content}}}\n|\n")}};
+  mstch::template_type tmplt{std::string("\\\n {{>partial}}\n/\n")};
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(
+        "\\\n |\n <\n->\n |\n/\n",
+        mstch::render(
+            tmplt, mstch::map{{"content", std::string("<\n->")}}, partials));
+  }
+  EXPECT_EQ(
+      "X<Y<>>",
+      mstch::render(
+          mstch::template_type{std::string("{{>node}}")},
+          mstch::map{{"content", std::string("X")},
+                     {"nodes",
+                      mstch::array{mstch::map{{"content", std::string("Y")},
+                                              {"nodes", mstch::array{}}}}}},
+          partials));
+}
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+# Copyright (c) Facebook, Inc. and its affiliates.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+
+"""
+Times the C++ compilation of the cpp2 code generated for the fixtures under
+thrift/compiler/test/fixtures:
+
+    thrift/compiler/test/benchmark_compile.py \
+            --thrift [$THRIFT]                \
+            --cxx [$CXX]                      \
+            --cxxflags [$CXXFLAGS]            \
+            --jobs [$JOBS]                    \
+            --splits [$SPLITS]                \
+            --fixture-names [$FIXTURENAMES]
+
+$CXXFLAGS must let $CXX find the thrift, folly and other headers. Each
+fixture is generated as its cmd file says, then again with
+client_cpp_splits=$SPLITS, and every generated .cpp is compiled with $JOBS
+compilers in parallel, reporting the wall time, the summed compile time and
+the slowest translation unit of both.
+"""
+
+
+def parsed_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--thrift",
+        dest="thrift",
+        help="Path to the thrift compiler",
+        type=str,
+        default="thrift1",
+    )
+    parser.add_argument(
+        "--cxx",
+        dest="cxx",
+        help="C++ compiler",
+        type=str,
+        default=os.environ.get("CXX", "c++"),
+    )
+    parser.add_argument(
+        "--cxxflags",
+        dest="cxxflags",
+        help="Flags passed to every compilation, e.g. include directories",
+        type=str,
+        default="-std=c++17 -O2",
+    )
+    parser.add_argument(
+        "--jobs",
+        dest="jobs",
+        help="Number of translation units compiled in parallel",
+        type=int,
+        default=os.cpu_count(),
+    )
+    parser.add_argument(
+        "--splits",
+        dest="splits",
+        help="Number of files the service clients are split into",
+        type=int,
+        default=4,
+    )
+    parser.add_argument(
+        "--fixture-names",
+        dest="fixture_names",
+        help="Name of the fixture to build, default to build all fixtures",
+        type=str,
+        nargs="*",
+        default=None,
+    )
+    return parser.parse_args()
+
+
+def cpp2_commands(fixture):
+    """Returns the mstch_cpp2 generator options of the fixture by source."""
+    commands = []
+    with open(os.path.join(fixture, "cmd"), "r") as f:
+        for line in f:
+            if re.match(r"^\s*#", line) or not line.strip():
+                continue
+            args = shlex.split(line.strip())
+            gen, _, options = args[0].partition(":")
+            if gen == "mstch_cpp2":
+                commands.append((options, args[1:-1], args[-1]))
+    return commands
+
+
+def generate(thrift, fixture, out, extra_option):
+    for options, args, source in cpp2_commands(fixture):
+        options = ",".join(o for o in (options, extra_option) if o)
+        subprocess.run(
+            [thrift, "-o", out, "--gen", "mstch_cpp2:" + options]
+            + args
+            + [os.path.join(fixture, source)],
+            cwd=fixture,
+            check=True,
+            stdout=subprocess.DEVNULL,
+        )
+
+
+def compile_all(cxx, cxxflags, jobs, out):
+    gen = os.path.join(out, "gen-cpp2")
+    sources = sorted(
+        os.path.join(gen, f) for f in os.listdir(gen) if f.endswith(".cpp")
+    )
+
+    def compile_one(source):
+        start = time.perf_counter()
+        subprocess.run(
+            [cxx]
+            + shlex.split(cxxflags)
+            + ["-I", out, "-c", source, "-o", os.devnull],
+            check=True,
+        )
+        return time.perf_counter() - start
+
+    start = time.perf_counter()
+    with ThreadPoolExecutor(jobs) as pool:
+        times = list(pool.map(compile_one, sources))
+    return time.perf_counter() - start, sum(times), max(times), len(sources)
+
+
+def main():
+    args = parsed_args()
+    fixture_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "fixtures")
+    fixture_names = args.fixture_names or sorted(
+        f
+        for f in os.listdir(fixture_dir)
+        if os.path.isfile(os.path.join(fixture_dir, f, "cmd"))
+        and cpp2_commands(os.path.join(fixture_dir, f))
+    )
+
+    split_option = "client_cpp_splits={}".format(args.splits)
+    for name in fixture_names:
+        fixture = os.path.join(fixture_dir, name)
+        results = []
+        for extra_option in ("", split_option):
+            out = tempfile.mkdtemp()
+            try:
+                generate(args.thrift, fixture, out, extra_option)
+                results.append(
+                    compile_all(args.cxx, args.cxxflags, args.jobs, out)
+                )
+            except subprocess.CalledProcessError as e:
+                sys.stderr.write("{}: {}\n".format(name, e))
+                break
+            finally:
+                shutil.rmtree(out, ignore_errors=True)
+        for label, (wall, total, slowest, count) in zip(
+            ("default", split_option), results
+        ):
+            print(
+                "{:<40} {:<22} {:8.2f}s wall -j{} {:8.2f}s total "
+                "{:8.2f}s slowest of {} files".format(
+                    name, label, wall, args.jobs, total, slowest, count
+                )
+            )
+
+
+if __name__ == "__main__":
+    main()
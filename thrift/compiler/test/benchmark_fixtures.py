@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+# Copyright (c) Facebook, Inc. and its affiliates.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+"""
+Times the Thrift compiler on the fixtures under thrift/compiler/test/fixtures,
+generating all the languages of a fixture in one run:
+
+    thrift/compiler/test/benchmark_fixtures.py \
+            --thrift [$THRIFT]                 \
+            --jobs [$JOBS]                     \
+            --fixture-names [$FIXTURENAMES]
+
+Each fixture is generated into a scratch directory three times: serially,
+with $JOBS generators in parallel, and again with $JOBS on top of the output
+of the previous run, counting the generated files which were rewritten.
+"""
+
+
+def parsed_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--thrift",
+        dest="thrift",
+        help="Path to the thrift compiler",
+        type=str,
+        default="thrift1",
+    )
+    parser.add_argument(
+        "--jobs",
+        dest="jobs",
+        help="Number of generators to run in parallel",
+        type=int,
+        default=os.cpu_count(),
+    )
+    parser.add_argument(
+        "--fixture-names",
+        dest="fixture_names",
+        help="Name of the fixture to build, default to build all fixtures",
+        type=str,
+        nargs="*",
+        default=None,
+    )
+    return parser.parse_args()
+
+
+def read_commands(fixture):
+    """Returns the generator arguments of the fixture by source file."""
+    commands = {}
+    with open(os.path.join(fixture, "cmd"), "r") as f:
+        for line in f:
+            if re.match(r"^\s*#", line) or not line.strip():
+                continue
+            args = shlex.split(line.strip())
+            commands.setdefault(args[-1], []).append(args[:-1])
+    return commands
+
+
+def mtimes(path):
+    return {
+        os.path.join(root, f): os.stat(os.path.join(root, f)).st_mtime_ns
+        for root, _, files in os.walk(path)
+        for f in files
+    }
+
+
+def run(thrift, jobs, fixture, out):
+    start = time.perf_counter()
+    for source, gens in read_commands(fixture).items():
+        cmd = [thrift, "-j", str(jobs), "-o", out]
+        for gen in gens:
+            cmd += ["--gen"] + gen
+        cmd.append(os.path.join(fixture, source))
+        subprocess.run(
+            cmd, cwd=fixture, check=True, stdout=subprocess.DEVNULL
+        )
+    return time.perf_counter() - start
+
+
+def main():
+    args = parsed_args()
+    fixture_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "fixtures")
+    fixture_names = args.fixture_names or sorted(
+        f
+        for f in os.listdir(fixture_dir)
+        if os.path.isfile(os.path.join(fixture_dir, f, "cmd"))
+    )
+
+    totals = [0.0, 0.0, 0.0]
+    rewritten = 0
+    generated = 0
+    for name in fixture_names:
+        fixture = os.path.join(fixture_dir, name)
+        out = tempfile.mkdtemp()
+        try:
+            serial = run(args.thrift, 1, fixture, out)
+            shutil.rmtree(out)
+            os.mkdir(out)
+            parallel = run(args.thrift, args.jobs, fixture, out)
+            before = mtimes(out)
+            time.sleep(0.01)
+            again = run(args.thrift, args.jobs, fixture, out)
+            after = mtimes(out)
+        except subprocess.CalledProcessError as e:
+            sys.stderr.write("{}: {}\n".format(name, e))
+            continue
+        finally:
+            shutil.rmtree(out, ignore_errors=True)
+        changed = sum(1 for f, t in after.items() if before.get(f) != t)
+        print(
+            "{:<40} {:8.3f}s serial {:8.3f}s -j{} {:8.3f}s again, "
+            "{}/{} files rewritten".format(
+                name, serial, parallel, args.jobs, again, changed, len(after)
+            )
+        )
+        for i, t in enumerate((serial, parallel, again)):
+            totals[i] += t
+        rewritten += changed
+        generated += len(after)
+
+    print(
+        "{:<40} {:8.3f}s serial {:8.3f}s -j{} {:8.3f}s again, "
+        "{}/{} files rewritten".format(
+            "total", totals[0], totals[1], args.jobs, totals[2], rewritten, generated
+        )
+    )
+
+
+if __name__ == "__main__":
+    main()
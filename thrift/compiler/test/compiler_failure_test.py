@@ -197,3 +197,21 @@ class CompilerFailureTest(unittest.TestCase):
             err,
             "[FAILURE:foo.thrift:4] Type \"Random.Type\" not defined.\n"
         )
+
+    def test_invalid_client_cpp_splits(self):
+        write_file("foo.thrift", textwrap.dedent("""\
+            service S {
+                void meh(),
+            }
+        """))
+
+        for value in ["abc", "-1", "99999999999"]:
+            ret, out, err = self.run_thrift(
+                "--gen", "mstch_cpp2:client_cpp_splits=" + value, "foo.thrift")
+
+            self.assertEqual(ret, 1)
+            self.assertEqual(
+                out,
+                "Error: mstch_cpp2: client_cpp_splits must be a number "
+                "below 10000, got '{}'\n".format(value)
+            )
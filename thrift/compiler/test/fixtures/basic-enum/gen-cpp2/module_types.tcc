@@ -59,6 +59,27 @@ void MyStruct::readNoXfer(Protocol_* iprot) {
   using apache::thrift::TProtocolException;
 
 
+  {
+    static constexpr uint8_t _layout[] = {0x08, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00};
+    static constexpr uint8_t _layoutMask[] = {0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff};
+    using _FixedLayout = apache::thrift::detail::FixedStructLayout<Protocol_>;
+    if (_FixedLayout::kSupported &&
+        _FixedLayout::match(iprot, _layout, _layoutMask)) {
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::enumeration,  ::test::fixtures::enumstrict::MyEnum>::readWithContext(*iprot, this->myEnum, _readState);
+        this->__isset.myEnum = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::enumeration,  ::test::fixtures::enumstrict::MyBigEnum>::readWithContext(*iprot, this->myBigEnum, _readState);
+        this->__isset.myBigEnum = true;
+      }
+      _FixedLayout::skipStop(iprot);
+      goto _end;
+    }
+  }
+
   if (UNLIKELY(!_readState.advanceToNextField(
           iprot,
           0,
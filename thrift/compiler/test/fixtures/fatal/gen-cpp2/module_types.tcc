@@ -1128,6 +1128,27 @@ void structB::readNoXfer(Protocol_* iprot) {
   using apache::thrift::TProtocolException;
 
 
+  {
+    static constexpr uint8_t _layout[] = {0x04, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00};
+    static constexpr uint8_t _layoutMask[] = {0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0xff};
+    using _FixedLayout = apache::thrift::detail::FixedStructLayout<Protocol_>;
+    if (_FixedLayout::kSupported &&
+        _FixedLayout::match(iprot, _layout, _layoutMask)) {
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::floating_point, double>::readWithContext(*iprot, this->c, _readState);
+        this->__isset.c = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, bool>::readWithContext(*iprot, this->d, _readState);
+        this->__isset.d = true;
+      }
+      _FixedLayout::skipStop(iprot);
+      goto _end;
+    }
+  }
+
   if (UNLIKELY(!_readState.advanceToNextField(
           iprot,
           0,
@@ -1767,8 +1788,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<structC>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 1u, 0u, 31u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_a;
@@ -1776,7 +1798,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_b;
@@ -1784,7 +1806,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_DOUBLE))) {
         goto _readField_c;
@@ -1792,7 +1814,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_d;
@@ -1800,7 +1822,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_e;
@@ -1808,7 +1830,7 @@ _loop:
         goto _skip;
       }
     }
-    case 6:
+    case apache::thrift::detail::fieldDispatchHash(6, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_f;
@@ -1816,7 +1838,7 @@ _loop:
         goto _skip;
       }
     }
-    case 7:
+    case apache::thrift::detail::fieldDispatchHash(7, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_g;
@@ -1824,7 +1846,7 @@ _loop:
         goto _skip;
       }
     }
-    case 8:
+    case apache::thrift::detail::fieldDispatchHash(8, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_h;
@@ -1832,7 +1854,7 @@ _loop:
         goto _skip;
       }
     }
-    case 9:
+    case apache::thrift::detail::fieldDispatchHash(9, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_i;
@@ -1840,7 +1862,7 @@ _loop:
         goto _skip;
       }
     }
-    case 10:
+    case apache::thrift::detail::fieldDispatchHash(10, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_j;
@@ -1848,7 +1870,7 @@ _loop:
         goto _skip;
       }
     }
-    case 11:
+    case apache::thrift::detail::fieldDispatchHash(11, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_j1;
@@ -1856,7 +1878,7 @@ _loop:
         goto _skip;
       }
     }
-    case 12:
+    case apache::thrift::detail::fieldDispatchHash(12, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_j2;
@@ -1864,7 +1886,7 @@ _loop:
         goto _skip;
       }
     }
-    case 13:
+    case apache::thrift::detail::fieldDispatchHash(13, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_j3;
@@ -1872,7 +1894,7 @@ _loop:
         goto _skip;
       }
     }
-    case 14:
+    case apache::thrift::detail::fieldDispatchHash(14, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_k;
@@ -1880,7 +1902,7 @@ _loop:
         goto _skip;
       }
     }
-    case 15:
+    case apache::thrift::detail::fieldDispatchHash(15, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_k1;
@@ -1888,7 +1910,7 @@ _loop:
         goto _skip;
       }
     }
-    case 16:
+    case apache::thrift::detail::fieldDispatchHash(16, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_k2;
@@ -1896,7 +1918,7 @@ _loop:
         goto _skip;
       }
     }
-    case 17:
+    case apache::thrift::detail::fieldDispatchHash(17, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_k3;
@@ -1904,7 +1926,7 @@ _loop:
         goto _skip;
       }
     }
-    case 18:
+    case apache::thrift::detail::fieldDispatchHash(18, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_l;
@@ -1912,7 +1934,7 @@ _loop:
         goto _skip;
       }
     }
-    case 19:
+    case apache::thrift::detail::fieldDispatchHash(19, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_l1;
@@ -1920,7 +1942,7 @@ _loop:
         goto _skip;
       }
     }
-    case 20:
+    case apache::thrift::detail::fieldDispatchHash(20, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_l2;
@@ -1928,7 +1950,7 @@ _loop:
         goto _skip;
       }
     }
-    case 21:
+    case apache::thrift::detail::fieldDispatchHash(21, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_l3;
@@ -1936,7 +1958,7 @@ _loop:
         goto _skip;
       }
     }
-    case 22:
+    case apache::thrift::detail::fieldDispatchHash(22, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_m1;
@@ -1944,7 +1966,7 @@ _loop:
         goto _skip;
       }
     }
-    case 23:
+    case apache::thrift::detail::fieldDispatchHash(23, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_m2;
@@ -1952,7 +1974,7 @@ _loop:
         goto _skip;
       }
     }
-    case 24:
+    case apache::thrift::detail::fieldDispatchHash(24, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_m3;
@@ -1960,7 +1982,7 @@ _loop:
         goto _skip;
       }
     }
-    case 25:
+    case apache::thrift::detail::fieldDispatchHash(25, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_n1;
@@ -1968,7 +1990,7 @@ _loop:
         goto _skip;
       }
     }
-    case 26:
+    case apache::thrift::detail::fieldDispatchHash(26, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_n2;
@@ -1976,7 +1998,7 @@ _loop:
         goto _skip;
       }
     }
-    case 27:
+    case apache::thrift::detail::fieldDispatchHash(27, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_n3;
@@ -1984,7 +2006,7 @@ _loop:
         goto _skip;
       }
     }
-    case 28:
+    case apache::thrift::detail::fieldDispatchHash(28, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_o1;
@@ -1992,7 +2014,7 @@ _loop:
         goto _skip;
       }
     }
-    case 29:
+    case apache::thrift::detail::fieldDispatchHash(29, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_o2;
@@ -2000,7 +2022,7 @@ _loop:
         goto _skip;
       }
     }
-    case 30:
+    case apache::thrift::detail::fieldDispatchHash(30, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_o3;
@@ -3126,8 +3148,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<struct3>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 1u, 0u, 31u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldA;
@@ -3135,7 +3158,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_fieldB;
@@ -3143,7 +3166,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldC;
@@ -3151,7 +3174,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldD;
@@ -3159,7 +3182,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldE;
@@ -3167,7 +3190,7 @@ _loop:
         goto _skip;
       }
     }
-    case 6:
+    case apache::thrift::detail::fieldDispatchHash(6, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldF;
@@ -3175,7 +3198,7 @@ _loop:
         goto _skip;
       }
     }
-    case 7:
+    case apache::thrift::detail::fieldDispatchHash(7, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldG;
@@ -3183,7 +3206,7 @@ _loop:
         goto _skip;
       }
     }
-    case 8:
+    case apache::thrift::detail::fieldDispatchHash(8, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldH;
@@ -3191,7 +3214,7 @@ _loop:
         goto _skip;
       }
     }
-    case 9:
+    case apache::thrift::detail::fieldDispatchHash(9, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldI;
@@ -3199,7 +3222,7 @@ _loop:
         goto _skip;
       }
     }
-    case 10:
+    case apache::thrift::detail::fieldDispatchHash(10, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldJ;
@@ -3207,7 +3230,7 @@ _loop:
         goto _skip;
       }
     }
-    case 11:
+    case apache::thrift::detail::fieldDispatchHash(11, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldK;
@@ -3215,7 +3238,7 @@ _loop:
         goto _skip;
       }
     }
-    case 12:
+    case apache::thrift::detail::fieldDispatchHash(12, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldL;
@@ -3223,7 +3246,7 @@ _loop:
         goto _skip;
       }
     }
-    case 13:
+    case apache::thrift::detail::fieldDispatchHash(13, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldM;
@@ -3231,7 +3254,7 @@ _loop:
         goto _skip;
       }
     }
-    case 14:
+    case apache::thrift::detail::fieldDispatchHash(14, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldN;
@@ -3239,7 +3262,7 @@ _loop:
         goto _skip;
       }
     }
-    case 15:
+    case apache::thrift::detail::fieldDispatchHash(15, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldO;
@@ -3247,7 +3270,7 @@ _loop:
         goto _skip;
       }
     }
-    case 16:
+    case apache::thrift::detail::fieldDispatchHash(16, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldP;
@@ -3255,7 +3278,7 @@ _loop:
         goto _skip;
       }
     }
-    case 17:
+    case apache::thrift::detail::fieldDispatchHash(17, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldQ;
@@ -3263,7 +3286,7 @@ _loop:
         goto _skip;
       }
     }
-    case 18:
+    case apache::thrift::detail::fieldDispatchHash(18, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldR;
@@ -5346,6 +5369,157 @@ void struct_with_special_names::readNoXfer(Protocol_* iprot) {
   using apache::thrift::TProtocolException;
 
 
+  {
+    static constexpr uint8_t _layout[] = {0x08, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x12, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x13, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x15, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x16, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x17, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x19, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x1a, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00};
+    static constexpr uint8_t _layoutMask[] = {0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff};
+    using _FixedLayout = apache::thrift::detail::FixedStructLayout<Protocol_>;
+    if (_FixedLayout::kSupported &&
+        _FixedLayout::match(iprot, _layout, _layoutMask)) {
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->get, _readState);
+        this->__isset.get = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->getter, _readState);
+        this->__isset.getter = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->lists, _readState);
+        this->__isset.lists = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->maps, _readState);
+        this->__isset.maps = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->name, _readState);
+        this->__isset.name = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->name_to_value, _readState);
+        this->__isset.name_to_value = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->names, _readState);
+        this->__isset.names = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->prefix_tree, _readState);
+        this->__isset.prefix_tree = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->sets, _readState);
+        this->__isset.sets = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->setter, _readState);
+        this->__isset.setter = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->str, _readState);
+        this->__isset.str = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->strings, _readState);
+        this->__isset.strings = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->type, _readState);
+        this->__isset.type = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->value, _readState);
+        this->__isset.value = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->value_to_name, _readState);
+        this->__isset.value_to_name = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->values, _readState);
+        this->__isset.values = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->id, _readState);
+        this->__isset.id = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->ids, _readState);
+        this->__isset.ids = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->descriptor, _readState);
+        this->__isset.descriptor = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->descriptors, _readState);
+        this->__isset.descriptors = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->key, _readState);
+        this->__isset.key = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->keys, _readState);
+        this->__isset.keys = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->annotation, _readState);
+        this->__isset.annotation = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->annotations, _readState);
+        this->__isset.annotations = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->member, _readState);
+        this->__isset.member = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->members, _readState);
+        this->__isset.members = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->field, _readState);
+        this->__isset.field = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->fields, _readState);
+        this->__isset.fields = true;
+      }
+      _FixedLayout::skipStop(iprot);
+      goto _end;
+    }
+  }
+
   if (UNLIKELY(!_readState.advanceToNextField(
           iprot,
           0,
@@ -5732,8 +5906,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<struct_with_special_names>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, INT32_MIN, INT32_MIN, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 1u, 0u, 31u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_get;
@@ -5741,7 +5916,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_getter;
@@ -5749,7 +5924,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_lists;
@@ -5757,7 +5932,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_maps;
@@ -5765,7 +5940,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_name;
@@ -5773,7 +5948,7 @@ _loop:
         goto _skip;
       }
     }
-    case 6:
+    case apache::thrift::detail::fieldDispatchHash(6, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_name_to_value;
@@ -5781,7 +5956,7 @@ _loop:
         goto _skip;
       }
     }
-    case 7:
+    case apache::thrift::detail::fieldDispatchHash(7, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_names;
@@ -5789,7 +5964,7 @@ _loop:
         goto _skip;
       }
     }
-    case 8:
+    case apache::thrift::detail::fieldDispatchHash(8, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_prefix_tree;
@@ -5797,7 +5972,7 @@ _loop:
         goto _skip;
       }
     }
-    case 9:
+    case apache::thrift::detail::fieldDispatchHash(9, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_sets;
@@ -5805,7 +5980,7 @@ _loop:
         goto _skip;
       }
     }
-    case 10:
+    case apache::thrift::detail::fieldDispatchHash(10, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_setter;
@@ -5813,7 +5988,7 @@ _loop:
         goto _skip;
       }
     }
-    case 11:
+    case apache::thrift::detail::fieldDispatchHash(11, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_str;
@@ -5821,7 +5996,7 @@ _loop:
         goto _skip;
       }
     }
-    case 12:
+    case apache::thrift::detail::fieldDispatchHash(12, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_strings;
@@ -5829,7 +6004,7 @@ _loop:
         goto _skip;
       }
     }
-    case 13:
+    case apache::thrift::detail::fieldDispatchHash(13, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_type;
@@ -5837,7 +6012,7 @@ _loop:
         goto _skip;
       }
     }
-    case 14:
+    case apache::thrift::detail::fieldDispatchHash(14, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_value;
@@ -5845,7 +6020,7 @@ _loop:
         goto _skip;
       }
     }
-    case 15:
+    case apache::thrift::detail::fieldDispatchHash(15, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_value_to_name;
@@ -5853,7 +6028,7 @@ _loop:
         goto _skip;
       }
     }
-    case 16:
+    case apache::thrift::detail::fieldDispatchHash(16, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_values;
@@ -5861,7 +6036,7 @@ _loop:
         goto _skip;
       }
     }
-    case 17:
+    case apache::thrift::detail::fieldDispatchHash(17, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_id;
@@ -5869,7 +6044,7 @@ _loop:
         goto _skip;
       }
     }
-    case 18:
+    case apache::thrift::detail::fieldDispatchHash(18, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_ids;
@@ -5877,7 +6052,7 @@ _loop:
         goto _skip;
       }
     }
-    case 19:
+    case apache::thrift::detail::fieldDispatchHash(19, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_descriptor;
@@ -5885,7 +6060,7 @@ _loop:
         goto _skip;
       }
     }
-    case 20:
+    case apache::thrift::detail::fieldDispatchHash(20, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_descriptors;
@@ -5893,7 +6068,7 @@ _loop:
         goto _skip;
       }
     }
-    case 21:
+    case apache::thrift::detail::fieldDispatchHash(21, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_key;
@@ -5901,7 +6076,7 @@ _loop:
         goto _skip;
       }
     }
-    case 22:
+    case apache::thrift::detail::fieldDispatchHash(22, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_keys;
@@ -5909,7 +6084,7 @@ _loop:
         goto _skip;
       }
     }
-    case 23:
+    case apache::thrift::detail::fieldDispatchHash(23, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_annotation;
@@ -5917,7 +6092,7 @@ _loop:
         goto _skip;
       }
     }
-    case 24:
+    case apache::thrift::detail::fieldDispatchHash(24, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_annotations;
@@ -5925,7 +6100,7 @@ _loop:
         goto _skip;
       }
     }
-    case 25:
+    case apache::thrift::detail::fieldDispatchHash(25, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_member;
@@ -5933,7 +6108,7 @@ _loop:
         goto _skip;
       }
     }
-    case 26:
+    case apache::thrift::detail::fieldDispatchHash(26, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_members;
@@ -5941,7 +6116,7 @@ _loop:
         goto _skip;
       }
     }
-    case 27:
+    case apache::thrift::detail::fieldDispatchHash(27, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_field;
@@ -5949,7 +6124,7 @@ _loop:
         goto _skip;
       }
     }
-    case 28:
+    case apache::thrift::detail::fieldDispatchHash(28, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fields;
@@ -24,6 +24,9 @@ FROZEN_TYPE(::some::ns::IncludedB,
   FROZEN_LOAD_INLINE(
     FROZEN_LOAD_FIELD(i32Field, 1)
     FROZEN_LOAD_FIELD(strField, 2)));
+FROZEN_COLUMNS(::some::ns::IncludedB,
+  FROZEN_COLUMN(i32Field, 1, int32_t)
+  FROZEN_COLUMN(strField, 2, ::std::string));
 
 
 
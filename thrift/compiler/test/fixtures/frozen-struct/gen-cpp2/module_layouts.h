@@ -42,6 +42,13 @@ FROZEN_TYPE(::some::ns::ModuleA,
     FROZEN_LOAD_FIELD(mapField, 4)
     FROZEN_LOAD_FIELD(inclAField, 5)
     FROZEN_LOAD_FIELD(inclBField, 6)));
+FROZEN_COLUMNS(::some::ns::ModuleA,
+  FROZEN_COLUMN(i32Field, 1, int32_t)
+  FROZEN_COLUMN(strField, 2, ::std::string)
+  FROZEN_COLUMN(listField, 3, ::std::vector<int16_t>)
+  FROZEN_COLUMN(mapField, 4, ::std::map<::std::string, int32_t>)
+  FROZEN_COLUMN(inclAField, 5,  ::some::ns::IncludedA)
+  FROZEN_COLUMN(inclBField, 6,  ::some::ns::IncludedB));
 
 
 
@@ -57,6 +64,9 @@ FROZEN_TYPE(::some::ns::ModuleB,
   FROZEN_LOAD_INLINE(
     FROZEN_LOAD_FIELD(i32Field, 1)
     FROZEN_LOAD_FIELD(inclEnumB, 2)));
+FROZEN_COLUMNS(::some::ns::ModuleB,
+  FROZEN_COLUMN(i32Field, 1, int32_t)
+  FROZEN_COLUMN(inclEnumB, 2,  ::some::ns::EnumB));
 
 
 
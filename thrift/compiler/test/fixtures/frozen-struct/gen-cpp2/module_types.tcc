@@ -313,6 +313,27 @@ void ModuleB::readNoXfer(Protocol_* iprot) {
   using apache::thrift::TProtocolException;
 
 
+  {
+    static constexpr uint8_t _layout[] = {0x08, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00};
+    static constexpr uint8_t _layoutMask[] = {0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff};
+    using _FixedLayout = apache::thrift::detail::FixedStructLayout<Protocol_>;
+    if (_FixedLayout::kSupported &&
+        _FixedLayout::match(iprot, _layout, _layoutMask)) {
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->i32Field, _readState);
+        this->__isset.i32Field = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::enumeration,  ::some::ns::EnumB>::readWithContext(*iprot, this->inclEnumB, _readState);
+        this->__isset.inclEnumB = true;
+      }
+      _FixedLayout::skipStop(iprot);
+      goto _end;
+    }
+  }
+
   if (UNLIKELY(!_readState.advanceToNextField(
           iprot,
           0,
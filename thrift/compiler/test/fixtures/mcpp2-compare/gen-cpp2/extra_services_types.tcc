@@ -242,8 +242,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<containerStruct2>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 1, 2, 3, 4, 5, INT32_MIN, INT32_MIN, INT32_MIN, 201, 202, 203, INT32_MIN, 205, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, 101, 102, 103, INT32_MIN, 105, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 1u, 0u, 63u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_fieldA;
@@ -251,7 +252,7 @@ _loop:
         goto _skip;
       }
     }
-    case 101:
+    case apache::thrift::detail::fieldDispatchHash(101, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_req_fieldA;
@@ -259,7 +260,7 @@ _loop:
         goto _skip;
       }
     }
-    case 201:
+    case apache::thrift::detail::fieldDispatchHash(201, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_opt_fieldA;
@@ -267,7 +268,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldB;
@@ -275,7 +276,7 @@ _loop:
         goto _skip;
       }
     }
-    case 102:
+    case apache::thrift::detail::fieldDispatchHash(102, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_req_fieldB;
@@ -283,7 +284,7 @@ _loop:
         goto _skip;
       }
     }
-    case 202:
+    case apache::thrift::detail::fieldDispatchHash(202, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_opt_fieldB;
@@ -291,7 +292,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldC;
@@ -299,7 +300,7 @@ _loop:
         goto _skip;
       }
     }
-    case 103:
+    case apache::thrift::detail::fieldDispatchHash(103, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_req_fieldC;
@@ -307,7 +308,7 @@ _loop:
         goto _skip;
       }
     }
-    case 203:
+    case apache::thrift::detail::fieldDispatchHash(203, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_opt_fieldC;
@@ -315,7 +316,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_fieldD;
@@ -323,7 +324,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_fieldE;
@@ -331,7 +332,7 @@ _loop:
         goto _skip;
       }
     }
-    case 105:
+    case apache::thrift::detail::fieldDispatchHash(105, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_req_fieldE;
@@ -339,7 +340,7 @@ _loop:
         goto _skip;
       }
     }
-    case 205:
+    case apache::thrift::detail::fieldDispatchHash(205, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_opt_fieldE;
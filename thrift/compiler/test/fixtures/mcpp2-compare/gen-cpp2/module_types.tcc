@@ -634,8 +634,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<MyStruct>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 1, 2, 3, 4, 5, 6, 7, 8, 9, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 1u, 0u, 15u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_MyBoolField;
@@ -643,7 +644,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I64))) {
         goto _readField_MyIntField;
@@ -651,7 +652,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_MyStringField;
@@ -659,7 +660,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_MyStringField2;
@@ -667,7 +668,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_MyBinaryField;
@@ -675,7 +676,7 @@ _loop:
         goto _skip;
       }
     }
-    case 6:
+    case apache::thrift::detail::fieldDispatchHash(6, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_MyBinaryField2;
@@ -683,7 +684,7 @@ _loop:
         goto _skip;
       }
     }
-    case 7:
+    case apache::thrift::detail::fieldDispatchHash(7, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_MyBinaryField3;
@@ -691,7 +692,7 @@ _loop:
         goto _skip;
       }
     }
-    case 8:
+    case apache::thrift::detail::fieldDispatchHash(8, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_MyBinaryListField4;
@@ -699,7 +700,7 @@ _loop:
         goto _skip;
       }
     }
-    case 9:
+    case apache::thrift::detail::fieldDispatchHash(9, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_MyMapEnumAndInt;
@@ -2188,8 +2189,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<AnException>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 102, 5, INT32_MIN, INT32_MIN, 10, INT32_MIN, 2, INT32_MIN, INT32_MIN, 7, INT32_MIN, INT32_MIN, 101, INT32_MIN, 4, INT32_MIN, 9, INT32_MIN, 1, INT32_MIN, INT32_MIN, 6, 19, INT32_MIN, 11, INT32_MIN, 3, 105, INT32_MIN, 8, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 2654435761u, 27u, 31u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_code;
@@ -2197,7 +2199,7 @@ _loop:
         goto _skip;
       }
     }
-    case 101:
+    case apache::thrift::detail::fieldDispatchHash(101, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_req_code;
@@ -2205,7 +2207,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_message2;
@@ -2213,7 +2215,7 @@ _loop:
         goto _skip;
       }
     }
-    case 102:
+    case apache::thrift::detail::fieldDispatchHash(102, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_req_message;
@@ -2221,7 +2223,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_exception_list;
@@ -2229,7 +2231,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_exception_set;
@@ -2237,7 +2239,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_exception_map;
@@ -2245,7 +2247,7 @@ _loop:
         goto _skip;
       }
     }
-    case 105:
+    case apache::thrift::detail::fieldDispatchHash(105, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_req_exception_map;
@@ -2253,7 +2255,7 @@ _loop:
         goto _skip;
       }
     }
-    case 6:
+    case apache::thrift::detail::fieldDispatchHash(6, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_enum_field;
@@ -2261,7 +2263,7 @@ _loop:
         goto _skip;
       }
     }
-    case 7:
+    case apache::thrift::detail::fieldDispatchHash(7, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_enum_container;
@@ -2269,7 +2271,7 @@ _loop:
         goto _skip;
       }
     }
-    case 8:
+    case apache::thrift::detail::fieldDispatchHash(8, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_a_struct;
@@ -2277,7 +2279,7 @@ _loop:
         goto _skip;
       }
     }
-    case 9:
+    case apache::thrift::detail::fieldDispatchHash(9, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_a_set_struct;
@@ -2285,7 +2287,7 @@ _loop:
         goto _skip;
       }
     }
-    case 10:
+    case apache::thrift::detail::fieldDispatchHash(10, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_a_union_list;
@@ -2293,7 +2295,7 @@ _loop:
         goto _skip;
       }
     }
-    case 11:
+    case apache::thrift::detail::fieldDispatchHash(11, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_union_typedef;
@@ -2301,7 +2303,7 @@ _loop:
         goto _skip;
       }
     }
-    case 19:
+    case apache::thrift::detail::fieldDispatchHash(19, 2654435761u, 27u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_a_union_typedef_list;
@@ -3443,8 +3445,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<containerStruct>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, INT32_MIN, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, 201, 202, 203, INT32_MIN, 205, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, 218, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, 223, INT32_MIN, 225, INT32_MIN, INT32_MIN, INT32_MIN, 101, 102, 103, INT32_MIN, 105, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, 118, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, 123, INT32_MIN, 125, INT32_MIN, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 1u, 0u, 127u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_fieldA;
@@ -3452,7 +3455,7 @@ _loop:
         goto _skip;
       }
     }
-    case 101:
+    case apache::thrift::detail::fieldDispatchHash(101, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_req_fieldA;
@@ -3460,7 +3463,7 @@ _loop:
         goto _skip;
       }
     }
-    case 201:
+    case apache::thrift::detail::fieldDispatchHash(201, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_opt_fieldA;
@@ -3468,7 +3471,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldB;
@@ -3476,7 +3479,7 @@ _loop:
         goto _skip;
       }
     }
-    case 102:
+    case apache::thrift::detail::fieldDispatchHash(102, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_req_fieldB;
@@ -3484,7 +3487,7 @@ _loop:
         goto _skip;
       }
     }
-    case 202:
+    case apache::thrift::detail::fieldDispatchHash(202, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_opt_fieldB;
@@ -3492,7 +3495,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldC;
@@ -3500,7 +3503,7 @@ _loop:
         goto _skip;
       }
     }
-    case 103:
+    case apache::thrift::detail::fieldDispatchHash(103, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_req_fieldC;
@@ -3508,7 +3511,7 @@ _loop:
         goto _skip;
       }
     }
-    case 203:
+    case apache::thrift::detail::fieldDispatchHash(203, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_opt_fieldC;
@@ -3516,7 +3519,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_fieldD;
@@ -3524,7 +3527,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_fieldE;
@@ -3532,7 +3535,7 @@ _loop:
         goto _skip;
       }
     }
-    case 105:
+    case apache::thrift::detail::fieldDispatchHash(105, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_req_fieldE;
@@ -3540,7 +3543,7 @@ _loop:
         goto _skip;
       }
     }
-    case 205:
+    case apache::thrift::detail::fieldDispatchHash(205, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_opt_fieldE;
@@ -3548,7 +3551,7 @@ _loop:
         goto _skip;
       }
     }
-    case 6:
+    case apache::thrift::detail::fieldDispatchHash(6, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldF;
@@ -3556,7 +3559,7 @@ _loop:
         goto _skip;
       }
     }
-    case 7:
+    case apache::thrift::detail::fieldDispatchHash(7, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldG;
@@ -3564,7 +3567,7 @@ _loop:
         goto _skip;
       }
     }
-    case 8:
+    case apache::thrift::detail::fieldDispatchHash(8, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldH;
@@ -3572,7 +3575,7 @@ _loop:
         goto _skip;
       }
     }
-    case 9:
+    case apache::thrift::detail::fieldDispatchHash(9, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_fieldI;
@@ -3580,7 +3583,7 @@ _loop:
         goto _skip;
       }
     }
-    case 10:
+    case apache::thrift::detail::fieldDispatchHash(10, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldJ;
@@ -3588,7 +3591,7 @@ _loop:
         goto _skip;
       }
     }
-    case 11:
+    case apache::thrift::detail::fieldDispatchHash(11, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldK;
@@ -3596,7 +3599,7 @@ _loop:
         goto _skip;
       }
     }
-    case 12:
+    case apache::thrift::detail::fieldDispatchHash(12, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldL;
@@ -3604,7 +3607,7 @@ _loop:
         goto _skip;
       }
     }
-    case 13:
+    case apache::thrift::detail::fieldDispatchHash(13, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldM;
@@ -3612,7 +3615,7 @@ _loop:
         goto _skip;
       }
     }
-    case 14:
+    case apache::thrift::detail::fieldDispatchHash(14, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldN;
@@ -3620,7 +3623,7 @@ _loop:
         goto _skip;
       }
     }
-    case 15:
+    case apache::thrift::detail::fieldDispatchHash(15, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldO;
@@ -3628,7 +3631,7 @@ _loop:
         goto _skip;
       }
     }
-    case 16:
+    case apache::thrift::detail::fieldDispatchHash(16, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldP;
@@ -3636,7 +3639,7 @@ _loop:
         goto _skip;
       }
     }
-    case 17:
+    case apache::thrift::detail::fieldDispatchHash(17, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldQ;
@@ -3644,7 +3647,7 @@ _loop:
         goto _skip;
       }
     }
-    case 18:
+    case apache::thrift::detail::fieldDispatchHash(18, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldR;
@@ -3652,7 +3655,7 @@ _loop:
         goto _skip;
       }
     }
-    case 118:
+    case apache::thrift::detail::fieldDispatchHash(118, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_req_fieldR;
@@ -3660,7 +3663,7 @@ _loop:
         goto _skip;
       }
     }
-    case 218:
+    case apache::thrift::detail::fieldDispatchHash(218, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_opt_fieldR;
@@ -3668,7 +3671,7 @@ _loop:
         goto _skip;
       }
     }
-    case 19:
+    case apache::thrift::detail::fieldDispatchHash(19, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldS;
@@ -3676,7 +3679,7 @@ _loop:
         goto _skip;
       }
     }
-    case 21:
+    case apache::thrift::detail::fieldDispatchHash(21, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldT;
@@ -3684,7 +3687,7 @@ _loop:
         goto _skip;
       }
     }
-    case 22:
+    case apache::thrift::detail::fieldDispatchHash(22, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldU;
@@ -3692,7 +3695,7 @@ _loop:
         goto _skip;
       }
     }
-    case 23:
+    case apache::thrift::detail::fieldDispatchHash(23, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldV;
@@ -3700,7 +3703,7 @@ _loop:
         goto _skip;
       }
     }
-    case 123:
+    case apache::thrift::detail::fieldDispatchHash(123, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_req_fieldV;
@@ -3708,7 +3711,7 @@ _loop:
         goto _skip;
       }
     }
-    case 223:
+    case apache::thrift::detail::fieldDispatchHash(223, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_opt_fieldV;
@@ -3716,7 +3719,7 @@ _loop:
         goto _skip;
       }
     }
-    case 24:
+    case apache::thrift::detail::fieldDispatchHash(24, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldW;
@@ -3724,7 +3727,7 @@ _loop:
         goto _skip;
       }
     }
-    case 25:
+    case apache::thrift::detail::fieldDispatchHash(25, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldX;
@@ -3732,7 +3735,7 @@ _loop:
         goto _skip;
       }
     }
-    case 125:
+    case apache::thrift::detail::fieldDispatchHash(125, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_req_fieldX;
@@ -3740,7 +3743,7 @@ _loop:
         goto _skip;
       }
     }
-    case 225:
+    case apache::thrift::detail::fieldDispatchHash(225, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_opt_fieldX;
@@ -3748,7 +3751,7 @@ _loop:
         goto _skip;
       }
     }
-    case 26:
+    case apache::thrift::detail::fieldDispatchHash(26, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldY;
@@ -3756,7 +3759,7 @@ _loop:
         goto _skip;
       }
     }
-    case 27:
+    case apache::thrift::detail::fieldDispatchHash(27, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldZ;
@@ -3764,7 +3767,7 @@ _loop:
         goto _skip;
       }
     }
-    case 28:
+    case apache::thrift::detail::fieldDispatchHash(28, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldAA;
@@ -3772,7 +3775,7 @@ _loop:
         goto _skip;
       }
     }
-    case 29:
+    case apache::thrift::detail::fieldDispatchHash(29, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldAB;
@@ -3780,7 +3783,7 @@ _loop:
         goto _skip;
       }
     }
-    case 30:
+    case apache::thrift::detail::fieldDispatchHash(30, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldAC;
@@ -3788,7 +3791,7 @@ _loop:
         goto _skip;
       }
     }
-    case 31:
+    case apache::thrift::detail::fieldDispatchHash(31, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldAD;
@@ -3796,7 +3799,7 @@ _loop:
         goto _skip;
       }
     }
-    case 32:
+    case apache::thrift::detail::fieldDispatchHash(32, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldAE;
@@ -3804,7 +3807,7 @@ _loop:
         goto _skip;
       }
     }
-    case 33:
+    case apache::thrift::detail::fieldDispatchHash(33, 1u, 0u, 127u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_fieldSD;
@@ -5329,8 +5332,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<AnnotatedStruct>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 1u, 0u, 63u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_no_annotation;
@@ -5338,7 +5342,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_cpp_unique_ref;
@@ -5346,7 +5350,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_cpp2_unique_ref;
@@ -5354,7 +5358,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_container_with_ref;
@@ -5362,7 +5366,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_req_cpp_unique_ref;
@@ -5370,7 +5374,7 @@ _loop:
         goto _skip;
       }
     }
-    case 6:
+    case apache::thrift::detail::fieldDispatchHash(6, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_req_cpp2_unique_ref;
@@ -5378,7 +5382,7 @@ _loop:
         goto _skip;
       }
     }
-    case 7:
+    case apache::thrift::detail::fieldDispatchHash(7, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_req_container_with_ref;
@@ -5386,7 +5390,7 @@ _loop:
         goto _skip;
       }
     }
-    case 8:
+    case apache::thrift::detail::fieldDispatchHash(8, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_opt_cpp_unique_ref;
@@ -5394,7 +5398,7 @@ _loop:
         goto _skip;
       }
     }
-    case 9:
+    case apache::thrift::detail::fieldDispatchHash(9, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_opt_cpp2_unique_ref;
@@ -5402,7 +5406,7 @@ _loop:
         goto _skip;
       }
     }
-    case 10:
+    case apache::thrift::detail::fieldDispatchHash(10, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_opt_container_with_ref;
@@ -5410,7 +5414,7 @@ _loop:
         goto _skip;
       }
     }
-    case 11:
+    case apache::thrift::detail::fieldDispatchHash(11, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_ref_type_unique;
@@ -5418,7 +5422,7 @@ _loop:
         goto _skip;
       }
     }
-    case 12:
+    case apache::thrift::detail::fieldDispatchHash(12, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_ref_type_shared;
@@ -5426,7 +5430,7 @@ _loop:
         goto _skip;
       }
     }
-    case 13:
+    case apache::thrift::detail::fieldDispatchHash(13, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_ref_type_const;
@@ -5434,7 +5438,7 @@ _loop:
         goto _skip;
       }
     }
-    case 14:
+    case apache::thrift::detail::fieldDispatchHash(14, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_req_ref_type_shared;
@@ -5442,7 +5446,7 @@ _loop:
         goto _skip;
       }
     }
-    case 15:
+    case apache::thrift::detail::fieldDispatchHash(15, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_req_ref_type_const;
@@ -5450,7 +5454,7 @@ _loop:
         goto _skip;
       }
     }
-    case 16:
+    case apache::thrift::detail::fieldDispatchHash(16, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_req_ref_type_unique;
@@ -5458,7 +5462,7 @@ _loop:
         goto _skip;
       }
     }
-    case 17:
+    case apache::thrift::detail::fieldDispatchHash(17, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_opt_ref_type_const;
@@ -5466,7 +5470,7 @@ _loop:
         goto _skip;
       }
     }
-    case 18:
+    case apache::thrift::detail::fieldDispatchHash(18, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_opt_ref_type_unique;
@@ -5474,7 +5478,7 @@ _loop:
         goto _skip;
       }
     }
-    case 19:
+    case apache::thrift::detail::fieldDispatchHash(19, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_opt_ref_type_shared;
@@ -5482,7 +5486,7 @@ _loop:
         goto _skip;
       }
     }
-    case 20:
+    case apache::thrift::detail::fieldDispatchHash(20, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_base_type;
@@ -5490,7 +5494,7 @@ _loop:
         goto _skip;
       }
     }
-    case 21:
+    case apache::thrift::detail::fieldDispatchHash(21, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_list_type;
@@ -5498,7 +5502,7 @@ _loop:
         goto _skip;
       }
     }
-    case 22:
+    case apache::thrift::detail::fieldDispatchHash(22, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_set_type;
@@ -5506,7 +5510,7 @@ _loop:
         goto _skip;
       }
     }
-    case 23:
+    case apache::thrift::detail::fieldDispatchHash(23, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_map_type;
@@ -5514,7 +5518,7 @@ _loop:
         goto _skip;
       }
     }
-    case 24:
+    case apache::thrift::detail::fieldDispatchHash(24, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_map_struct_type;
@@ -5522,7 +5526,7 @@ _loop:
         goto _skip;
       }
     }
-    case 25:
+    case apache::thrift::detail::fieldDispatchHash(25, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_iobuf_type;
@@ -5530,7 +5534,7 @@ _loop:
         goto _skip;
       }
     }
-    case 26:
+    case apache::thrift::detail::fieldDispatchHash(26, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_iobuf_ptr;
@@ -5538,7 +5542,7 @@ _loop:
         goto _skip;
       }
     }
-    case 27:
+    case apache::thrift::detail::fieldDispatchHash(27, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_list_i32_template;
@@ -5546,7 +5550,7 @@ _loop:
         goto _skip;
       }
     }
-    case 28:
+    case apache::thrift::detail::fieldDispatchHash(28, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_list_string_template;
@@ -5554,7 +5558,7 @@ _loop:
         goto _skip;
       }
     }
-    case 29:
+    case apache::thrift::detail::fieldDispatchHash(29, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_set_template;
@@ -5562,7 +5566,7 @@ _loop:
         goto _skip;
       }
     }
-    case 30:
+    case apache::thrift::detail::fieldDispatchHash(30, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_map_template;
@@ -5570,7 +5574,7 @@ _loop:
         goto _skip;
       }
     }
-    case 31:
+    case apache::thrift::detail::fieldDispatchHash(31, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_typedef_list_template;
@@ -5578,7 +5582,7 @@ _loop:
         goto _skip;
       }
     }
-    case 32:
+    case apache::thrift::detail::fieldDispatchHash(32, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_typedef_deque_template;
@@ -5586,7 +5590,7 @@ _loop:
         goto _skip;
       }
     }
-    case 33:
+    case apache::thrift::detail::fieldDispatchHash(33, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_typedef_set_template;
@@ -5594,7 +5598,7 @@ _loop:
         goto _skip;
       }
     }
-    case 34:
+    case apache::thrift::detail::fieldDispatchHash(34, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_typedef_map_template;
@@ -5602,7 +5606,7 @@ _loop:
         goto _skip;
       }
     }
-    case 35:
+    case apache::thrift::detail::fieldDispatchHash(35, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I64))) {
         goto _readField_indirection_a;
@@ -5610,7 +5614,7 @@ _loop:
         goto _skip;
       }
     }
-    case 36:
+    case apache::thrift::detail::fieldDispatchHash(36, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_indirection_b;
@@ -5618,7 +5622,7 @@ _loop:
         goto _skip;
       }
     }
-    case 37:
+    case apache::thrift::detail::fieldDispatchHash(37, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_indirection_c;
@@ -5626,7 +5630,7 @@ _loop:
         goto _skip;
       }
     }
-    case 38:
+    case apache::thrift::detail::fieldDispatchHash(38, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_iobuf_type_val;
@@ -5634,7 +5638,7 @@ _loop:
         goto _skip;
       }
     }
-    case 39:
+    case apache::thrift::detail::fieldDispatchHash(39, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_iobuf_ptr_val;
@@ -5642,7 +5646,7 @@ _loop:
         goto _skip;
       }
     }
-    case 40:
+    case apache::thrift::detail::fieldDispatchHash(40, 1u, 0u, 63u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_struct_struct;
@@ -6679,6 +6683,27 @@ void FloatStruct::readNoXfer(Protocol_* iprot) {
   using apache::thrift::TProtocolException;
 
 
+  {
+    static constexpr uint8_t _layout[] = {0x13, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    static constexpr uint8_t _layoutMask[] = {0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff};
+    using _FixedLayout = apache::thrift::detail::FixedStructLayout<Protocol_>;
+    if (_FixedLayout::kSupported &&
+        _FixedLayout::match(iprot, _layout, _layoutMask)) {
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::floating_point, float>::readWithContext(*iprot, this->floatField, _readState);
+        this->__isset.floatField = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::floating_point, double>::readWithContext(*iprot, this->doubleField, _readState);
+        this->__isset.doubleField = true;
+      }
+      _FixedLayout::skipStop(iprot);
+      goto _end;
+    }
+  }
+
   if (UNLIKELY(!_readState.advanceToNextField(
           iprot,
           0,
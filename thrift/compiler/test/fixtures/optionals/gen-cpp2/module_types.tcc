@@ -59,6 +59,33 @@ void Color::readNoXfer(Protocol_* iprot) {
   using apache::thrift::TProtocolException;
 
 
+  {
+    static constexpr uint8_t _layout[] = {0x04, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    static constexpr uint8_t _layoutMask[] = {0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff};
+    using _FixedLayout = apache::thrift::detail::FixedStructLayout<Protocol_>;
+    if (_FixedLayout::kSupported &&
+        _FixedLayout::match(iprot, _layout, _layoutMask)) {
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::floating_point, double>::readWithContext(*iprot, this->red, _readState);
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::floating_point, double>::readWithContext(*iprot, this->green, _readState);
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::floating_point, double>::readWithContext(*iprot, this->blue, _readState);
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::floating_point, double>::readWithContext(*iprot, this->alpha, _readState);
+      }
+      _FixedLayout::skipStop(iprot);
+      goto _end;
+    }
+  }
+
   if (UNLIKELY(!_readState.advanceToNextField(
           iprot,
           0,
@@ -647,8 +674,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<Person>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 1u, 0u, 15u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I64))) {
         goto _readField_id;
@@ -656,7 +684,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_name;
@@ -664,7 +692,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I16))) {
         goto _readField_age;
@@ -672,7 +700,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_address;
@@ -680,7 +708,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_favoriteColor;
@@ -688,7 +716,7 @@ _loop:
         goto _skip;
       }
     }
-    case 6:
+    case apache::thrift::detail::fieldDispatchHash(6, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_friends;
@@ -696,7 +724,7 @@ _loop:
         goto _skip;
       }
     }
-    case 7:
+    case apache::thrift::detail::fieldDispatchHash(7, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I64))) {
         goto _readField_bestFriend;
@@ -704,7 +732,7 @@ _loop:
         goto _skip;
       }
     }
-    case 8:
+    case apache::thrift::detail::fieldDispatchHash(8, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_petNames;
@@ -712,7 +740,7 @@ _loop:
         goto _skip;
       }
     }
-    case 9:
+    case apache::thrift::detail::fieldDispatchHash(9, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_afraidOfAnimal;
@@ -720,7 +748,7 @@ _loop:
         goto _skip;
       }
     }
-    case 10:
+    case apache::thrift::detail::fieldDispatchHash(10, 1u, 0u, 15u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_vehicles;
@@ -52,6 +52,27 @@ void SmallStruct::readNoXfer(Protocol_* iprot) {
   using apache::thrift::TProtocolException;
 
 
+  {
+    static constexpr uint8_t _layout[] = {0x02, 0x00, 0x01, 0x00, 0x08, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00};
+    static constexpr uint8_t _layoutMask[] = {0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff};
+    using _FixedLayout = apache::thrift::detail::FixedStructLayout<Protocol_>;
+    if (_FixedLayout::kSupported &&
+        _FixedLayout::match(iprot, _layout, _layoutMask)) {
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, bool>::readWithContext(*iprot, this->small_A, _readState);
+        this->__isset.small_A = true;
+      }
+      _FixedLayout::skipFieldHeader(iprot);
+      {
+        ::apache::thrift::detail::pm::protocol_methods< ::apache::thrift::type_class::integral, int32_t>::readWithContext(*iprot, this->small_B, _readState);
+        this->__isset.small_B = true;
+      }
+      _FixedLayout::skipStop(iprot);
+      goto _end;
+    }
+  }
+
   if (UNLIKELY(!_readState.advanceToNextField(
           iprot,
           0,
@@ -566,8 +587,9 @@ _loop:
     _readState.template fillFieldTraitsFromName<apache::thrift::detail::TccStructTraits<containerStruct>>();
   }
 
-  switch (_readState.fieldId) {
-    case 1:
+  static constexpr int32_t _fieldIds[] = {INT32_MIN, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, INT32_MIN, 23, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN, INT32_MIN};
+  switch (apache::thrift::detail::fieldDispatchSlot(_fieldIds, _readState.fieldId, 1u, 0u, 31u)) {
+    case apache::thrift::detail::fieldDispatchHash(1, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_fieldA;
@@ -575,7 +597,7 @@ _loop:
         goto _skip;
       }
     }
-    case 2:
+    case apache::thrift::detail::fieldDispatchHash(2, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldB;
@@ -583,7 +605,7 @@ _loop:
         goto _skip;
       }
     }
-    case 3:
+    case apache::thrift::detail::fieldDispatchHash(3, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldC;
@@ -591,7 +613,7 @@ _loop:
         goto _skip;
       }
     }
-    case 4:
+    case apache::thrift::detail::fieldDispatchHash(4, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_fieldD;
@@ -599,7 +621,7 @@ _loop:
         goto _skip;
       }
     }
-    case 5:
+    case apache::thrift::detail::fieldDispatchHash(5, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRING))) {
         goto _readField_fieldE;
@@ -607,7 +629,7 @@ _loop:
         goto _skip;
       }
     }
-    case 6:
+    case apache::thrift::detail::fieldDispatchHash(6, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldF;
@@ -615,7 +637,7 @@ _loop:
         goto _skip;
       }
     }
-    case 7:
+    case apache::thrift::detail::fieldDispatchHash(7, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldG;
@@ -623,7 +645,7 @@ _loop:
         goto _skip;
       }
     }
-    case 8:
+    case apache::thrift::detail::fieldDispatchHash(8, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldH;
@@ -631,7 +653,7 @@ _loop:
         goto _skip;
       }
     }
-    case 9:
+    case apache::thrift::detail::fieldDispatchHash(9, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_BOOL))) {
         goto _readField_fieldI;
@@ -639,7 +661,7 @@ _loop:
         goto _skip;
       }
     }
-    case 10:
+    case apache::thrift::detail::fieldDispatchHash(10, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldJ;
@@ -647,7 +669,7 @@ _loop:
         goto _skip;
       }
     }
-    case 11:
+    case apache::thrift::detail::fieldDispatchHash(11, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldK;
@@ -655,7 +677,7 @@ _loop:
         goto _skip;
       }
     }
-    case 12:
+    case apache::thrift::detail::fieldDispatchHash(12, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_SET))) {
         goto _readField_fieldL;
@@ -663,7 +685,7 @@ _loop:
         goto _skip;
       }
     }
-    case 13:
+    case apache::thrift::detail::fieldDispatchHash(13, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldM;
@@ -671,7 +693,7 @@ _loop:
         goto _skip;
       }
     }
-    case 14:
+    case apache::thrift::detail::fieldDispatchHash(14, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldN;
@@ -679,7 +701,7 @@ _loop:
         goto _skip;
       }
     }
-    case 15:
+    case apache::thrift::detail::fieldDispatchHash(15, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldO;
@@ -687,7 +709,7 @@ _loop:
         goto _skip;
       }
     }
-    case 16:
+    case apache::thrift::detail::fieldDispatchHash(16, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_LIST))) {
         goto _readField_fieldP;
@@ -695,7 +717,7 @@ _loop:
         goto _skip;
       }
     }
-    case 17:
+    case apache::thrift::detail::fieldDispatchHash(17, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_I32))) {
         goto _readField_fieldQ;
@@ -703,7 +725,7 @@ _loop:
         goto _skip;
       }
     }
-    case 18:
+    case apache::thrift::detail::fieldDispatchHash(18, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_MAP))) {
         goto _readField_fieldR;
@@ -711,7 +733,7 @@ _loop:
         goto _skip;
       }
     }
-    case 19:
+    case apache::thrift::detail::fieldDispatchHash(19, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldS;
@@ -719,7 +741,7 @@ _loop:
         goto _skip;
       }
     }
-    case 20:
+    case apache::thrift::detail::fieldDispatchHash(20, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldT;
@@ -727,7 +749,7 @@ _loop:
         goto _skip;
       }
     }
-    case 21:
+    case apache::thrift::detail::fieldDispatchHash(21, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldU;
@@ -735,7 +757,7 @@ _loop:
         goto _skip;
       }
     }
-    case 23:
+    case apache::thrift::detail::fieldDispatchHash(23, 1u, 0u, 31u):
     {
       if (LIKELY(_readState.isCompatibleWithType(iprot, apache::thrift::protocol::T_STRUCT))) {
         goto _readField_fieldX;
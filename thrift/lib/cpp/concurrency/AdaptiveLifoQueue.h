@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _THRIFT_CONCURRENCY_ADAPTIVELIFOQUEUE_H_
+#define _THRIFT_CONCURRENCY_ADAPTIVELIFOQUEUE_H_ 1
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace apache {
+namespace thrift {
+namespace concurrency {
+
+/**
+ * AdaptiveLifoQueue class
+ *
+ * A multi-producer multi-consumer queue with priorities (0 being the highest)
+ * which serves the items of a priority in arrival order, or, once switched to
+ * LIFO, newest first.
+ *
+ * Under overload, a FIFO queue makes every item wait behind all the older
+ * ones, until none of them is served before its deadline. Serving the newest
+ * items first keeps serving some on time, while the oldest ones, likely past
+ * their deadline already, can be dropped from the other end of the queue with
+ * try_dequeue_oldest_if().
+ */
+template <typename T>
+class AdaptiveLifoQueue {
+ public:
+  explicit AdaptiveLifoQueue(size_t numPriorities)
+      : queues_(std::max<size_t>(1, numPriorities)) {}
+
+  void enqueue(size_t priority, T item) {
+    std::lock_guard<std::mutex> g(mutex_);
+    queues_[std::min(queues_.size() - 1, priority)].push_back(std::move(item));
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Dequeue an item of the highest priority with pending items: the oldest
+   * one, or the newest one in LIFO mode.
+   */
+  bool try_dequeue(T& item) {
+    const bool lifo = isLifo();
+    std::lock_guard<std::mutex> g(mutex_);
+    for (auto& queue : queues_) {
+      if (queue.empty()) {
+        continue;
+      }
+      if (lifo) {
+        item = std::move(queue.back());
+        queue.pop_back();
+      } else {
+        item = std::move(queue.front());
+        queue.pop_front();
+      }
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Dequeue the oldest item of a priority if pred returns true for it,
+   * starting from the lowest priority.
+   */
+  template <typename Pred>
+  bool try_dequeue_oldest_if(T& item, Pred&& pred) {
+    std::lock_guard<std::mutex> g(mutex_);
+    for (auto it = queues_.rbegin(); it != queues_.rend(); ++it) {
+      if (!it->empty() && pred(it->front())) {
+        item = std::move(it->front());
+        it->pop_front();
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void setLifo(bool lifo) {
+    lifo_.store(lifo, std::memory_order_relaxed);
+  }
+
+  bool isLifo() const {
+    return lifo_.load(std::memory_order_relaxed);
+  }
+
+  size_t size() const {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  size_t priorities() const {
+    return queues_.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  // Accesses to queues_ should lock mutex_
+  std::vector<std::deque<T>> queues_;
+
+  std::atomic<size_t> size_{0};
+  std::atomic<bool> lifo_{false};
+};
+
+} // namespace concurrency
+} // namespace thrift
+} // namespace apache
+
+#endif // #ifndef _THRIFT_CONCURRENCY_ADAPTIVELIFOQUEUE_H_
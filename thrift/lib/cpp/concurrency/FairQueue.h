@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _THRIFT_CONCURRENCY_FAIRQUEUE_H_
+#define _THRIFT_CONCURRENCY_FAIRQUEUE_H_ 1
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace apache {
+namespace thrift {
+namespace concurrency {
+
+/**
+ * Key of the items of the tenant `name` in a FairQueue. Items without a
+ * tenant use key 0, as does the empty name.
+ */
+inline uint64_t fairQueueKey(const std::string& name) {
+  return name.empty() ? 0 : std::hash<std::string>()(name);
+}
+
+/**
+ * FairQueue class
+ *
+ * A multi-producer multi-consumer queue whose items are enqueued under a key
+ * (e.g. the client which sent a request), and dequeued in turn for each key
+ * with pending items, using deficit round robin: in each round, a key may
+ * dequeue as many items as its weight. A key flooding the queue thus only
+ * delays the items of the other keys by its weight, not by its backlog.
+ *
+ * Keys are hashes of the tenant names, see fairQueueKey(), computed by the
+ * producers so that the critical section only deals with integers. Keys
+ * missing from the weights get the default weight.
+ */
+template <typename T>
+class FairQueue {
+ public:
+  typedef std::unordered_map<std::string, uint32_t> Weights;
+
+  explicit FairQueue(
+      const Weights& weights = Weights(),
+      uint32_t defaultWeight = 1)
+      : defaultWeight_(std::max<uint32_t>(1, defaultWeight)) {
+    for (const auto& weight : weights) {
+      weights_[fairQueueKey(weight.first)] =
+          std::max<uint32_t>(1, weight.second);
+    }
+  }
+
+  void enqueue(uint64_t key, T item) {
+    std::lock_guard<std::mutex> g(mutex_);
+    auto it = flows_.find(key);
+    if (it == flows_.end()) {
+      it = flows_.emplace(key, Flow(getWeight(key))).first;
+      active_.push_back(it);
+    }
+    it->second.items.push_back(std::move(item));
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  bool try_dequeue(T& item) {
+    std::lock_guard<std::mutex> g(mutex_);
+    if (active_.empty()) {
+      return false;
+    }
+    auto it = active_.front();
+    auto& flow = it->second;
+    if (flow.deficit == 0) {
+      // Beginning of the turn of the key
+      flow.deficit = flow.weight;
+    }
+    item = std::move(flow.items.front());
+    flow.items.pop_front();
+    --flow.deficit;
+    size_.fetch_sub(1, std::memory_order_relaxed);
+
+    if (flow.items.empty()) {
+      // An idle key doesn't save its deficit for later
+      active_.pop_front();
+      flows_.erase(it);
+    } else if (flow.deficit == 0) {
+      active_.pop_front();
+      active_.push_back(it);
+    }
+    return true;
+  }
+
+  size_t size() const {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  uint32_t getWeight(uint64_t key) const {
+    auto it = weights_.find(key);
+    return it == weights_.end() ? defaultWeight_ : it->second;
+  }
+
+ private:
+  struct Flow {
+    explicit Flow(uint32_t weight_) : weight(weight_) {}
+
+    const uint32_t weight;
+    uint32_t deficit{0};
+    std::deque<T> items;
+  };
+
+  // A node based map, so that active_ can hold iterators into it
+  typedef std::map<uint64_t, Flow> Flows;
+
+  std::unordered_map<uint64_t, uint32_t> weights_;
+  const uint32_t defaultWeight_;
+
+  std::mutex mutex_;
+  // Accesses to the following members should lock mutex_
+  Flows flows_;
+  // Keys with pending items, in the order they are served
+  std::deque<typename Flows::iterator> active_;
+
+  std::atomic<size_t> size_{0};
+};
+
+} // namespace concurrency
+} // namespace thrift
+} // namespace apache
+
+#endif // #ifndef _THRIFT_CONCURRENCY_FAIRQUEUE_H_
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _THRIFT_CONCURRENCY_NUMATHREADMANAGER_H_
+#define _THRIFT_CONCURRENCY_NUMATHREADMANAGER_H_ 1
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <folly/Conv.h>
+#include <folly/DefaultKeepAliveExecutor.h>
+
+#include <thrift/lib/cpp/concurrency/InitThreadFactory.h>
+#include <thrift/lib/cpp/concurrency/NumaTopology.h>
+#include <thrift/lib/cpp/concurrency/PosixThreadFactory.h>
+#include <thrift/lib/cpp/concurrency/ThreadManager.h>
+
+namespace apache {
+namespace thrift {
+namespace concurrency {
+
+/**
+ * NumaThreadManager class
+ *
+ * A PriorityThreadManager made of one PriorityThreadManager per NUMA node,
+ * whose threads are bound to the CPUs of that node. A task runs on the node
+ * of the thread adding it, so that a request an IO thread bound to a node
+ * hands over is processed, and its response built, next to the memory the
+ * IO thread allocated for it. Tasks added by threads bound to no node go to
+ * the node of the CPU the thread happens to run on.
+ */
+class NumaThreadManager : public PriorityThreadManager,
+                          public folly::DefaultKeepAliveExecutor {
+ public:
+  /**
+   * normalThreadsCount threads of NORMAL priority are spread over the nodes,
+   * each node getting at least one, along with a couple of threads for each
+   * other priority, as newPriorityThreadManager() does.
+   */
+  static std::shared_ptr<NumaThreadManager> newNumaThreadManager(
+      size_t normalThreadsCount,
+      bool enableTaskStats = false,
+      const NumaTopology& topology = NumaTopology::get()) {
+    static_assert(N_PRIORITIES == 5, "Implementation is out-of-date");
+    const size_t numNodes = topology.numNodes();
+    std::vector<std::shared_ptr<PriorityThreadManager>> managers;
+    for (size_t node = 0; node < numNodes; node++) {
+      size_t normalThreads = normalThreadsCount / numNodes +
+          (node < normalThreadsCount % numNodes ? 1 : 0);
+      auto factory = [&](PosixThreadFactory::PRIORITY prio) {
+        return bindToNode(
+            std::make_shared<PosixThreadFactory>(
+                PosixThreadFactory::OTHER, prio),
+            topology,
+            node);
+      };
+      // Note that priorities for HIGH and IMPORTANT are the same, the
+      // difference is in the number of threads.
+      managers.push_back(PriorityThreadManager::newPriorityThreadManager(
+          {{
+              {factory(PosixThreadFactory::HIGHER_PRI), 2},
+              {factory(PosixThreadFactory::HIGH_PRI), 2},
+              {factory(PosixThreadFactory::HIGH_PRI), 2},
+              {factory(PosixThreadFactory::NORMAL_PRI),
+               std::max<size_t>(1, normalThreads)},
+              {factory(PosixThreadFactory::LOW_PRI), 2},
+          }},
+          enableTaskStats));
+    }
+    return std::make_shared<NumaThreadManager>(std::move(managers), topology);
+  }
+
+  NumaThreadManager(
+      std::vector<std::shared_ptr<PriorityThreadManager>> managers,
+      const NumaTopology& topology)
+      : managers_(std::move(managers)),
+        topology_(topology),
+        tasks_(managers_.size()) {
+    CHECK(!managers_.empty());
+  }
+
+  ~NumaThreadManager() override {
+    joinKeepAliveOnce();
+  }
+
+  static std::shared_ptr<ThreadFactory> bindToNode(
+      std::shared_ptr<ThreadFactory> factory,
+      const NumaTopology& topology,
+      size_t node) {
+    return std::make_shared<InitThreadFactory>(
+        factory, [&topology, node] { topology.bindCurrentThread(node); });
+  }
+
+  size_t numNodes() const {
+    return managers_.size();
+  }
+
+  PriorityThreadManager& getNodeManager(size_t node) {
+    return *managers_[node];
+  }
+
+  // Tasks added to the threads of a node so far
+  size_t getNodeTaskCount(size_t node) const {
+    return tasks_[node].load(std::memory_order_relaxed);
+  }
+
+  // Tasks added by threads bound to no node, which may have been scheduled on
+  // another node since they read their CPU
+  size_t getUnboundTaskCount() const {
+    return unboundTasks_.load(std::memory_order_relaxed);
+  }
+
+  void start() override {
+    for (auto& m : managers_) {
+      m->start();
+    }
+  }
+
+  void stop() override {
+    joinKeepAliveOnce();
+    for (auto& m : managers_) {
+      m->stop();
+    }
+  }
+
+  void join() override {
+    joinKeepAliveOnce();
+    for (auto& m : managers_) {
+      m->join();
+    }
+  }
+
+  STATE state() const override {
+    // The node managers change state together
+    return managers_[0]->state();
+  }
+
+  std::string getNamePrefix() const override {
+    return namePrefix_;
+  }
+
+  void setNamePrefix(const std::string& name) override {
+    namePrefix_ = name;
+    for (size_t node = 0; node < managers_.size(); node++) {
+      managers_[node]->setNamePrefix(folly::to<std::string>(name, "-n", node));
+    }
+  }
+
+  std::shared_ptr<ThreadFactory> threadFactory() const override {
+    throw IllegalStateException("Not implemented");
+    return std::shared_ptr<ThreadFactory>();
+  }
+
+  void threadFactory(std::shared_ptr<ThreadFactory> value) override {
+    for (size_t node = 0; node < managers_.size(); node++) {
+      managers_[node]->threadFactory(bindToNode(value, topology_, node));
+    }
+  }
+
+  void addWorker(size_t value) override {
+    addWorker(NORMAL, value);
+  }
+
+  void removeWorker(size_t value) override {
+    removeWorker(NORMAL, value);
+  }
+
+  void addWorker(PRIORITY priority, size_t value) override {
+    for (size_t i = 0; i < value; i++) {
+      managers_[nextWorkerNode_++ % managers_.size()]->addWorker(priority, 1);
+    }
+  }
+
+  void removeWorker(PRIORITY priority, size_t value) override {
+    for (size_t i = 0; i < value; i++) {
+      managers_[--nextWorkerNode_ % managers_.size()]->removeWorker(
+          priority, 1);
+    }
+  }
+
+  size_t workerCount(PRIORITY priority) override {
+    size_t count = 0;
+    for (auto& m : managers_) {
+      count += m->workerCount(priority);
+    }
+    return count;
+  }
+
+  void add(
+      std::shared_ptr<Runnable> task,
+      int64_t timeout = 0,
+      int64_t expiration = 0,
+      bool cancellable = false) noexcept override {
+    PriorityRunnable* p = dynamic_cast<PriorityRunnable*>(task.get());
+    PRIORITY prio = p ? p->getPriority() : NORMAL;
+    add(prio, std::move(task), timeout, expiration, cancellable);
+  }
+
+  void add(
+      PRIORITY priority,
+      std::shared_ptr<Runnable> task,
+      int64_t timeout = 0,
+      int64_t expiration = 0,
+      bool cancellable = false) noexcept override {
+    currentManager().add(
+        priority, std::move(task), timeout, expiration, cancellable);
+  }
+
+  /**
+   * Implements folly::Executor::add()
+   */
+  void add(folly::Func f) override {
+    add(FunctionRunner::create(std::move(f)));
+  }
+
+  /**
+   * Implements folly::Executor::addWithPriority(), see
+   * PriorityThreadManager::PriorityImplT::addWithPriority()
+   */
+  void addWithPriority(folly::Func f, int8_t priority) override {
+    add(translatePriority(priority), FunctionRunner::create(std::move(f)));
+  }
+
+  template <typename T>
+  size_t sum(T method) const {
+    size_t count = 0;
+    for (const auto& m : managers_) {
+      count += ((*m).*method)();
+    }
+    return count;
+  }
+
+  size_t idleWorkerCount() const override {
+    return sum(&ThreadManager::idleWorkerCount);
+  }
+
+  size_t workerCount() const override {
+    return sum(&ThreadManager::workerCount);
+  }
+
+  size_t pendingTaskCount() const override {
+    return sum(&ThreadManager::pendingTaskCount);
+  }
+
+  size_t pendingTaskCount(PRIORITY priority) const override {
+    size_t count = 0;
+    for (const auto& m : managers_) {
+      count += m->pendingTaskCount(priority);
+    }
+    return count;
+  }
+
+  size_t totalTaskCount() const override {
+    return sum(&ThreadManager::totalTaskCount);
+  }
+
+  size_t expiredTaskCount() override {
+    size_t count = 0;
+    for (auto& m : managers_) {
+      count += m->expiredTaskCount();
+    }
+    return count;
+  }
+
+  void remove(std::shared_ptr<Runnable> /*task*/) override {
+    throw IllegalStateException("Not implemented");
+  }
+
+  std::shared_ptr<Runnable> removeNextPending() override {
+    throw IllegalStateException("Not implemented");
+    return std::shared_ptr<Runnable>();
+  }
+
+  void clearPending() override {
+    for (auto& m : managers_) {
+      m->clearPending();
+    }
+  }
+
+  void setExpireCallback(ExpireCallback expireCallback) override {
+    for (auto& m : managers_) {
+      m->setExpireCallback(expireCallback);
+    }
+  }
+
+  void setCodelCallback(ExpireCallback expireCallback) override {
+    for (auto& m : managers_) {
+      m->setCodelCallback(expireCallback);
+    }
+  }
+
+  void setThreadInitCallback(InitCallback /*initCallback*/) override {
+    throw IllegalStateException("Not implemented");
+  }
+
+  void enableCodel(bool enabled) override {
+    for (auto& m : managers_) {
+      m->enableCodel(enabled);
+    }
+  }
+
+  // The CoDel state of the node of the calling thread
+  folly::Codel* getCodel() override {
+    return getCodel(NORMAL);
+  }
+
+  folly::Codel* getCodel(PRIORITY priority) override {
+    return managers_[topology_.currentNode() % managers_.size()]->getCodel(
+        priority);
+  }
+
+  void enableAdaptiveLifo(bool enabled) override {
+    for (auto& m : managers_) {
+      m->enableAdaptiveLifo(enabled);
+    }
+  }
+
+  bool isAdaptiveLifoEnabled() const override {
+    return managers_.front()->isAdaptiveLifoEnabled();
+  }
+
+ private:
+  PriorityThreadManager& currentManager() {
+    if (NumaTopology::boundNode() < 0) {
+      unboundTasks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto node = topology_.currentNode() % managers_.size();
+    tasks_[node].fetch_add(1, std::memory_order_relaxed);
+    return *managers_[node];
+  }
+
+  void joinKeepAliveOnce() {
+    if (!std::exchange(keepAliveJoined_, true)) {
+      joinKeepAlive();
+    }
+  }
+
+  std::vector<std::shared_ptr<PriorityThreadManager>> managers_;
+  const NumaTopology& topology_;
+  std::string namePrefix_;
+  size_t nextWorkerNode_{0};
+  std::vector<std::atomic<size_t>> tasks_;
+  std::atomic<size_t> unboundTasks_{0};
+  bool keepAliveJoined_{false};
+};
+
+} // namespace concurrency
+} // namespace thrift
+} // namespace apache
+
+#endif // #ifndef _THRIFT_CONCURRENCY_NUMATHREADMANAGER_H_
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp/concurrency/NumaTopology.h>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include <glog/logging.h>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace apache {
+namespace thrift {
+namespace concurrency {
+
+namespace {
+
+thread_local int tlBoundNode = -1;
+
+std::vector<std::vector<int>> allCpusOnOneNode() {
+  std::vector<int> cpus;
+  long n = sysconf(_SC_NPROCESSORS_CONF);
+  for (int cpu = 0; cpu < std::max(1L, n); cpu++) {
+    cpus.push_back(cpu);
+  }
+  return {std::move(cpus)};
+}
+
+bool parseInt(const std::string& s, int& value) {
+  if (s.empty() || s.size() > 9 ||
+      !std::all_of(s.begin(), s.end(), [](char c) {
+        return c >= '0' && c <= '9';
+      })) {
+    return false;
+  }
+  value = std::atoi(s.c_str());
+  return true;
+}
+
+} // namespace
+
+NumaTopology::NumaTopology(std::vector<std::vector<int>> nodeCpus)
+    : nodeCpus_(std::move(nodeCpus)) {
+  if (nodeCpus_.empty()) {
+    nodeCpus_ = allCpusOnOneNode();
+  }
+  for (size_t node = 0; node < nodeCpus_.size(); node++) {
+    for (int cpu : nodeCpus_[node]) {
+      if (cpu >= static_cast<int>(cpuNodes_.size())) {
+        cpuNodes_.resize(cpu + 1, -1);
+      }
+      cpuNodes_[cpu] = node;
+    }
+  }
+}
+
+const NumaTopology& NumaTopology::get() {
+  static const NumaTopology topology = fromSysfs();
+  return topology;
+}
+
+NumaTopology NumaTopology::fromSysfs(const std::string& nodeDir) {
+  std::vector<std::pair<int, std::vector<int>>> nodes;
+  if (DIR* dir = opendir(nodeDir.c_str())) {
+    while (struct dirent* entry = readdir(dir)) {
+      std::string name = entry->d_name;
+      int node;
+      if (name.compare(0, 4, "node") != 0 || !parseInt(name.substr(4), node)) {
+        continue;
+      }
+      std::ifstream file(nodeDir + "/" + name + "/cpulist");
+      std::string list;
+      if (!std::getline(file, list)) {
+        continue;
+      }
+      auto cpus = parseCpuList(list);
+      // Memory-only nodes have no CPU to run threads on
+      if (!cpus.empty()) {
+        nodes.emplace_back(node, std::move(cpus));
+      }
+    }
+    closedir(dir);
+  }
+
+  if (nodes.empty()) {
+    VLOG(1) << "No NUMA topology under " << nodeDir
+            << ", assuming a single node";
+    return NumaTopology({});
+  }
+
+  std::sort(nodes.begin(), nodes.end());
+  std::vector<std::vector<int>> nodeCpus;
+  for (auto& node : nodes) {
+    nodeCpus.push_back(std::move(node.second));
+  }
+  return NumaTopology(std::move(nodeCpus));
+}
+
+std::vector<int> NumaTopology::parseCpuList(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream ranges(list);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    while (!range.empty() && std::isspace(range.back())) {
+      range.pop_back();
+    }
+    if (range.empty()) {
+      continue;
+    }
+    auto dash = range.find('-');
+    int first;
+    int last;
+    if (dash == std::string::npos) {
+      if (!parseInt(range, first)) {
+        return {};
+      }
+      last = first;
+    } else if (
+        !parseInt(range.substr(0, dash), first) ||
+        !parseInt(range.substr(dash + 1), last) || last < first) {
+      return {};
+    }
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+int NumaTopology::nodeOfCpu(int cpu) const {
+  if (cpu < 0 || cpu >= static_cast<int>(cpuNodes_.size())) {
+    return -1;
+  }
+  return cpuNodes_[cpu];
+}
+
+int NumaTopology::currentNode() const {
+  if (tlBoundNode >= 0) {
+    return tlBoundNode;
+  }
+#if defined(__linux__)
+  int node = nodeOfCpu(sched_getcpu());
+  if (node >= 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+void NumaTopology::bindCurrentThread(size_t node) const {
+  node %= numNodes();
+  tlBoundNode = node;
+#if defined(__linux__)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (int cpu : nodeCpus_[node]) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuset);
+    }
+  }
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+  if (err != 0) {
+    LOG(WARNING) << "Failed to bind thread to NUMA node " << node
+                 << ", error " << err;
+  }
+#endif
+}
+
+int NumaTopology::boundNode() {
+  return tlBoundNode;
+}
+
+} // namespace concurrency
+} // namespace thrift
+} // namespace apache
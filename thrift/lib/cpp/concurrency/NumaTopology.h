@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _THRIFT_CONCURRENCY_NUMATOPOLOGY_H_
+#define _THRIFT_CONCURRENCY_NUMATOPOLOGY_H_ 1
+
+#include <string>
+#include <vector>
+
+namespace apache {
+namespace thrift {
+namespace concurrency {
+
+/**
+ * NumaTopology class
+ *
+ * The CPUs of each NUMA node of the host, as listed by
+ * /sys/devices/system/node. Hosts without that information, or non-Linux
+ * ones, are seen as a single node holding every CPU.
+ */
+class NumaTopology {
+ public:
+  explicit NumaTopology(std::vector<std::vector<int>> nodeCpus);
+
+  /**
+   * Topology of the host, read once.
+   */
+  static const NumaTopology& get();
+
+  static NumaTopology fromSysfs(
+      const std::string& nodeDir = "/sys/devices/system/node");
+
+  /**
+   * Parse a kernel CPU list such as "0-3,8,10-11". Returns an empty list if
+   * the string is malformed.
+   */
+  static std::vector<int> parseCpuList(const std::string& list);
+
+  size_t numNodes() const {
+    return nodeCpus_.size();
+  }
+
+  const std::vector<int>& cpusOfNode(size_t node) const {
+    return nodeCpus_[node];
+  }
+
+  // -1 if the CPU is unknown
+  int nodeOfCpu(int cpu) const;
+
+  /**
+   * Node the calling thread runs on: the one it was bound to with
+   * bindCurrentThread(), otherwise the node of the CPU it currently runs on.
+   * 0 if that can't be told.
+   */
+  int currentNode() const;
+
+  /**
+   * Restrict the calling thread to the CPUs of a node, and remember that node
+   * for currentNode().
+   */
+  void bindCurrentThread(size_t node) const;
+
+  // Node the calling thread was bound to, -1 if none
+  static int boundNode();
+
+ private:
+  std::vector<std::vector<int>> nodeCpus_;
+  std::vector<int> cpuNodes_;
+};
+
+} // namespace concurrency
+} // namespace thrift
+} // namespace apache
+
+#endif // #ifndef _THRIFT_CONCURRENCY_NUMATOPOLOGY_H_
@@ -36,6 +36,14 @@ class Runnable {
   virtual ~Runnable() {}
   virtual void run() = 0;
 
+  /**
+   * Key of the client this runnable runs for, under which fair queue thread
+   * managers queue it. 0 when there is none.
+   */
+  virtual uint64_t getFairQueueKey() const {
+    return 0;
+  }
+
   /**
    * Gets the thread object that is hosting this runnable object  - can return
    * an empty std::shared pointer if no references remain on the thread object
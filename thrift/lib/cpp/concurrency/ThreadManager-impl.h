@@ -32,6 +32,9 @@
 #include <folly/synchronization/LifoSem.h>
 #include <folly/synchronization/SmallLocks.h>
 
+#include <thrift/lib/cpp/concurrency/AdaptiveLifoQueue.h>
+#include <thrift/lib/cpp/concurrency/FairQueue.h>
+
 namespace apache {
 namespace thrift {
 namespace concurrency {
@@ -126,6 +129,19 @@ class ThreadManager::ImplT : public ThreadManager,
         namePrefixCounter_(0),
         codelEnabled_(false || FLAGS_codel_enabled) {}
 
+  /**
+   * Queue the tasks in a FairQueue keyed by their fair queue key instead of
+   * by priority.
+   */
+  ImplT(
+      bool enableTaskStats,
+      std::string fairQueueHeader,
+      const typename FairQueue<std::unique_ptr<Task>>::Weights& weights)
+      : ImplT(enableTaskStats) {
+    fairQueueHeader_ = std::move(fairQueueHeader);
+    fairTasks_ = std::make_unique<FairQueue<std::unique_ptr<Task>>>(weights);
+  }
+
   ~ImplT() override {
     stop();
   }
@@ -177,7 +193,8 @@ class ThreadManager::ImplT : public ThreadManager,
   }
 
   size_t pendingTaskCount() const override {
-    return tasks_.size();
+    return tasks_.size() + (fairTasks_ ? fairTasks_->size() : 0) +
+        (lifoTasks_ ? lifoTasks_->size() : 0);
   }
 
   size_t totalTaskCount() const override {
@@ -224,6 +241,13 @@ class ThreadManager::ImplT : public ThreadManager,
       int64_t maxItems) override;
   void enableCodel(bool) override;
   Codel* getCodel() override;
+  void enableAdaptiveLifo(bool) override;
+  bool isAdaptiveLifoEnabled() const override {
+    return lifoTasks_ != nullptr;
+  }
+  const std::string& getFairQueueHeader() const override {
+    return fairQueueHeader_;
+  }
 
   // Methods to be invoked by workers
   void workerStarted(Worker<SemType>* worker);
@@ -234,6 +258,7 @@ class ThreadManager::ImplT : public ThreadManager,
       const SystemClockTimePoint& workEnd);
   std::unique_ptr<Task> waitOnTask();
   void onTaskExpired(const Task& task);
+  void updateLifo(bool overloaded, const SystemClockTimePoint& now);
 
   Codel codel_;
 
@@ -259,6 +284,17 @@ class ThreadManager::ImplT : public ThreadManager,
       bool afterTasks = false);
   bool shouldStop();
 
+  void enqueueTask(size_t priority, std::unique_ptr<Task> task);
+  bool tryDequeueTask(std::unique_ptr<Task>& task) {
+    if (fairTasks_ && fairTasks_->try_dequeue(task)) {
+      return true;
+    }
+    if (lifoTasks_ && lifoTasks_->try_dequeue(task)) {
+      return true;
+    }
+    return tasks_.try_dequeue(task);
+  }
+
   size_t workerCount_;
   // intendedWorkerCount_ tracks the number of worker threads that we currently
   // want to have.  This may be different from workerCount_ while we are
@@ -285,6 +321,12 @@ class ThreadManager::ImplT : public ThreadManager,
 
   folly::PriorityUMPMCQueueSet<std::unique_ptr<Task>, /* MayBlock = */ false>
       tasks_;
+  // If set, holds the tasks instead of tasks_, which then only gets the
+  // nullptr tasks asking the workers to exit
+  std::unique_ptr<FairQueue<std::unique_ptr<Task>>> fairTasks_;
+  std::string fairQueueHeader_;
+  // Same as fairTasks_, set by enableAdaptiveLifo()
+  std::unique_ptr<AdaptiveLifoQueue<std::unique_ptr<Task>>> lifoTasks_;
 
   mutable std::mutex mutex_;
   std::mutex stateUpdateMutex_;
@@ -107,14 +107,20 @@ class ThreadManager::ImplT<SemType>::Worker : public Runnable {
       // Getting the current time is moderately expensive,
       // so only get the time if we actually need it.
       SystemClockTimePoint startTime;
-      if (task->canExpire() || task->statsEnabled()) {
+      if (task->canExpire() || task->statsEnabled() || manager_->lifoTasks_) {
         startTime = SystemClock::now();
 
         // Codel auto-expire time algorithm
         auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
             startTime - task->getQueueBeginTime());
 
-        if (task->canExpire() && manager_->codel_.overloaded(delay)) {
+        const bool overloaded = (task->canExpire() || manager_->lifoTasks_) &&
+            manager_->codel_.overloaded(delay);
+        if (manager_->lifoTasks_) {
+          manager_->updateLifo(overloaded, startTime);
+        }
+
+        if (task->canExpire() && overloaded) {
           if (manager_->codelCallback_) {
             manager_->codelCallback_(task->getRunnable());
           }
@@ -261,15 +267,15 @@ void ThreadManager::ImplT<SemType>::stopImpl(bool joinArg) {
     if (joinArg) {
       state_ = ThreadManager::JOINING;
       removeWorkerImpl(l, intendedWorkerCount_, true);
-      assert(tasks_.empty());
+      assert(pendingTaskCount() == 0);
     } else {
       state_ = ThreadManager::STOPPING;
       removeWorkerImpl(l, intendedWorkerCount_);
       // Empty the task queue, in case we stopped without running
       // all of the tasks.
-      totalTaskCount_ -= tasks_.size();
+      totalTaskCount_ -= pendingTaskCount();
       std::unique_ptr<Task> task;
-      while (tasks_.try_dequeue(task)) {
+      while (tryDequeueTask(task)) {
       }
     }
     state_ = ThreadManager::STOPPED;
@@ -311,8 +317,7 @@ void ThreadManager::ImplT<SemType>::removeWorkerImpl(
     // Insert nullptr tasks onto the tasks queue to ask workers to exit
     // after all current tasks are completed
     for (size_t n = 0; n < value; ++n) {
-      auto const qpriority = tasks_.priorities() / 2; // median priority
-      tasks_.at_priority(qpriority).enqueue(nullptr);
+      enqueueTask(tasks_.priorities() / 2, nullptr); // median priority
       ++totalTaskCount_;
     }
     cond_.notify_all();
@@ -373,8 +378,7 @@ void ThreadManager::ImplT<SemType>::add(
 
   auto task = std::make_unique<Task>(
       std::move(value), std::chrono::milliseconds{expiration});
-  auto const qpriority = std::min(tasks_.priorities() - 1, priority);
-  tasks_.at_priority(qpriority).enqueue(std::move(task));
+  enqueueTask(priority, std::move(task));
 
   ++totalTaskCount_;
 
@@ -385,6 +389,25 @@ void ThreadManager::ImplT<SemType>::add(
   }
 }
 
+template <typename SemType>
+void ThreadManager::ImplT<SemType>::enqueueTask(
+    size_t priority,
+    std::unique_ptr<Task> task) {
+  // nullptr tasks asking the workers to exit stay in tasks_, which is only
+  // dequeued from once fairTasks_ is empty
+  if (fairTasks_ && task) {
+    auto key = task->getRunnable()->getFairQueueKey();
+    fairTasks_->enqueue(key, std::move(task));
+    return;
+  }
+  if (lifoTasks_ && task) {
+    lifoTasks_->enqueue(priority, std::move(task));
+    return;
+  }
+  auto const qpriority = std::min(tasks_.priorities() - 1, priority);
+  tasks_.at_priority(qpriority).enqueue(std::move(task));
+}
+
 template <typename SemType>
 void ThreadManager::ImplT<SemType>::remove(shared_ptr<Runnable> /*task*/) {
   std::unique_lock<std::mutex> l(mutex_);
@@ -407,7 +430,7 @@ std::shared_ptr<Runnable> ThreadManager::ImplT<SemType>::removeNextPending() {
   }
 
   std::unique_ptr<Task> task;
-  if (tasks_.try_dequeue(task)) {
+  if (tryDequeueTask(task)) {
     std::shared_ptr<Runnable> r = task->getRunnable();
     --totalTaskCount_;
     return r;
@@ -447,7 +470,7 @@ ThreadManager::ImplT<SemType>::waitOnTask() {
   std::unique_ptr<Task> task;
 
   // Fast path - if tasks are ready, get one
-  if (tasks_.try_dequeue(task)) {
+  if (tryDequeueTask(task)) {
     --totalTaskCount_;
     return task;
   }
@@ -462,7 +485,7 @@ ThreadManager::ImplT<SemType>::waitOnTask() {
   ++idleCount_;
   --totalTaskCount_;
   l.unlock();
-  while (!tasks_.try_dequeue(task)) {
+  while (!tryDequeueTask(task)) {
     waitSem_.wait();
     if (shouldStop()) {
       std::unique_lock<std::mutex> l2(mutex_);
@@ -569,6 +592,52 @@ Codel* ThreadManager::ImplT<SemType>::getCodel() {
   return &codel_;
 }
 
+template <typename SemType>
+void ThreadManager::ImplT<SemType>::enableAdaptiveLifo(bool enabled) {
+  std::unique_lock<std::mutex> l(mutex_);
+  if (state_ != ThreadManager::UNINITIALIZED) {
+    throw IllegalStateException(
+        "ThreadManager::Impl::enableAdaptiveLifo must be called before "
+        "start()");
+  }
+  if (fairTasks_) {
+    LOG(WARNING) << "Adaptive LIFO is not supported with fair queuing";
+    return;
+  }
+  lifoTasks_ = enabled
+      ? std::make_unique<AdaptiveLifoQueue<std::unique_ptr<Task>>>(
+            tasks_.priorities())
+      : nullptr;
+}
+
+template <typename SemType>
+void ThreadManager::ImplT<SemType>::updateLifo(
+    bool overloaded,
+    const SystemClockTimePoint& now) {
+  // Switch to LIFO when CoDel reports a standing queue, and back to FIFO
+  // once the backlog is gone: the tasks served in LIFO mode barely wait, so
+  // their delay doesn't tell whether the queue is still standing.
+  if (overloaded) {
+    lifoTasks_->setLifo(true);
+  } else if (lifoTasks_->empty()) {
+    lifoTasks_->setLifo(false);
+  }
+  if (!lifoTasks_->isLifo()) {
+    return;
+  }
+
+  // The oldest tasks are the last to be served in LIFO mode, drop the ones
+  // whose expiration passed rather than let them build up.
+  std::unique_ptr<Task> expired;
+  while (lifoTasks_->try_dequeue_oldest_if(
+      expired, [&](const std::unique_ptr<Task>& task) {
+        return task && task->canExpire() && task->getExpireTime() <= now;
+      })) {
+    --totalTaskCount_;
+    onTaskExpired(*expired);
+  }
+}
+
 template <typename SemType>
 class SimpleThreadManager : public ThreadManager::ImplT<SemType> {
  public:
@@ -724,6 +793,44 @@ shared_ptr<ThreadManager> ThreadManager::newPriorityQueueThreadManager(
   return tm;
 }
 
+template <typename SemType>
+class FairQueueThreadManager : public ThreadManager::ImplT<SemType> {
+ public:
+  FairQueueThreadManager(
+      size_t numThreads,
+      std::string keyHeader,
+      const std::unordered_map<std::string, uint32_t>& weights,
+      bool enableTaskStats = false)
+      : ThreadManager::ImplT<SemType>(
+            enableTaskStats,
+            std::move(keyHeader),
+            weights),
+        numThreads_(numThreads) {}
+
+  void start() override {
+    if (this->state() == this->STARTED) {
+      return;
+    }
+    ThreadManager::ImplT<SemType>::start();
+    this->addWorker(numThreads_);
+  }
+
+ private:
+  const size_t numThreads_;
+};
+
+template <typename SemType>
+shared_ptr<ThreadManager> ThreadManager::newFairQueueThreadManager(
+    size_t numThreads,
+    std::string keyHeader,
+    std::unordered_map<std::string, uint32_t> weights,
+    bool enableTaskStats) {
+  auto tm = make_shared<FairQueueThreadManager<SemType>>(
+      numThreads, std::move(keyHeader), weights, enableTaskStats);
+  tm->threadFactory(Factory(PosixThreadFactory::NORMAL_PRI));
+  return tm;
+}
+
 template <typename SemType>
 class PriorityThreadManager::PriorityImplT
     : public PriorityThreadManager,
@@ -956,6 +1063,16 @@ class PriorityThreadManager::PriorityImplT
     return getCodel(NORMAL);
   }
 
+  void enableAdaptiveLifo(bool enabled) override {
+    for (auto& m : managers_) {
+      m->enableAdaptiveLifo(enabled);
+    }
+  }
+
+  bool isAdaptiveLifoEnabled() const override {
+    return managers_[NORMAL]->isAdaptiveLifoEnabled();
+  }
+
   Codel* getCodel(PRIORITY priority) override {
     return managers_[priority]->getCodel();
   }
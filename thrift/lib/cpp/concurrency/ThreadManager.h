@@ -22,6 +22,8 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include <folly/Executor.h>
 #include <folly/SharedMutex.h>
@@ -31,6 +33,7 @@
 #include <folly/portability/Unistd.h>
 #include <folly/synchronization/LifoSem.h>
 
+#include <thrift/lib/cpp/concurrency/Exception.h>
 #include <thrift/lib/cpp/concurrency/FunctionRunner.h>
 #include <thrift/lib/cpp/concurrency/Thread.h>
 #include <thrift/lib/cpp/concurrency/Util.h>
@@ -228,6 +231,23 @@ class ThreadManager : public virtual folly::Executor {
       size_t numThreads,
       bool enableTaskStats = false);
 
+  /**
+   * Creates a thread manager which serves its pending tasks in turn for
+   * each key returned by Runnable::getFairQueueKey() (e.g. the client which
+   * sent a request), so that one key flooding the queue doesn't hold up the
+   * others. The tasks of a key with weight N are served N at a time, keys
+   * missing from the weights have weight 1. See FairQueue.
+   *
+   * `keyHeader` names the request header whose value keys the requests, see
+   * getFairQueueHeader().
+   */
+  template <typename SemType = folly::LifoSem>
+  static std::shared_ptr<ThreadManager> newFairQueueThreadManager(
+      size_t numThreads,
+      std::string keyHeader = std::string(),
+      std::unordered_map<std::string, uint32_t> weights = {},
+      bool enableTaskStats = false);
+
   /**
    * Get an internal statistics.
    *
@@ -264,6 +284,36 @@ class ThreadManager : public virtual folly::Executor {
 
   virtual folly::Codel* getCodel() = 0;
 
+  /**
+   * Serve the tasks newest first while CoDel reports a standing queue, until
+   * the queue is empty again, and meanwhile drop the oldest tasks once their
+   * expiration passed. Under overload, this serves some tasks on time rather
+   * than all of them late. Must be called before start(). Throws if the
+   * thread manager doesn't support it.
+   */
+  virtual void enableAdaptiveLifo(bool) {
+    throw IllegalStateException("Adaptive LIFO is not supported");
+  }
+
+  /**
+   * Whether enableAdaptiveLifo() was called. Only then may a task's
+   * expiration be its deadline: otherwise CoDel drops expirable tasks as
+   * soon as the queue is standing, and the workers drop them once expired.
+   */
+  virtual bool isAdaptiveLifoEnabled() const {
+    return false;
+  }
+
+  /**
+   * Name of the request header whose value keys the tasks of a fair queue
+   * thread manager, or empty. Request tasks read it once when they are
+   * created, and keep the key for Runnable::getFairQueueKey().
+   */
+  virtual const std::string& getFairQueueHeader() const {
+    static const std::string kNone;
+    return kNone;
+  }
+
   template <typename SemType>
   class ImplT;
 
@@ -427,6 +477,7 @@ class ThreadManagerExecutorAdapter : public ThreadManager {
   folly::Codel* getCodel() override {
     return nullptr;
   }
+  void enableAdaptiveLifo(bool) override {}
 
  private:
   std::shared_ptr<folly::Executor> exe_;
@@ -74,6 +74,18 @@ int64_t Util::monotonicTimeTicks(int64_t ticksPerSec) {
 #endif // defined(THRIFT_HAVE_CLOCK_GETTIME)
 }
 
+int64_t Util::threadCpuTimeNsec() {
+#if defined(THRIFT_HAVE_CLOCK_GETTIME) && defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec now;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+    int64_t result;
+    toTicks(result, now, NS_PER_S);
+    return result;
+  }
+#endif // defined(THRIFT_HAVE_CLOCK_GETTIME)
+  return -1;
+}
+
 } // namespace concurrency
 } // namespace thrift
 } // namespace apache
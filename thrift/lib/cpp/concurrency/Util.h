@@ -171,6 +171,12 @@ class Util {
   static int64_t monotonicTimeUsec() {
     return monotonicTimeTicks(US_PER_S);
   }
+
+  /**
+   * Get the CPU time consumed by the calling thread, in nanoseconds, or -1
+   * on systems which can't measure it.
+   */
+  static int64_t threadCpuTimeNsec();
 };
 
 typedef std::chrono::system_clock SystemClock;
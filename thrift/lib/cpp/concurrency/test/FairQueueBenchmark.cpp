@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/concurrency/PriorityUnboundedQueueSet.h>
+#include <folly/portability/GFlags.h>
+#include <glog/logging.h>
+#include <thrift/lib/cpp/concurrency/FairQueue.h>
+#include <thrift/lib/cpp/concurrency/ThreadManager.h>
+
+DEFINE_int32(threads, 4, "Number of worker threads");
+DEFINE_int32(noisy_tasks, 1000000, "Number of tasks the noisy tenant floods");
+DEFINE_int32(quiet_tasks, 10000, "Number of tasks of the quiet tenant");
+DEFINE_int32(quiet_interval_us, 20, "Interval between the quiet tasks");
+DEFINE_int32(task_ns, 500, "Time each task spins for");
+
+using namespace apache::thrift::concurrency;
+using std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kKeys = 16;
+
+void spin(std::chrono::nanoseconds duration) {
+  auto end = steady_clock::now() + duration;
+  while (steady_clock::now() < end) {
+  }
+}
+
+class TimedTask : public Runnable {
+ public:
+  TimedTask(const std::string& key, int64_t* latencyNs)
+      : key_(fairQueueKey(key)),
+        latencyNs_(latencyNs),
+        enqueued_(steady_clock::now()) {}
+
+  void run() override {
+    *latencyNs_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      steady_clock::now() - enqueued_)
+                      .count();
+    spin(std::chrono::nanoseconds(FLAGS_task_ns));
+  }
+
+  uint64_t getFairQueueKey() const override {
+    return key_;
+  }
+
+ private:
+  const uint64_t key_;
+  int64_t* latencyNs_;
+  const steady_clock::time_point enqueued_;
+};
+
+const std::vector<std::string>& keys() {
+  static const auto keys = [] {
+    std::vector<std::string> v;
+    for (int i = 0; i < kKeys; i++) {
+      v.push_back("tenant" + std::to_string(i));
+    }
+    return v;
+  }();
+  return keys;
+}
+
+const std::vector<uint64_t>& keyHashes() {
+  static const auto hashes = [] {
+    std::vector<uint64_t> v;
+    for (const auto& key : keys()) {
+      v.push_back(fairQueueKey(key));
+    }
+    return v;
+  }();
+  return hashes;
+}
+
+// Cost of going through the queue alone, from a single thread
+BENCHMARK(PriorityUMPMCQueueSet, iters) {
+  folly::PriorityUMPMCQueueSet<int64_t, /* MayBlock = */ false> queue(
+      N_PRIORITIES);
+  int64_t item;
+  for (size_t i = 0; i < iters; i++) {
+    queue.at_priority(NORMAL).enqueue(i);
+    queue.try_dequeue(item);
+  }
+  folly::doNotOptimizeAway(item);
+}
+
+BENCHMARK_RELATIVE(FairQueue, iters) {
+  FairQueue<int64_t> queue;
+  int64_t item;
+  for (size_t i = 0; i < iters; i++) {
+    queue.enqueue(keyHashes()[i % kKeys], i);
+    queue.try_dequeue(item);
+  }
+  folly::doNotOptimizeAway(item);
+}
+
+BENCHMARK_RELATIVE(FairQueueBacklog, iters) {
+  FairQueue<int64_t> queue;
+  int64_t item;
+  for (size_t i = 0; i < iters; i++) {
+    queue.enqueue(keyHashes()[i % kKeys], i);
+  }
+  while (queue.try_dequeue(item)) {
+  }
+  folly::doNotOptimizeAway(item);
+}
+
+BENCHMARK_DRAW_LINE();
+
+// Throughput of tasks spread over kKeys keys, from one producer
+void runTasks(size_t iters, std::shared_ptr<ThreadManager> threadManager) {
+  std::vector<int64_t> latencies;
+  BENCHMARK_SUSPEND {
+    latencies.resize(iters);
+    threadManager->start();
+  }
+  for (size_t i = 0; i < iters; i++) {
+    threadManager->add(
+        std::make_shared<TimedTask>(keys()[i % kKeys], &latencies[i]));
+  }
+  threadManager->join();
+}
+
+BENCHMARK(SimpleThreadManager, iters) {
+  std::shared_ptr<ThreadManager> threadManager;
+  BENCHMARK_SUSPEND {
+    threadManager = ThreadManager::newSimpleThreadManager(FLAGS_threads);
+  }
+  runTasks(iters, std::move(threadManager));
+}
+
+BENCHMARK_RELATIVE(FairQueueThreadManager, iters) {
+  std::shared_ptr<ThreadManager> threadManager;
+  BENCHMARK_SUSPEND {
+    threadManager = ThreadManager::newFairQueueThreadManager(FLAGS_threads);
+  }
+  runTasks(iters, std::move(threadManager));
+}
+
+struct Tenant {
+  Tenant(std::string name_, size_t tasks) : name(name_), latencyNs(tasks) {}
+
+  void print(const char* manager) {
+    std::sort(latencyNs.begin(), latencyNs.end());
+    auto percentile = [&](double p) {
+      return latencyNs[std::min(
+                 latencyNs.size() - 1, size_t(p * latencyNs.size()))] /
+          1000.0;
+    };
+    printf(
+        "%-24s %-6s %8zu tasks  p50 %10.1fus  p99 %10.1fus  max %10.1fus\n",
+        manager,
+        name.c_str(),
+        latencyNs.size(),
+        percentile(0.5),
+        percentile(0.99),
+        percentile(1.0));
+  }
+
+  const std::string name;
+  std::vector<int64_t> latencyNs;
+};
+
+/**
+ * A noisy tenant floods the thread manager with more tasks than it can run,
+ * while a quiet one sends a task every quiet_interval_us. Prints the time the
+ * tasks of each waited in the queue, and the overall throughput.
+ */
+void isolation(const char* name, std::shared_ptr<ThreadManager> threadManager) {
+  Tenant noisy("noisy", FLAGS_noisy_tasks);
+  Tenant quiet("quiet", FLAGS_quiet_tasks);
+  threadManager->start();
+
+  const auto start = steady_clock::now();
+  std::thread noisyProducer([&] {
+    for (auto& latency : noisy.latencyNs) {
+      threadManager->add(std::make_shared<TimedTask>(noisy.name, &latency));
+    }
+  });
+  std::thread quietProducer([&] {
+    for (auto& latency : quiet.latencyNs) {
+      threadManager->add(std::make_shared<TimedTask>(quiet.name, &latency));
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(FLAGS_quiet_interval_us));
+    }
+  });
+  noisyProducer.join();
+  quietProducer.join();
+  threadManager->join();
+  const std::chrono::duration<double> elapsed = steady_clock::now() - start;
+
+  noisy.print(name);
+  quiet.print(name);
+  printf(
+      "%-24s %.0f tasks/s\n",
+      name,
+      (FLAGS_noisy_tasks + FLAGS_quiet_tasks) / elapsed.count());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  folly::runBenchmarks();
+
+  isolation(
+      "SimpleThreadManager",
+      ThreadManager::newSimpleThreadManager(FLAGS_threads));
+  isolation(
+      "FairQueueThreadManager",
+      ThreadManager::newFairQueueThreadManager(FLAGS_threads));
+  return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp/concurrency/NumaTopology.h>
+
+#include <sys/stat.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <folly/portability/GTest.h>
+
+using namespace apache::thrift::concurrency;
+
+TEST(NumaTopologyTest, parseCpuList) {
+  EXPECT_EQ(
+      NumaTopology::parseCpuList("0-3,8,10-11\n"),
+      (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(NumaTopology::parseCpuList("5"), std::vector<int>{5});
+  EXPECT_TRUE(NumaTopology::parseCpuList("").empty());
+  EXPECT_TRUE(NumaTopology::parseCpuList("3-1").empty());
+  EXPECT_TRUE(NumaTopology::parseCpuList("a-b").empty());
+}
+
+TEST(NumaTopologyTest, nodeOfCpu) {
+  NumaTopology topology({{0, 1, 4, 5}, {2, 3, 6, 7}});
+  EXPECT_EQ(topology.numNodes(), 2);
+  EXPECT_EQ(topology.nodeOfCpu(4), 0);
+  EXPECT_EQ(topology.nodeOfCpu(6), 1);
+  EXPECT_EQ(topology.nodeOfCpu(8), -1);
+  EXPECT_EQ(topology.nodeOfCpu(-1), -1);
+}
+
+TEST(NumaTopologyTest, fromSysfs) {
+  char dir[] = "/tmp/NumaTopologyTestXXXXXX";
+  ASSERT_NE(mkdtemp(dir), nullptr);
+  auto addNode = [&](const std::string& name, const std::string& cpus) {
+    auto nodeDir = std::string(dir) + "/" + name;
+    ASSERT_EQ(mkdir(nodeDir.c_str(), 0700), 0);
+    std::ofstream(nodeDir + "/cpulist") << cpus << "\n";
+  };
+  addNode("node1", "4-7");
+  addNode("node0", "0-3");
+  // Memory-only node
+  addNode("node2", "");
+  addNode("possible", "0-7");
+
+  auto topology = NumaTopology::fromSysfs(dir);
+  EXPECT_EQ(topology.numNodes(), 2);
+  EXPECT_EQ(topology.cpusOfNode(0), (std::vector<int>{0, 1, 2, 3}));
+  EXPECT_EQ(topology.nodeOfCpu(5), 1);
+
+  system((std::string("rm -rf ") + dir).c_str());
+}
+
+TEST(NumaTopologyTest, noTopology) {
+  auto topology = NumaTopology::fromSysfs("/nonexistent");
+  EXPECT_EQ(topology.numNodes(), 1);
+  EXPECT_EQ(topology.nodeOfCpu(0), 0);
+  EXPECT_EQ(topology.currentNode(), 0);
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
@@ -22,6 +23,7 @@
 #include <mutex>
 #include <random>
 #include <thread>
+#include <vector>
 
 #include <folly/Synchronized.h>
 #include <folly/executors/Codel.h>
@@ -29,6 +31,8 @@
 #include <folly/portability/SysResource.h>
 #include <folly/portability/SysTime.h>
 #include <folly/synchronization/Baton.h>
+#include <thrift/lib/cpp/concurrency/AdaptiveLifoQueue.h>
+#include <thrift/lib/cpp/concurrency/FairQueue.h>
 #include <thrift/lib/cpp/concurrency/FunctionRunner.h>
 #include <thrift/lib/cpp/concurrency/PosixThreadFactory.h>
 #include <thrift/lib/cpp/concurrency/ThreadManager.h>
@@ -795,3 +799,146 @@ TEST_F(ThreadManagerTest, PriorityQueueThreadManagerExecutor) {
 
   EXPECT_EQ("bca", foo);
 }
+
+TEST_F(ThreadManagerTest, FairQueueOrder) {
+  FairQueue<std::string> queue({{"B", 2}});
+  for (auto item : {"A1", "A2", "A3", "B1", "B2", "B3", "B4", "C1"}) {
+    queue.enqueue(fairQueueKey(std::string(item, 1)), item);
+  }
+  EXPECT_EQ(8, queue.size());
+
+  std::string order;
+  std::string item;
+  while (queue.try_dequeue(item)) {
+    order += item + " ";
+  }
+  // A once, B twice, C once per round, in the order they were first seen
+  EXPECT_EQ("A1 B1 B2 C1 A2 B3 B4 A3 ", order);
+  EXPECT_TRUE(queue.empty());
+
+  // an idle key starts over at the back of the round
+  queue.enqueue(fairQueueKey("A"), "A4");
+  queue.enqueue(fairQueueKey("B"), "B5");
+  queue.enqueue(fairQueueKey("A"), "A5");
+  order.clear();
+  while (queue.try_dequeue(item)) {
+    order += item + " ";
+  }
+  EXPECT_EQ("A4 B5 A5 ", order);
+}
+
+class KeyedRunnable : public Runnable {
+ public:
+  KeyedRunnable(const std::string& key, std::function<void()> f)
+      : key_(fairQueueKey(key)), f_(std::move(f)) {}
+
+  void run() override {
+    f_();
+  }
+
+  uint64_t getFairQueueKey() const override {
+    return key_;
+  }
+
+ private:
+  const uint64_t key_;
+  std::function<void()> f_;
+};
+
+TEST_F(ThreadManagerTest, FairQueueThreadManager) {
+  auto threadManager =
+      ThreadManager::newFairQueueThreadManager(1, "client", {{"A", 2}});
+  EXPECT_EQ("client", threadManager->getFairQueueHeader());
+  threadManager->start();
+  folly::Baton<> reqStartedBaton;
+  folly::Baton<> reqSyncBaton;
+  // block the TM
+  threadManager->add([&] {
+    reqStartedBaton.post();
+    reqSyncBaton.wait();
+  });
+  reqStartedBaton.wait();
+
+  // A floods the queue before B gets a chance
+  std::string order;
+  for (int i = 0; i < 6; i++) {
+    threadManager->add(
+        std::make_shared<KeyedRunnable>("A", [&] { order += "A"; }));
+  }
+  for (int i = 0; i < 2; i++) {
+    threadManager->add(
+        std::make_shared<KeyedRunnable>("B", [&] { order += "B"; }));
+  }
+  EXPECT_EQ(8, threadManager->pendingTaskCount());
+
+  // unblock the TM, and wait for all the tasks to run
+  reqSyncBaton.post();
+  threadManager->join();
+
+  // A twice, then B once per round
+  EXPECT_EQ("AABAABAA", order);
+}
+
+TEST_F(ThreadManagerTest, AdaptiveLifoQueueOrder) {
+  AdaptiveLifoQueue<int> queue(2);
+  for (int i = 1; i <= 4; i++) {
+    queue.enqueue(1, i);
+  }
+  queue.enqueue(0, 10);
+  queue.enqueue(0, 20);
+  EXPECT_EQ(6, queue.size());
+
+  // oldest first, highest priority first
+  int item;
+  ASSERT_TRUE(queue.try_dequeue(item));
+  EXPECT_EQ(10, item);
+  ASSERT_TRUE(queue.try_dequeue(item));
+  EXPECT_EQ(20, item);
+  ASSERT_TRUE(queue.try_dequeue(item));
+  EXPECT_EQ(1, item);
+
+  // newest first once in LIFO mode
+  queue.setLifo(true);
+  queue.enqueue(1, 5);
+  ASSERT_TRUE(queue.try_dequeue(item));
+  EXPECT_EQ(5, item);
+
+  // the oldest items are only dequeued if they match
+  EXPECT_FALSE(queue.try_dequeue_oldest_if(item, [](int i) { return i > 2; }));
+  ASSERT_TRUE(queue.try_dequeue_oldest_if(item, [](int i) { return i < 3; }));
+  EXPECT_EQ(2, item);
+  ASSERT_TRUE(queue.try_dequeue(item));
+  EXPECT_EQ(4, item);
+  ASSERT_TRUE(queue.try_dequeue(item));
+  EXPECT_EQ(3, item);
+  EXPECT_FALSE(queue.try_dequeue(item));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(ThreadManagerTest, AdaptiveLifo) {
+  auto threadManager = ThreadManager::newSimpleThreadManager(1);
+  threadManager->threadFactory(std::make_shared<PosixThreadFactory>());
+  threadManager->enableAdaptiveLifo(true);
+  threadManager->start();
+  EXPECT_THROW(
+      threadManager->enableAdaptiveLifo(false), IllegalStateException);
+
+  // Each task makes the next ones wait longer than the CoDel target for
+  // several intervals, until the thread manager switches to LIFO
+  constexpr int kTasks = 25;
+  std::vector<int> order;
+  for (int i = 0; i < kTasks; i++) {
+    threadManager->add(FunctionRunner::create([&order, i] {
+      order.push_back(i);
+      /* sleep override */
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }));
+  }
+  threadManager->join();
+
+  ASSERT_EQ(kTasks, order.size());
+  EXPECT_EQ(0, order.front());
+  EXPECT_FALSE(std::is_sorted(order.begin(), order.end()));
+  // the newest task didn't wait for the older ones
+  EXPECT_NE(kTasks - 1, order.back());
+}
@@ -26,8 +26,10 @@
 #include <folly/io/async/EventBase.h>
 #include <thrift/lib/cpp/TApplicationException.h>
 #include <thrift/lib/cpp/TProcessor.h>
+#include <thrift/lib/cpp/concurrency/FairQueue.h>
 #include <thrift/lib/cpp/concurrency/Thread.h>
 #include <thrift/lib/cpp/concurrency/ThreadManager.h>
+#include <thrift/lib/cpp/concurrency/Util.h>
 #include <thrift/lib/cpp/protocol/TProtocolTypes.h>
 #include <thrift/lib/cpp/transport/THeader.h>
 #include <thrift/lib/cpp2/SerializationSwitch.h>
@@ -53,11 +55,13 @@ class EventTask : public virtual apache::thrift::concurrency::Runnable {
           taskFunc,
       apache::thrift::ResponseChannelRequest::UniquePtr req,
       folly::EventBase* base,
-      bool oneway)
+      bool oneway,
+      uint64_t fairQueueKey = 0)
       : taskFunc_(std::move(taskFunc)),
         req_(std::move(req)),
         base_(base),
-        oneway_(oneway) {}
+        oneway_(oneway),
+        fairQueueKey_(fairQueueKey) {}
 
   virtual ~EventTask() {
     // req_ needs to be destructed on base_ eventBase thread
@@ -81,7 +85,39 @@ class EventTask : public virtual apache::thrift::concurrency::Runnable {
         return;
       }
     }
+    auto admissionController = req_ ? req_->getAdmissionController() : nullptr;
+    if (!admissionController || !admissionController->needsCpuTime()) {
+      taskFunc_(std::move(req_));
+      return;
+    }
+    // Charge the request the CPU time of its handler, not the time it
+    // spent waiting, see AdmissionController::consumedCpuTime()
+    using apache::thrift::concurrency::Util;
+    const auto cpuStart = Util::threadCpuTimeNsec();
     taskFunc_(std::move(req_));
+    if (cpuStart >= 0) {
+      admissionController->consumedCpuTime(
+          std::chrono::nanoseconds(Util::threadCpuTimeNsec() - cpuStart));
+    }
+  }
+
+  uint64_t getFairQueueKey() const override {
+    return fairQueueKey_;
+  }
+
+  // Key of the request in the fair queue of tm, if it has one
+  static uint64_t computeFairQueueKey(
+      const apache::thrift::concurrency::ThreadManager& tm,
+      const apache::thrift::Cpp2RequestContext* ctx) {
+    const auto& headerName = tm.getFairQueueHeader();
+    auto headers = ctx && !headerName.empty() ? ctx->getHeadersPtr() : nullptr;
+    if (headers) {
+      auto it = headers->find(headerName);
+      if (it != headers->end()) {
+        return apache::thrift::concurrency::fairQueueKey(it->second);
+      }
+    }
+    return 0;
   }
 
   void expired() {
@@ -108,6 +144,7 @@ class EventTask : public virtual apache::thrift::concurrency::Runnable {
   apache::thrift::ResponseChannelRequest::UniquePtr req_;
   folly::EventBase* base_;
   bool oneway_;
+  const uint64_t fairQueueKey_;
 };
 
 class PriorityEventTask : public apache::thrift::concurrency::PriorityRunnable,
@@ -119,8 +156,14 @@ class PriorityEventTask : public apache::thrift::concurrency::PriorityRunnable,
           taskFunc,
       apache::thrift::ResponseChannelRequest::UniquePtr req,
       folly::EventBase* base,
-      bool oneway)
-      : EventTask(std::move(taskFunc), std::move(req), base, oneway),
+      bool oneway,
+      uint64_t fairQueueKey = 0)
+      : EventTask(
+            std::move(taskFunc),
+            std::move(req),
+            base,
+            oneway,
+            fairQueueKey),
         priority_(priority) {}
 
   apache::thrift::concurrency::PriorityThreadManager::PRIORITY getPriority()
@@ -280,9 +323,14 @@ class GeneratedAsyncProcessor : public AsyncProcessor {
             },
             std::move(req),
             eb,
-            kind == apache::thrift::RpcKind::SINGLE_REQUEST_NO_RESPONSE),
+            kind == apache::thrift::RpcKind::SINGLE_REQUEST_NO_RESPONSE,
+            apache::thrift::EventTask::computeFairQueueKey(*tm, ctx)),
         0, // timeout
-        0, // expiration
+        // With adaptive LIFO, lets the thread manager drop the request once
+        // the client gave up. Otherwise the request never expires: CoDel
+        // would shed every expirable request while the queue is standing.
+        ctx && tm->isAdaptiveLifoEnabled() ? ctx->getRequestTimeout().count()
+                                           : 0, // expiration
         true); // cancellable
   }
 };
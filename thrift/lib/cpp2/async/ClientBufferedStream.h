@@ -19,6 +19,7 @@
 #include <folly/Portability.h>
 #include <folly/futures/Future.h>
 #include <thrift/lib/cpp2/async/ClientStreamBridge.h>
+#include <thrift/lib/cpp2/async/StreamFlowControl.h>
 #if FOLLY_HAS_COROUTINES
 #include <folly/experimental/coro/AsyncGenerator.h>
 #include <folly/experimental/coro/Baton.h>
@@ -44,13 +45,33 @@ class ClientBufferedStream {
         decode_(decode),
         bufferSize_(bufferSize) {}
 
+  /**
+   * Sizes the credits granted to the server in bytes rather than messages, see
+   * StreamFlowControlOptions. The credits granted with the request still count
+   * messages. Must be called before subscribing.
+   */
+  void setFlowControl(const StreamFlowControlOptions& options) {
+    flowControl_ = options;
+  }
+
+  /**
+   * Returns the buffer memory counters of this stream, which are only
+   * maintained if requested before subscribing.
+   */
+  std::shared_ptr<const StreamBufferStats> getBufferStats() {
+    if (!bufferStats_) {
+      bufferStats_ = std::make_shared<StreamBufferStats>();
+    }
+    return bufferStats_;
+  }
+
   template <typename OnNextTry>
   void subscribeInline(OnNextTry&& onNextTry) && {
     auto streamBridge = std::move(streamBridge_);
 
-    int32_t outstanding = bufferSize_;
+    auto credits = makeCreditController();
 
-    apache::thrift::detail::ClientStreamBridge::ClientQueue queue;
+    apache::thrift::detail::ClientStreamQueue queue;
     class ReadyCallback : public apache::thrift::detail::ClientStreamConsumer {
      public:
       void consume() override {
@@ -71,9 +92,8 @@ class ClientBufferedStream {
 
     while (true) {
       if (queue.empty()) {
-        if (outstanding == 0) {
-          streamBridge->requestN(1);
-          ++outstanding;
+        if (auto n = credits.onEmpty()) {
+          streamBridge->requestN(n);
         }
 
         ReadyCallback callback;
@@ -81,14 +101,17 @@ class ClientBufferedStream {
           callback.wait();
         }
         queue = streamBridge->getMessages();
+        credits.onReceived(queue.messages());
       }
 
+      size_t bytes;
       {
         auto& payload = queue.front();
         if (!payload.hasValue() && !payload.hasException()) {
           onNextTry(folly::Try<T>());
           break;
         }
+        bytes = credits.payloadBytes(payload);
         auto value = decode_(std::move(payload));
         queue.pop();
         const auto hasException = value.hasException();
@@ -98,17 +121,16 @@ class ClientBufferedStream {
         }
       }
 
-      outstanding--;
-      if (outstanding <= bufferSize_ / 2) {
-        streamBridge->requestN(bufferSize_ - outstanding);
-        outstanding = bufferSize_;
+      if (auto n = credits.onConsumed(bytes)) {
+        streamBridge->requestN(n);
       }
     }
   }
 
 #if FOLLY_HAS_COROUTINES
   folly::coro::AsyncGenerator<T&&> toAsyncGenerator() && {
-    return toAsyncGeneratorImpl(std::move(streamBridge_), bufferSize_, decode_);
+    return toAsyncGeneratorImpl(
+        std::move(streamBridge_), makeCreditController(), decode_);
   }
 #endif // FOLLY_HAS_COROUTINES
 
@@ -119,21 +141,24 @@ class ClientBufferedStream {
         std::forward<Callback>(onNextTry),
         std::move(streamBridge_),
         decode_,
-        bufferSize_);
+        makeCreditController());
     Subscription sub(c->state_);
     e->add([c]() { (*c)(); });
     return sub;
   }
 
  private:
+  detail::StreamCreditController<> makeCreditController() const {
+    return detail::StreamCreditController<>(
+        bufferSize_, flowControl_, bufferStats_);
+  }
+
 #if FOLLY_HAS_COROUTINES
   static folly::coro::AsyncGenerator<T&&> toAsyncGeneratorImpl(
       detail::ClientStreamBridge::ClientPtr streamBridge,
-      int32_t bufferSize,
+      detail::StreamCreditController<> credits,
       folly::Try<T> (*decode)(folly::Try<StreamPayload>&&)) {
-    int32_t outstanding = bufferSize;
-
-    apache::thrift::detail::ClientStreamBridge::ClientQueue queue;
+    apache::thrift::detail::ClientStreamQueue queue;
     class ReadyCallback : public apache::thrift::detail::ClientStreamConsumer {
      public:
       void consume() override {
@@ -153,9 +178,8 @@ class ClientBufferedStream {
         throw folly::OperationCancelled();
       }
       if (queue.empty()) {
-        if (outstanding == 0) {
-          streamBridge->requestN(1);
-          ++outstanding;
+        if (auto n = credits.onEmpty()) {
+          streamBridge->requestN(n);
         }
 
         ReadyCallback callback;
@@ -171,23 +195,24 @@ class ClientBufferedStream {
           detail::ClientStreamBridge::Ptr(streamBridge.release());
           throw folly::OperationCancelled();
         }
+        credits.onReceived(queue.messages());
       }
 
+      size_t bytes;
       {
         auto& payload = queue.front();
         if (!payload.hasValue() && !payload.hasException()) {
           break;
         }
+        bytes = credits.payloadBytes(payload);
         auto value = decode(std::move(payload));
         queue.pop();
         // yield value or rethrow exception
         co_yield std::move(value).value();
       }
 
-      outstanding--;
-      if (outstanding <= bufferSize / 2) {
-        streamBridge->requestN(bufferSize - outstanding);
-        outstanding = bufferSize;
+      if (auto n = credits.onConsumed(bytes)) {
+        streamBridge->requestN(n);
       }
     }
   }
@@ -254,14 +279,12 @@ class ClientBufferedStream {
         OnNextTry onNextTry,
         detail::ClientStreamBridge::ClientPtr streamBridge,
         folly::Try<T> (*decode)(folly::Try<StreamPayload>&&),
-        int32_t bufferSize)
+        detail::StreamCreditController<> credits)
         : e_(e),
           onNextTry_(std::move(onNextTry)),
           decode_(decode),
-          bufferSize_(bufferSize),
-          state_(std::make_shared<SharedState>(std::move(streamBridge))) {
-      outstanding_ = bufferSize_;
-    }
+          credits_(std::move(credits)),
+          state_(std::make_shared<SharedState>(std::move(streamBridge))) {}
 
     ~Continuation() {
       state_->promise.setValue();
@@ -286,13 +309,12 @@ class ClientBufferedStream {
 
     void operator()() noexcept {
       std::unique_ptr<Continuation> cb(this);
-      apache::thrift::detail::ClientStreamBridge::ClientQueue queue;
+      apache::thrift::detail::ClientStreamQueue queue;
 
       while (!state_->streamBridge->isCanceled()) {
         if (queue.empty()) {
-          if (outstanding_ == 0) {
-            state_->streamBridge->requestN(1);
-            ++outstanding_;
+          if (auto n = credits_.onEmpty()) {
+            state_->streamBridge->requestN(n);
           }
 
           if (Continuation::wait(cb)) {
@@ -306,14 +328,17 @@ class ClientBufferedStream {
             // we've been cancelled
             return;
           }
+          credits_.onReceived(queue.messages());
         }
 
+        size_t bytes;
         {
           auto& payload = queue.front();
           if (!payload.hasValue() && !payload.hasException()) {
             onNextTry_(folly::Try<T>());
             return;
           }
+          bytes = credits_.payloadBytes(payload);
           auto value = decode_(std::move(payload));
           queue.pop();
           const auto hasException = value.hasException();
@@ -323,10 +348,8 @@ class ClientBufferedStream {
           }
         }
 
-        outstanding_--;
-        if (outstanding_ <= bufferSize_ / 2) {
-          state_->streamBridge->requestN(bufferSize_ - outstanding_);
-          outstanding_ = bufferSize_;
+        if (auto n = credits_.onConsumed(bytes)) {
+          state_->streamBridge->requestN(n);
         }
       }
     }
@@ -335,8 +358,7 @@ class ClientBufferedStream {
     folly::Executor::KeepAlive<> e_;
     OnNextTry onNextTry_;
     folly::Try<T> (*decode_)(folly::Try<StreamPayload>&&);
-    int32_t bufferSize_;
-    int32_t outstanding_;
+    detail::StreamCreditController<> credits_;
     std::shared_ptr<SharedState> state_;
     friend class ClientBufferedStream;
   };
@@ -344,6 +366,8 @@ class ClientBufferedStream {
   detail::ClientStreamBridge::ClientPtr streamBridge_;
   folly::Try<T> (*decode_)(folly::Try<StreamPayload>&&) = nullptr;
   int32_t bufferSize_{0};
+  folly::Optional<StreamFlowControlOptions> flowControl_;
+  std::shared_ptr<StreamBufferStats> bufferStats_;
 
   friend class yarpl::flowable::ThriftStreamShim;
 }; // namespace thrift
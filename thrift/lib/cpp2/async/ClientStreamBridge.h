@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <vector>
+
 #include <folly/Try.h>
 
 #include <thrift/lib/cpp2/async/StreamCallbacks.h>
+#include <thrift/lib/cpp2/async/StreamPayloadBatch.h>
 #include <thrift/lib/cpp2/async/TwoWayBridge.h>
 
 namespace apache {
@@ -167,6 +170,65 @@ class ClientStreamBridge : public TwoWayBridge<
   };
   folly::Executor::KeepAlive<> serverExecutor_;
 };
+
+/**
+ * Messages taken from a ClientStreamBridge, with batched payloads split into
+ * the stream elements they carry.
+ */
+class ClientStreamQueue {
+ public:
+  ClientStreamQueue& operator=(ClientStreamBridge::ClientQueue&& messages) {
+    messages_ = std::move(messages);
+    elements_.clear();
+    next_ = 0;
+    return *this;
+  }
+
+  bool empty() const {
+    return messages_.empty();
+  }
+
+  folly::Try<StreamPayload>& front() {
+    if (next_ < elements_.size()) {
+      return elements_[next_];
+    }
+    auto& message = messages_.front();
+    if (!message.hasValue() || !message->metadata.elementCount_ref()) {
+      return message;
+    }
+    try {
+      for (auto& element : splitStreamPayloadBatch(*message)) {
+        elements_.emplace_back(std::move(element));
+      }
+    } catch (const std::exception& ex) {
+      elements_.clear();
+      elements_.emplace_back(
+          folly::exception_wrapper(std::current_exception(), ex));
+    }
+    next_ = 0;
+    return elements_[next_];
+  }
+
+  void pop() {
+    if (next_ < elements_.size() && ++next_ < elements_.size()) {
+      return;
+    }
+    elements_.clear();
+    next_ = 0;
+    messages_.pop();
+  }
+
+  // The messages front() is taken from, its own first.
+  const ClientStreamBridge::ClientQueue& messages() const {
+    return messages_;
+  }
+
+ private:
+  ClientStreamBridge::ClientQueue messages_;
+  // elements of the batch at the front of messages_
+  std::vector<folly::Try<StreamPayload>> elements_;
+  size_t next_{0};
+};
 } // namespace detail
 } // namespace thrift
 } // namespace apache
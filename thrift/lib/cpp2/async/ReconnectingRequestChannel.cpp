@@ -20,6 +20,9 @@
 #include <utility>
 
 #include <folly/ExceptionWrapper.h>
+#include <folly/io/async/EventBase.h>
+
+#include <thrift/lib/cpp2/async/RocketClientChannel.h>
 
 namespace apache {
 namespace thrift {
@@ -64,10 +67,11 @@ void ReconnectingRequestChannel::sendRequestResponse(
     std::unique_ptr<folly::IOBuf> buf,
     std::shared_ptr<transport::THeader> header,
     RequestClientCallback::Ptr cob) {
+  auto& channel = impl();
   cob = RequestClientCallback::Ptr(
       new ChannelKeepAlive(impl_, std::move(cob), false));
 
-  return impl().sendRequestResponse(
+  return channel.sendRequestResponse(
       options, std::move(buf), std::move(header), std::move(cob));
 }
 
@@ -76,19 +80,41 @@ void ReconnectingRequestChannel::sendRequestNoResponse(
     std::unique_ptr<folly::IOBuf> buf,
     std::shared_ptr<transport::THeader> header,
     RequestClientCallback::Ptr cob) {
+  auto& channel = impl();
   cob = RequestClientCallback::Ptr(
       new ChannelKeepAlive(impl_, std::move(cob), true));
 
-  return impl().sendRequestNoResponse(
+  return channel.sendRequestNoResponse(
       options, std::move(buf), std::move(header), std::move(cob));
 }
 
+ReconnectingRequestChannel::~ReconnectingRequestChannel() {
+  if (auto* rocket = dynamic_cast<RocketClientChannel*>(impl_.get())) {
+    rocket->setOnServerDrain(nullptr);
+  }
+}
+
 ReconnectingRequestChannel::Impl& ReconnectingRequestChannel::impl() {
   if (!impl_ || !impl_->good()) {
-    impl_ = implCreator_(evb_);
+    reconnect();
   }
   return *impl_;
 }
 
+void ReconnectingRequestChannel::reconnect() {
+  impl_ = implCreator_(evb_);
+  if (auto* rocket = dynamic_cast<RocketClientChannel*>(impl_.get())) {
+    rocket->setOnServerDrain([this] {
+      // Connect ahead of the next request. Not inline, replacing impl_ may
+      // destroy the draining channel.
+      evb_.runInLoop([this, dg = DestructorGuard(this)] {
+        if (impl_ && !impl_->good()) {
+          reconnect();
+        }
+      });
+    });
+  }
+}
+
 } // namespace thrift
 } // namespace apache
@@ -41,6 +41,9 @@ class THeader;
 
 // Simple RequestChannel wrapper that automatically re-creates underlying
 // RequestChannel in case request is about to be sent over a bad channel.
+// A rocket channel whose server sent a drain notice is re-created as soon as
+// the notice arrives; the requests in flight over it complete normally and
+// it is closed once they did.
 class ReconnectingRequestChannel : public RequestChannel {
  public:
   using Impl = ClientChannel;
@@ -79,13 +82,14 @@ class ReconnectingRequestChannel : public RequestChannel {
   }
 
  protected:
-  ~ReconnectingRequestChannel() override = default;
+  ~ReconnectingRequestChannel() override;
 
  private:
   ReconnectingRequestChannel(folly::EventBase& evb, ImplCreator implCreator)
       : implCreator_(std::move(implCreator)), evb_(evb) {}
 
   Impl& impl();
+  void reconnect();
 
   ImplPtr impl_;
   ImplCreator implCreator_;
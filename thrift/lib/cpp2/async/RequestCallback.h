@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 
+#include <folly/Optional.h>
 #include <folly/Try.h>
 #include <folly/io/IOBuf.h>
 
@@ -461,6 +462,19 @@ class RpcOptions {
     return chunkBufferSize_;
   }
 
+  /**
+   * Lets the server pack several stream elements into each payload it sends,
+   * within the limits of 'config'. Credits are still granted per element.
+   */
+  RpcOptions& setStreamBatching(const StreamBatchingConfig& config) {
+    streamBatching_ = config;
+    return *this;
+  }
+
+  const folly::Optional<StreamBatchingConfig>& getStreamBatching() const {
+    return streamBatching_;
+  }
+
   RpcOptions& setQueueTimeout(std::chrono::milliseconds queueTimeout) {
     queueTimeout_ = queueTimeout;
     return *this;
@@ -530,6 +544,7 @@ class RpcOptions {
   bool clientOnlyTimeouts_{false};
   bool enableChecksum_{false};
   int32_t chunkBufferSize_{100};
+  folly::Optional<StreamBatchingConfig> streamBatching_;
 
   std::string routingKey_;
   std::string shardId_;
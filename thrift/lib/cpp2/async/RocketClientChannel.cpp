@@ -508,7 +508,14 @@ RocketClientChannel::getTransport() {
 
 bool RocketClientChannel::good() {
   DCHECK(!evb_ || evb_->isInEventBaseThread());
-  return rclient_ && rclient_->isAlive();
+  return rclient_ && rclient_->isAlive() && !rclient_->isServerDraining();
+}
+
+void RocketClientChannel::setOnServerDrain(
+    folly::Function<void()> onServerDrain) {
+  if (rclient_) {
+    rclient_->setOnServerDrain(std::move(onServerDrain));
+  }
 }
 
 size_t RocketClientChannel::inflightRequestsAndStreams() const {
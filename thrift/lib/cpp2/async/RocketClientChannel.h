@@ -100,8 +100,16 @@ class RocketClientChannel final : public ClientChannel {
   }
 
   folly::AsyncTransportWrapper* FOLLY_NULLABLE getTransport() override;
+  // False once the server sent a drain notice, even though requests can
+  // still be sent until the connection closes
   bool good() override;
 
+  /**
+   * Called once, from the EventBase thread, when the server sends a drain
+   * notice ahead of shutting down. The channel must not be destroyed inline.
+   */
+  void setOnServerDrain(folly::Function<void()> onServerDrain);
+
   size_t inflightRequestsAndStreams() const;
 
   void attachEventBase(folly::EventBase*) override;
@@ -36,6 +36,9 @@ class ThriftStreamShim;
 namespace apache {
 namespace thrift {
 
+template <typename T>
+class ServerStreamMulticastPublisher;
+
 template <typename T>
 class ServerStream {
  public:
@@ -83,6 +86,7 @@ class ServerStream {
   detail::ServerStreamFn<T> fn_;
 
   friend class yarpl::flowable::ThriftStreamShim;
+  friend class ServerStreamMulticastPublisher<T>;
 };
 
 template <typename Response, typename StreamElement>
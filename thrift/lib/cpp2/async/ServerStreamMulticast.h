@@ -0,0 +1,576 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <folly/AtomicLinkedList.h>
+#include <folly/Function.h>
+#include <folly/Optional.h>
+#include <folly/Synchronized.h>
+#include <folly/Try.h>
+#include <folly/container/F14Map.h>
+#include <folly/io/async/EventBase.h>
+
+#include <thrift/lib/cpp/TApplicationException.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
+
+namespace apache {
+namespace thrift {
+
+struct ServerStreamMulticastOptions {
+  // What happens to a subscriber which has maxBuffered events pending, for
+  // lack of credits, when another one is published.
+  enum class SlowSubscriberPolicy {
+    // The new event is dropped for it.
+    DROP,
+    // Its oldest pending event is dropped, so it catches up with the latest.
+    COALESCE,
+    // Its stream fails with a TApplicationException.
+    DISCONNECT,
+  };
+
+  SlowSubscriberPolicy slowSubscriberPolicy{SlowSubscriberPolicy::DROP};
+  size_t maxBuffered{100};
+};
+
+struct ServerStreamMulticastStats {
+  std::atomic<uint64_t> subscribers{0};
+  // Events sent to, dropped for and subscribers disconnected by the policy.
+  std::atomic<uint64_t> delivered{0};
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<uint64_t> disconnected{0};
+};
+
+template <typename T>
+class ServerStreamMulticastPublisher;
+
+namespace detail {
+
+/**
+ * State shared by a ServerStreamMulticastPublisher and the streams of its
+ * subscribers.
+ *
+ * Each event is encoded once per protocol the subscribers use, and the same
+ * buffers are sent to all of them. Subscribers are grouped by the EventBase
+ * their stream runs on: publishing hands an event to each group through a
+ * lock-free queue, and only the push which finds the queue empty schedules
+ * the group to deliver it, so the cost of crossing threads is paid once per
+ * EventBase and batch of events rather than per subscriber.
+ */
+template <typename T>
+class ServerMulticastStream
+    : public std::enable_shared_from_this<ServerMulticastStream<T>> {
+  using EncodeFn = folly::Try<StreamPayload> (*)(folly::Try<T>&&);
+
+  // A value encoded with each encoder, or the completion or error which ends
+  // the streams. Errors carry buffers which are consumed when sent, so those
+  // are encoded for each subscriber.
+  struct Event {
+    const folly::Try<StreamPayload>* find(EncodeFn encode) const {
+      for (auto& entry : encoded) {
+        if (entry.first == encode) {
+          return &entry.second;
+        }
+      }
+      // the subscriber arrived after the event was published
+      return nullptr;
+    }
+
+    std::vector<std::pair<EncodeFn, folly::Try<StreamPayload>>> encoded;
+    folly::Optional<folly::Try<T>> terminal;
+  };
+  using EventPtr = std::shared_ptr<const Event>;
+
+  class Subscriber;
+
+  // Subscribers whose streams run on one EventBase. Only the queue is
+  // accessed off that EventBase.
+  struct EventBaseGroup {
+    EventBaseGroup(
+        folly::EventBase* evb,
+        std::weak_ptr<ServerMulticastStream> stream,
+        std::shared_ptr<ServerStreamMulticastStats> stats)
+        : evb(folly::getKeepAliveToken(evb)),
+          stream(std::move(stream)),
+          stats(std::move(stats)) {}
+
+    static void enqueue(std::shared_ptr<EventBaseGroup> self, EventPtr event) {
+      if (self->queue.insertHead(std::move(event))) {
+        auto* evb = self->evb.get();
+        evb->add([self = std::move(self)] { self->drain(); });
+      }
+    }
+
+    void drain() {
+      draining = true;
+      queue.sweep([&](EventPtr&& event) {
+        // subscribers may join while events are delivered
+        for (size_t i = 0, n = subscribers.size(); i < n; ++i) {
+          subscribers[i]->push(event);
+        }
+      });
+      draining = false;
+      if (finished) {
+        removeFinished();
+      }
+      flushStats();
+    }
+
+    void add(Subscriber* subscriber) {
+      subscriber->index_ = subscribers.size();
+      subscribers.push_back(subscriber);
+    }
+
+    // Subscribers which finish while events are delivered are removed after.
+    void remove(Subscriber* subscriber) {
+      if (draining) {
+        ++finished;
+        return;
+      }
+      auto* last = subscribers.back();
+      last->index_ = subscriber->index_;
+      subscribers[subscriber->index_] = last;
+      subscribers.pop_back();
+      delete subscriber;
+      leaveIfEmpty();
+    }
+
+    void removeFinished() {
+      auto it = std::partition(
+          subscribers.begin(), subscribers.end(), [](Subscriber* subscriber) {
+            return !subscriber->done_;
+          });
+      std::vector<Subscriber*> done(it, subscribers.end());
+      subscribers.erase(it, subscribers.end());
+      for (size_t i = 0; i < subscribers.size(); ++i) {
+        subscribers[i]->index_ = i;
+      }
+      finished = 0;
+      for (auto* subscriber : done) {
+        delete subscriber;
+      }
+      leaveIfEmpty();
+    }
+
+    void leaveIfEmpty() {
+      if (subscribers.empty()) {
+        if (auto self = stream.lock()) {
+          self->leave(*this);
+        }
+      }
+    }
+
+    void flushStats() {
+      if (delivered) {
+        stats->delivered.fetch_add(
+            std::exchange(delivered, 0), std::memory_order_relaxed);
+      }
+      if (dropped) {
+        stats->dropped.fetch_add(
+            std::exchange(dropped, 0), std::memory_order_relaxed);
+      }
+    }
+
+    const folly::Executor::KeepAlive<folly::EventBase> evb;
+    const std::weak_ptr<ServerMulticastStream> stream;
+    const std::shared_ptr<ServerStreamMulticastStats> stats;
+    folly::AtomicLinkedList<EventPtr> queue;
+    std::vector<Subscriber*> subscribers;
+    bool draining{false};
+    size_t finished{0};
+    // counted here so subscribers don't contend on the shared counters
+    uint64_t delivered{0};
+    uint64_t dropped{0};
+  };
+
+  // The stream of one subscriber, deleted by its group or, if it finishes
+  // before joining one, by itself.
+  class Subscriber : private StreamServerCallback {
+   public:
+    Subscriber(
+        std::shared_ptr<ServerMulticastStream> stream,
+        EncodeFn encode,
+        folly::Executor::KeepAlive<> serverExecutor,
+        folly::Function<void()> onStreamCompleteOrCancel)
+        : stream_(std::move(stream)),
+          encode_(encode),
+          serverExecutor_(std::move(serverExecutor)),
+          onStreamCompleteOrCancel_(std::move(onStreamCompleteOrCancel)) {
+      stream_->stats_->subscribers.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void start(
+        FirstResponsePayload&& payload,
+        StreamClientCallback* callback,
+        folly::EventBase* evb) {
+      clientCallback_ = callback;
+      if (!callback->onFirstResponse(std::move(payload), evb, this)) {
+        finish();
+        return;
+      }
+      // the publisher may have completed before the subscriber joined
+      if (auto terminal = stream_->join(this, evb)) {
+        close(std::move(*terminal));
+      }
+    }
+
+    void push(const EventPtr& event) {
+      if (done_) {
+        return;
+      }
+      if (pending_.empty() && (credits_ || event->terminal)) {
+        send(*event);
+        return;
+      }
+      pending_.push_back(event);
+      auto& options = stream_->options_;
+      if (event->terminal || pending_.size() <= options.maxBuffered) {
+        return;
+      }
+      using Policy = ServerStreamMulticastOptions::SlowSubscriberPolicy;
+      switch (options.slowSubscriberPolicy) {
+        case Policy::DROP:
+          pending_.pop_back();
+          ++group_->dropped;
+          break;
+        case Policy::COALESCE:
+          pending_.pop_front();
+          ++group_->dropped;
+          break;
+        case Policy::DISCONNECT:
+          pending_.clear();
+          stream_->stats_->disconnected.fetch_add(
+              1, std::memory_order_relaxed);
+          close(folly::Try<T>(
+              folly::make_exception_wrapper<TApplicationException>(
+                  "Stream subscriber fell behind the publisher")));
+          break;
+      }
+    }
+
+    void setGroup(std::shared_ptr<EventBaseGroup> group) {
+      group_ = std::move(group);
+    }
+
+   private:
+    friend struct EventBaseGroup;
+
+    bool onStreamRequestN(uint64_t credits) override {
+      credits_ += credits;
+      auto group = group_;
+      auto alive = flush();
+      if (group) {
+        group->flushStats();
+      }
+      return alive;
+    }
+
+    void onStreamCancel() override {
+      pending_.clear();
+      finish();
+    }
+
+    void resetClientCallback(StreamClientCallback& clientCallback) override {
+      clientCallback_ = &clientCallback;
+    }
+
+    // returns stream liveness
+    bool flush() {
+      while (!pending_.empty() && (credits_ || pending_.front()->terminal)) {
+        auto event = std::move(pending_.front());
+        pending_.pop_front();
+        if (!send(*event)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // returns stream liveness
+    bool send(const Event& event) {
+      if (event.terminal) {
+        close(folly::Try<T>(*event.terminal));
+        return false;
+      }
+      auto payload = event.find(encode_);
+      if (!payload) {
+        return true;
+      }
+      if (payload->hasException()) {
+        close(folly::Try<T>(
+            folly::make_exception_wrapper<TApplicationException>(
+                payload->exception().what().toStdString())));
+        return false;
+      }
+      --credits_;
+      ++group_->delivered;
+      auto& value = payload->value();
+      // shares the encoded buffer with the other subscribers
+      if (!clientCallback_->onStreamNext(StreamPayload(
+              value.payload ? value.payload->clone() : nullptr,
+              StreamPayloadMetadata(value.metadata)))) {
+        finish();
+        return false;
+      }
+      return true;
+    }
+
+    // Ends the stream with 'terminal', a completion or an error.
+    void close(folly::Try<T>&& terminal) {
+      auto result = encode_(std::move(terminal));
+      if (result.hasException()) {
+        clientCallback_->onStreamError(std::move(result.exception()));
+      } else {
+        clientCallback_->onStreamComplete();
+      }
+      finish();
+    }
+
+    // may delete this
+    void finish() {
+      done_ = true;
+      auto* executor = serverExecutor_.get();
+      executor->add([ex = std::move(serverExecutor_),
+                     f = std::move(onStreamCompleteOrCancel_)]() mutable {
+        if (f) {
+          f();
+        }
+      });
+      stream_->stats_->subscribers.fetch_sub(1, std::memory_order_relaxed);
+      if (auto group = std::move(group_)) {
+        group->remove(this);
+      } else {
+        delete this;
+      }
+    }
+
+    const std::shared_ptr<ServerMulticastStream> stream_;
+    const EncodeFn encode_;
+    folly::Executor::KeepAlive<> serverExecutor_;
+    folly::Function<void()> onStreamCompleteOrCancel_;
+    StreamClientCallback* clientCallback_{nullptr};
+    std::shared_ptr<EventBaseGroup> group_;
+    uint64_t credits_{0};
+    std::deque<EventPtr> pending_;
+    // position in the group, maintained by it
+    size_t index_{0};
+    bool done_{false};
+  };
+
+ public:
+  explicit ServerMulticastStream(const ServerStreamMulticastOptions& options)
+      : options_(options),
+        stats_(std::make_shared<ServerStreamMulticastStats>()) {}
+
+  ServerStreamFn<T> subscribe(
+      folly::Function<void()> onStreamCompleteOrCancel) {
+    return [stream = this->shared_from_this(),
+            onStreamCompleteOrCancel = std::move(onStreamCompleteOrCancel)](
+               folly::Executor::KeepAlive<> serverExecutor,
+               EncodeFn encode) mutable -> ServerStreamFactory {
+      stream->addEncoder(encode);
+      return [stream = std::move(stream),
+              encode,
+              serverExecutor = std::move(serverExecutor),
+              onStreamCompleteOrCancel = std::move(onStreamCompleteOrCancel)](
+                 FirstResponsePayload&& payload,
+                 StreamClientCallback* callback,
+                 folly::EventBase* clientEb) mutable {
+        auto subscriber = new Subscriber(
+            std::move(stream),
+            encode,
+            std::move(serverExecutor),
+            std::move(onStreamCompleteOrCancel));
+        if (clientEb->isInEventBaseThread()) {
+          subscriber->start(std::move(payload), callback, clientEb);
+        } else {
+          clientEb->runInEventBaseThread(
+              [subscriber, payload = std::move(payload), callback, clientEb](
+                  ) mutable {
+                subscriber->start(std::move(payload), callback, clientEb);
+              });
+        }
+      };
+    };
+  }
+
+  void publish(folly::Try<T>&& value) {
+    bool terminal = !value.hasValue();
+    std::vector<EncodeFn> encoders;
+    std::vector<std::shared_ptr<EventBaseGroup>> groups;
+    auto snapshot = [&](const State& state) {
+      encoders = state.encoders;
+      groups.reserve(state.groups.size());
+      for (auto& entry : state.groups) {
+        groups.push_back(entry.second);
+      }
+    };
+    if (terminal) {
+      auto state = state_.wlock();
+      state->terminal = value;
+      snapshot(*state);
+    } else {
+      snapshot(*state_.rlock());
+    }
+    if (groups.empty()) {
+      return;
+    }
+
+    auto event = std::make_shared<Event>();
+    if (terminal) {
+      event->terminal = std::move(value);
+    } else {
+      event->encoded.reserve(encoders.size());
+      for (size_t i = 0; i < encoders.size(); ++i) {
+        auto copy = i + 1 < encoders.size() ? folly::Try<T>(value)
+                                            : folly::Try<T>(std::move(value));
+        event->encoded.emplace_back(encoders[i], encoders[i](std::move(copy)));
+      }
+    }
+    EventPtr shared = std::move(event);
+    for (auto& group : groups) {
+      EventBaseGroup::enqueue(std::move(group), shared);
+    }
+  }
+
+  bool completed() const {
+    return state_.rlock()->terminal.hasValue();
+  }
+
+  std::shared_ptr<const ServerStreamMulticastStats> getStats() const {
+    return stats_;
+  }
+
+ private:
+  struct State {
+    std::vector<EncodeFn> encoders;
+    folly::F14FastMap<folly::EventBase*, std::shared_ptr<EventBaseGroup>>
+        groups;
+    folly::Optional<folly::Try<T>> terminal;
+  };
+
+  void addEncoder(EncodeFn encode) {
+    auto known = [&](const State& state) {
+      return std::find(state.encoders.begin(), state.encoders.end(), encode) !=
+          state.encoders.end();
+    };
+    if (known(*state_.rlock())) {
+      return;
+    }
+    auto state = state_.wlock();
+    if (!known(*state)) {
+      state->encoders.push_back(encode);
+    }
+  }
+
+  // Returns the terminal event if the publisher completed, otherwise adds
+  // 'subscriber' to the group of 'evb'.
+  folly::Optional<folly::Try<T>> join(
+      Subscriber* subscriber,
+      folly::EventBase* evb) {
+    auto state = state_.wlock();
+    if (state->terminal) {
+      return folly::Try<T>(*state->terminal);
+    }
+    auto& group = state->groups[evb];
+    if (!group) {
+      group = std::make_shared<EventBaseGroup>(
+          evb, this->weak_from_this(), stats_);
+    }
+    group->add(subscriber);
+    subscriber->setGroup(group);
+    return folly::none;
+  }
+
+  // Called on the group's EventBase once it has no subscribers left.
+  void leave(EventBaseGroup& group) {
+    auto state = state_.wlock();
+    auto it = state->groups.find(group.evb.get());
+    if (it != state->groups.end() && it->second.get() == &group &&
+        group.subscribers.empty()) {
+      state->groups.erase(it);
+    }
+  }
+
+  const ServerStreamMulticastOptions options_;
+  const std::shared_ptr<ServerStreamMulticastStats> stats_;
+  folly::Synchronized<State> state_;
+};
+
+} // namespace detail
+
+/**
+ * Publishes the same events to any number of streams.
+ *
+ * A handler returns subscribe() for each stream request, which then receives
+ * the events published after it was set up. Subscribers without credits
+ * buffer up to maxBuffered events, beyond which the SlowSubscriberPolicy
+ * applies. next() may be called from several threads at once, the events of
+ * each of them being received in the order they were published.
+ */
+template <typename T>
+class ServerStreamMulticastPublisher {
+ public:
+  explicit ServerStreamMulticastPublisher(
+      const ServerStreamMulticastOptions& options =
+          ServerStreamMulticastOptions())
+      : impl_(std::make_shared<detail::ServerMulticastStream<T>>(options)),
+        stats_(impl_->getStats()) {}
+  ServerStreamMulticastPublisher(ServerStreamMulticastPublisher&&) = default;
+  ServerStreamMulticastPublisher& operator=(ServerStreamMulticastPublisher&&) =
+      default;
+  ~ServerStreamMulticastPublisher() {
+    CHECK(!impl_ || impl_->completed())
+        << "StreamMulticastPublisher has to be completed.";
+  }
+
+  // Completion callback is optional, it runs on the server executor once this
+  // subscriber's stream completes or is cancelled.
+  ServerStream<T> subscribe(
+      folly::Function<void()> onStreamCompleteOrCancel = [] {}) const {
+    return ServerStream<T>(
+        impl_->subscribe(std::move(onStreamCompleteOrCancel)));
+  }
+
+  void next(T payload) const {
+    impl_->publish(folly::Try<T>(std::move(payload)));
+  }
+  void complete(folly::exception_wrapper ew) && {
+    std::exchange(impl_, nullptr)->publish(folly::Try<T>(std::move(ew)));
+  }
+  void complete() && {
+    std::exchange(impl_, nullptr)->publish(folly::Try<T>{});
+  }
+
+  // Remains valid after the publisher completes.
+  const ServerStreamMulticastStats& getStats() const {
+    return *stats_;
+  }
+
+ private:
+  std::shared_ptr<detail::ServerMulticastStream<T>> impl_;
+  std::shared_ptr<const ServerStreamMulticastStats> stats_;
+};
+
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/async/SinkFileWriter.h>
+
+#include <algorithm>
+
+#include <folly/Exception.h>
+#include <folly/FBVector.h>
+#include <folly/FileUtil.h>
+#include <folly/portability/SysUio.h>
+#include <folly/portability/Unistd.h>
+
+namespace apache {
+namespace thrift {
+
+size_t writeIOBufToFd(int fd, const folly::IOBuf& data) {
+  folly::fbvector<struct iovec> iov;
+  data.appendToIov(&iov);
+  size_t written = 0;
+  // writevFull resumes partial writes, but takes at most IOV_MAX buffers
+  for (size_t i = 0; i < iov.size(); i += IOV_MAX) {
+    size_t count = std::min<size_t>(iov.size() - i, IOV_MAX);
+    auto bytes = folly::writevFull(fd, iov.data() + i, count);
+    if (bytes < 0) {
+      folly::throwSystemError("writev failed");
+    }
+    written += bytes;
+  }
+  return written;
+}
+
+void syncFd(int fd) {
+  if (folly::fdatasyncNoInt(fd) != 0) {
+    folly::throwSystemError("fdatasync failed");
+  }
+}
+
+} // namespace thrift
+} // namespace apache
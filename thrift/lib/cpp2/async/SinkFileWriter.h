@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <folly/Executor.h>
+#include <folly/Portability.h>
+#include <folly/io/IOBuf.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/AsyncGenerator.h>
+#include <folly/experimental/coro/Task.h>
+#include <folly/futures/Future.h>
+#endif
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Writes all of 'data' to 'fd' with writev, straight from the buffers of the
+ * chain. Returns the number of bytes written, throws std::system_error.
+ */
+size_t writeIOBufToFd(int fd, const folly::IOBuf& data);
+
+/**
+ * Calls fdatasync on 'fd', throws std::system_error.
+ */
+void syncFd(int fd);
+
+#if FOLLY_HAS_COROUTINES
+struct SinkFileWriterOptions {
+  // Executor to block on writes in, the consumer's own if null.
+  folly::Executor::KeepAlive<> writeExecutor;
+  // Whether to fdatasync once all chunks are written.
+  bool sync{false};
+};
+
+namespace detail {
+
+inline const folly::IOBuf* sinkChunkData(const folly::IOBuf& chunk) {
+  return &chunk;
+}
+
+inline const folly::IOBuf* sinkChunkData(
+    const std::unique_ptr<folly::IOBuf>& chunk) {
+  return chunk.get();
+}
+
+} // namespace detail
+
+/**
+ * Consumes a sink of binary chunks by writing them to 'fd', for use as the
+ * consumer of a SinkConsumer. Declaring the sink's element as
+ *
+ *   typedef binary (cpp.type = "folly::IOBuf") IOBuf
+ *
+ * makes its chunks share the buffers they were received in, so that they are
+ * never copied before being written.
+ *
+ * The next chunk is only taken from the sink once the previous one was
+ * written, and the client is granted credits as chunks are taken, so the
+ * client can't get ahead of the disk by more than the sink's buffer size.
+ * Returns the number of bytes written.
+ */
+template <typename Chunk>
+folly::coro::Task<int64_t> writeSinkToFd(
+    folly::coro::AsyncGenerator<Chunk&&> chunks,
+    int fd,
+    SinkFileWriterOptions options = SinkFileWriterOptions()) {
+  int64_t written = 0;
+  while (auto item = co_await chunks.next()) {
+    Chunk chunk = std::move(*item);
+    auto data = detail::sinkChunkData(chunk);
+    if (!data) {
+      continue;
+    }
+    if (options.writeExecutor) {
+      written += co_await folly::via(
+          options.writeExecutor, [&] { return writeIOBufToFd(fd, *data); });
+    } else {
+      written += writeIOBufToFd(fd, *data);
+    }
+  }
+  if (options.sync) {
+    if (options.writeExecutor) {
+      co_await folly::via(options.writeExecutor, [&] { syncFd(fd); });
+    } else {
+      syncFd(fd);
+    }
+  }
+  co_return written;
+}
+#endif
+
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include <folly/Optional.h>
+#include <folly/Try.h>
+
+#include <thrift/lib/cpp2/async/StreamCallbacks.h>
+#include <thrift/lib/cpp2/async/StreamPayloadBatch.h>
+#include <thrift/lib/cpp2/util/Ewma.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Byte-based flow control for ClientBufferedStream.
+ *
+ * Credits are still granted as message counts through requestN, but sized so
+ * that the bytes buffered by the client plus those it granted credits for stay
+ * within a window. The window tracks twice the bandwidth-delay product of the
+ * stream, estimated as the rate at which the consumer drains its buffer times
+ * the delay between granting credits and receiving messages for them.
+ */
+struct StreamFlowControlOptions {
+  size_t minWindowBytes{64 * 1024};
+  size_t maxWindowBytes{16 * 1024 * 1024};
+  // Used until the drain rate and delay have been measured.
+  size_t initialWindowBytes{1024 * 1024};
+  // Averaging window of the drain rate, delay and message size estimates.
+  std::chrono::milliseconds averagingWindow{1000};
+};
+
+/**
+ * Buffer memory counters of a stream, written by the thread consuming it and
+ * readable from any thread.
+ */
+struct StreamBufferStats {
+  // Bytes of payloads received and not consumed yet.
+  std::atomic<uint64_t> bufferedBytes{0};
+  std::atomic<uint64_t> peakBufferedBytes{0};
+  // Credits granted and not used up yet.
+  std::atomic<int64_t> outstandingCredits{0};
+  // Flow control window, 0 unless credits are sized in bytes.
+  std::atomic<uint64_t> windowBytes{0};
+  std::atomic<uint64_t> consumedBytes{0};
+  std::atomic<uint64_t> consumedMessages{0};
+};
+
+namespace detail {
+
+/**
+ * Decides when a ClientBufferedStream requests more messages and how many,
+ * counting either messages or, given StreamFlowControlOptions, bytes.
+ *
+ * The consumer calls onReceived() with each batch of messages it takes from
+ * the stream, onConsumed() after consuming each message and onEmpty() before
+ * waiting for more, requesting the credits these return.
+ */
+template <class Clock = std::chrono::steady_clock>
+class StreamCreditController {
+ public:
+  StreamCreditController(
+      int32_t bufferSize,
+      const folly::Optional<StreamFlowControlOptions>& options,
+      std::shared_ptr<StreamBufferStats> stats)
+      : options_(options),
+        stats_(std::move(stats)),
+        bufferSize_(bufferSize),
+        outstanding_(bufferSize) {
+    if (options_) {
+      // the request granted the initial credits
+      window_ = options_->initialWindowBytes;
+      grantedAt_ = Clock::now();
+    }
+    updateStats();
+  }
+
+  template <class Queue>
+  void onReceived(const Queue& queue) {
+    if (!measuring()) {
+      return;
+    }
+    auto now = Clock::now();
+    bool idle = bufferedBytes_ == 0;
+    queue.forEach([&](const folly::Try<StreamPayload>& payload) {
+      if (!payload.hasValue()) {
+        return;
+      }
+      // credits are granted for elements, several of which may be batched
+      int64_t elements = streamPayloadElements(*payload);
+      size_t bytes = payloadBytes(payload);
+      if (payload->metadata.elementCount_ref()) {
+        bytes -= std::min<size_t>(bytes, elements * kStreamElementHeaderBytes);
+      }
+      bufferedBytes_ += bytes;
+      if (options_) {
+        outstanding_ -= elements;
+        add(messageBytes_, elements ? double(bytes) / elements : 0);
+        messagesBeforeGrant_ -= elements;
+        if (grantedAt_ && messagesBeforeGrant_ < 0) {
+          // the first element sent for the granted credits
+          std::chrono::duration<double> delay = now - *grantedAt_;
+          add(delay_, delay.count());
+          grantedAt_.reset();
+        }
+      }
+    });
+    if (!options_) {
+      updateStats();
+      return;
+    }
+    if (idle) {
+      busySince_ = now;
+      busyBytes_ = 0;
+    }
+    updateStats();
+  }
+
+  // Size of a message to pass to onConsumed(), 0 unless it's measured.
+  size_t payloadBytes(const folly::Try<StreamPayload>& payload) const {
+    if (!measuring() || !payload.hasValue() || !payload->payload) {
+      return 0;
+    }
+    return payload->payload->computeChainDataLength();
+  }
+
+  // Returns the credits to request after consuming a message of 'bytes'.
+  int64_t onConsumed(size_t bytes) {
+    if (measuring()) {
+      bufferedBytes_ -= std::min(bufferedBytes_, bytes);
+      if (stats_) {
+        stats_->consumedBytes.fetch_add(bytes, std::memory_order_relaxed);
+        stats_->consumedMessages.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (!options_) {
+      int64_t credits = 0;
+      if (--outstanding_ <= bufferSize_ / 2) {
+        credits = bufferSize_ - outstanding_;
+        outstanding_ = bufferSize_;
+      }
+      updateStats();
+      return credits;
+    }
+
+    busyBytes_ += bytes;
+    auto now = Clock::now();
+    if (now - busySince_ >= kDrainSamplePeriod) {
+      sampleDrainRate(now);
+    }
+    auto credits = grant(now, false);
+    updateStats();
+    return credits;
+  }
+
+  // Returns the credits to request before waiting on an empty queue.
+  int64_t onEmpty() {
+    int64_t credits = 0;
+    if (!options_) {
+      if (outstanding_ == 0) {
+        credits = 1;
+        ++outstanding_;
+      }
+    } else {
+      auto now = Clock::now();
+      sampleDrainRate(now);
+      credits = grant(now, outstanding_ <= 0);
+    }
+    updateStats();
+    return credits;
+  }
+
+  size_t windowBytes() const {
+    return window_;
+  }
+
+ private:
+  // Long enough for the drain rate to be measurable, short enough for
+  // consumers which never catch up to contribute samples.
+  static constexpr std::chrono::milliseconds kDrainSamplePeriod{10};
+
+  bool measuring() const {
+    return options_ || stats_;
+  }
+
+  void add(folly::Optional<Ewma<Clock>>& ewma, double x) {
+    // seed with the first sample, Ewma converges from its initial value
+    if (!ewma) {
+      ewma.emplace(options_->averagingWindow, x);
+    } else {
+      ewma->add(x);
+    }
+  }
+
+  void sampleDrainRate(typename Clock::time_point now) {
+    std::chrono::duration<double> busy = now - busySince_;
+    if (busyBytes_ && busy.count() > 0) {
+      add(drainRate_, busyBytes_ / busy.count());
+    }
+    busySince_ = now;
+    busyBytes_ = 0;
+    if (drainRate_ && delay_) {
+      double window = 2 * drainRate_->estimate() * delay_->estimate();
+      window_ = std::max<size_t>(
+          options_->minWindowBytes,
+          std::min<double>(options_->maxWindowBytes, window));
+    }
+  }
+
+  // Grants credits for the part of the window not already buffered or granted
+  // once that's half of it, or at least one credit if 'starved'.
+  int64_t grant(typename Clock::time_point now, bool starved) {
+    double messageBytes =
+        std::max(messageBytes_ ? messageBytes_->estimate() : 0.0, 1.0);
+    int64_t outstanding = std::max<int64_t>(outstanding_, 0);
+    double used = bufferedBytes_ + outstanding * messageBytes;
+    int64_t credits = 0;
+    if (used <= window_ / 2 && messageBytes_) {
+      credits = static_cast<int64_t>((window_ - used) / messageBytes);
+    }
+    if (starved) {
+      credits = std::max<int64_t>(credits, 1);
+    }
+    if (credits > 0) {
+      if (!grantedAt_) {
+        grantedAt_ = now;
+        messagesBeforeGrant_ = outstanding;
+      }
+      outstanding_ += credits;
+    }
+    return credits;
+  }
+
+  void updateStats() {
+    if (!stats_) {
+      return;
+    }
+    stats_->bufferedBytes.store(bufferedBytes_, std::memory_order_relaxed);
+    if (bufferedBytes_ >
+        stats_->peakBufferedBytes.load(std::memory_order_relaxed)) {
+      stats_->peakBufferedBytes.store(
+          bufferedBytes_, std::memory_order_relaxed);
+    }
+    stats_->outstandingCredits.store(outstanding_, std::memory_order_relaxed);
+    stats_->windowBytes.store(
+        options_ ? window_ : 0, std::memory_order_relaxed);
+  }
+
+  const folly::Optional<StreamFlowControlOptions> options_;
+  const std::shared_ptr<StreamBufferStats> stats_;
+  const int32_t bufferSize_;
+  int64_t outstanding_;
+  size_t bufferedBytes_{0};
+
+  // byte-based flow control only
+  size_t window_{0};
+  folly::Optional<Ewma<Clock>> messageBytes_;
+  folly::Optional<Ewma<Clock>> drainRate_;
+  folly::Optional<Ewma<Clock>> delay_;
+  // when credits were last granted while no delay sample was pending, and how
+  // many elements earlier credits were still outstanding for
+  folly::Optional<typename Clock::time_point> grantedAt_;
+  int64_t messagesBeforeGrant_{0};
+  typename Clock::time_point busySince_{Clock::now()};
+  size_t busyBytes_{0};
+};
+
+template <class Clock>
+constexpr std::chrono::milliseconds
+    StreamCreditController<Clock>::kDrainSamplePeriod;
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
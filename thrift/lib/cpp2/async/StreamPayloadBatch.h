@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBufQueue.h>
+
+#include <thrift/lib/cpp2/async/StreamCallbacks.h>
+
+namespace apache {
+namespace thrift {
+namespace detail {
+
+// Each element of a batch is preceded by its length.
+constexpr size_t kStreamElementHeaderBytes = sizeof(uint32_t);
+
+/**
+ * Packs encoded stream elements into one payload, for clients which sent a
+ * StreamBatchingConfig with their request.
+ */
+class StreamPayloadBatchWriter {
+ public:
+  void append(std::unique_ptr<folly::IOBuf> element) {
+    size_t length = element ? element->computeChainDataLength() : 0;
+    folly::io::QueueAppender appender(&queue_, kStreamElementHeaderBytes);
+    appender.writeBE<uint32_t>(length);
+    if (element) {
+      // copies small elements into the tailroom of the batch
+      queue_.append(std::move(element), true /* pack */);
+    }
+    ++elements_;
+    bytes_ += kStreamElementHeaderBytes + length;
+  }
+
+  size_t elements() const {
+    return elements_;
+  }
+
+  size_t bytes() const {
+    return bytes_;
+  }
+
+  StreamPayload finish() {
+    StreamPayloadMetadata metadata;
+    metadata.elementCount_ref() = elements_;
+    elements_ = 0;
+    bytes_ = 0;
+    return StreamPayload(queue_.move(), std::move(metadata));
+  }
+
+ private:
+  folly::IOBufQueue queue_{folly::IOBufQueue::cacheChainLength()};
+  size_t elements_{0};
+  size_t bytes_{0};
+};
+
+/**
+ * Returns the number of stream elements carried by 'payload'.
+ */
+inline size_t streamPayloadElements(const StreamPayload& payload) {
+  auto count = payload.metadata.elementCount_ref();
+  return count ? *count : 1;
+}
+
+/**
+ * Splits a batch into payloads of its elements, sharing its buffers.
+ */
+inline std::vector<StreamPayload> splitStreamPayloadBatch(
+    const StreamPayload& batch) {
+  auto count = *batch.metadata.elementCount_ref();
+  if (count <= 0 || !batch.payload) {
+    throw std::out_of_range("Empty stream payload batch");
+  }
+  std::vector<StreamPayload> elements;
+  elements.reserve(count);
+  folly::io::Cursor cursor(batch.payload.get());
+  for (int32_t i = 0; i < count; ++i) {
+    auto length = cursor.readBE<uint32_t>();
+    std::unique_ptr<folly::IOBuf> element;
+    cursor.clone(element, length);
+    elements.emplace_back(std::move(element), StreamPayloadMetadata());
+  }
+  return elements;
+}
+
+} // namespace detail
+} // namespace thrift
+} // namespace apache
@@ -61,6 +61,13 @@ class Queue {
     }
   }
 
+  template <typename F>
+  void forEach(F&& f) const {
+    for (auto node = head_; node; node = node->next) {
+      f(const_cast<const T&>(node->value));
+    }
+  }
+
   explicit operator bool() const {
     return !empty();
   }
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <folly/portability/GFlags.h>
+#include <glog/logging.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
+#include <thrift/lib/cpp2/async/ServerStreamMulticast.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+using namespace apache::thrift;
+
+namespace {
+
+// IO threads the subscribers' streams are spread over
+constexpr size_t kThreads = 4;
+const std::string kEvent(1024, 'x');
+
+folly::Try<StreamPayload> encode(folly::Try<std::string>&& in) {
+  if (in.hasValue()) {
+    folly::IOBufQueue buf;
+    CompactSerializer::serialize(*in, &buf);
+    return folly::Try<StreamPayload>({buf.move(), {}});
+  } else if (in.hasException()) {
+    return folly::Try<StreamPayload>(in.exception());
+  } else {
+    return folly::Try<StreamPayload>();
+  }
+}
+
+class CountingClientCallback : public StreamClientCallback {
+ public:
+  bool onFirstResponse(
+      FirstResponsePayload&&,
+      folly::EventBase*,
+      StreamServerCallback* c) override {
+    cb = c;
+    return true;
+  }
+  void onFirstResponseError(folly::exception_wrapper) override {
+    std::terminate();
+  }
+  bool onStreamNext(StreamPayload&&) override {
+    ++received;
+    return true;
+  }
+  void onStreamError(folly::exception_wrapper) override {}
+  void onStreamComplete() override {}
+  void resetServerCallback(StreamServerCallback&) override {
+    std::terminate();
+  }
+
+  StreamServerCallback* cb{nullptr};
+  size_t received{0};
+};
+
+class Subscribers {
+ public:
+  explicit Subscribers(size_t count) : callbacks_(count) {}
+
+  // Sets up the stream subscribe(i) returns for each subscriber, granting it
+  // more credits than it will use.
+  template <typename Subscribe>
+  void start(Subscribe subscribe) {
+    for (size_t i = 0; i < callbacks_.size(); ++i) {
+      subscribe(i)(serverThread_.getEventBase(), &encode)(
+          FirstResponsePayload{nullptr, {}},
+          &callbacks_[i],
+          threads_[i % kThreads].getEventBase());
+    }
+    forEachThread([&](size_t thread) {
+      for (size_t i = thread; i < callbacks_.size(); i += kThreads) {
+        std::ignore = callbacks_[i].cb->onStreamRequestN(1u << 30);
+      }
+    });
+  }
+
+  // Returns once the events published so far have been received.
+  void wait() {
+    forEachThread([](size_t) {});
+  }
+
+ private:
+  template <typename F>
+  void forEachThread(F f) {
+    for (size_t thread = 0; thread < kThreads; ++thread) {
+      threads_[thread].getEventBase()->runInEventBaseThreadAndWait(
+          [&] { f(thread); });
+    }
+  }
+
+  folly::ScopedEventBaseThread threads_[kThreads];
+  folly::ScopedEventBaseThread serverThread_;
+  std::vector<CountingClientCallback> callbacks_;
+};
+
+// One publisher per stream, each encoding and handing off every event.
+void perSubscriber(size_t iters, size_t subscribers) {
+  folly::BenchmarkSuspender setup;
+  Subscribers s(subscribers);
+  std::vector<ServerStreamPublisher<std::string>> publishers;
+  publishers.reserve(subscribers);
+  s.start([&](size_t) {
+    auto pair = ServerStream<std::string>::createPublisher();
+    publishers.push_back(std::move(pair.second));
+    return std::move(pair.first);
+  });
+  setup.dismiss();
+
+  while (iters--) {
+    for (auto& publisher : publishers) {
+      publisher.next(kEvent);
+    }
+  }
+  s.wait();
+
+  setup.rehire();
+  for (auto& publisher : publishers) {
+    std::move(publisher).complete();
+  }
+  s.wait();
+}
+
+void multicast(size_t iters, size_t subscribers) {
+  folly::BenchmarkSuspender setup;
+  Subscribers s(subscribers);
+  ServerStreamMulticastPublisher<std::string> publisher;
+  s.start([&](size_t) { return publisher.subscribe(); });
+  setup.dismiss();
+
+  while (iters--) {
+    publisher.next(kEvent);
+  }
+  s.wait();
+
+  setup.rehire();
+  std::move(publisher).complete();
+  s.wait();
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(perSubscriber, 1K, 1000)
+BENCHMARK_RELATIVE_NAMED_PARAM(multicast, 1K, 1000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(perSubscriber, 100K, 100000)
+BENCHMARK_RELATIVE_NAMED_PARAM(multicast, 100K, 100000)
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include <folly/synchronization/Baton.h>
 #include <gtest/gtest.h>
 #include <thrift/lib/cpp2/async/ClientBufferedStream.h>
+#include <thrift/lib/cpp2/async/ServerStreamMulticast.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #if FOLLY_HAS_COROUTINES
 #include <folly/experimental/coro/Baton.h>
@@ -500,6 +501,141 @@ TEST(ServerStreamTest, ClientBufferedStreamPublisherIntegration) {
   EXPECT_TRUE(done);
 }
 
+class MulticastClientCallback : public StreamClientCallback {
+ public:
+  bool onFirstResponse(
+      FirstResponsePayload&&,
+      folly::EventBase*,
+      StreamServerCallback* c) override {
+    cb = c;
+    return true;
+  }
+  void onFirstResponseError(folly::exception_wrapper) override {
+    std::terminate();
+  }
+
+  bool onStreamNext(StreamPayload&& payload) override {
+    values.push_back(*decode(folly::Try<StreamPayload>(std::move(payload))));
+    return true;
+  }
+  void onStreamError(folly::exception_wrapper ew) override {
+    error = std::move(ew);
+    completed.post();
+  }
+  void onStreamComplete() override {
+    completed.post();
+  }
+
+  void resetServerCallback(StreamServerCallback&) override {
+    std::terminate();
+  }
+
+  std::vector<int> values;
+  folly::exception_wrapper error;
+  folly::fibers::Baton completed;
+  StreamServerCallback* cb;
+};
+
+TEST(ServerStreamTest, MulticastPublishConsume) {
+  folly::ScopedEventBaseThread clientEbs[2], serverEb;
+  MulticastClientCallback clientCallbacks[4];
+  std::atomic<int> closed{0};
+  ServerStreamMulticastPublisher<int> publisher;
+  for (int i = 0; i < 4; ++i) {
+    publisher.subscribe([&] { ++closed; })(serverEb.getEventBase(), &encode)(
+        FirstResponsePayload{nullptr, {}},
+        &clientCallbacks[i],
+        clientEbs[i % 2].getEventBase());
+  }
+  for (int i = 0; i < 4; ++i) {
+    // runs after the subscriber joined its EventBase's group
+    clientEbs[i % 2].getEventBase()->runInEventBaseThreadAndWait([&] {
+      std::ignore = clientCallbacks[i].cb->onStreamRequestN(100);
+    });
+  }
+  EXPECT_EQ(4, publisher.getStats().subscribers.load());
+
+  for (int i = 0; i < 10; i++) {
+    publisher.next(i);
+  }
+  clientEbs[0].getEventBase()->runInEventBaseThreadAndWait(
+      [&] { clientCallbacks[0].cb->onStreamCancel(); });
+  const auto& stats = publisher.getStats();
+  std::move(publisher).complete();
+
+  for (int i = 1; i < 4; ++i) {
+    clientCallbacks[i].completed.wait();
+    EXPECT_FALSE(clientCallbacks[i].error);
+    EXPECT_EQ(
+        std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}),
+        clientCallbacks[i].values);
+  }
+  for (auto& clientEb : clientEbs) {
+    clientEb.getEventBase()->runInEventBaseThreadAndWait([] {});
+  }
+  serverEb.getEventBase()->runInEventBaseThreadAndWait([] {});
+  EXPECT_EQ(4, closed);
+  EXPECT_EQ(40, stats.delivered.load());
+  EXPECT_EQ(0, stats.subscribers.load());
+}
+
+TEST(ServerStreamTest, MulticastSlowSubscriber) {
+  using Policy = ServerStreamMulticastOptions::SlowSubscriberPolicy;
+  auto test = [](Policy policy) {
+    folly::ScopedEventBaseThread clientEb, serverEb;
+    MulticastClientCallback clientCallback;
+    ServerStreamMulticastOptions options;
+    options.slowSubscriberPolicy = policy;
+    options.maxBuffered = 3;
+    ServerStreamMulticastPublisher<int> publisher(options);
+    publisher.subscribe()(serverEb.getEventBase(), &encode)(
+        FirstResponsePayload{nullptr, {}},
+        &clientCallback,
+        clientEb.getEventBase());
+    clientEb.getEventBase()->runInEventBaseThreadAndWait([] {});
+
+    // without credits
+    for (int i = 0; i < 10; i++) {
+      publisher.next(i);
+    }
+    if (policy != Policy::DISCONNECT) {
+      clientEb.getEventBase()->runInEventBaseThreadAndWait(
+          [&] { std::ignore = clientCallback.cb->onStreamRequestN(100); });
+    }
+    const auto& stats = publisher.getStats();
+    std::move(publisher).complete();
+    clientCallback.completed.wait();
+    if (policy == Policy::DISCONNECT) {
+      EXPECT_TRUE(clientCallback.error);
+      EXPECT_EQ(1, stats.disconnected.load());
+    } else {
+      EXPECT_FALSE(clientCallback.error);
+      EXPECT_EQ(7, stats.dropped.load());
+    }
+    return clientCallback.values;
+  };
+
+  EXPECT_EQ(std::vector<int>({0, 1, 2}), test(Policy::DROP));
+  EXPECT_EQ(std::vector<int>({7, 8, 9}), test(Policy::COALESCE));
+  EXPECT_EQ(std::vector<int>(), test(Policy::DISCONNECT));
+}
+
+TEST(ServerStreamTest, MulticastSubscribeAfterComplete) {
+  folly::ScopedEventBaseThread clientEb, serverEb;
+  MulticastClientCallback clientCallback;
+  ServerStreamMulticastPublisher<int> publisher;
+  auto stream = publisher.subscribe();
+  publisher.next(0);
+  std::move(publisher).complete();
+  stream(serverEb.getEventBase(), &encode)(
+      FirstResponsePayload{nullptr, {}},
+      &clientCallback,
+      clientEb.getEventBase());
+  clientCallback.completed.wait();
+  EXPECT_FALSE(clientCallback.error);
+  EXPECT_TRUE(clientCallback.values.empty());
+}
+
 TEST(ServerStreamTest, FactoryLeak) {
   auto [stream, publisher] = ServerStream<int>::createPublisher([] {});
   std::move(publisher).complete();
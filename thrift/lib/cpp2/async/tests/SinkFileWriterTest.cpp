@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/async/SinkFileWriter.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <folly/FileUtil.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/experimental/TestUtil.h>
+#include <folly/experimental/coro/BlockingWait.h>
+
+namespace apache {
+namespace thrift {
+
+namespace {
+
+std::unique_ptr<folly::IOBuf> makeChain(size_t buffers) {
+  auto chain = folly::IOBuf::copyBuffer("0");
+  for (size_t i = 1; i < buffers; ++i) {
+    chain->prependChain(folly::IOBuf::copyBuffer(std::to_string(i % 10)));
+  }
+  return chain;
+}
+
+std::string readFile(const folly::test::TemporaryFile& file) {
+  std::string contents;
+  EXPECT_TRUE(folly::readFile(file.path().c_str(), contents));
+  return contents;
+}
+
+} // namespace
+
+TEST(SinkFileWriterTest, WriteChain) {
+  folly::test::TemporaryFile file;
+  // more buffers than a single writev takes
+  auto chain = makeChain(IOV_MAX * 2 + 1);
+  EXPECT_EQ(chain->computeChainDataLength(), writeIOBufToFd(file.fd(), *chain));
+  EXPECT_EQ(chain->moveToFbString().toStdString(), readFile(file));
+}
+
+TEST(SinkFileWriterTest, WriteError) {
+  auto chain = makeChain(1);
+  EXPECT_THROW(writeIOBufToFd(-1, *chain), std::system_error);
+}
+
+#if FOLLY_HAS_COROUTINES
+TEST(SinkFileWriterTest, WriteSink) {
+  folly::test::TemporaryFile file;
+  folly::CPUThreadPoolExecutor executor(1);
+  SinkFileWriterOptions options;
+  options.writeExecutor = folly::getKeepAliveToken(executor);
+  options.sync = true;
+
+  std::string expected;
+  auto written = folly::coro::blockingWait(writeSinkToFd(
+      folly::coro::co_invoke(
+          [&]() -> folly::coro::AsyncGenerator<folly::IOBuf&&> {
+            for (size_t i = 0; i < 100; ++i) {
+              auto chunk = makeChain(i % 5 + 1);
+              expected += chunk->cloneAsValue().moveToFbString().toStdString();
+              co_yield std::move(*chunk);
+            }
+          }),
+      file.fd(),
+      std::move(options)));
+  EXPECT_EQ(expected.size(), written);
+  EXPECT_EQ(expected, readFile(file));
+}
+#endif
+
+} // namespace thrift
+} // namespace apache
@@ -79,25 +79,35 @@ void ByteRangeFreezer::doAppendBytes(
     folly::MutableByteRange& range,
     size_t& distance,
     size_t alignment) {
-  CHECK_LE(origin, write_.begin());
+  detail::appendAlignedBytes(write_, origin, n, range, distance, alignment);
+}
+
+namespace detail {
+
+void appendAlignedBytes(
+    folly::MutableByteRange& write,
+    byte* origin,
+    size_t n,
+    folly::MutableByteRange& range,
+    size_t& distance,
+    size_t alignment) {
+  CHECK_LE(origin, write.begin());
   if (!n) {
     distance = 0;
     range.reset(nullptr, 0);
     return;
   }
-  auto start = reinterpret_cast<intptr_t>(write_.begin());
+  auto start = reinterpret_cast<intptr_t>(write.begin());
   auto aligned = alignBy(start, alignment);
   auto padding = aligned - start;
-  if (padding + n > write_.size()) {
+  if (padding + n > write.size()) {
     throw std::length_error("Insufficient buffer allocated");
   }
-  range.reset(write_.begin() + padding, n);
-  write_.advance(padding + n);
+  range.reset(write.begin() + padding, n);
+  write.advance(padding + n);
   distance = range.begin() - origin;
 }
 
-namespace detail {
-
 FieldPosition BlockLayout::maximize() {
   FieldPosition pos = startFieldPosition();
   FROZEN_MAXIMIZE_FIELD(mask);
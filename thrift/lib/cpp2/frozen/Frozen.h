@@ -31,9 +31,11 @@
 
 #include <folly/Demangle.h>
 #include <folly/FBVector.h>
+#include <folly/Function.h>
 #include <folly/MapUtil.h>
 #include <folly/Memory.h>
 #include <folly/Optional.h>
+#include <folly/Portability.h>
 #include <folly/Range.h>
 #include <folly/container/F14Map-fwd.h>
 #include <folly/container/F14Set-fwd.h>
@@ -42,8 +44,10 @@
 #include <folly/lang/Bits.h>
 #include <folly/sorted_vector_types.h>
 #include <thrift/lib/cpp2/frozen/FrozenMacros.h>
+#include <thrift/lib/cpp2/frozen/HintTypes.h>
 #include <thrift/lib/cpp2/frozen/Traits.h>
 #include <thrift/lib/cpp2/frozen/schema/MemorySchema.h>
+#include <thrift/lib/thrift/gen-cpp2/frozen_constants.h>
 #include <thrift/lib/thrift/gen-cpp2/frozen_types.h>
 
 namespace apache {
@@ -864,6 +868,27 @@ class FreezeRoot {
     doAppendBytes(origin, n, range, distance, align);
   }
 
+  /**
+   * Freezes items [begin, end) of a range through 'root', with item 'begin'
+   * located at 'write'.
+   */
+  using ItemRangeFreezer = folly::FunctionRef<
+      void(FreezeRoot& root, FreezePosition write, size_t begin, size_t end)>;
+
+  /**
+   * Internal utility for freezing the 'count' items of a range, the first of
+   * which is located at 'write', each 'writeStep' apart. By default, all items
+   * are frozen in order through this root, but freezers may dispatch disjoint
+   * sub-ranges of items to other roots, provided the frozen bytes are the same.
+   */
+  void freezeItemRange(
+      FreezePosition write,
+      FieldPosition writeStep,
+      size_t count,
+      ItemRangeFreezer freezeItems) {
+    doFreezeItemRange(write, writeStep, count, freezeItems);
+  }
+
  private:
   virtual void doAppendBytes(
       byte* origin,
@@ -871,12 +896,50 @@ class FreezeRoot {
       folly::MutableByteRange& range,
       size_t& distance,
       size_t align) = 0;
+
+  virtual void doFreezeItemRange(
+      FreezePosition write,
+      FieldPosition /* writeStep */,
+      size_t count,
+      ItemRangeFreezer freezeItems) {
+    freezeItems(*this, write, 0, count);
+  }
 };
 
 inline size_t alignBy(size_t start, size_t alignment) {
   return ((start - 1) | (alignment - 1)) + 1;
 }
 
+namespace detail {
+/**
+ * Takes 'n' bytes aligned by 'alignment' from the front of 'write', setting an
+ * output range and a distance from a given origin.
+ */
+void appendAlignedBytes(
+    folly::MutableByteRange& write,
+    byte* origin,
+    size_t n,
+    folly::MutableByteRange& range,
+    size_t& distance,
+    size_t alignment);
+
+/**
+ * Number of keys resolved together by batched lookups on frozen tables.
+ */
+constexpr size_t kLookupBatchSize = 16;
+
+/**
+ * Hints that the memory at 'addr' will soon be read.
+ */
+inline void prefetchForRead(const void* addr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(addr, 0);
+#else
+  (void)addr;
+#endif
+}
+} // namespace detail
+
 /**
  * A FreezeRoot that writes to a given ByteRange
  */
@@ -1077,6 +1140,8 @@ using View = typename Layout<T>::View;
 #include <thrift/lib/cpp2/frozen/FrozenRef-inl.h> // @nolint
 #include <thrift/lib/cpp2/frozen/FrozenString-inl.h> // @nolint
 // depends on Range
+#include <thrift/lib/cpp2/frozen/FrozenColumnar-inl.h> // @nolint
+#include <thrift/lib/cpp2/frozen/FrozenGroupedHashTable-inl.h> // @nolint
 #include <thrift/lib/cpp2/frozen/FrozenHashTable-inl.h> // @nolint
 #include <thrift/lib/cpp2/frozen/FrozenOrderedTable-inl.h> // @nolint
 // depends on Associative
@@ -164,6 +164,21 @@ template <class T>
 struct Layout<T, typename std::enable_if<IsHashSet<T>::value>::type>
     : public detail::
           SetTableLayout<T, typename T::value_type, detail::HashTableLayout> {};
+
+template <class T>
+struct Layout<T, typename std::enable_if<IsGroupedHashMap<T>::value>::type>
+    : public detail::MapTableLayout<
+          T,
+          typename T::key_type,
+          typename T::mapped_type,
+          detail::GroupedHashTableLayout> {};
+
+template <class T>
+struct Layout<T, typename std::enable_if<IsGroupedHashSet<T>::value>::type>
+    : public detail::SetTableLayout<
+          T,
+          typename T::value_type,
+          detail::GroupedHashTableLayout> {};
 } // namespace frozen
 } // namespace thrift
 } // namespace apache
@@ -0,0 +1,590 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// IWYU pragma: private, include "thrift/lib/cpp2/frozen/Frozen.h"
+
+namespace apache {
+namespace thrift {
+namespace frozen {
+
+/**
+ * Describes the fields of a struct to ColumnarLayout, specialized for every
+ * struct by codegen'd X_layouts.h files through FROZEN_COLUMNS.
+ *
+ * 'forEach(visit)' calls 'visit(tag, get, set)' for each field, where 'tag' is
+ * a detail::ColumnTag naming the field, 'get(row)' returns a pointer to the
+ * field's value in 'row', or null if unset, and 'set(row, value)' sets it.
+ */
+template <class T>
+struct StructColumns;
+
+namespace detail {
+
+template <class F>
+struct ColumnTag {
+  typedef F type;
+  int32_t id;
+  const char* name;
+
+  ColumnTag(int32_t _id, const char* _name) : id(_id), name(_name) {}
+};
+
+/**
+ * Arithmetic and enum fields are stored unpacked, so their columns can be
+ * viewed as contiguous ranges. Booleans are kept as bitmaps.
+ */
+template <class F>
+using ColumnValues = typename std::conditional<
+    (std::is_arithmetic<F>::value && !std::is_same<F, bool>::value) ||
+        std::is_enum<F>::value,
+    VectorUnpacked<F>,
+    std::vector<F>>::type;
+
+/**
+ * The values of one field across the rows of a list, with a bitmap of the
+ * rows having the field. Rows without it hold a default value, and the bitmap
+ * is left empty if every row has it.
+ */
+template <class F>
+struct Column {
+  ColumnValues<F> values;
+  std::vector<bool> present;
+};
+
+/**
+ * Layout of a single column of a ColumnarLayout, laid out as simple fields.
+ */
+template <class F>
+struct ColumnLayout : public LayoutBase {
+  typedef LayoutBase Base;
+  typedef Column<F> T;
+  typedef ColumnLayout LayoutSelf;
+  Field<ColumnValues<F>> valuesField;
+  Field<std::vector<bool>> presentField;
+
+  ColumnLayout()
+      : LayoutBase(typeid(T)),
+        valuesField(1, "values"),
+        presentField(2, "present") {}
+
+  FieldPosition maximize() {
+    FieldPosition pos = startFieldPosition();
+    FROZEN_MAXIMIZE_FIELD(values);
+    FROZEN_MAXIMIZE_FIELD(present);
+    return pos;
+  }
+
+  FieldPosition layout(LayoutRoot& root, const T& x, LayoutPosition self) {
+    FieldPosition pos = startFieldPosition();
+    FROZEN_LAYOUT_FIELD(values);
+    FROZEN_LAYOUT_FIELD(present);
+    return pos;
+  }
+
+  void freeze(FreezeRoot& root, const T& x, FreezePosition self) const {
+    FROZEN_FREEZE_FIELD(values);
+    FROZEN_FREEZE_FIELD(present);
+  }
+
+  void thaw(ViewPosition self, T& out) const {
+    thawField(self, valuesField, out.values);
+    thawField(self, presentField, out.present);
+  }
+
+  class View : public ViewBase<View, ColumnLayout, T> {
+    typedef typename Layout<ColumnValues<F>>::View ValuesView;
+    typedef typename Layout<std::vector<bool>>::View PresentView;
+
+    ValuesView values_;
+    PresentView present_;
+
+    static F thawValue(folly::Range<const F*> values, size_t row) {
+      return values[row];
+    }
+
+    template <class Values>
+    static F thawValue(const Values& values, size_t row) {
+      return (values.begin() + row).thaw();
+    }
+
+   public:
+    View() {}
+    View(const LayoutSelf* layout, ViewPosition self)
+        : ViewBase<View, ColumnLayout, T>(layout, self),
+          values_(layout->valuesField.layout.view(
+              self(layout->valuesField.pos))),
+          present_(layout->presentField.layout.view(
+              self(layout->presentField.pos))) {}
+
+    /**
+     * The field's value in every row, including defaults for rows without
+     * it. For arithmetic and enum fields this is a folly::Range.
+     */
+    ValuesView values() const {
+      return values_;
+    }
+
+    /**
+     * Which rows have the field, empty if all of them do.
+     */
+    PresentView present() const {
+      return present_;
+    }
+
+    /**
+     * Rows beyond the column's values don't have the field, which is the case
+     * for every row if the field was added after freezing.
+     */
+    bool isPresent(size_t row) const {
+      return row < values_.size() && (present_.empty() || present_[row]);
+    }
+
+    auto operator[](size_t row) const -> decltype(values_[row]) {
+      return values_[row];
+    }
+
+    F thawRow(size_t row) const {
+      return thawValue(values_, row);
+    }
+  };
+
+  View view(ViewPosition self) const {
+    return View(this, self);
+  }
+
+  void print(std::ostream& os, int level) const final {
+    LayoutBase::print(os, level);
+    os << "column of " << folly::demangle(typeid(F).name());
+    valuesField.print(os, level + 1);
+    presentField.print(os, level + 1);
+  }
+
+  void clear() final {
+    LayoutBase::clear();
+    valuesField.clear();
+    presentField.clear();
+  }
+
+  FROZEN_SAVE_INLINE(FROZEN_SAVE_FIELD(values) FROZEN_SAVE_FIELD(present))
+
+  FROZEN_LOAD_INLINE(FROZEN_LOAD_FIELD(values, 1) FROZEN_LOAD_FIELD(present, 2))
+};
+
+template <class F>
+using ColumnField = Field<Column<F>, ColumnLayout<F>>;
+
+/**
+ * Layout of the columns of a ColumnarLayout, with one field per field of Item
+ * under the same id. The fields are only known through StructColumns<Item>,
+ * so they're held type-erased in declaration order, and each operation visits
+ * StructColumns<Item> again to recover their types.
+ */
+template <class T, class Item>
+struct ColumnsLayout : public LayoutBase {
+  typedef LayoutBase Base;
+  typedef ColumnsLayout LayoutSelf;
+
+  std::vector<std::unique_ptr<FieldBase>> columns;
+
+  ColumnsLayout() : LayoutBase(typeid(T)) {
+    StructColumns<Item>::forEach([&](auto tag, auto, auto) {
+      typedef typename decltype(tag)::type F;
+      columns.push_back(std::make_unique<ColumnField<F>>(tag.id, tag.name));
+    });
+  }
+
+  ColumnsLayout(const ColumnsLayout& other) : LayoutBase(other) {
+    other.forEachColumn([&](auto& field, auto, auto) {
+      typedef typename std::decay<decltype(field)>::type ColumnFieldType;
+      columns.push_back(std::make_unique<ColumnFieldType>(field));
+    });
+  }
+
+  /**
+   * Calls 'fn(field, get, set)' for each column.
+   */
+  template <class Fn>
+  void forEachColumn(Fn&& fn) const {
+    size_t i = 0;
+    StructColumns<Item>::forEach([&](auto tag, auto get, auto set) {
+      typedef typename decltype(tag)::type F;
+      fn(static_cast<ColumnField<F>&>(*columns[i++]), get, set);
+    });
+  }
+
+  /**
+   * Finds the column of field 'id', which must hold values of type F.
+   */
+  template <class F>
+  const ColumnField<F>& column(int32_t id) const {
+    for (auto& field : columns) {
+      if (field->key == id) {
+        if (auto typed = dynamic_cast<const ColumnField<F>*>(field.get())) {
+          return *typed;
+        }
+        throw std::invalid_argument(
+            "Column " + std::to_string(id) + " doesn't hold " +
+            folly::demangle(typeid(F).name()).toStdString());
+      }
+    }
+    throw std::out_of_range("No column " + std::to_string(id));
+  }
+
+  template <class F, class Get>
+  static Column<F>
+  gather(const ColumnField<F>& /* field */, const T& rows, Get get) {
+    Column<F> column;
+    bool sparse = false;
+    for (auto& row : rows) {
+      if (!get(row)) {
+        sparse = true;
+        break;
+      }
+    }
+    column.values.reserve(rows.size());
+    for (auto& row : rows) {
+      auto value = get(row);
+      column.values.push_back(value ? *value : F());
+      if (sparse) {
+        column.present.push_back(value != nullptr);
+      }
+    }
+    return column;
+  }
+
+  FieldPosition maximize() {
+    FieldPosition pos = startFieldPosition();
+    forEachColumn(
+        [&](auto& field, auto, auto) { pos = maximizeField(pos, field); });
+    return pos;
+  }
+
+  FieldPosition layout(LayoutRoot& root, const T& rows, LayoutPosition self) {
+    FieldPosition pos = startFieldPosition();
+    forEachColumn([&](auto& field, auto get, auto) {
+      pos = root.layoutField(self, pos, field, gather(field, rows, get));
+    });
+    return pos;
+  }
+
+  void freeze(FreezeRoot& root, const T& rows, FreezePosition self) const {
+    forEachColumn([&](auto& field, auto get, auto) {
+      root.freezeField(self, field, gather(field, rows, get));
+    });
+  }
+
+  /**
+   * Thaws the columns into 'rows', which must already hold every row.
+   */
+  void thaw(ViewPosition self, T& rows) const {
+    forEachColumn([&](auto& field, auto, auto set) {
+      typename std::decay<decltype(field.layout)>::type::T column;
+      thawField(self, field, column);
+      auto n = std::min(rows.size(), column.values.size());
+      for (size_t i = 0; i < n; ++i) {
+        if (column.present.empty() || column.present[i]) {
+          auto value = std::move(column.values[i]);
+          set(rows[i], std::move(value));
+        }
+      }
+    });
+  }
+
+  void thawRow(ViewPosition self, size_t row, Item& out) const {
+    forEachColumn([&](auto& field, auto, auto set) {
+      auto column = field.layout.view(self(field.pos));
+      if (column.isPresent(row)) {
+        set(out, column.thawRow(row));
+      }
+    });
+  }
+
+  void print(std::ostream& os, int level) const final {
+    LayoutBase::print(os, level);
+    os << "columns of " << folly::demangle(typeid(Item).name());
+    forEachColumn([&](auto& field, auto, auto) { field.print(os, level + 1); });
+  }
+
+  void clear() final {
+    LayoutBase::clear();
+    for (auto& field : columns) {
+      field->clear();
+    }
+  }
+
+  template <typename SchemaInfo>
+  void save(
+      typename SchemaInfo::Schema& schema,
+      typename SchemaInfo::Layout& _layout,
+      typename SchemaInfo::Helper& helper) const {
+    Base::template save<SchemaInfo>(schema, _layout, helper);
+    forEachColumn([&](auto& field, auto, auto) {
+      field.template save<SchemaInfo>(schema, _layout, helper);
+    });
+  }
+
+  template <typename SchemaInfo>
+  void load(
+      const typename SchemaInfo::Schema& schema,
+      const typename SchemaInfo::Layout& _layout,
+      LoadRoot& root) {
+    Base::template load<SchemaInfo>(schema, _layout, root);
+    for (const auto& field : _layout.getFields()) {
+      forEachColumn([&](auto& column, auto, auto) {
+        if (column.key == field.getId()) {
+          column.template load<SchemaInfo>(schema, field, root);
+        }
+      });
+    }
+  }
+};
+
+/**
+ * Layout specialization for lists of structs stored column by column. Rows
+ * can still be viewed and thawed one at a time, but scans over one field are
+ * better served by the views of its column.
+ */
+template <class T, class Item>
+struct ColumnarLayout : public LayoutBase {
+  typedef LayoutBase Base;
+  typedef ColumnarLayout LayoutSelf;
+  typedef ColumnsLayout<T, Item> ColumnsLayoutType;
+
+  Field<size_t> countField;
+  Field<T, ColumnsLayoutType> columnsField;
+
+  ColumnarLayout()
+      : LayoutBase(typeid(T)),
+        // count keeps the id it has in ArrayLayout
+        countField(2, "count"),
+        columnsField(4, "columns") {}
+
+  FieldPosition maximize() {
+    FieldPosition pos = startFieldPosition();
+    FROZEN_MAXIMIZE_FIELD(count);
+    FROZEN_MAXIMIZE_FIELD(columns);
+    return pos;
+  }
+
+  FieldPosition layout(LayoutRoot& root, const T& coll, LayoutPosition self) {
+    FieldPosition pos = startFieldPosition();
+    pos = root.layoutField(self, pos, countField, coll.size());
+    pos = root.layoutField(self, pos, columnsField, coll);
+    return pos;
+  }
+
+  void freeze(FreezeRoot& root, const T& coll, FreezePosition self) const {
+    root.freezeField(self, countField, coll.size());
+    root.freezeField(self, columnsField, coll);
+  }
+
+  void thaw(ViewPosition self, T& out) const {
+    size_t count = 0;
+    thawField(self, countField, count);
+    out.clear();
+    out.resize(count);
+    columnsField.layout.thaw(self(columnsField.pos), out);
+  }
+
+  void print(std::ostream& os, int level) const override {
+    LayoutBase::print(os, level);
+    os << "columnar range of " << folly::demangle(type.name());
+    countField.print(os, level + 1);
+    columnsField.print(os, level + 1);
+  }
+
+  void clear() override {
+    LayoutBase::clear();
+    countField.clear();
+    columnsField.clear();
+  }
+
+  template <typename SchemaInfo>
+  void save(
+      typename SchemaInfo::Schema& schema,
+      typename SchemaInfo::Layout& _layout,
+      typename SchemaInfo::Helper& helper) const {
+    FROZEN_SAVE_BODY(FROZEN_SAVE_FIELD(count) FROZEN_SAVE_FIELD(columns))
+    // older readers would take these for lists of empty items
+    schema.requireFileVersion(
+        schema::frozen_constants::kColumnarListFileVersion());
+  }
+
+  template <typename SchemaInfo>
+  void load(
+      const typename SchemaInfo::Schema& schema,
+      const typename SchemaInfo::Layout& _layout,
+      LoadRoot& root) {
+    FROZEN_LOAD_BODY(FROZEN_LOAD_FIELD(count, 2) FROZEN_LOAD_FIELD(columns, 4))
+    if (!this->countField.layout.empty() &&
+        this->columnsField.layout.empty()) {
+      throw LayoutTypeMismatchException("columnar list", "list");
+    }
+  }
+
+  /**
+   * A view of a columnar list. Indexing and iteration produce Rows, while
+   * 'column' gives views of all the values of one field.
+   */
+  class View : public ViewBase<View, ColumnarLayout, T> {
+    class Iterator;
+
+    const ColumnsLayoutType& columnsLayout() const {
+      return this->layout_->columnsField.layout;
+    }
+
+    ViewPosition columnsPosition() const {
+      return this->position_(this->layout_->columnsField.pos);
+    }
+
+   public:
+    /**
+     * One row of a columnar list.
+     */
+    class Row {
+     public:
+      Row() {}
+      Row(const View& outer, size_t index) : outer_(outer), index_(index) {}
+
+      size_t index() const {
+        return index_;
+      }
+
+      /**
+       * Whether this row has field 'id', which holds values of type F.
+       */
+      template <class F>
+      bool has(int32_t id) const {
+        return outer_.template column<F>(id).isPresent(index_);
+      }
+
+      /**
+       * The value of field 'id' in this row, which holds values of type F.
+       */
+      template <class F>
+      auto get(int32_t id) const
+          -> decltype(std::declval<typename ColumnLayout<F>::View>()[0]) {
+        return outer_.template column<F>(id)[index_];
+      }
+
+      Item thaw() const {
+        Item item;
+        outer_.columnsLayout().thawRow(outer_.columnsPosition(), index_, item);
+        return item;
+      }
+
+     private:
+      View outer_;
+      size_t index_{0};
+    };
+
+    typedef Row value_type;
+    typedef Row reference_type;
+    typedef Iterator iterator;
+    typedef Iterator const_iterator;
+
+    View() {}
+    View(const LayoutSelf* layout, ViewPosition self)
+        : ViewBase<View, ColumnarLayout, T>(layout, self) {
+      thawField(self, layout->countField, count_);
+    }
+
+    Row operator[](size_t index) const {
+      return Row(*this, index);
+    }
+
+    const_iterator begin() const {
+      return const_iterator(*this, 0);
+    }
+
+    const_iterator end() const {
+      return const_iterator(*this, count_);
+    }
+
+    size_t size() const {
+      return count_;
+    }
+
+    bool empty() const {
+      return !count_;
+    }
+
+    /**
+     * Views the column of field 'id', which holds values of type F.
+     */
+    template <class F>
+    typename ColumnLayout<F>::View column(int32_t id) const {
+      auto& field = columnsLayout().template column<F>(id);
+      return field.layout.view(columnsPosition()(field.pos));
+    }
+
+   private:
+    class Iterator {
+     public:
+      using difference_type = ptrdiff_t;
+      using value_type = const Row;
+      using pointer = value_type*;
+      using reference = value_type&;
+      using iterator_category = std::forward_iterator_tag;
+
+      Iterator() {}
+      Iterator(const View& outer, size_t index)
+          : outer_(outer), index_(index) {}
+
+      Row operator*() const {
+        return outer_[index_];
+      }
+
+      Iterator& operator++() {
+        ++index_;
+        return *this;
+      }
+
+      Iterator operator++(int) {
+        Iterator ret(*this);
+        ++index_;
+        return ret;
+      }
+
+      bool operator==(const Iterator& other) const {
+        return index_ == other.index_;
+      }
+
+      bool operator!=(const Iterator& other) const {
+        return index_ != other.index_;
+      }
+
+     private:
+      View outer_;
+      size_t index_{0};
+    };
+
+    size_t count_{0};
+  };
+
+  View view(ViewPosition self) const {
+    return View(this, self);
+  }
+};
+
+} // namespace detail
+
+template <class Item>
+struct Layout<VectorColumnar<Item>>
+    : public detail::ColumnarLayout<VectorColumnar<Item>, Item> {};
+
+} // namespace frozen
+} // namespace thrift
+} // namespace apache
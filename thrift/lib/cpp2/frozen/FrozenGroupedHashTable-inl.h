@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// IWYU pragma: private, include "thrift/lib/cpp2/frozen/Frozen.h"
+
+#if FOLLY_SSE >= 2
+#include <emmintrin.h>
+#endif
+
+namespace apache {
+namespace thrift {
+namespace frozen {
+namespace detail {
+
+/**
+ * Tags of the slots in a group of a GroupedHashTableLayout.
+ */
+struct TagGroup {
+  static constexpr size_t kSlots = 16;
+  static constexpr uint8_t kEmpty = 0x80;
+
+  /**
+   * Returns a bitmask of the slots in the group at 'tags' holding 'tag'.
+   */
+  static uint32_t match(const uint8_t* tags, uint8_t tag) {
+#if FOLLY_SSE >= 2
+    auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kSlots; ++i) {
+      mask |= uint32_t(tags[i] == tag) << i;
+    }
+    return mask;
+#endif
+  }
+
+  /**
+   * Returns true iff the group at 'tags' has any empty slot.
+   */
+  static bool hasEmpty(const uint8_t* tags) {
+#if FOLLY_SSE >= 2
+    auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags));
+    return _mm_movemask_epi8(group) != 0;
+#else
+    return tags[kSlots - 1] & kEmpty;
+#endif
+  }
+};
+
+/**
+ * Layout specialization for range types which support unique hash lookup,
+ * probing groups of slots at once like F14 and SwissTable.
+ *
+ * Every slot has a tag byte which either marks it empty or holds 7 bits of the
+ * hash of its item's key, so a lookup compares all the tags of a group at once
+ * and only compares the keys of items with matching tags. A group's occupied
+ * slots always precede its empty ones, and a lookup ends at the first group
+ * with an empty slot, so most lookups of missing keys touch one group. Items
+ * are stored densely in slot order, located through the number of items in
+ * the groups before their own.
+ */
+template <class T, class Item, class KeyExtractor, class Key>
+struct GroupedHashTableLayout : public ArrayLayout<T, Item> {
+  typedef ArrayLayout<T, Item> Base;
+  typedef Layout<Key> KeyLayout;
+  typedef GroupedHashTableLayout LayoutSelf;
+  typedef VectorUnpacked<uint8_t> Tags;
+
+  Field<Tags> tagsField;
+  Field<std::vector<size_t>> groupOffsetsField;
+
+  GroupedHashTableLayout()
+      : // continue field ids from ArrayLayout, distinct from HashTableLayout
+        tagsField(5, "tags"),
+        groupOffsetsField(6, "groupOffsets") {}
+
+  FieldPosition maximize() {
+    FieldPosition pos = Base::maximize();
+    FROZEN_MAXIMIZE_FIELD(tags);
+    FROZEN_MAXIMIZE_FIELD(groupOffsets);
+    return pos;
+  }
+
+  static size_t groupCount(size_t size) {
+    // 80% LF leaves most groups with an empty slot to end lookups early
+    return (size * 5 / 4 + TagGroup::kSlots - 1) / TagGroup::kSlots;
+  }
+
+  static size_t mix(size_t h) {
+    // tags and groups are both taken from the hash, so they must be unrelated
+    // even for integer keys hashed to themselves
+    return folly::hash::twang_mix64(h);
+  }
+
+  static uint8_t tagOf(size_t h) {
+    return h & 0x7f;
+  }
+
+  static size_t groupOf(size_t h, size_t groups) {
+    return (h >> 7) % groups;
+  }
+
+  static void buildIndex(
+      const T& coll,
+      std::vector<const Item*>& index,
+      Tags& tags,
+      std::vector<size_t>& groupOffsets) {
+    auto groups = groupCount(coll.size());
+    index.assign(groups * TagGroup::kSlots, nullptr);
+    tags.assign(groups * TagGroup::kSlots, TagGroup::kEmpty);
+    for (auto& item : coll) {
+      const typename KeyExtractor::KeyType& itemKey =
+          KeyExtractor::getKey(item);
+      size_t h = mix(KeyLayout::hash(itemKey));
+      auto tag = tagOf(h);
+      auto group = groupOf(h, groups);
+      for (size_t p = 0;; ++p) { // linear probing over groups
+        if (p == groups) {
+          throw std::out_of_range("All buckets full!");
+        }
+        size_t slot = group * TagGroup::kSlots;
+        size_t end = slot + TagGroup::kSlots;
+        for (; slot < end && index[slot]; ++slot) {
+          if (tags[slot] == tag &&
+              itemKey == KeyExtractor::getKey(*index[slot])) {
+            throw std::domain_error("Input collection is not distinct");
+          }
+        }
+        if (slot < end) {
+          index[slot] = KeyExtractor::getPointer(item);
+          tags[slot] = tag;
+          break;
+        }
+        group = group + 1 == groups ? 0 : group + 1;
+      }
+    }
+    groupOffsets.resize(groups);
+    size_t count = 0;
+    for (size_t group = 0; group < groups; ++group) {
+      groupOffsets[group] = count;
+      for (size_t slot = 0; slot < TagGroup::kSlots; ++slot) {
+        if (index[group * TagGroup::kSlots + slot]) {
+          ++count;
+        }
+      }
+    }
+  }
+
+  FieldPosition layoutItems(
+      LayoutRoot& root,
+      const T& coll,
+      LayoutPosition self,
+      FieldPosition pos,
+      LayoutPosition write,
+      FieldPosition writeStep) final {
+    std::vector<const Item*> index;
+    Tags tags;
+    std::vector<size_t> groupOffsets;
+    buildIndex(coll, index, tags, groupOffsets);
+
+    pos = root.layoutField(self, pos, this->tagsField, tags);
+    pos = root.layoutField(self, pos, this->groupOffsetsField, groupOffsets);
+
+    FieldPosition noField; // not really used
+    for (auto& it : index) {
+      if (it) {
+        root.layoutField(write, noField, this->itemField, *it);
+        write = write(writeStep);
+      }
+    }
+
+    return pos;
+  }
+
+  void freezeItems(
+      FreezeRoot& root,
+      const T& coll,
+      FreezePosition self,
+      FreezePosition write,
+      FieldPosition writeStep) const final {
+    std::vector<const Item*> index;
+    Tags tags;
+    std::vector<size_t> groupOffsets;
+    buildIndex(coll, index, tags, groupOffsets);
+
+    root.freezeField(self, this->tagsField, tags);
+    root.freezeField(self, this->groupOffsetsField, groupOffsets);
+
+    // items are stored densely in slot order
+    index.erase(std::remove(index.begin(), index.end(), nullptr), index.end());
+    root.freezeItemRange(
+        write,
+        writeStep,
+        index.size(),
+        [&](FreezeRoot& itemRoot,
+            FreezePosition itemWrite,
+            size_t begin,
+            size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            itemRoot.freezeField(itemWrite, this->itemField, *index[i]);
+            itemWrite = itemWrite(writeStep);
+          }
+        });
+  }
+
+  void thaw(ViewPosition self, T& out) const {
+    out.clear();
+    auto v = view(self);
+    for (auto it = v.begin(); it != v.end(); ++it) {
+      out.insert(it.thaw());
+    }
+  }
+
+  void print(std::ostream& os, int level) const override {
+    Base::print(os, level);
+    tagsField.print(os, level + 1);
+    groupOffsetsField.print(os, level + 1);
+  }
+
+  void clear() final {
+    Base::clear();
+    tagsField.clear();
+    groupOffsetsField.clear();
+  }
+
+  template <typename SchemaInfo>
+  void save(
+      typename SchemaInfo::Schema& schema,
+      typename SchemaInfo::Layout& _layout,
+      typename SchemaInfo::Helper& helper) const {
+    FROZEN_SAVE_BODY(FROZEN_SAVE_FIELD(tags) FROZEN_SAVE_FIELD(groupOffsets))
+    // older readers would take these for empty tables
+    schema.requireFileVersion(
+        schema::frozen_constants::kGroupedHashTableFileVersion());
+  }
+
+  template <typename SchemaInfo>
+  void load(
+      const typename SchemaInfo::Schema& schema,
+      const typename SchemaInfo::Layout& _layout,
+      LoadRoot& root) {
+    FROZEN_LOAD_BODY(
+        FROZEN_LOAD_FIELD(tags, 5) FROZEN_LOAD_FIELD(groupOffsets, 6))
+    if (!this->countField.layout.empty() &&
+        this->groupOffsetsField.layout.empty()) {
+      throw LayoutTypeMismatchException(
+          "grouped hash table", "another table layout");
+    }
+  }
+
+  class View : public Base::View {
+    typedef typename Layout<Key>::View KeyView;
+    typedef typename Layout<Item>::View ItemView;
+    typedef typename Layout<Tags>::View TagsView;
+    typedef typename Layout<std::vector<size_t>>::View OffsetsView;
+
+    TagsView tags_;
+    OffsetsView groupOffsets_;
+
+   public:
+    View() {}
+    View(const LayoutSelf* layout, ViewPosition self)
+        : Base::View(layout, self),
+          tags_(layout->tagsField.layout.view(self(layout->tagsField.pos))),
+          groupOffsets_(layout->groupOffsetsField.layout.view(
+              self(layout->groupOffsetsField.pos))) {}
+
+    typedef typename Base::View::iterator iterator;
+
+    void operator[](size_t) = delete;
+
+    std::pair<iterator, iterator> equal_range(const KeyView& key) const {
+      auto found = find(key);
+      if (found != this->end()) {
+        auto next = found;
+        return std::make_pair(found, ++next);
+      } else {
+        return std::make_pair(found, found);
+      }
+    }
+
+    iterator find(const KeyView& key) const {
+      auto groups = groupOffsets_.size();
+      if (!groups) {
+        return this->end();
+      }
+      size_t h = mix(KeyLayout::hash(key));
+      auto tag = tagOf(h);
+      auto group = groupOf(h, groups);
+      for (size_t p = 0; p < groups; ++p) {
+        const uint8_t* groupTags = tags_.begin() + group * TagGroup::kSlots;
+        auto matches = TagGroup::match(groupTags, tag);
+        if (matches) {
+          auto offset = groupOffsets_[group];
+          do {
+            auto slot = folly::findFirstSet(matches) - 1;
+            auto found = this->begin() + (offset + slot);
+            if (KeyExtractor::getViewKey(*found) == key) {
+              return found;
+            }
+            matches &= matches - 1;
+          } while (matches);
+        }
+        if (TagGroup::hasEmpty(groupTags)) {
+          return this->end();
+        }
+        group = group + 1 == groups ? 0 : group + 1;
+      }
+      return this->end();
+    }
+
+    /**
+     * Looks up each of 'keys' in turn, writing to 'out' the iterator 'find'
+     * would return for it. Like HashTableLayout's, keys are resolved in
+     * batches, prefetching every key's tags before matching any, and every
+     * first candidate item before comparing any keys.
+     */
+    template <class Keys, class OutputIterator>
+    OutputIterator findMany(const Keys& keys, OutputIterator out) const {
+      constexpr size_t kMiss = ~size_t(0);
+      auto groups = groupOffsets_.size();
+      size_t hashes[kLookupBatchSize];
+      size_t indexes[kLookupBatchSize];
+      auto it = keys.begin();
+      auto last = keys.end();
+      while (it != last) {
+        auto first = it;
+        size_t n = 0;
+        for (; n < kLookupBatchSize && it != last; ++n, ++it) {
+          const KeyView& key = *it;
+          size_t h = mix(KeyLayout::hash(key));
+          hashes[n] = h;
+          if (groups) {
+            auto group = groupOf(h, groups);
+            prefetchForRead(tags_.begin() + group * TagGroup::kSlots);
+            groupOffsets_.prefetch(group);
+          }
+        }
+        for (size_t i = 0; i < n; ++i) {
+          // a key whose first candidate doesn't match takes the slow path
+          indexes[i] = kMiss;
+          if (!groups) {
+            continue;
+          }
+          auto group = groupOf(hashes[i], groups);
+          auto matches = TagGroup::match(
+              tags_.begin() + group * TagGroup::kSlots, tagOf(hashes[i]));
+          if (matches) {
+            auto slot = folly::findFirstSet(matches) - 1;
+            indexes[i] = groupOffsets_[group] + slot;
+            this->prefetch(indexes[i]);
+          }
+        }
+        for (size_t i = 0; i < n; ++i, ++first) {
+          const KeyView& key = *first;
+          if (indexes[i] != kMiss) {
+            auto found = this->begin() + indexes[i];
+            if (KeyExtractor::getViewKey(*found) == key) {
+              *out++ = found;
+              continue;
+            }
+          }
+          *out++ = find(key);
+        }
+      }
+      return out;
+    }
+
+    size_t count(const KeyView& key) const {
+      return find(key) == this->end() ? 0 : 1;
+    }
+
+    T thaw() const {
+      T ret;
+      static_cast<const GroupedHashTableLayout*>(this->layout_)
+          ->thaw(this->position_, ret);
+      return ret;
+    }
+  };
+
+  View view(ViewPosition self) const {
+    return View(this, self);
+  }
+};
+} // namespace detail
+} // namespace frozen
+} // namespace thrift
+} // namespace apache
@@ -204,13 +204,21 @@ struct HashTableLayout : public ArrayLayout<T, Item> {
     assert(index.empty() == sparseTable.empty());
     root.freezeField(self, this->sparseTableField, sparseTable);
 
-    FieldPosition noField; // not really used
-    for (auto& it : index) {
-      if (it) {
-        root.freezeField(write, this->itemField, *it);
-        write = write(writeStep);
-      }
-    }
+    // items are stored densely in bucket order
+    index.erase(std::remove(index.begin(), index.end(), nullptr), index.end());
+    root.freezeItemRange(
+        write,
+        writeStep,
+        index.size(),
+        [&](FreezeRoot& itemRoot,
+            FreezePosition itemWrite,
+            size_t begin,
+            size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            itemRoot.freezeField(itemWrite, this->itemField, *index[i]);
+            itemWrite = itemWrite(writeStep);
+          }
+        });
   }
 
   void thaw(ViewPosition self, T& out) const {
@@ -233,7 +241,17 @@ struct HashTableLayout : public ArrayLayout<T, Item> {
 
   FROZEN_SAVE_INLINE(FROZEN_SAVE_FIELD(sparseTable))
 
-  FROZEN_LOAD_INLINE(FROZEN_LOAD_FIELD(sparseTable, 4))
+  template <typename SchemaInfo>
+  void load(
+      const typename SchemaInfo::Schema& schema,
+      const typename SchemaInfo::Layout& _layout,
+      LoadRoot& root) {
+    FROZEN_LOAD_BODY(FROZEN_LOAD_FIELD(sparseTable, 4))
+    if (!this->countField.layout.empty() &&
+        this->sparseTableField.layout.empty()) {
+      throw LayoutTypeMismatchException("hash table", "another table layout");
+    }
+  }
 
   class View : public Base::View {
     typedef typename Layout<Key>::View KeyView;
@@ -297,6 +315,66 @@ struct HashTableLayout : public ArrayLayout<T, Item> {
       return this->end();
     }
 
+    /**
+     * Looks up each of 'keys' in turn, writing to 'out' the iterator 'find'
+     * would return for it. Keys are resolved in batches: every key of a batch
+     * is hashed and its block prefetched, then every first probe is resolved
+     * and its item prefetched, and only then are keys compared, so the cache
+     * misses of a batch overlap instead of adding up.
+     */
+    template <class Keys, class OutputIterator>
+    OutputIterator findMany(const Keys& keys, OutputIterator out) const {
+      constexpr size_t kMiss = ~size_t(0);
+      auto blocks = table_.size();
+      auto buckets = blocks * Block::bits;
+      size_t hashes[kLookupBatchSize];
+      size_t indexes[kLookupBatchSize];
+      auto it = keys.begin();
+      auto last = keys.end();
+      while (it != last) {
+        auto first = it;
+        size_t n = 0;
+        for (; n < kLookupBatchSize && it != last; ++n, ++it) {
+          const KeyView& key = *it;
+          auto h = KeyLayout::hash(key);
+          h *= 5; // same as find()
+          hashes[n] = h;
+          if (buckets) {
+            table_.prefetch(h % buckets / Block::bits);
+          }
+        }
+        for (size_t i = 0; i < n; ++i) {
+          indexes[i] = kMiss;
+          if (!buckets) {
+            continue;
+          }
+          auto bucket = hashes[i] % buckets;
+          auto minor = bucket % Block::bits;
+          auto block = table_[bucket / Block::bits];
+          auto mask = block.mask();
+          if (1 & (mask >> minor)) {
+            size_t subOffset = folly::popcount(mask & ((1ULL << minor) - 1));
+            indexes[i] = block.offset() + subOffset;
+            this->prefetch(indexes[i]);
+          }
+        }
+        for (size_t i = 0; i < n; ++i, ++first) {
+          const KeyView& key = *first;
+          if (indexes[i] == kMiss) {
+            *out++ = this->end();
+            continue;
+          }
+          auto found = this->begin() + indexes[i];
+          if (KeyExtractor::getViewKey(*found) == key) {
+            *out++ = found;
+          } else {
+            *out++ = find(key); // collided, continue probing one at a time
+          }
+        }
+      }
+      return out;
+    }
+
     size_t count(const KeyView& key) const {
       return find(key) == this->end() ? 0 : 1;
     }
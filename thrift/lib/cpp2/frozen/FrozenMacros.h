@@ -198,3 +198,52 @@
       LoadRoot& root) {                           \
     FROZEN_LOAD_BODY(__VA_ARGS__)                 \
   }
+
+#define FROZEN_COLUMN(NAME, ID, /*TYPE*/...)                    \
+  visit(                                                        \
+      detail::ColumnTag<__VA_ARGS__>(ID, #NAME),                \
+      [](const T& x) -> const __VA_ARGS__* { return &x.NAME; }, \
+      [](T& x, __VA_ARGS__&& v) {                               \
+        x.NAME = std::move(v);                                  \
+        x.__isset.NAME = true;                                  \
+      });
+#define FROZEN_COLUMN_OPT(NAME, ID, /*TYPE*/...)            \
+  visit(                                                    \
+      detail::ColumnTag<__VA_ARGS__>(ID, #NAME),            \
+      [](const T& x) -> const __VA_ARGS__* {                \
+        return x.NAME##_ref() ? &*x.NAME##_ref() : nullptr; \
+      },                                                    \
+      [](T& x, __VA_ARGS__&& v) { x.NAME##_ref() = std::move(v); });
+#define FROZEN_COLUMN_REQ(NAME, ID, /*TYPE*/...)                \
+  visit(                                                        \
+      detail::ColumnTag<__VA_ARGS__>(ID, #NAME),                \
+      [](const T& x) -> const __VA_ARGS__* { return &x.NAME; }, \
+      [](T& x, __VA_ARGS__&& v) { x.NAME = std::move(v); });
+#define FROZEN_COLUMN_UNIQUE_REF(NAME, ID, /*TYPE*/...)              \
+  visit(                                                             \
+      detail::ColumnTag<__VA_ARGS__>(ID, #NAME),                     \
+      [](const T& x) -> const __VA_ARGS__* { return x.NAME.get(); }, \
+      [](T& x, __VA_ARGS__&& v) {                                    \
+        x.NAME = std::make_unique<__VA_ARGS__>(std::move(v));        \
+      });
+#define FROZEN_COLUMN_SHARED_REF(NAME, ID, /*TYPE*/...)              \
+  visit(                                                             \
+      detail::ColumnTag<__VA_ARGS__>(ID, #NAME),                     \
+      [](const T& x) -> const __VA_ARGS__* { return x.NAME.get(); }, \
+      [](T& x, __VA_ARGS__&& v) {                                    \
+        x.NAME = std::make_shared<__VA_ARGS__>(std::move(v));        \
+      });
+
+/**
+ * Describes the fields of a struct for columnar layouts, see StructColumns.
+ */
+#define FROZEN_COLUMNS(TYPE, ...)          \
+  template <>                              \
+  struct StructColumns<TYPE> {             \
+    typedef TYPE T;                        \
+    template <class Visitor>               \
+    static void forEach(Visitor&& visit) { \
+      (void)visit;                         \
+      __VA_ARGS__                          \
+    }                                      \
+  }
@@ -27,6 +27,11 @@ template <class T, class Item, class KeyExtractor, class Key = T>
 struct SortedTableLayout : public ArrayLayout<T, Item> {
   typedef ArrayLayout<T, Item> Base;
   typedef SortedTableLayout LayoutSelf;
+  typedef std::is_base_of<
+      std::random_access_iterator_tag,
+      typename std::iterator_traits<
+          typename T::const_iterator>::iterator_category>
+      IsRandomAccess;
 
   void thaw(ViewPosition self, T& out) const {
     out.clear();
@@ -112,20 +117,38 @@ struct SortedTableLayout : public ArrayLayout<T, Item> {
     std::vector<const Item*> index;
     maybeIndex(coll, index);
 
-    FieldPosition noField; // not really used
-    if (index.empty()) {
-      // either the collection was already sorted or it's empty
+    if (index.empty() && !IsRandomAccess::value) {
+      // already sorted, but sub-ranges of items can't be reached in constant
+      // time without an indirection table.
+      index.reserve(coll.size());
       for (auto& item : coll) {
-        root.freezeField(write, this->itemField, item);
-        write = write(writeStep);
-      }
-    } else {
-      // collection was non-empty and non-sorted, needs indirection table.
-      for (auto ptr : index) {
-        root.freezeField(write, this->itemField, *ptr);
-        write = write(writeStep);
+        index.push_back(KeyExtractor::getPointer(item));
       }
     }
+
+    root.freezeItemRange(
+        write,
+        writeStep,
+        coll.size(),
+        [&](FreezeRoot& itemRoot,
+            FreezePosition itemWrite,
+            size_t begin,
+            size_t end) {
+          if (index.empty()) {
+            // either the collection was already sorted or it's empty
+            auto it = std::next(coll.begin(), begin);
+            for (size_t i = begin; i < end; ++i, ++it) {
+              itemRoot.freezeField(itemWrite, this->itemField, *it);
+              itemWrite = itemWrite(writeStep);
+            }
+          } else {
+            // collection was non-empty and non-sorted, needs indirection table.
+            for (size_t i = begin; i < end; ++i) {
+              itemRoot.freezeField(itemWrite, this->itemField, *index[i]);
+              itemWrite = itemWrite(writeStep);
+            }
+          }
+        });
   }
 
   class View : public Base::View {
@@ -174,6 +197,34 @@ struct SortedTableLayout : public ArrayLayout<T, Item> {
       }
     }
 
+    /**
+     * Finds the lower bound of each of 'keys' in turn, writing each to 'out'.
+     * Binary searches for a batch of keys advance in lock step, prefetching
+     * the next probe of every search before comparing any, so the cache misses
+     * of a batch overlap instead of adding up.
+     */
+    template <class Keys, class OutputIterator>
+    OutputIterator lowerBoundMany(const Keys& keys, OutputIterator out) const {
+      return searchMany(keys, out, [&](size_t index, const KeyView&) {
+        return this->begin() + index;
+      });
+    }
+
+    /**
+     * Looks up each of 'keys' in turn, writing to 'out' the iterator 'find'
+     * would return for it, searching batches of keys as 'lowerBoundMany' does.
+     */
+    template <class Keys, class OutputIterator>
+    OutputIterator findMany(const Keys& keys, OutputIterator out) const {
+      return searchMany(keys, out, [&](size_t index, const KeyView& key) {
+        if (index != this->size() &&
+            KeyExtractor::getViewKey(Base::View::operator[](index)) == key) {
+          return this->begin() + index;
+        }
+        return this->end();
+      });
+    }
+
     size_t count(const KeyView& key) const {
       return find(key) == this->end() ? 0 : 1;
     }
@@ -184,6 +235,51 @@ struct SortedTableLayout : public ArrayLayout<T, Item> {
           ->thaw(this->position_, ret);
       return ret;
     }
+
+   private:
+    bool keyBefore(size_t index, const KeyView& key) const {
+      return KeyExtractor::getViewKey(Base::View::operator[](index)) < key;
+    }
+
+    template <class Keys, class OutputIterator, class Resolve>
+    OutputIterator
+    searchMany(const Keys& keys, OutputIterator out, Resolve resolve) const {
+      auto size = this->size();
+      size_t bases[kLookupBatchSize];
+      auto it = keys.begin();
+      auto last = keys.end();
+      while (it != last) {
+        auto first = it;
+        size_t n = 0;
+        for (; n < kLookupBatchSize && it != last; ++n, ++it) {
+          bases[n] = 0;
+        }
+        // Every search of the batch halves a range of the same length, so
+        // they all take the same number of steps.
+        for (size_t len = size; len > 1;) {
+          size_t half = len / 2;
+          for (size_t i = 0; i < n; ++i) {
+            this->prefetch(bases[i] + half);
+          }
+          auto keyIt = first;
+          for (size_t i = 0; i < n; ++i, ++keyIt) {
+            const KeyView& key = *keyIt;
+            if (keyBefore(bases[i] + half, key)) {
+              bases[i] += half;
+            }
+          }
+          len -= half;
+        }
+        for (size_t i = 0; i < n; ++i, ++first) {
+          const KeyView& key = *first;
+          if (size && keyBefore(bases[i], key)) {
+            ++bases[i];
+          }
+          *out++ = resolve(bases[i], key);
+        }
+      }
+      return out;
+    }
   };
 
   View view(ViewPosition self) const {
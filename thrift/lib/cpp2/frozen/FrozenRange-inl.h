@@ -118,10 +118,21 @@ struct ArrayLayout : public LayoutBase {
       FreezePosition /* self */,
       FreezePosition write,
       FieldPosition writeStep) const {
-    for (const auto& it : coll) {
-      root.freezeField(write, itemField, it);
-      write = write(writeStep);
-    }
+    root.freezeItemRange(
+        write,
+        writeStep,
+        coll.size(),
+        [&](FreezeRoot& itemRoot,
+            FreezePosition itemWrite,
+            size_t begin,
+            size_t end) {
+          auto it = coll.begin();
+          std::advance(it, begin);
+          for (size_t i = begin; i < end; ++i, ++it) {
+            itemRoot.freezeField(itemWrite, itemField, *it);
+            itemWrite = itemWrite(writeStep);
+          }
+        });
   }
 
   void thaw(ViewPosition self, T& out) const {
@@ -231,6 +242,15 @@ struct ArrayLayout : public LayoutBase {
       return {data, data + count_};
     }
 
+    /**
+     * Hints that the item at 'index' will soon be viewed, so that lookups
+     * resolving many keys at once can overlap their cache misses.
+     */
+    void prefetch(size_t index) const {
+      auto pos = indexPosition(data_, index, itemLayout());
+      prefetchForRead(pos.start + pos.bitOffset / 8);
+    }
+
    private:
     /**
      * Simple iterator on a range, with additional '.thaw()' member for thawing
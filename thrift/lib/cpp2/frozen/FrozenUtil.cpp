@@ -16,9 +16,17 @@
 
 #include <thrift/lib/cpp2/frozen/FrozenUtil.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 
 #include <folly/Conv.h>
+#include <folly/Exception.h>
+#include <folly/futures/Future.h>
+#include <folly/portability/SysMman.h>
+#include <folly/portability/SysStat.h>
+#include <folly/portability/SysSyscall.h>
+#include <folly/portability/Unistd.h>
 
 // clang-format off
 DEFINE_bool(thrift_frozen_util_disable_mlock, false,
@@ -40,6 +48,30 @@ FrozenFileForwardIncompatible::FrozenFileForwardIncompatible(int fileVersion)
           " are supported.")),
       fileVersion_(fileVersion) {}
 
+namespace detail {
+
+void serializeSchema(
+    schema::Schema& schema,
+    std::string& out,
+    size_t dataAlignment) {
+  out.clear();
+  CompactSerializer::serialize(schema, &out);
+  if (dataAlignment <= 1) {
+    return;
+  }
+  // The padding's length prefix grows with it, so it may overshoot the next
+  // multiple and need to be extended to the one after.
+  std::string padding;
+  while (out.size() % dataAlignment) {
+    padding.append(alignBy(out.size(), dataAlignment) - out.size(), '\0');
+    schema.padding_ref() = padding;
+    out.clear();
+    CompactSerializer::serialize(schema, &out);
+  }
+}
+
+} // namespace detail
+
 MallocFreezer::Segment::Segment(size_t _size)
     : size(_size),
       // NB: All allocations rounded up to next multiple of 8 due to packed
@@ -108,6 +140,479 @@ void MallocFreezer::doAppendBytes(
   range = appendBuffer(padding + n);
   range.advance(padding);
 }
+
+namespace {
+
+/**
+ * Position of item 'i' of a range whose first item is at 'write', normalized
+ * so that the bit offset is less than 8.
+ */
+FreezePosition
+itemPosition(FreezePosition write, FieldPosition writeStep, size_t i) {
+  size_t bitOffset = write.bitOffset + writeStep.bitOffset * i;
+  return {write.start + writeStep.offset * i + bitOffset / 8, bitOffset % 8};
+}
+
+/**
+ * Freezes a sub-range of items into scratch memory to measure the bytes they
+ * append, as if the items were at their real positions and their appended
+ * bytes started at 'tailStart'. Distances are computed between these virtual
+ * addresses, so freezing fails exactly when it would in place, provided that
+ * 'tailStart' is exact.
+ */
+class MeasuringFreezer final : public FreezeRoot {
+ public:
+  MeasuringFreezer(
+      FreezePosition first,
+      FreezePosition last,
+      uintptr_t tailStart)
+      : itemStart_(first.start),
+        itemScratch_(
+            last.start - first.start + 1 + LayoutRoot::kPaddingBytes),
+        tailStart_(tailStart),
+        cursor_(tailStart) {}
+
+  FreezePosition scratchPosition(FreezePosition real) {
+    return {itemScratch_.data() + (real.start - itemStart_), real.bitOffset};
+  }
+
+  size_t appended() const {
+    return cursor_ - tailStart_;
+  }
+
+  size_t maxAlignment() const {
+    return maxAlignment_;
+  }
+
+  bool registeredPositions() const {
+    return !positions_.empty();
+  }
+
+ private:
+  // Large enough to amortize allocation, small enough to stay cheap to zero.
+  static constexpr size_t kSegmentBytes = 1 << 20;
+
+  struct Segment {
+    std::unique_ptr<byte[]> buffer;
+    size_t size;
+    uintptr_t virtualStart;
+  };
+
+  uintptr_t virtualAddress(const byte* ptr) const {
+    if (ptr >= itemScratch_.data() &&
+        ptr < itemScratch_.data() + itemScratch_.size()) {
+      return reinterpret_cast<uintptr_t>(itemStart_) +
+          (ptr - itemScratch_.data());
+    }
+    auto it = segments_.upper_bound(ptr);
+    CHECK(it != segments_.begin());
+    --it;
+    return it->second.virtualStart + (ptr - it->first);
+  }
+
+  void doAppendBytes(
+      byte* origin,
+      size_t n,
+      folly::MutableByteRange& range,
+      size_t& distance,
+      size_t alignment) override {
+    if (!n) {
+      distance = 0;
+      range.reset(nullptr, 0);
+      return;
+    }
+    auto aligned = alignBy(cursor_, alignment);
+    // leave room for whole-word writes of packed integers past the end
+    auto needed = aligned + n + LayoutRoot::kPaddingBytes;
+    if (!current_ || needed > current_->virtualStart + current_->size) {
+      auto size = std::max(kSegmentBytes, n + LayoutRoot::kPaddingBytes);
+      auto buffer = std::make_unique<byte[]>(size);
+      auto key = buffer.get();
+      current_ =
+          &segments_.emplace(key, Segment{std::move(buffer), size, aligned})
+               .first->second;
+    }
+    auto originAddress = virtualAddress(origin);
+    CHECK_LE(originAddress, aligned);
+    range.reset(current_->buffer.get() + (aligned - current_->virtualStart), n);
+    distance = aligned - originAddress;
+    cursor_ = aligned + n;
+    maxAlignment_ = std::max(maxAlignment_, alignment);
+  }
+
+  const byte* itemStart_;
+  std::vector<byte> itemScratch_;
+  const uintptr_t tailStart_;
+  uintptr_t cursor_;
+  size_t maxAlignment_{1};
+  std::map<const byte*, Segment> segments_;
+  Segment* current_{nullptr};
+};
+
+/**
+ * Freezes a sub-range of items in place, appending to the region reserved for
+ * it.
+ */
+class RegionFreezer final : public FreezeRoot {
+ public:
+  explicit RegionFreezer(folly::MutableByteRange region) : write_(region) {}
+
+  size_t remaining() const {
+    return write_.size();
+  }
+
+ private:
+  void doAppendBytes(
+      byte* origin,
+      size_t n,
+      folly::MutableByteRange& range,
+      size_t& distance,
+      size_t alignment) override {
+    detail::appendAlignedBytes(write_, origin, n, range, distance, alignment);
+  }
+
+  folly::MutableByteRange write_;
+};
+
+struct ItemSubRange {
+  size_t begin;
+  size_t end;
+  // Where the appended bytes were assumed to start when measured.
+  uintptr_t measuredAt{0};
+  bool measured{false};
+  bool registeredPositions{false};
+  size_t tailBytes{0};
+  size_t maxAlignment{1};
+  uintptr_t tailStart{0};
+};
+
+void measure(
+    ItemSubRange& sub,
+    uintptr_t tailStart,
+    FreezePosition write,
+    FieldPosition writeStep,
+    FreezeRoot::ItemRangeFreezer freezeItems) {
+  auto first = itemPosition(write, writeStep, sub.begin);
+  auto last = itemPosition(write, writeStep, sub.end);
+  MeasuringFreezer measurer(first, last, tailStart);
+  freezeItems(measurer, measurer.scratchPosition(first), sub.begin, sub.end);
+  sub.measuredAt = tailStart;
+  sub.measured = true;
+  sub.registeredPositions = measurer.registeredPositions();
+  sub.tailBytes = measurer.appended();
+  sub.maxAlignment = measurer.maxAlignment();
+}
+
+void runConcurrently(
+    folly::Executor* executor,
+    const std::vector<size_t>& tasks,
+    folly::FunctionRef<void(size_t)> run) {
+  std::vector<folly::Future<folly::Unit>> futures;
+  futures.reserve(tasks.size());
+  for (auto task : tasks) {
+    futures.push_back(folly::via(executor, [run, task] { run(task); }));
+  }
+  // wait for every task before rethrowing, they reference the caller's stack
+  for (auto& result : folly::collectAll(futures).get()) {
+    result.throwIfFailed();
+  }
+}
+
+} // namespace
+
+void ParallelByteRangeFreezer::doAppendBytes(
+    byte* origin,
+    size_t n,
+    folly::MutableByteRange& range,
+    size_t& distance,
+    size_t alignment) {
+  detail::appendAlignedBytes(write_, origin, n, range, distance, alignment);
+}
+
+void ParallelByteRangeFreezer::doFreezeItemRange(
+    FreezePosition write,
+    FieldPosition writeStep,
+    size_t count,
+    ItemRangeFreezer freezeItems) {
+  size_t tasks = executor_
+      ? std::min(
+            2 * options_.concurrency,
+            count / std::max<size_t>(options_.minItemsPerTask, 1))
+      : 0;
+  // Items may refer to references frozen before this range, which only this
+  // root knows about.
+  if (tasks < 2 || !positions_.empty()) {
+    freezeItems(*this, write, 0, count);
+    return;
+  }
+
+  // Sub-ranges of bit-packed items must start on byte boundaries.
+  size_t perTask = alignBy((count + tasks - 1) / tasks, 64);
+  std::vector<ItemSubRange> subRanges;
+  for (size_t begin = 0; begin < count; begin += perTask) {
+    subRanges.push_back({begin, std::min(count, begin + perTask)});
+  }
+  std::vector<size_t> all(subRanges.size());
+  for (size_t k = 0; k < all.size(); ++k) {
+    all[k] = k;
+  }
+
+  // Measure all sub-ranges concurrently, assuming each one's bytes are
+  // appended right after the items. This is exact for the first sub-range, and
+  // for the others if their appended bytes need no more alignment than the
+  // guess provides. Failures are retried below with the exact start.
+  auto tailStart = reinterpret_cast<uintptr_t>(write_.begin());
+  runConcurrently(executor_, all, [&](size_t k) {
+    try {
+      measure(subRanges[k], tailStart, write, writeStep, freezeItems);
+    } catch (const std::exception&) {
+      subRanges[k].measured = false;
+    }
+  });
+
+  uintptr_t cursor = tailStart;
+  for (auto& sub : subRanges) {
+    if (!sub.measured || (cursor - sub.measuredAt) % sub.maxAlignment != 0) {
+      measure(sub, cursor, write, writeStep, freezeItems);
+    }
+    if (sub.registeredPositions) {
+      // references may be shared between sub-ranges
+      freezeItems(*this, write, 0, count);
+      return;
+    }
+    sub.tailStart = cursor;
+    cursor += sub.tailBytes;
+  }
+
+  size_t tailBytes = cursor - tailStart;
+  if (tailBytes > write_.size()) {
+    throw std::length_error("Insufficient buffer allocated");
+  }
+  write_.advance(tailBytes);
+
+  auto freezeInPlace = [&](size_t k) {
+    auto& sub = subRanges[k];
+    RegionFreezer region(folly::MutableByteRange(
+        reinterpret_cast<byte*>(sub.tailStart), sub.tailBytes));
+    freezeItems(
+        region, itemPosition(write, writeStep, sub.begin), sub.begin, sub.end);
+    CHECK_EQ(region.remaining(), 0);
+  };
+
+  // Packed integers are written as whole words, which may extend up to
+  // kPaddingBytes past the end of a sub-range's items or appended bytes, and
+  // past the last item into the first appended bytes. Neighboring sub-ranges
+  // are therefore frozen in separate waves, which keeps concurrent writes
+  // apart as long as every sub-range but the last appends enough bytes.
+  bool separated = true;
+  for (size_t k = 0; k + 1 < subRanges.size(); ++k) {
+    auto appended = subRanges[k].tailBytes;
+    if (tailBytes && appended < LayoutRoot::kPaddingBytes) {
+      separated = false;
+    }
+  }
+  if (!separated) {
+    for (auto k : all) {
+      freezeInPlace(k);
+    }
+    return;
+  }
+  std::vector<size_t> even, odd, last;
+  for (auto k : all) {
+    if (k + 1 == all.size() && k % 2 == 0) {
+      // the last items write into the first sub-range's appended bytes
+      last.push_back(k);
+    } else {
+      (k % 2 ? odd : even).push_back(k);
+    }
+  }
+  runConcurrently(executor_, even, freezeInPlace);
+  runConcurrently(executor_, odd, freezeInPlace);
+  runConcurrently(executor_, last, freezeInPlace);
+}
+
+namespace detail {
+
+struct MappedRegion {
+  ~MappedRegion() {
+    if (data) {
+      munmap(data, size);
+    }
+  }
+
+  byte* data{nullptr};
+  size_t size{0};
+  std::atomic<bool> cancelled{false};
+  std::atomic<size_t> prefaulted{0};
+};
+
+} // namespace detail
+
+namespace {
+
+// Background prefaulting checks for cancellation and reports progress between
+// chunks of this many bytes.
+constexpr size_t kPrefaultChunkBytes = size_t(16) << 20;
+
+size_t pageSize() {
+  static const size_t size = sysconf(_SC_PAGESIZE);
+  return size;
+}
+
+byte* mapFile(int fd, size_t size, const MapOptions& options) {
+  int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+  if (options.prefault == MapOptions::Prefault::POPULATE) {
+    flags |= MAP_POPULATE;
+  }
+#endif
+  if (!options.hugePages) {
+    void* addr = mmap(nullptr, size, PROT_READ, flags, fd, 0);
+    if (addr == MAP_FAILED) {
+      folly::throwSystemError("mmap failed");
+    }
+    return static_cast<byte*>(addr);
+  }
+
+  // Reserve enough address space to place the file at a huge page boundary,
+  // map it there, and release the rest.
+  size_t mappedSize = alignBy(size, pageSize());
+  size_t reservedSize = mappedSize + kHugePageSize;
+  void* reserved = mmap(
+      nullptr,
+      reservedSize,
+      PROT_NONE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+      -1,
+      0);
+  if (reserved == MAP_FAILED) {
+    folly::throwSystemError("mmap failed");
+  }
+  auto base = static_cast<byte*>(reserved);
+  auto aligned = reinterpret_cast<byte*>(
+      alignBy(reinterpret_cast<uintptr_t>(base), kHugePageSize));
+  void* addr = mmap(aligned, size, PROT_READ, flags | MAP_FIXED, fd, 0);
+  if (addr == MAP_FAILED) {
+    munmap(base, reservedSize);
+    folly::throwSystemError("mmap failed");
+  }
+  if (aligned != base) {
+    munmap(base, aligned - base);
+  }
+  auto end = aligned + mappedSize;
+  if (end != base + reservedSize) {
+    munmap(end, base + reservedSize - end);
+  }
+#ifdef MADV_HUGEPAGE
+  // only advice, the kernel may not support huge pages for this file
+  madvise(addr, size, MADV_HUGEPAGE);
+#endif
+  return static_cast<byte*>(addr);
+}
+
+bool lockPages(const void* addr, size_t size) {
+#if defined(__linux__) && defined(SYS_mlock2)
+  if (FLAGS_thrift_frozen_util_mlock_on_fault) {
+    constexpr int kMlockOnFault = 1; // MLOCK_ONFAULT, missing from old headers
+    return syscall(SYS_mlock2, addr, size, kMlockOnFault) == 0;
+  }
+#endif
+  return mlock(addr, size) == 0;
+}
+
+void touchPages(byte* data, size_t size) {
+#ifdef MADV_POPULATE_READ
+  if (madvise(data, size, MADV_POPULATE_READ) == 0) {
+    return;
+  }
+#endif
+  auto step = pageSize();
+  for (size_t i = 0; i < size; i += step) {
+    static_cast<void>(*static_cast<volatile byte*>(data + i));
+  }
+}
+
+void prefaultInBackground(
+    const std::shared_ptr<detail::MappedRegion>& region,
+    const MapOptions& options) {
+  if (!options.executor) {
+    throw std::invalid_argument("Background prefaulting requires an executor");
+  }
+  size_t tasks = std::max<size_t>(options.concurrency, 1);
+  size_t perTask = alignBy((region->size + tasks - 1) / tasks, pageSize());
+  for (size_t begin = 0; begin < region->size; begin += perTask) {
+    size_t end = std::min(region->size, begin + perTask);
+    // Tasks share ownership of the mapping, which outlives the view if they
+    // are still running when it is destroyed.
+    options.executor->add([region, progress = options.progress, begin, end] {
+      for (size_t chunk = begin; chunk < end; chunk += kPrefaultChunkBytes) {
+        if (region->cancelled.load(std::memory_order_relaxed)) {
+          return;
+        }
+        size_t chunkSize = std::min(end - chunk, kPrefaultChunkBytes);
+        touchPages(region->data + chunk, chunkSize);
+        size_t done = region->prefaulted += chunkSize;
+        if (progress) {
+          progress(done, region->size);
+        }
+      }
+    });
+  }
+}
+
+} // namespace
+
+namespace detail {
+
+FileMapping::FileMapping(folly::File file, const MapOptions& options)
+    : region_(std::make_shared<MappedRegion>()) {
+  struct stat st;
+  folly::checkUnixError(fstat(file.fd(), &st), "fstat failed");
+  if (st.st_size == 0) {
+    // nothing to map, mapFrozen() rejects the missing schema
+    return;
+  }
+  region_->size = st.st_size;
+  region_->data = mapFile(file.fd(), region_->size, options);
+  range_ = folly::ByteRange(region_->data, region_->size);
+
+  if (options.lock && !FLAGS_thrift_frozen_util_disable_mlock) {
+    if (!lockPages(region_->data, region_->size)) {
+      if (options.lockMode == folly::MemoryMapping::LockMode::MUST_LOCK) {
+        folly::throwSystemError("mlock failed");
+      }
+      PLOG(WARNING) << "mlock of " << region_->size << " bytes failed";
+    }
+  }
+
+  switch (options.prefault) {
+    case MapOptions::Prefault::NONE:
+    case MapOptions::Prefault::POPULATE:
+      break;
+    case MapOptions::Prefault::WILLNEED:
+      madvise(region_->data, region_->size, MADV_WILLNEED);
+      break;
+    case MapOptions::Prefault::BACKGROUND:
+      prefaultInBackground(region_, options);
+      break;
+  }
+}
+
+FileMapping::~FileMapping() {
+  if (region_) {
+    region_->cancelled = true;
+  }
+}
+
+} // namespace detail
+
+bool mlockFrozenRange(folly::ByteRange range) {
+  if (range.empty()) {
+    return true;
+  }
+  return lockPages(range.begin(), range.size());
+}
+
 } // namespace frozen
 } // namespace thrift
 } // namespace apache
@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <stdexcept>
 
+#include <folly/Executor.h>
 #include <folly/File.h>
 #include <folly/portability/GFlags.h>
 #include <folly/system/MemoryMapping.h>
@@ -95,6 +98,65 @@ class MallocFreezer final : public FreezeRoot {
   size_t size_{0};
 };
 
+/**
+ * A FreezeRoot that writes to a given ByteRange like ByteRangeFreezer, but
+ * freezes the items of large ranges concurrently on an executor.
+ *
+ * The items of such a range are split into sub-ranges, which are first frozen
+ * into scratch memory in parallel to measure the bytes each one appends. This
+ * places every sub-range's out-of-line data exactly where a serial freeze would
+ * put it, so sub-ranges can then be frozen in place concurrently and produce
+ * the same bytes as ByteRangeFreezer. Ranges holding shared references are
+ * frozen serially, since their items may refer to each other.
+ *
+ * Freezing blocks until all tasks finish, so it must not be called from a
+ * thread of 'executor'.
+ */
+class ParallelByteRangeFreezer final : public FreezeRoot {
+ public:
+  struct Options {
+    // Number of tasks to run concurrently, usually the executor's thread count.
+    size_t concurrency{1};
+    // Ranges with fewer items than this per task are frozen serially.
+    size_t minItemsPerTask{4096};
+  };
+
+  template <class T>
+  static typename Layout<T>::View freeze(
+      const Layout<T>& layout,
+      const T& root,
+      folly::MutableByteRange& write,
+      folly::Executor* executor,
+      const Options& options) {
+    ParallelByteRangeFreezer freezer(write, executor, options);
+    return freezer.doFreeze(layout, root);
+  }
+
+ private:
+  ParallelByteRangeFreezer(
+      folly::MutableByteRange& write,
+      folly::Executor* executor,
+      const Options& options)
+      : write_(write), executor_(executor), options_(options) {}
+
+  void doAppendBytes(
+      byte* origin,
+      size_t n,
+      folly::MutableByteRange& range,
+      size_t& distance,
+      size_t alignment) override;
+
+  void doFreezeItemRange(
+      FreezePosition write,
+      FieldPosition writeStep,
+      size_t count,
+      ItemRangeFreezer freezeItems) override;
+
+  folly::MutableByteRange& write_;
+  folly::Executor* executor_;
+  Options options_;
+};
+
 /**
  * Returns an upper bound estimate of the number of bytes required to freeze
  * this object with a minimal layout. Actual bytes required will depend on the
@@ -123,16 +185,45 @@ size_t frozenSize(const T& v, const Layout<T>& fixedLayout) {
   return size;
 }
 
+/**
+ * Files frozen with a data alignment of kHugePageSize can have their data
+ * mapped on transparent huge pages.
+ */
+constexpr size_t kHugePageSize = size_t(2) << 20;
+
+/**
+ * Options for freezeToFile().
+ */
+struct FreezeFileOptions {
+  // Places the frozen data at a multiple of this offset in the file by padding
+  // the schema before it. Padded files remain readable by older versions.
+  size_t dataAlignment{1};
+};
+
+namespace detail {
+
+/**
+ * Serializes 'schema' to 'out', padding it to a multiple of 'dataAlignment'
+ * bytes if needed.
+ */
+void serializeSchema(
+    schema::Schema& schema,
+    std::string& out,
+    size_t dataAlignment);
+
+} // namespace detail
+
 template <class T>
-void serializeRootLayout(const Layout<T>& layout, std::string& out) {
+void serializeRootLayout(
+    const Layout<T>& layout,
+    std::string& out,
+    size_t dataAlignment = 1) {
   schema::MemorySchema memSchema;
   schema::Schema schema;
   saveRoot(layout, memSchema);
   schema::convert(memSchema, schema);
 
-  schema.fileVersion = schema::frozen_constants::kCurrentFrozenFileVersion();
-  out.clear();
-  CompactSerializer::serialize(schema, &out);
+  detail::serializeSchema(schema, out, dataAlignment);
 }
 
 template <class T>
@@ -151,13 +242,19 @@ void deserializeRootLayout(folly::ByteRange& range, Layout<T>& layoutOut) {
   range.advance(schemaSize);
 }
 
-template <class T>
-void freezeToFile(const T& x, folly::File file) {
+namespace detail {
+
+template <class T, class Freeze>
+void freezeToFile(
+    const T& x,
+    folly::File file,
+    const FreezeFileOptions& options,
+    Freeze&& freeze) {
   std::string schemaStr;
   auto layout = std::make_unique<Layout<T>>();
   auto contentSize = LayoutRoot::layout(x, *layout);
 
-  serializeRootLayout(*layout, schemaStr);
+  serializeRootLayout(*layout, schemaStr, options.dataAlignment);
 
   size_t initialBufferSize = contentSize + schemaStr.size();
   folly::MemoryMapping mapping(
@@ -166,11 +263,52 @@ void freezeToFile(const T& x, folly::File file) {
   auto writeRange = mapping.writableRange();
   std::copy(schemaStr.begin(), schemaStr.end(), writeRange.begin());
   writeRange.advance(schemaStr.size());
-  ByteRangeFreezer::freeze(*layout, x, writeRange);
+  freeze(*layout, x, writeRange);
   size_t finalBufferSize = writeRange.begin() - mappingRange.begin();
   ftruncate(file.fd(), finalBufferSize);
 }
 
+} // namespace detail
+
+template <class T>
+void freezeToFile(
+    const T& x,
+    folly::File file,
+    const FreezeFileOptions& options = {}) {
+  detail::freezeToFile(
+      x,
+      std::move(file),
+      options,
+      [](const Layout<T>& layout,
+         const T& root,
+         folly::MutableByteRange& write) {
+        ByteRangeFreezer::freeze(layout, root, write);
+      });
+}
+
+/**
+ * Same as freezeToFile(x, file, fileOptions), but freezes large ranges
+ * concurrently on 'executor'. The file contents are identical.
+ */
+template <class T>
+void freezeToFile(
+    const T& x,
+    folly::File file,
+    folly::Executor* executor,
+    const ParallelByteRangeFreezer::Options& options,
+    const FreezeFileOptions& fileOptions = {}) {
+  detail::freezeToFile(
+      x,
+      std::move(file),
+      fileOptions,
+      [&](const Layout<T>& layout,
+          const T& root,
+          folly::MutableByteRange& write) {
+        ParallelByteRangeFreezer::freeze(
+            layout, root, write, executor, options);
+      });
+}
+
 template <class T>
 void freezeToString(const T& x, std::string& out) {
   out.clear();
@@ -230,6 +368,8 @@ void freezeToStringMalloc(const T& x, std::string& out) {
  *      in addition to the layout tree.
  *  - mapFrozen<T>(File): Owns the memory mapping created from the File (which,
  *      in turn, takes ownership of the File) in addition to the layout tree.
+ *  - mapFrozen<T>(File, MapOptions): Same as mapFrozen<T>(File), mapping and
+ *      prefaulting the file as configured.
  */
 template <class T>
 using MappedFrozen = Bundled<typename Layout<T>::View>;
@@ -303,6 +443,90 @@ MappedFrozen<T> mapFrozen(folly::File file) {
       std::move(file), folly::MemoryMapping::LockMode::TRY_LOCK);
 }
 
+/**
+ * Options for mapFrozen(File, MapOptions), which trade work at startup for the
+ * latency of the first lookups into a mapped file.
+ */
+struct MapOptions {
+  enum class Prefault {
+    // Pages are read in by the lookups first touching them.
+    NONE,
+    // Reads in the whole file before mapFrozen() returns (MAP_POPULATE).
+    POPULATE,
+    // Starts asynchronous readahead of the whole file (MADV_WILLNEED).
+    WILLNEED,
+    // Faults in the whole file from tasks on 'executor', which may still be
+    // running when mapFrozen() returns.
+    BACKGROUND,
+  };
+  Prefault prefault{Prefault::NONE};
+
+  // For Prefault::BACKGROUND, the file is split among 'concurrency' tasks on
+  // 'executor'. As chunks complete, 'progress' is called from those tasks with
+  // the number of bytes faulted in so far and the size of the file.
+  folly::Executor* executor{nullptr};
+  size_t concurrency{1};
+  std::function<void(size_t done, size_t total)> progress;
+
+  // Maps the file at a huge page aligned address and advises transparent huge
+  // pages for it (MADV_HUGEPAGE). Files frozen with a data alignment of
+  // kHugePageSize can then have all of their data on huge pages.
+  bool hugePages{false};
+
+  // Locks the whole file in memory, as mapFrozen(File) does. Hot parts of
+  // files too large to lock may be locked with mlockFrozenRange() instead.
+  bool lock{false};
+  folly::MemoryMapping::LockMode lockMode{
+      folly::MemoryMapping::LockMode::TRY_LOCK};
+};
+
+namespace detail {
+
+struct MappedRegion;
+
+/**
+ * A read-only mapping of a whole file, placed and prefaulted as configured by
+ * MapOptions. Stops background prefaulting when destroyed.
+ */
+class FileMapping {
+ public:
+  FileMapping(folly::File file, const MapOptions& options);
+  FileMapping(FileMapping&&) = default;
+  ~FileMapping();
+
+  folly::ByteRange range() const {
+    return range_;
+  }
+
+ private:
+  std::shared_ptr<MappedRegion> region_;
+  folly::ByteRange range_;
+};
+
+} // namespace detail
+
+template <class T>
+MappedFrozen<T> mapFrozen(folly::File file, const MapOptions& options) {
+  detail::FileMapping mapping(std::move(file), options);
+  auto ret = mapFrozen<T>(mapping.range());
+  ret.hold(std::move(mapping));
+  return ret;
+}
+
+/**
+ * Locks the pages holding 'range' of a mapped file in memory until the file is
+ * unmapped, for example the items of a hot VectorUnpacked field in a file too
+ * large to lock whole. Returns false if they couldn't be locked, for example
+ * due to RLIMIT_MEMLOCK.
+ */
+bool mlockFrozenRange(folly::ByteRange range);
+
+template <class T>
+bool mlockFrozenRange(folly::Range<const T*> range) {
+  return mlockFrozenRange(folly::ByteRange(
+      reinterpret_cast<const byte*>(range.begin()), range.size() * sizeof(T)));
+}
+
 } // namespace frozen
 } // namespace thrift
 } // namespace apache
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -45,7 +47,63 @@ class VectorUnpacked : public std::vector<T> {
       "Unpacked storage is only available for simple item types");
   using std::vector<T>::vector;
 };
+
+/*
+ * For representing hash maps and sets whose frozen lookups probe groups of 16
+ * slots at once by comparing 7-bit hash tags with SIMD instructions, like F14
+ * and SwissTable. Lookups of missing keys usually stop after a single group,
+ * which helps most with large tables. Frozen files containing these can't be
+ * read by versions older than kGroupedHashTableFileVersion.
+ *
+ * Use this in Thrift IDL like:
+ *
+ *   cpp_include "thrift/lib/cpp2/frozen/HintTypes.h"
+ *
+ *   struct MyStruct {
+ *     7: map<i64, string>
+ *        (cpp.template = "apache::thrift::frozen::GroupedHashMap")
+ *        names,
+ *   }
+ */
+template <class K, class V>
+class GroupedHashMap : public std::unordered_map<K, V> {
+  using std::unordered_map<K, V>::unordered_map;
+};
+
+template <class V>
+class GroupedHashSet : public std::unordered_set<V> {
+  using std::unordered_set<V>::unordered_set;
+};
+
+/*
+ * For representing lists of structs which are frozen column by column: each
+ * field of the struct is stored in its own array across all rows, with a
+ * bitmap of the rows having it if some don't. Scanning one field only touches
+ * that field's column, and arithmetic and enum columns can be viewed as plain
+ * contiguous ranges. Frozen files containing these can't be read by versions
+ * older than kColumnarListFileVersion.
+ *
+ * Use this in Thrift IDL like:
+ *
+ *   cpp_include "thrift/lib/cpp2/frozen/HintTypes.h"
+ *
+ *   struct MyStruct {
+ *     7: list<Row>
+ *        (cpp.template = "apache::thrift::frozen::VectorColumnar")
+ *        rows,
+ *   }
+ */
+template <class T>
+class VectorColumnar : public std::vector<T> {
+  using std::vector<T>::vector;
+};
 } // namespace frozen
 } // namespace thrift
 } // namespace apache
 THRIFT_DECLARE_TRAIT_TEMPLATE(IsString, apache::thrift::frozen::VectorUnpacked)
+THRIFT_DECLARE_TRAIT_TEMPLATE(
+    IsGroupedHashMap,
+    apache::thrift::frozen::GroupedHashMap)
+THRIFT_DECLARE_TRAIT_TEMPLATE(
+    IsGroupedHashSet,
+    apache::thrift::frozen::GroupedHashSet)
@@ -27,6 +27,10 @@ struct IsHashMap : std::false_type {};
 template <class>
 struct IsHashSet : std::false_type {};
 template <class>
+struct IsGroupedHashMap : std::false_type {};
+template <class>
+struct IsGroupedHashSet : std::false_type {};
+template <class>
 struct IsOrderedMap : std::false_type {};
 template <class>
 struct IsOrderedSet : std::false_type {};
@@ -63,6 +63,7 @@ void MemorySchema::initFromSchema(Schema&& schema) {
     }
   }
   setRootLayoutId(schema.rootLayout);
+  requireFileVersion(schema.fileVersion);
 }
 
 void convert(Schema&& schema, MemorySchema& memSchema) {
@@ -92,6 +93,7 @@ void convert(const MemorySchema& memSchema, Schema& schema) {
   //
   schema.relaxTypeChecks = true;
   schema.rootLayout = memSchema.getRootLayoutId();
+  schema.fileVersion = memSchema.getFileVersion();
 }
 
 } // namespace schema
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -216,6 +217,18 @@ class MemorySchema {
     return layouts;
   }
 
+  /**
+   * Raises the file version of this schema to at least 'version', for layouts
+   * which older readers would misinterpret.
+   */
+  inline void requireFileVersion(int32_t version) {
+    fileVersion = std::max(fileVersion, version);
+  }
+
+  inline int32_t getFileVersion() const {
+    return fileVersion;
+  }
+
   class Helper {
     // Add helper structures here to help minimize size of schema during
     // save() operations.
@@ -233,6 +246,8 @@ class MemorySchema {
  private:
   std::vector<MemoryLayout> layouts;
   int16_t rootLayout;
+  // Files using only the original layouts are version 1.
+  int32_t fileVersion{1};
 };
 
 struct SchemaInfo {
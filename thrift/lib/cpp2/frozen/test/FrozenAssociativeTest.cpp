@@ -386,3 +386,73 @@ TEST(FrozenMap, StructAsKey) {
 
   EXPECT_NO_THROW(freeze(userMap));
 }
+
+namespace {
+template <class Map>
+void testFindMany(size_t size) {
+  Map map;
+  for (size_t i = 0; i < size; ++i) {
+    map[i * 3] = i;
+  }
+  auto fmap = freeze(map);
+  // enough keys for several batches, hitting and missing in turn
+  std::vector<int> keys;
+  for (int k = -5; k < int(size * 3) + 5; ++k) {
+    keys.push_back(k);
+  }
+  std::vector<decltype(fmap.end())> found;
+  fmap.findMany(keys, std::back_inserter(found));
+  ASSERT_EQ(keys.size(), found.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(fmap.find(keys[i]), found[i]) << keys[i];
+  }
+}
+} // namespace
+
+TEST(FrozenMap, FindMany) {
+  for (size_t size : {0, 1, 2, 17, 100, 1000}) {
+    testFindMany<std::map<int, int>>(size);
+    testFindMany<std::unordered_map<int, int>>(size);
+    testFindMany<GroupedHashMap<int, int>>(size);
+  }
+}
+
+TEST(FrozenMap, LowerBoundMany) {
+  std::map<int, int> map;
+  for (int i = 0; i < 100; ++i) {
+    map[i * 3] = i;
+  }
+  auto fmap = freeze(map);
+  std::vector<int> keys;
+  for (int k = 400; k >= -5; --k) {
+    keys.push_back(k);
+  }
+  std::vector<decltype(fmap.end())> found(keys.size());
+  auto end = fmap.lowerBoundMany(keys, found.begin());
+  EXPECT_EQ(found.end(), end);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(fmap.lower_bound(keys[i]), found[i]) << keys[i];
+  }
+}
+
+TEST(FrozenHashSet, FindManyStrings) {
+  std::unordered_set<std::string> set;
+  for (int i = 0; i < 100; ++i) {
+    set.insert(folly::to<std::string>(i));
+  }
+  auto fset = freeze(set);
+  std::vector<std::string> strings;
+  for (int i = 50; i < 150; ++i) {
+    strings.push_back(folly::to<std::string>(i));
+  }
+  std::vector<folly::StringPiece> keys(strings.begin(), strings.end());
+  std::vector<decltype(fset.end())> found;
+  fset.findMany(keys, std::back_inserter(found));
+  ASSERT_EQ(keys.size(), found.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(i < 50, found[i] != fset.end()) << keys[i];
+    if (found[i] != fset.end()) {
+      EXPECT_EQ(keys[i], *found[i]);
+    }
+  }
+}
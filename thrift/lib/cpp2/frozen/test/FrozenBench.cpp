@@ -211,6 +211,228 @@ BENCHMARK_RELATIVE_PARAM(benchmarkLookup, frozenMap_i64)
 
 BENCHMARK_DRAW_LINE();
 
+template <class Map>
+const Bundled<typename Layout<Map>::View>& frozenEvenKeyMap(size_t entries) {
+  // built on first use since the largest tables take a while to build
+  static std::map<size_t, Bundled<typename Layout<Map>::View>> frozenMaps;
+  auto& frozenMap = frozenMaps[entries];
+  if (!frozenMap) {
+    Map map;
+    map.reserve(entries);
+    for (size_t i = 0; i < entries; ++i) {
+      map[i * 2] = i;
+    }
+    frozenMap = freeze(map);
+  }
+  return frozenMap;
+}
+
+template <class Map>
+void benchmarkSizedLookup(size_t iters, size_t entries, bool hit) {
+  folly::BenchmarkSuspender setup;
+  auto& map = frozenEvenKeyMap<Map>(entries);
+  std::vector<int64_t> keys(kChunkSize);
+  setup.dismiss();
+
+  int s = 0;
+  while (iters) {
+    setup.rehire();
+    for (auto& key : keys) {
+      key = folly::Random::rand64(entries) * 2 + (hit ? 0 : 1);
+    }
+    setup.dismiss();
+
+    for (size_t i = 0; i < keys.size() && iters; ++i, --iters) {
+      if (map.find(keys[i]) != map.end()) {
+        ++s;
+      }
+    }
+  }
+  folly::doNotOptimizeAway(s);
+}
+
+using HashTableMap = std::unordered_map<int64_t, int64_t>;
+using GroupedHashTableMap = GroupedHashMap<int64_t, int64_t>;
+
+void hashTableHit(size_t iters, size_t entries) {
+  benchmarkSizedLookup<HashTableMap>(iters, entries, true);
+}
+void groupedHashTableHit(size_t iters, size_t entries) {
+  benchmarkSizedLookup<GroupedHashTableMap>(iters, entries, true);
+}
+void hashTableMiss(size_t iters, size_t entries) {
+  benchmarkSizedLookup<HashTableMap>(iters, entries, false);
+}
+void groupedHashTableMiss(size_t iters, size_t entries) {
+  benchmarkSizedLookup<GroupedHashTableMap>(iters, entries, false);
+}
+
+BENCHMARK_NAMED_PARAM(hashTableHit, 1M, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(groupedHashTableHit, 1M, 1000000)
+BENCHMARK_NAMED_PARAM(hashTableMiss, 1M, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(groupedHashTableMiss, 1M, 1000000)
+BENCHMARK_NAMED_PARAM(hashTableHit, 10M, 10000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(groupedHashTableHit, 10M, 10000000)
+BENCHMARK_NAMED_PARAM(hashTableMiss, 10M, 10000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(groupedHashTableMiss, 10M, 10000000)
+BENCHMARK_NAMED_PARAM(hashTableHit, 100M, 100000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(groupedHashTableHit, 100M, 100000000)
+BENCHMARK_NAMED_PARAM(hashTableMiss, 100M, 100000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(groupedHashTableMiss, 100M, 100000000)
+
+BENCHMARK_DRAW_LINE();
+
+template <class Map>
+void benchmarkSizedFindMany(size_t iters, size_t entries, bool hit) {
+  folly::BenchmarkSuspender setup;
+  auto& map = frozenEvenKeyMap<Map>(entries);
+  std::vector<int64_t> keys(kChunkSize);
+  std::vector<decltype(map.end())> found(kChunkSize);
+  setup.dismiss();
+
+  int s = 0;
+  while (iters) {
+    setup.rehire();
+    for (auto& key : keys) {
+      key = folly::Random::rand64(entries) * 2 + (hit ? 0 : 1);
+    }
+    setup.dismiss();
+
+    auto n = std::min(iters, keys.size());
+    map.findMany(folly::range(keys.data(), keys.data() + n), found.begin());
+    for (size_t i = 0; i < n; ++i) {
+      if (found[i] != map.end()) {
+        ++s;
+      }
+    }
+    iters -= n;
+  }
+  folly::doNotOptimizeAway(s);
+}
+
+using SortedTableMap = folly::sorted_vector_map<int64_t, int64_t>;
+
+void hashTableFindManyHit(size_t iters, size_t entries) {
+  benchmarkSizedFindMany<HashTableMap>(iters, entries, true);
+}
+void hashTableFindManyMiss(size_t iters, size_t entries) {
+  benchmarkSizedFindMany<HashTableMap>(iters, entries, false);
+}
+void groupedHashTableFindManyHit(size_t iters, size_t entries) {
+  benchmarkSizedFindMany<GroupedHashTableMap>(iters, entries, true);
+}
+void sortedTableHit(size_t iters, size_t entries) {
+  benchmarkSizedLookup<SortedTableMap>(iters, entries, true);
+}
+void sortedTableFindManyHit(size_t iters, size_t entries) {
+  benchmarkSizedFindMany<SortedTableMap>(iters, entries, true);
+}
+
+BENCHMARK_NAMED_PARAM(hashTableHit, 1M_find, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(hashTableFindManyHit, 1M, 1000000)
+BENCHMARK_NAMED_PARAM(hashTableMiss, 1M_find, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(hashTableFindManyMiss, 1M, 1000000)
+BENCHMARK_NAMED_PARAM(groupedHashTableHit, 1M_find, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(groupedHashTableFindManyHit, 1M, 1000000)
+BENCHMARK_NAMED_PARAM(sortedTableHit, 1M, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(sortedTableFindManyHit, 1M, 1000000)
+BENCHMARK_NAMED_PARAM(hashTableHit, 10M_find, 10000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(hashTableFindManyHit, 10M, 10000000)
+BENCHMARK_NAMED_PARAM(hashTableMiss, 10M_find, 10000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(hashTableFindManyMiss, 10M, 10000000)
+BENCHMARK_NAMED_PARAM(groupedHashTableHit, 10M_find, 10000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(groupedHashTableFindManyHit, 10M, 10000000)
+BENCHMARK_NAMED_PARAM(sortedTableHit, 10M, 10000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(sortedTableFindManyHit, 10M, 10000000)
+BENCHMARK_NAMED_PARAM(hashTableHit, 100M_find, 100000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(hashTableFindManyHit, 100M, 100000000)
+BENCHMARK_NAMED_PARAM(hashTableMiss, 100M_find, 100000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(hashTableFindManyMiss, 100M, 100000000)
+BENCHMARK_NAMED_PARAM(groupedHashTableHit, 100M_find, 100000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(groupedHashTableFindManyHit, 100M, 100000000)
+
+BENCHMARK_DRAW_LINE();
+
+using apache::thrift::test::Person1;
+
+constexpr size_t kScanRows = 1000000;
+
+template <class People>
+const Bundled<typename Layout<People>::View>& frozenPeople() {
+  static auto frozenPeople = [] {
+    People people(kScanRows);
+    for (auto& person : people) {
+      person.height = folly::Random::randDouble01();
+      if (folly::Random::oneIn(3)) {
+        person.age_ref() = folly::Random::rand32(100);
+      }
+    }
+    return freeze(people);
+  }();
+  return frozenPeople;
+}
+
+BENCHMARK(scanRows, iters) {
+  folly::BenchmarkSuspender setup;
+  auto& people = frozenPeople<std::vector<Person1>>();
+  setup.dismiss();
+
+  float s = 0;
+  while (iters--) {
+    for (auto person : people) {
+      s += person.height();
+    }
+  }
+  folly::doNotOptimizeAway(s);
+}
+
+BENCHMARK_RELATIVE(scanColumn, iters) {
+  folly::BenchmarkSuspender setup;
+  auto& people = frozenPeople<VectorColumnar<Person1>>();
+  setup.dismiss();
+
+  float s = 0;
+  while (iters--) {
+    for (auto height : people.column<float>(2).values()) {
+      s += height;
+    }
+  }
+  folly::doNotOptimizeAway(s);
+}
+
+BENCHMARK(scanOptionalRows, iters) {
+  folly::BenchmarkSuspender setup;
+  auto& people = frozenPeople<std::vector<Person1>>();
+  setup.dismiss();
+
+  int64_t s = 0;
+  while (iters--) {
+    for (auto person : people) {
+      if (auto age = person.age()) {
+        s += *age;
+      }
+    }
+  }
+  folly::doNotOptimizeAway(s);
+}
+
+BENCHMARK_RELATIVE(scanOptionalColumn, iters) {
+  folly::BenchmarkSuspender setup;
+  auto& people = frozenPeople<VectorColumnar<Person1>>();
+  setup.dismiss();
+
+  int64_t s = 0;
+  while (iters--) {
+    // ages of rows without one are zero, so the bitmap can be ignored
+    for (auto age : people.column<int32_t>(5).values()) {
+      s += age;
+    }
+  }
+  folly::doNotOptimizeAway(s);
+}
+
+BENCHMARK_DRAW_LINE();
+
 template <class T>
 void benchmarkOldFreezeDataToString(size_t iters, const T& data) {
   const auto layout = maximumLayout<T>();
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/Conv.h>
 #include <folly/portability/GTest.h>
 
 #include <thrift/lib/cpp2/frozen/FrozenTestUtil.h>
+#include <thrift/lib/cpp2/frozen/FrozenUtil.h>
 #include <thrift/lib/cpp2/frozen/HintTypes.h>
 
 namespace apache {
@@ -33,6 +35,73 @@ TEST(FrozenVectorTypes, Unpacked) {
   const int* raw = fiu.begin();
   EXPECT_EQ(raw[3], 7);
 }
+
+TEST(FrozenHashTypes, GroupedHashMap) {
+  GroupedHashMap<int64_t, std::string> map;
+  for (int64_t i = 0; i < 10000; ++i) {
+    map[i * 2] = folly::to<std::string>(i);
+  }
+  auto fmap = freeze(map);
+  EXPECT_EQ(fmap.size(), 10000);
+  for (int64_t i = 0; i < 10000; ++i) {
+    EXPECT_EQ(fmap.at(i * 2), folly::to<std::string>(i));
+    EXPECT_EQ(fmap.count(i * 2 + 1), 0);
+  }
+  EXPECT_THROW(fmap.at(-1), std::out_of_range);
+  EXPECT_EQ(map, fmap.thaw());
+}
+
+TEST(FrozenHashTypes, GroupedHashSet) {
+  GroupedHashSet<std::string> set{"one", "two", "three"};
+  auto fset = freeze(set);
+  EXPECT_EQ(fset.count("two"), 1);
+  EXPECT_EQ(fset.count("four"), 0);
+  EXPECT_EQ(freeze(GroupedHashSet<std::string>()).count("one"), 0);
+  EXPECT_EQ(set, fset.thaw());
+}
+
+TEST(FrozenHashTypes, GroupedHashTableCollisions) {
+  // integer keys hash to themselves, so all of these share their low bits
+  GroupedHashSet<int64_t> set;
+  for (int64_t i = 0; i < 1000; ++i) {
+    set.insert(i << 20);
+  }
+  auto fset = freeze(set);
+  for (int64_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(fset.count(i << 20), 1);
+    EXPECT_EQ(fset.count((i << 20) + 1), 0);
+  }
+}
+
+TEST(FrozenHashTypes, GroupedHashTableFileVersion) {
+  GroupedHashMap<int, int> grouped{{1, 2}, {3, 4}};
+  std::unordered_map<int, int> plain{{1, 2}, {3, 4}};
+
+  std::string groupedLayout, plainLayout;
+  Layout<decltype(grouped)> layout;
+  LayoutRoot::layout(grouped, layout);
+  serializeRootLayout(layout, groupedLayout);
+  Layout<decltype(plain)> layout2;
+  LayoutRoot::layout(plain, layout2);
+  serializeRootLayout(layout2, plainLayout);
+
+  schema::Schema groupedSchema, plainSchema;
+  CompactSerializer::deserialize(groupedLayout, groupedSchema);
+  EXPECT_EQ(
+      schema::frozen_constants::kGroupedHashTableFileVersion(),
+      groupedSchema.fileVersion);
+  CompactSerializer::deserialize(plainLayout, plainSchema);
+  EXPECT_EQ(1, plainSchema.fileVersion);
+
+  // neither layout can be read as the other
+  auto str = freezeToString(grouped);
+  EXPECT_EQ(mapFrozen<decltype(grouped)>(std::string(str)).at(3), 4);
+  EXPECT_THROW(
+      mapFrozen<decltype(plain)>(std::move(str)), LayoutTypeMismatchException);
+  EXPECT_THROW(
+      mapFrozen<decltype(grouped)>(freezeToString(plain)),
+      LayoutTypeMismatchException);
+}
 } // namespace frozen
 } // namespace thrift
 } // namespace apache
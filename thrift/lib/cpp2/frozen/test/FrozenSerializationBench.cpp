@@ -15,6 +15,11 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/experimental/TestUtil.h>
+#include <folly/portability/Fcntl.h>
 #include <thrift/lib/cpp2/frozen/FrozenUtil.h>
 #include <thrift/lib/cpp2/frozen/test/gen-cpp2/Example_layouts.h>
 #include <thrift/lib/cpp2/frozen/test/gen-cpp2/Example_types.h>
@@ -110,6 +115,116 @@ BENCHMARK_RELATIVE(FrozenThaw, iters) {
   folly::doNotOptimizeAway(s);
 }
 
+using BigMap = std::unordered_map<int64_t, std::string>;
+
+BigMap bigMap = [] {
+  BigMap m;
+  for (int64_t i = 0; i < 1000000; ++i) {
+    m[i * 31] = folly::to<std::string>(i);
+  }
+  return m;
+}();
+
+void freezeBigMap(size_t iters, size_t threads) {
+  size_t s = 0;
+  folly::BenchmarkSuspender setup;
+  Layout<BigMap> layout;
+  std::vector<byte> buffer(LayoutRoot::layout(bigMap, layout));
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+  ParallelByteRangeFreezer::Options options;
+  if (threads) {
+    executor = std::make_unique<folly::CPUThreadPoolExecutor>(threads);
+    options.concurrency = threads;
+  }
+  setup.dismiss();
+  while (iters--) {
+    auto write = folly::MutableByteRange(buffer.data(), buffer.size());
+    if (executor) {
+      ParallelByteRangeFreezer::freeze(
+          layout, bigMap, write, executor.get(), options);
+    } else {
+      ByteRangeFreezer::freeze(layout, bigMap, write);
+    }
+    s += buffer.size() - write.size();
+  }
+  folly::doNotOptimizeAway(s);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_PARAM(freezeBigMap, 0)
+BENCHMARK_RELATIVE_PARAM(freezeBigMap, 1)
+BENCHMARK_RELATIVE_PARAM(freezeBigMap, 2)
+BENCHMARK_RELATIVE_PARAM(freezeBigMap, 4)
+BENCHMARK_RELATIVE_PARAM(freezeBigMap, 8)
+BENCHMARK_RELATIVE_PARAM(freezeBigMap, 16)
+
+const folly::test::TemporaryFile& bigMapFile() {
+  static folly::test::TemporaryFile file = [] {
+    folly::test::TemporaryFile tmp;
+    FreezeFileOptions options;
+    options.dataAlignment = kHugePageSize;
+    freezeToFile(bigMap, folly::File(tmp.fd()), options);
+    return tmp;
+  }();
+  return file;
+}
+
+// Time from mapping a file with a cold page cache to completing its first
+// lookups.
+void mapAndLookup(size_t iters, MapOptions::Prefault prefault, bool hugePages) {
+  size_t s = 0;
+  folly::BenchmarkSuspender setup;
+  auto& file = bigMapFile();
+  folly::CPUThreadPoolExecutor executor(8);
+  MapOptions options;
+  options.prefault = prefault;
+  options.hugePages = hugePages;
+  options.executor = &executor;
+  options.concurrency = 8;
+  setup.dismiss();
+  while (iters--) {
+    {
+      folly::BenchmarkSuspender evict;
+      posix_fadvise(file.fd(), 0, 0, POSIX_FADV_DONTNEED);
+    }
+    auto mapped = mapFrozen<BigMap>(folly::File(file.fd()), options);
+    for (int64_t i = 0; i < 1000; ++i) {
+      s += mapped.at(31 * folly::Random::rand32(1000000)).size();
+    }
+  }
+  folly::doNotOptimizeAway(s);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(mapAndLookup, Fault, MapOptions::Prefault::NONE, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    mapAndLookup,
+    Populate,
+    MapOptions::Prefault::POPULATE,
+    false)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    mapAndLookup,
+    WillNeed,
+    MapOptions::Prefault::WILLNEED,
+    false)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    mapAndLookup,
+    Background,
+    MapOptions::Prefault::BACKGROUND,
+    false)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    mapAndLookup,
+    HugePages,
+    MapOptions::Prefault::NONE,
+    true)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    mapAndLookup,
+    HugePagesPopulate,
+    MapOptions::Prefault::POPULATE,
+    true)
+
 #if 0
 ============================================================================
                                                 relative  time/iter  iters/s
@@ -528,3 +528,98 @@ TEST(Frozen, Bundled) {
   EXPECT_EQ(47, *s.findFirstOfType<int>());
   EXPECT_EQ(nullptr, s.findFirstOfType<std::string>());
 }
+
+VectorColumnar<Person1> makePeople(size_t n) {
+  VectorColumnar<Person1> people(n);
+  for (size_t i = 0; i < n; ++i) {
+    auto& person = people[i];
+    person.name = folly::to<std::string>("person", i);
+    person.height = 1.5f + (i % 50) / 100.0f;
+    if (i % 3) {
+      person.age_ref() = i % 90;
+    }
+    person.gender = static_cast<Gender>(i % 3);
+    if (i % 10 == 0) {
+      Pet1 pet;
+      pet.name = folly::to<std::string>("pet", i);
+      pet.vegan_ref() = i % 20 == 0;
+      person.pets.push_back(pet);
+    }
+  }
+  return people;
+}
+
+TEST(FrozenColumnar, RoundTrip) {
+  for (size_t n : {0, 1, 1000}) {
+    auto people = makePeople(n);
+    auto fpeople = freeze(people);
+    EXPECT_EQ(n, fpeople.size());
+    EXPECT_EQ(people, fpeople.thaw());
+
+    // rows read the same as from the row-wise layout
+    std::vector<Person1> rows(people.begin(), people.end());
+    auto frows = freeze(rows);
+    size_t i = 0;
+    for (auto row : fpeople) {
+      EXPECT_EQ(i, row.index());
+      EXPECT_EQ(frows[i].thaw(), row.thaw());
+      ++i;
+    }
+    EXPECT_EQ(n, i);
+
+    auto mapped =
+        mapFrozen<VectorColumnar<Person1>>(freezeToString(people));
+    EXPECT_EQ(people, mapped.thaw());
+  }
+}
+
+TEST(FrozenColumnar, Columns) {
+  auto people = makePeople(1000);
+  auto fpeople = freeze(people);
+
+  folly::Range<const float*> heights = fpeople.column<float>(2).values();
+  ASSERT_EQ(people.size(), heights.size());
+  folly::Range<const Gender*> genders = fpeople.column<Gender>(6).values();
+  ASSERT_EQ(people.size(), genders.size());
+  auto names = fpeople.column<std::string>(1);
+  EXPECT_TRUE(names.present().empty());
+  auto ages = fpeople.column<int32_t>(5);
+  EXPECT_FALSE(ages.present().empty());
+
+  for (size_t i = 0; i < people.size(); ++i) {
+    EXPECT_EQ(people[i].height, heights[i]);
+    EXPECT_EQ(people[i].gender, genders[i]);
+    EXPECT_EQ(people[i].name, names[i]);
+    EXPECT_EQ(people[i].age_ref().has_value(), ages.isPresent(i));
+    EXPECT_EQ(people[i].age_ref().value_or(0), ages[i]);
+    EXPECT_EQ(people[i].pets, fpeople.column<std::vector<Pet1>>(4).thawRow(i));
+  }
+
+  auto row = fpeople[4];
+  EXPECT_EQ("person4", row.get<std::string>(1));
+  EXPECT_TRUE(row.has<int32_t>(5));
+  EXPECT_FALSE(fpeople[3].has<int32_t>(5));
+
+  EXPECT_THROW(fpeople.column<int64_t>(5), std::invalid_argument);
+  EXPECT_THROW(fpeople.column<int32_t>(99), std::out_of_range);
+}
+
+TEST(FrozenColumnar, FileVersion) {
+  auto people = makePeople(3);
+  std::vector<Person1> rows(people.begin(), people.end());
+
+  std::string columnarLayout;
+  Layout<VectorColumnar<Person1>> layout;
+  LayoutRoot::layout(people, layout);
+  serializeRootLayout(layout, columnarLayout);
+  schema::Schema schema;
+  CompactSerializer::deserialize(columnarLayout, schema);
+  EXPECT_EQ(
+      schema::frozen_constants::kColumnarListFileVersion(),
+      schema.fileVersion);
+
+  // plain lists of structs can't be read as columns
+  EXPECT_THROW(
+      mapFrozen<VectorColumnar<Person1>>(freezeToString(rows)),
+      LayoutTypeMismatchException);
+}
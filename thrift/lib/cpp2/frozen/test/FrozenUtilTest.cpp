@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 
+#include <atomic>
+
+#include <folly/FileUtil.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/portability/GTest.h>
 
 #include <thrift/lib/cpp2/frozen/FrozenTestUtil.h>
@@ -75,6 +79,107 @@ TEST(FrozenUtil, FileSize) {
   EXPECT_LT(stats.st_size, 500); // most of this is the schema
 }
 
+TEST(FrozenUtil, DataAlignment) {
+  auto original = std::vector<std::string>{"hello", "world"};
+  folly::test::TemporaryFile plain;
+  freezeToFile(original, folly::File(plain.fd()));
+  std::string plainBytes;
+  folly::readFile(plain.path().c_str(), plainBytes);
+
+  for (size_t alignment : {size_t(4096), kHugePageSize}) {
+    folly::test::TemporaryFile tmp;
+    FreezeFileOptions options;
+    options.dataAlignment = alignment;
+    freezeToFile(original, folly::File(tmp.fd()), options);
+
+    std::string bytes;
+    folly::readFile(tmp.path().c_str(), bytes);
+    folly::ByteRange range = folly::StringPiece(bytes);
+    Layout<std::vector<std::string>> layout;
+    deserializeRootLayout(range, layout);
+    size_t schemaSize = bytes.size() - range.size();
+    EXPECT_EQ(0, schemaSize % alignment);
+
+    // only the schema differs
+    folly::ByteRange plainRange = folly::StringPiece(plainBytes);
+    Layout<std::vector<std::string>> plainLayout;
+    deserializeRootLayout(plainRange, plainLayout);
+    EXPECT_EQ(plainRange, range);
+
+    auto mapped = mapFrozen<std::vector<std::string>>(folly::File(tmp.fd()));
+    EXPECT_EQ(original, mapped.thaw());
+  }
+}
+
+TEST(FrozenUtil, MapOptions) {
+  std::unordered_map<int, std::string> original;
+  for (int i = 0; i < 10000; ++i) {
+    original[i] = std::to_string(i * i);
+  }
+  folly::test::TemporaryFile tmp;
+  FreezeFileOptions fileOptions;
+  fileOptions.dataAlignment = kHugePageSize;
+  freezeToFile(original, folly::File(tmp.fd()), fileOptions);
+
+  for (auto prefault :
+       {MapOptions::Prefault::NONE,
+        MapOptions::Prefault::POPULATE,
+        MapOptions::Prefault::WILLNEED}) {
+    for (bool hugePages : {false, true}) {
+      MapOptions options;
+      options.prefault = prefault;
+      options.hugePages = hugePages;
+      auto mapped =
+          mapFrozen<decltype(original)>(folly::File(tmp.fd()), options);
+      EXPECT_EQ(mapped.at(300), "90000");
+      EXPECT_EQ(original, mapped.thaw());
+    }
+  }
+}
+
+TEST(FrozenUtil, BackgroundPrefault) {
+  std::unordered_map<int, std::string> original;
+  for (int i = 0; i < 100000; ++i) {
+    original[i] = std::to_string(i * i);
+  }
+  folly::test::TemporaryFile tmp;
+  freezeToFile(original, folly::File(tmp.fd()));
+  struct stat stats;
+  fstat(tmp.fd(), &stats);
+
+  folly::CPUThreadPoolExecutor executor(4);
+  std::atomic<size_t> reported{0};
+  std::atomic<size_t> total{0};
+  MapOptions options;
+  options.prefault = MapOptions::Prefault::BACKGROUND;
+  options.executor = &executor;
+  options.concurrency = 4;
+  options.progress = [&](size_t done, size_t size) {
+    size_t last = reported.load();
+    while (last < done && !reported.compare_exchange_weak(last, done)) {
+    }
+    total = size;
+  };
+  auto mapped = mapFrozen<decltype(original)>(folly::File(tmp.fd()), options);
+  EXPECT_EQ(mapped.at(300), "90000");
+  executor.join();
+  EXPECT_EQ(size_t(stats.st_size), total.load());
+  EXPECT_EQ(size_t(stats.st_size), reported.load());
+
+  options.executor = nullptr;
+  EXPECT_THROW(
+      mapFrozen<decltype(original)>(folly::File(tmp.fd()), options),
+      std::invalid_argument);
+}
+
+TEST(FrozenUtil, MlockFrozenRange) {
+  auto file = freezeToTempFile(std::string("hello"));
+  auto mapped = mapFrozen<std::string>(folly::File(file.fd()), MapOptions());
+  EXPECT_EQ(folly::StringPiece(mapped), "hello");
+  EXPECT_TRUE(mlockFrozenRange(folly::StringPiece(mapped)));
+  EXPECT_TRUE(mlockFrozenRange(folly::ByteRange()));
+}
+
 TEST(FrozenUtil, FreezeToString) {
   // multiplication tables for first three primes
   using TestType = std::map<int, std::map<int, int>>;
@@ -190,3 +295,70 @@ TEST(Frozen, FreezeDataToString) {
   EXPECT_EQ(view[1], "123");
   EXPECT_EQ(view[2], "xyz");
 }
+
+namespace {
+template <class T>
+void expectParallelFreezeIdentical(const T& value) {
+  Layout<T> layout;
+  size_t size = LayoutRoot::layout(value, layout);
+  std::vector<byte> serial(size), parallel(size);
+  folly::MutableByteRange serialWrite(serial.data(), size);
+  ByteRangeFreezer::freeze(layout, value, serialWrite);
+
+  folly::CPUThreadPoolExecutor executor(4);
+  ParallelByteRangeFreezer::Options options;
+  options.concurrency = 4;
+  options.minItemsPerTask = 64;
+  folly::MutableByteRange parallelWrite(parallel.data(), size);
+  auto view = ParallelByteRangeFreezer::freeze(
+      layout, value, parallelWrite, &executor, options);
+
+  EXPECT_EQ(serialWrite.size(), parallelWrite.size());
+  EXPECT_TRUE(serial == parallel);
+  EXPECT_EQ(value, view.thaw());
+}
+} // namespace
+
+TEST(Frozen, ParallelFreezeVector) {
+  std::vector<std::string> strings;
+  std::vector<std::vector<double>> doubles;
+  for (int i = 0; i < 10000; ++i) {
+    strings.push_back(std::string(i % 13, 'a' + i % 26));
+    doubles.push_back(std::vector<double>(i % 3, i * 0.5));
+  }
+  expectParallelFreezeIdentical(strings);
+  expectParallelFreezeIdentical(doubles);
+  expectParallelFreezeIdentical(std::vector<int>(10000, 7));
+}
+
+TEST(Frozen, ParallelFreezeTables) {
+  std::map<int, std::string> sorted;
+  std::unordered_map<int64_t, std::vector<int>> hashed;
+  for (int i = 0; i < 10000; ++i) {
+    sorted[i * 7] = std::to_string(i);
+    hashed[i * 11] = std::vector<int>(i % 5, i);
+  }
+  expectParallelFreezeIdentical(sorted);
+  expectParallelFreezeIdentical(hashed);
+}
+
+TEST(Frozen, ParallelFreezeToFile) {
+  std::unordered_map<int, std::string> original;
+  for (int i = 0; i < 100000; ++i) {
+    original[i] = std::to_string(i * i);
+  }
+  folly::test::TemporaryFile serial, parallel;
+  freezeToFile(original, folly::File(serial.fd()));
+  folly::CPUThreadPoolExecutor executor(8);
+  ParallelByteRangeFreezer::Options options;
+  options.concurrency = 8;
+  freezeToFile(original, folly::File(parallel.fd()), &executor, options);
+
+  std::string serialBytes, parallelBytes;
+  folly::readFile(serial.path().c_str(), serialBytes);
+  folly::readFile(parallel.path().c_str(), parallelBytes);
+  EXPECT_EQ(serialBytes, parallelBytes);
+
+  auto mapped = mapFrozen<decltype(original)>(folly::File(parallel.fd()));
+  EXPECT_EQ(mapped.at(300), "90000");
+}
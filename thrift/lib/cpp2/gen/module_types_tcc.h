@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <folly/CPortability.h>
 #include <folly/Range.h>
 
 #include <thrift/lib/cpp/protocol/TType.h>
@@ -43,6 +44,56 @@ namespace detail {
 template <typename T>
 struct TccStructTraits;
 
+/**
+ * Generated readers of structs with many fields look up fields which don't
+ * arrive in the expected order in a table of their ids, at the slot given by a
+ * perfect hash of the ids found by the compiler. Switching on the slot rather
+ * than the id gives a dense jump table however sparse the ids are.
+ */
+constexpr size_t fieldDispatchHash(
+    int16_t id,
+    uint32_t mult,
+    uint32_t shift,
+    uint32_t mask) {
+  return ((uint32_t(uint16_t(id)) * mult) >> shift) & mask;
+}
+
+// Returns the slot of field 'id' in 'ids', or N if it's not one of them.
+template <size_t N>
+FOLLY_ALWAYS_INLINE size_t fieldDispatchSlot(
+    const int32_t (&ids)[N],
+    int16_t id,
+    uint32_t mult,
+    uint32_t shift,
+    uint32_t mask) {
+  auto slot = fieldDispatchHash(id, mult, shift, mask);
+  return ids[slot] == id ? slot : N;
+}
+
+/**
+ * Fused fast path of generated readers for structs whose fields are all fixed
+ * size scalars. In protocols where such structs are encoded at fixed offsets
+ * when all their fields are set, match() checks all their field headers at
+ * once, so that the reader can then read the values skipping the headers.
+ *
+ * 'layout' is the encoding of the struct with the bytes of values zeroed and
+ * 'mask' has 0xff for each byte of 'layout' which must match.
+ *
+ * Readers test kSupported before calling match(), so that protocols without
+ * a specialization skip the fast path at compile time.
+ */
+template <class Protocol>
+struct FixedStructLayout {
+  static constexpr bool kSupported = false;
+
+  template <size_t N>
+  static bool match(Protocol*, const uint8_t (&)[N], const uint8_t (&)[N]) {
+    return false;
+  }
+  static void skipFieldHeader(Protocol*) {}
+  static void skipStop(Protocol*) {}
+};
+
 } // namespace detail
 
 } // namespace thrift
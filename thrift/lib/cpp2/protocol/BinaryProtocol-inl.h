@@ -638,6 +638,31 @@ bool BinaryProtocolReader::advanceToNextField(
   return false;
 }
 
+bool BinaryProtocolReader::matchFixedLayout(
+    const uint8_t* layout,
+    const uint8_t* mask,
+    size_t size) {
+  // only when the whole struct is in the current buffer
+  if (in_.length() < size) {
+    return false;
+  }
+  const uint8_t* data = in_.data();
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    auto diff = folly::loadUnaligned<uint64_t>(data + i) ^
+        folly::loadUnaligned<uint64_t>(layout + i);
+    if (diff & folly::loadUnaligned<uint64_t>(mask + i)) {
+      return false;
+    }
+  }
+  for (; i < size; ++i) {
+    if ((data[i] ^ layout[i]) & mask[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void BinaryProtocolReader::readFieldBeginWithState(StructReadState& state) {
   int8_t type;
   readByte(type);
@@ -39,6 +39,11 @@ using folly::io::QueueAppender;
 
 class BinaryProtocolReader;
 
+namespace detail {
+template <class Protocol>
+struct FixedStructLayout;
+} // namespace detail
+
 /**
  * The default binary protocol for thrift. Writes all data in a very basic
  * binary format, essentially just spitting out the raw bytes.
@@ -358,6 +363,9 @@ class BinaryProtocolReader {
 
   inline void readFieldBeginWithState(StructReadState& state);
 
+  FOLLY_ALWAYS_INLINE bool
+  matchFixedLayout(const uint8_t* layout, const uint8_t* mask, size_t size);
+
   inline void checkStringSize(int32_t size);
   inline void checkContainerSize(int32_t size);
 
@@ -380,6 +388,8 @@ class BinaryProtocolReader {
   template <typename T>
   friend class ProtocolReaderWithRefill;
   friend class BinaryProtocolReaderWithRefill;
+  template <class Protocol>
+  friend struct detail::FixedStructLayout;
 
  private:
   inline bool readBoolSafe();
@@ -394,6 +404,29 @@ template <>
 struct ProtocolReaderStructReadState<BinaryProtocolReader>
     : BinaryProtocolReader::StructReadState {};
 
+template <>
+struct FixedStructLayout<BinaryProtocolReader> {
+  static constexpr bool kSupported = true;
+  // type and id
+  static constexpr size_t kFieldHeaderBytes = 3;
+
+  template <size_t N>
+  FOLLY_ALWAYS_INLINE static bool match(
+      BinaryProtocolReader* iprot,
+      const uint8_t (&layout)[N],
+      const uint8_t (&mask)[N]) {
+    return iprot->matchFixedLayout(layout, mask, N);
+  }
+
+  FOLLY_ALWAYS_INLINE static void skipFieldHeader(BinaryProtocolReader* iprot) {
+    iprot->in_.skipNoAdvance(kFieldHeaderBytes);
+  }
+
+  FOLLY_ALWAYS_INLINE static void skipStop(BinaryProtocolReader* iprot) {
+    iprot->in_.skipNoAdvance(1);
+  }
+};
+
 } // namespace detail
 } // namespace thrift
 } // namespace apache
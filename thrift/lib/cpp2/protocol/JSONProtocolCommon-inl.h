@@ -301,8 +301,20 @@ uint32_t JSONProtocolWriterCommon::writeJSONString(folly::StringPiece str) {
   uint32_t ret = 2;
 
   out_.write(detail::json::kJSONStringDelimiter);
-  for (auto c : str) {
-    ret += writeJSONChar(c);
+  auto cur = reinterpret_cast<const uint8_t*>(str.begin());
+  auto end = reinterpret_cast<const uint8_t*>(str.end());
+  while (true) {
+    // Characters up to the next one to escape are copied at once
+    auto special = detail::json::findSpecialChar<true>(cur, end);
+    if (special != cur) {
+      out_.push(cur, special - cur);
+      ret += folly::to_narrow(special - cur);
+    }
+    if (special == end) {
+      break;
+    }
+    ret += writeJSONChar(*special);
+    cur = special + 1;
   }
   out_.write(detail::json::kJSONStringDelimiter);
 
@@ -730,6 +742,21 @@ void JSONProtocolReaderCommon::readJSONString(StrType& val) {
   std::string json = "\"";
   val.clear();
   while (true) {
+    // Characters up to the next delimiter or backslash are copied at once
+    for (auto peek = in_.peekBytes(); !peek.empty(); peek = in_.peekBytes()) {
+      auto special =
+          detail::json::findSpecialChar<false>(peek.begin(), peek.end());
+      auto run = reinterpret_cast<const char*>(peek.begin());
+      if (allowDecodeUTF8_) {
+        json.append(run, special - peek.begin());
+      } else {
+        val.append(run, special - peek.begin());
+      }
+      in_.skip(special - peek.begin());
+      if (special != peek.end()) {
+        break;
+      }
+    }
     auto ch = in_.read<uint8_t>();
     if (ch == detail::json::kJSONStringDelimiter) {
       break;
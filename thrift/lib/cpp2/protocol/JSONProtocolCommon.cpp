@@ -16,6 +16,7 @@
 
 #include <thrift/lib/cpp2/protocol/JSONProtocolCommon.h>
 
+#include <cmath>
 #include <type_traits>
 
 #include <fmt/core.h>
@@ -90,7 +91,16 @@ const uint8_t JSONProtocolReaderCommon::kEscapeCharVals[8] = {
 
 uint32_t JSONProtocolWriterCommon::writeJSONDoubleInternal(double dbl) {
   WrappedIOBufQueueAppender appender(out_);
-  folly::toAppend(dbl, &appender);
+  // Integral doubles print as the same digits as the int64_t they convert to
+  // exactly, and formatting that skips the shortest round trip search. -0.0
+  // keeps its sign, so it's left out.
+  constexpr double kMaxExactIntegral = double(int64_t(1) << 53);
+  if (dbl > -kMaxExactIntegral && dbl < kMaxExactIntegral &&
+      dbl == std::trunc(dbl) && !(dbl == 0 && std::signbit(dbl))) {
+    folly::toAppend(static_cast<int64_t>(dbl), &appender);
+  } else {
+    folly::toAppend(dbl, &appender);
+  }
   return appender.size();
 }
 
@@ -22,15 +22,21 @@
 #include <typeinfo>
 
 #include <folly/Conv.h>
+#include <folly/Portability.h>
 #include <folly/Range.h>
 #include <folly/dynamic.h>
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
 #include <folly/io/IOBufQueue.h>
 #include <folly/json.h>
+#include <folly/lang/Bits.h>
 #include <thrift/lib/cpp/protocol/TBase64Utils.h>
 #include <thrift/lib/cpp2/protocol/Protocol.h>
 
+#if FOLLY_SSE >= 2
+#include <emmintrin.h>
+#endif
+
 namespace apache {
 namespace thrift {
 
@@ -61,6 +67,43 @@ constexpr folly::StringPiece kThriftNan("NaN");
 constexpr folly::StringPiece kThriftNegativeNan("-NaN");
 constexpr folly::StringPiece kThriftInfinity("Infinity");
 constexpr folly::StringPiece kThriftNegativeInfinity("-Infinity");
+
+// Returns the first character in [begin, end) that doesn't stand for itself in
+// a JSON string: the delimiter, a backslash and, if kControl, a control
+// character. Strings are written with all three escaped, and read back with
+// only the first two needing attention. Scans 16 characters at a time with
+// SSE2.
+template <bool kControl>
+inline const uint8_t* findSpecialChar(
+    const uint8_t* begin,
+    const uint8_t* end) {
+#if FOLLY_SSE >= 2
+  const __m128i delimiter = _mm_set1_epi8(kJSONStringDelimiter);
+  const __m128i backslash = _mm_set1_epi8(kJSONBackslash);
+  const __m128i maxControl = _mm_set1_epi8(0x1f);
+  for (; end - begin >= 16; begin += 16) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i special = _mm_or_si128(
+        _mm_cmpeq_epi8(chars, delimiter), _mm_cmpeq_epi8(chars, backslash));
+    if (kControl) {
+      // unsigned chars <= 0x1f
+      special = _mm_or_si128(
+          special, _mm_cmpeq_epi8(_mm_min_epu8(chars, maxControl), chars));
+    }
+    auto mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+    if (mask) {
+      return begin + folly::findFirstSet(mask) - 1;
+    }
+  }
+#endif
+  for (; begin != end; ++begin) {
+    if (*begin == kJSONStringDelimiter || *begin == kJSONBackslash ||
+        (kControl && *begin < 0x20)) {
+      break;
+    }
+  }
+  return begin;
+}
 } // namespace json
 } // namespace detail
 
@@ -40,6 +40,10 @@ class NimbleProtocolWriter {
  public:
   using ProtocolReader = NimbleProtocolReader;
 
+  static constexpr ProtocolType protocolType() {
+    return ProtocolType::T_NIMBLE_PROTOCOL;
+  }
+
   static constexpr bool kSortKeys() {
     return false;
   }
@@ -142,6 +146,10 @@ class NimbleProtocolReader {
     }
   }
 
+  static constexpr ProtocolType protocolType() {
+    return ProtocolType::T_NIMBLE_PROTOCOL;
+  }
+
   static constexpr bool kUsesFieldNames() {
     return false;
   }
@@ -392,14 +400,9 @@ inline bool canReadNElements(
 
 template <>
 inline void skip<NimbleProtocolReader, detail::nimble::NimbleType>(
-    NimbleProtocolReader& /* prot */,
-    detail::nimble::NimbleType /* arg_type */) {
-  // Fool the noreturn warning; we can't add the annotation without breaking
-  // interface compatibility.
-  volatile bool b = true;
-  if (b) {
-    throw std::runtime_error("Not implemented yet");
-  }
+    NimbleProtocolReader& prot,
+    detail::nimble::NimbleType arg_type) {
+  prot.skip_n(1, {arg_type});
 }
 
 template <>
@@ -72,7 +72,9 @@ class ProtocolReaderWithRefill : public VirtualReader<ProtocolT> {
   uint32_t bufferLength_;
 };
 
-class CompactProtocolReaderWithRefill : public VirtualCompactReader {
+// Readers are final so that fastproto, which is templated on the reader type,
+// calls them without virtual dispatch.
+class CompactProtocolReaderWithRefill final : public VirtualCompactReader {
  public:
   explicit CompactProtocolReaderWithRefill(Refiller refiller)
       : VirtualCompactReader(refiller) {}
@@ -296,7 +298,7 @@ class CompactProtocolReaderWithRefill : public VirtualCompactReader {
   }
 };
 
-class BinaryProtocolReaderWithRefill : public VirtualBinaryReader {
+class BinaryProtocolReaderWithRefill final : public VirtualBinaryReader {
  public:
   explicit BinaryProtocolReaderWithRefill(Refiller refiller)
       : VirtualBinaryReader(refiller) {}
@@ -173,7 +173,20 @@ class BufferingNimbleDecoder {
         ssize_t maxChunkFilledTemp = maxChunkFilled_;
         const std::uint8_t* controlBufTemp = controlCursor_.data();
         const std::uint8_t* dataBufTemp = dataCursor_.data();
-        for (ssize_t i = 0; i < numUnconditionalIters; ++i) {
+        ssize_t i = 0;
+        // Each iteration so far consumed at most kMaxBytesPerBlock, so the two
+        // blocks after it still have 2 * kMaxBytesPerBlock readable bytes.
+        for (; i + 1 < numUnconditionalIters; i += 2) {
+          dataBytesConsumed += decodeNimbleBlockPair<repr>(
+              controlBufTemp[i],
+              controlBufTemp[i + 1],
+              folly::ByteRange(
+                  dataBufTemp + dataBytesConsumed,
+                  dataBufTemp + dataBytesConsumed + 2 * kMaxBytesPerBlock),
+              &chunks_[maxChunkFilledTemp]);
+          maxChunkFilledTemp += 2 * kChunksPerBlock;
+        }
+        for (; i < numUnconditionalIters; ++i) {
           std::uint8_t controlByte = controlBufTemp[i];
           dataBytesConsumed += decodeNimbleBlock<repr>(
               controlByte,
@@ -24,6 +24,7 @@
 #include <folly/lang/Bits.h>
 
 #include <thrift/lib/cpp2/protocol/nimble/ChunkRepr.h>
+#include <thrift/lib/cpp2/protocol/nimble/ControlBitHelpers.h>
 #include <thrift/lib/cpp2/protocol/nimble/Vectorization.h>
 
 // See EncodeNimbleBlock.h to see why we work here in terms of "blocks" of four
@@ -132,6 +133,58 @@ int decodeNimbleBlock(
   return nimbleBlockDecodeData[control].data[0].offsetOrSize;
 }
 
+// Decodes two consecutive blocks, the second of which starts right after the
+// data of the first, into chunksOut. data must contain at least 32 valid bytes.
+// With AVX2 both blocks go through a single 256-bit shuffle, one per lane;
+// otherwise this is two calls to decodeNimbleBlock.
+template <ChunkRepr repr, bool tryVectorize = true>
+int decodeNimbleBlockPair(
+    std::uint8_t control0,
+    std::uint8_t control1,
+    folly::ByteRange data,
+    std::uint32_t chunksOut[8]) {
+  DCHECK(data.size() >= 2 * kMaxBytesPerBlock);
+#if APACHE_THRIFT_DETAIL_NIMBLE_CAN_VECTORIZE_AVX2
+  if (tryVectorize) {
+    const NimbleBlockVectorDecodeData& decodeData0 =
+        nimbleBlockVectorDecodeData[control0];
+    const NimbleBlockVectorDecodeData& decodeData1 =
+        nimbleBlockVectorDecodeData[control1];
+
+    // _mm256_shuffle_epi8 shuffles within each 128-bit lane, so the low lane
+    // holds the first block and its shuffle vector, the high lane the second.
+    __m256i input = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data()))),
+        _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(data.data() + decodeData0.size)),
+        1);
+    __m256i shuf = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(&decodeData0.shuffleVector))),
+        _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(&decodeData1.shuffleVector)),
+        1);
+    __m256i output = _mm256_shuffle_epi8(input, shuf);
+
+    if (repr == ChunkRepr::kZigzag) {
+      // output = (n >> 1) ^ -(n & 1), as in decodeNimbleBlock
+      __m256i shifted = _mm256_srli_epi32(output, 1);
+      __m256i anded = _mm256_and_si256(output, _mm256_set1_epi32(1));
+      __m256i negated = _mm256_sub_epi32(_mm256_setzero_si256(), anded);
+      output = _mm256_xor_si256(shifted, negated);
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(chunksOut), output);
+    return decodeData0.size + decodeData1.size;
+  }
+#endif
+  int size0 = decodeNimbleBlock<repr, tryVectorize>(control0, data, chunksOut);
+  int size1 = decodeNimbleBlock<repr, tryVectorize>(
+      control1, data.subpiece(size0), chunksOut + kChunksPerBlock);
+  return size0 + size1;
+}
+
 } // namespace detail
 } // namespace thrift
 } // namespace apache
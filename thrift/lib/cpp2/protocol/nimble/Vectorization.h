@@ -25,3 +25,11 @@
 #else
 #define APACHE_THRIFT_DETAIL_NIMBLE_CAN_VECTORIZE 0
 #endif
+
+// Decoding two blocks per 256-bit shuffle needs AVX2 at compile time too.
+#if APACHE_THRIFT_DETAIL_NIMBLE_CAN_VECTORIZE && defined(__AVX2__)
+#define APACHE_THRIFT_DETAIL_NIMBLE_CAN_VECTORIZE_AVX2 1
+#include <immintrin.h>
+#else
+#define APACHE_THRIFT_DETAIL_NIMBLE_CAN_VECTORIZE_AVX2 0
+#endif
@@ -208,6 +208,34 @@ TYPED_TEST(NimbleDecodeTest, DecodesExtraZeros) {
   EXPECT_EQ(zigzagDecode(16777218), decoded[3]);
 }
 
+TYPED_TEST(NimbleDecodeTest, DecodesBlockPairs) {
+  std::array<unsigned char, 2 * kMaxBytesPerBlock> data;
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = 37 * i + 11;
+  }
+  for (int control0 = 0; control0 < 256; ++control0) {
+    for (int control1 = 0; control1 < 256; ++control1) {
+      std::array<std::uint32_t, 2 * kChunksPerBlock> expected;
+      int expectedSize = decodeNimbleBlock<ChunkRepr::kZigzag, false>(
+          control0, folly::ByteRange(data), expected.data());
+      expectedSize += decodeNimbleBlock<ChunkRepr::kZigzag, false>(
+          control1,
+          folly::ByteRange(data).subpiece(expectedSize),
+          &expected[kChunksPerBlock]);
+
+      std::array<std::uint32_t, 2 * kChunksPerBlock> decoded;
+      int decodedSize =
+          decodeNimbleBlockPair<ChunkRepr::kZigzag, TypeParam::vectorize>(
+              control0, control1, folly::ByteRange(data), decoded.data());
+      EXPECT_TRUE(expectedSize == decodedSize && expected == decoded)
+          << folly::sformat(
+                 "Pair decode failed for control bytes {}, {}",
+                 control0,
+                 control1);
+    }
+  }
+}
+
 } // namespace detail
 } // namespace thrift
 } // namespace apache
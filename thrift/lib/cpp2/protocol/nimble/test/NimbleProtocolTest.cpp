@@ -500,6 +500,61 @@ TEST(NimbleProtocolTest, UnionTest) {
 
   EXPECT_EQ(myUnion.get_simpleI32(), decodedUnion.get_simpleI32());
 }
+TEST(NimbleProtocolTest, ChainedInputTest) {
+  ContainerTypes containerTypes;
+  for (int i = 0; i < 1000; ++i) {
+    containerTypes.myIntList.push_back(i * i * (i % 2 ? -1 : 1));
+    containerTypes.myStringList.push_back(std::string(i % 50, 'a' + i % 26));
+  }
+
+  NimbleProtocolWriter writer;
+  containerTypes.write(&writer);
+  std::unique_ptr<folly::IOBuf> message = writer.finalize();
+  message->coalesce();
+
+  // Splits the message into small buffers, so that chunks, blocks and strings
+  // all straddle IOBuf boundaries.
+  folly::IOBufQueue queue;
+  const std::size_t kPieceSize = 7;
+  for (std::size_t offset = 0; offset < message->length();
+       offset += kPieceSize) {
+    queue.append(folly::IOBuf::copyBuffer(
+        message->data() + offset,
+        std::min(kPieceSize, message->length() - offset)));
+  }
+  auto chain = queue.move();
+  ASSERT_TRUE(chain->isChained());
+
+  NimbleProtocolReader reader;
+  reader.setInput(folly::io::Cursor{chain.get()});
+  ContainerTypes decodedType;
+  decodedType.read(&reader);
+  EXPECT_EQ(containerTypes, decodedType);
+}
+
+TEST(NimbleProtocolTest, SkipStructTest) {
+  StringTypes strTypes;
+  strTypes.myStr = "skipped";
+  strTypes.myBinary = "also skipped";
+
+  NimbleProtocolWriter writer;
+  strTypes.write(&writer);
+  writer.writeI32(729);
+  writer.writeString("after");
+
+  std::unique_ptr<folly::IOBuf> message = writer.finalize();
+  NimbleProtocolReader reader;
+  reader.setInput(folly::io::Cursor{message.get()});
+
+  apache::thrift::skip(reader, nimble::NimbleType::STRUCT);
+  std::int32_t i32;
+  reader.readI32(i32);
+  EXPECT_EQ(729, i32);
+  std::string str;
+  reader.readString(str);
+  EXPECT_EQ("after", str);
+}
+
 } // namespace detail
 } // namespace thrift
 } // namespace apache
@@ -128,6 +128,19 @@ TEST_F(JSONProtocolTest, writeDouble) {
   EXPECT_EQ(expected, writing_cpp2([](W& p) { p.writeDouble(5.25); }));
 }
 
+TEST_F(JSONProtocolTest, writeDouble_integral) {
+  EXPECT_EQ("3", writing_cpp2([](W& p) { p.writeDouble(3.0); }));
+  EXPECT_EQ("0", writing_cpp2([](W& p) { p.writeDouble(0.0); }));
+  EXPECT_EQ("-0", writing_cpp2([](W& p) { p.writeDouble(-0.0); }));
+  EXPECT_EQ("-17", writing_cpp2([](W& p) { p.writeDouble(-17.0); }));
+  EXPECT_EQ(
+      "9007199254740991",
+      writing_cpp2([](W& p) { p.writeDouble(9007199254740991.0); }));
+  EXPECT_EQ(
+      "9007199254740992",
+      writing_cpp2([](W& p) { p.writeDouble(9007199254740992.0); }));
+}
+
 TEST_F(JSONProtocolTest, writeFloat) {
   auto expected = "5.25";
   EXPECT_EQ(expected, writing_cpp2([](W& p) { p.writeFloat(5.25f); }));
@@ -140,6 +153,15 @@ TEST_F(JSONProtocolTest, writeString) {
   EXPECT_EQ(expected, writing_cpp2([](W& p) { p.writeString("foobar"); }));
 }
 
+TEST_F(JSONProtocolTest, writeString_escaped) {
+  // special characters on both sides of 16 character boundaries
+  auto input = string(15, 'a') + "\"\\\n\x01" + string(17, 'b') +
+      string("\x7f\xc3\xa9\x00", 4) + "/";
+  auto expected = "\"" + string(15, 'a') + R"(\"\\\n\u0001)" + string(17, 'b') +
+      "\x7f\xc3\xa9" + R"(\u0000/")";
+  EXPECT_EQ(expected, writing_cpp2([&](W& p) { p.writeString(input); }));
+}
+
 TEST_F(JSONProtocolTest, writeBinary) {
   auto expected = R"("Zm9vYmFy")";
   EXPECT_EQ(
@@ -384,6 +406,19 @@ TEST_F(JSONProtocolTest, readString_raw) {
             }));
 }
 
+TEST_F(JSONProtocolTest, readString_escaped_split) {
+  vector<StringPiece> input = {
+      R"( "aaaaaaaaaaaaaaaaaaaa\)", R"("bbbb\n\u00)", R"(41)", R"(cc\\d")"};
+  auto expected = string(20, 'a') + "\"bbbb\nAcc\\d";
+  EXPECT_EQ(expected, reading_cpp2<string>(input, [](R& p) {
+              p.setAllowDecodeUTF8(false);
+              return returning([&](string& _) { p.readString(_); });
+            }));
+  EXPECT_EQ(expected, reading_cpp2<string>(input, [](R& p) {
+              return returning([&](string& _) { p.readString(_); });
+            }));
+}
+
 TEST_F(JSONProtocolTest, readString_utf8) {
   auto input = R"("\u263A")";
   auto expected = string(u8"\u263A");
@@ -66,3 +66,16 @@ TEST_F(SimpleJSONProtocolTest, roundtrip_struct_with_empty_map_string_i64) {
   EXPECT_EQ(serialized.size(), size);
   EXPECT_EQ(orig, deserialized);
 }
+
+TEST_F(SimpleJSONProtocolTest, roundtrip_struct_with_escaped_string) {
+  //  cpp2 -> str -> cpp2
+  using type = SubStruct;
+  auto orig = type{};
+  orig.mySubString = string(40, 'x') + "\"quoted\"\t\\" + string(40, 'y');
+  const auto serialized = S::serialize<string>(orig);
+  EXPECT_NE(string::npos, serialized.find(R"(\"quoted\"\t\\)"));
+  type deserialized;
+  const auto size = S::deserialize(serialized, deserialized);
+  EXPECT_EQ(serialized.size(), size);
+  EXPECT_EQ(orig, deserialized);
+}
@@ -51,6 +51,21 @@ class AdmissionController {
    */
   virtual void returnedResponse(std::chrono::nanoseconds) = 0;
 
+  /**
+   * Indicate to the controller the CPU time a thread manager thread spent
+   * running the handler of the request. Asynchronous handlers are only
+   * charged for the part that ran on that thread.
+   */
+  virtual void consumedCpuTime(std::chrono::nanoseconds) {}
+
+  /**
+   * Whether the controller uses consumedCpuTime(). Measuring the CPU time
+   * costs two system calls per request, which are skipped otherwise.
+   */
+  virtual bool needsCpuTime() const {
+    return false;
+  }
+
   /**
    * Delegate reporting the metrics to the underlying implementation
    * The last argument must contain the current metric values in case the
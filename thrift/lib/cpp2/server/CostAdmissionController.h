@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include <thrift/lib/cpp2/server/AdmissionController.h>
+#include <thrift/lib/cpp2/util/Ewma.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * This admission controller weighs every request by the estimated CPU time of
+ * its method, and admits it as long as the CPU time of the requests waiting
+ * in the queue stays below a budget.
+ *
+ * Unlike a limit on the number of queued requests, it tells a 50us lookup from
+ * a 50ms scan: a budget of 100ms holds two scans or two thousand lookups, and
+ * bounds the time a request waits in the queue either way.
+ *
+ * The cost of a method is the thread CPU time of running its handler in the
+ * thread manager (see consumedCpuTime()), not its latency: time spent waiting
+ * on I/O or downstream services doesn't keep the workers busy.
+ *
+ * One controller is made for each method a client calls (see
+ * CostAdmissionStrategy):
+ * - the MethodCost, an EWMA of the CPU times of the method, is shared by the
+ *   controllers of the method,
+ * - the Budget, the CPU time admitted but not dequeued yet, is shared by the
+ *   controllers of the client.
+ */
+template <class Clock = std::chrono::steady_clock>
+class CostAdmissionController : public AdmissionController {
+ public:
+  using Duration = typename Clock::duration;
+
+  class MethodCost {
+   public:
+    /**
+     * `window` is the window of the EWMA, `initialCost` the estimate used
+     * until the first responses come back.
+     */
+    MethodCost(Duration window, std::chrono::nanoseconds initialCost)
+        : cost_(window, initialCost.count()) {}
+
+    /**
+     * Return the estimated CPU time, in nanoseconds.
+     */
+    double estimate() const {
+      std::lock_guard<std::mutex> guard(mutex_);
+      return cost_.estimate();
+    }
+
+    void add(std::chrono::nanoseconds cpuTime) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      cost_.add(cpuTime.count());
+    }
+
+   private:
+    mutable std::mutex mutex_;
+    Ewma<Clock> cost_;
+  };
+
+  class Budget {
+   public:
+    explicit Budget(std::chrono::nanoseconds limit) : limit_(limit.count()) {}
+
+    /**
+     * Reserve `cost` nanoseconds of the budget, return false if they don't
+     * fit. A request is always admitted in an empty queue, however expensive,
+     * so that a method costing more than the whole budget is not starved.
+     */
+    bool acquire(double cost) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (queued_ > 0 && pending_ + cost > limit_) {
+        return false;
+      }
+      pending_ += cost;
+      queued_ += 1;
+      return true;
+    }
+
+    void release(double cost) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      queued_ -= 1;
+      // Don't let rounding errors accumulate while the queue is empty
+      pending_ = queued_ == 0 ? 0 : std::max(0.0, pending_ - cost);
+    }
+
+    double getPending() const {
+      std::lock_guard<std::mutex> guard(mutex_);
+      return pending_;
+    }
+
+    size_t getQueueSize() const {
+      std::lock_guard<std::mutex> guard(mutex_);
+      return queued_;
+    }
+
+    double getLimit() const {
+      return limit_;
+    }
+
+   private:
+    const double limit_;
+
+    mutable std::mutex mutex_;
+    // Accesses to the following members should lock mutex_
+    double pending_{0};
+    size_t queued_{0};
+  };
+
+  CostAdmissionController(
+      std::shared_ptr<Budget> budget,
+      std::shared_ptr<MethodCost> methodCost)
+      : budget_(std::move(budget)), methodCost_(std::move(methodCost)) {}
+
+  /**
+   * Return true if the estimated cost of the method fits in the budget.
+   */
+  bool admit() override {
+    const auto cost = methodCost_->estimate();
+    if (!budget_->acquire(cost)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    queued_ += 1;
+    queuedCost_ += cost;
+    return true;
+  }
+
+  /**
+   * Give back to the budget the cost reserved by admit(). The estimate may
+   * have changed since then, so the average of what this controller reserved
+   * is released, which adds up exactly once its queue is empty.
+   */
+  void dequeue() override {
+    double cost;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (queued_ == 0) {
+        return;
+      }
+      cost = queuedCost_ / queued_;
+      queued_ -= 1;
+      queuedCost_ -= cost;
+    }
+    budget_->release(cost);
+  }
+
+  void returnedResponse(std::chrono::nanoseconds) override {}
+
+  /**
+   * Learn the cost of the method from the CPU time of the request.
+   */
+  void consumedCpuTime(std::chrono::nanoseconds cpuTime) override {
+    methodCost_->add(cpuTime);
+  }
+
+  bool needsCpuTime() const override {
+    return true;
+  }
+
+ private:
+  const std::shared_ptr<Budget> budget_;
+  const std::shared_ptr<MethodCost> methodCost_;
+
+  std::mutex mutex_;
+  // Accesses to the following members should lock mutex_
+  size_t queued_{0};
+  double queuedCost_{0};
+};
+
+} // namespace thrift
+} // namespace apache
@@ -437,6 +437,7 @@ Cpp2Connection::Cpp2Request::Cpp2Request(
       rootRequestContextId);
   queueTimeout_.request_ = this;
   taskTimeout_.request_ = this;
+  connection_->getWorker()->countRequest();
 }
 
 MessageChannel::SendCallback* Cpp2Connection::Cpp2Request::prepareSendCallback(
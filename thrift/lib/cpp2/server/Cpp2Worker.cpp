@@ -16,6 +16,10 @@
 
 #include <thrift/lib/cpp2/server/Cpp2Worker.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <glog/logging.h>
 
 #include <folly/String.h>
@@ -24,10 +28,12 @@
 #include <folly/portability/Sockets.h>
 #include <thrift/lib/cpp/async/TAsyncSSLSocket.h>
 #include <thrift/lib/cpp/async/TAsyncSocket.h>
+#include <thrift/lib/cpp/concurrency/NumaTopology.h>
 #include <thrift/lib/cpp/concurrency/Util.h>
 #include <thrift/lib/cpp2/server/Cpp2Connection.h>
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 #include <thrift/lib/cpp2/server/peeking/PeekingManager.h>
+#include <thrift/lib/cpp2/transport/rocket/server/RocketServerConnection.h>
 #include <thrift/lib/thrift/gen-cpp2/RpcMetadata_types.h>
 #include <wangle/acceptor/EvbHandshakeHelper.h>
 #include <wangle/acceptor/SSLAcceptorHandshakeHelper.h>
@@ -44,7 +50,20 @@ using std::shared_ptr;
 
 namespace {
 folly::LeakySingleton<folly::EventBaseLocal<RequestsRegistry>> registry;
+
+// NUMA node of the CPU the packets of a connection are received on, -1 if
+// unknown
+int incomingNumaNode(folly::AsyncSocket& sock) {
+#ifdef SO_INCOMING_CPU
+  int cpu = -1;
+  socklen_t len = sizeof(cpu);
+  if (sock.getSockOpt(SOL_SOCKET, SO_INCOMING_CPU, &cpu, &len) == 0) {
+    return concurrency::NumaTopology::get().nodeOfCpu(cpu);
+  }
+#endif
+  return -1;
 }
+} // namespace
 
 void Cpp2Worker::initRequestsRegistry() {
   auto* evb = getEventBase();
@@ -72,6 +91,65 @@ void Cpp2Worker::onNewConnection(
     return;
   }
 
+  if (numaNode_ >= 0 && sock &&
+      steerToNumaNode(
+          sock, addr, nextProtocolName, secureTransportType, tinfo)) {
+    return;
+  }
+
+  handleNewConnection(
+      std::move(sock), addr, nextProtocolName, secureTransportType, tinfo);
+}
+
+bool Cpp2Worker::steerToNumaNode(
+    folly::AsyncTransportWrapper::UniquePtr& sock,
+    const folly::SocketAddress* addr,
+    const std::string& nextProtocolName,
+    wangle::SecureTransportType secureTransportType,
+    const wangle::TransportInfo& tinfo) {
+  auto asyncSocket = sock->getUnderlyingTransport<folly::AsyncSocket>();
+  int node = asyncSocket ? incomingNumaNode(*asyncSocket) : -1;
+  if (node < 0) {
+    return false;
+  }
+  if (node == numaNode_) {
+    ++server_->numaLocalConnections_;
+    return false;
+  }
+  ++server_->numaCrossNodeConnections_;
+  if (!server_->numaSteering_ || !sock->isDetachable()) {
+    return false;
+  }
+  auto target = server_->pickNumaWorker(node);
+  if (!target) {
+    return false;
+  }
+
+  ++server_->numaSteeredConnections_;
+  sock->detachEventBase();
+  auto* evb = target->getEventBase();
+  evb->runInEventBaseThread([target = std::move(target),
+                             sock = std::move(sock),
+                             addr = *addr,
+                             nextProtocolName,
+                             secureTransportType,
+                             tinfo]() mutable {
+    sock->attachEventBase(target->getEventBase());
+    if (target->stopping_) {
+      return;
+    }
+    target->handleNewConnection(
+        std::move(sock), &addr, nextProtocolName, secureTransportType, tinfo);
+  });
+  return true;
+}
+
+void Cpp2Worker::handleNewConnection(
+    folly::AsyncTransportWrapper::UniquePtr sock,
+    const folly::SocketAddress* addr,
+    const std::string& nextProtocolName,
+    wangle::SecureTransportType secureTransportType,
+    const wangle::TransportInfo& tinfo) {
   auto* observer = server_->getObserver();
   uint32_t maxConnection = server_->getMaxConnections();
   if (maxConnection > 0 &&
@@ -361,5 +439,74 @@ Cpp2Worker::ActiveRequestsGuard Cpp2Worker::getActiveRequestsGuard() {
   ++activeRequests_;
   return Cpp2Worker::ActiveRequestsGuard(this);
 }
+
+void Cpp2Worker::addRocketConnection(
+    rocket::RocketServerConnection* connection) {
+  rocketConnections_.insert(connection);
+  if (sendingDrainNotices_) {
+    sendDrainNotice(*connection);
+  }
+}
+
+void Cpp2Worker::removeRocketConnection(
+    rocket::RocketServerConnection* connection) {
+  rocketConnections_.erase(connection);
+  if (drainingConnections_.erase(connection)) {
+    server_->onRocketConnectionDrained();
+  }
+}
+
+void Cpp2Worker::sendDrainNotices() {
+  getEventBase()->runImmediatelyOrRunInEventBaseThreadAndWait([&] {
+    sendingDrainNotices_ = true;
+    for (auto* connection : rocketConnections_) {
+      sendDrainNotice(*connection);
+    }
+  });
+}
+
+void Cpp2Worker::sendDrainNotice(rocket::RocketServerConnection& connection) {
+  if (connection.sendDrainNotice()) {
+    drainingConnections_.insert(&connection);
+    server_->onRocketConnectionDraining();
+  }
+}
+
+void Cpp2Worker::migrateConnections(
+    std::shared_ptr<Cpp2Worker> target,
+    size_t maxConnections,
+    double maxShare) {
+  getEventBase()->runInEventBaseThread([self = shared_from_this(),
+                                        target = std::move(target),
+                                        maxConnections,
+                                        maxShare]() mutable {
+    if (self->stopping_ || target.get() == self.get()) {
+      return;
+    }
+    std::vector<std::pair<uint64_t, MigratableConnection*>> connections;
+    uint64_t total = 0;
+    for (auto* connection : self->migratableConnections_) {
+      auto requests = connection->takeRecentRequests();
+      total += requests;
+      connections.emplace_back(requests, connection);
+    }
+    std::sort(
+        connections.begin(), connections.end(), [](auto& a, auto& b) {
+          return a.first > b.first;
+        });
+    auto budget = static_cast<uint64_t>(total * maxShare);
+    for (auto& [requests, connection] : connections) {
+      if (maxConnections == 0 || requests == 0) {
+        break;
+      }
+      if (requests > budget) {
+        continue;
+      }
+      budget -= requests;
+      --maxConnections;
+      connection->migrateTo(target);
+    }
+  });
+}
 } // namespace thrift
 } // namespace apache
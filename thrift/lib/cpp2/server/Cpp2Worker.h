@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <unordered_set>
 
 #include <folly/io/async/AsyncServerSocket.h>
@@ -25,6 +26,7 @@
 #include <folly/io/async/HHWheelTimer.h>
 #include <thrift/lib/cpp/async/TAsyncSSLSocket.h>
 #include <thrift/lib/cpp2/security/FizzPeeker.h>
+#include <thrift/lib/cpp2/server/MigratableConnection.h>
 #include <thrift/lib/cpp2/server/RequestsRegistry.h>
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 #include <thrift/lib/cpp2/server/peeking/TLSHelper.h>
@@ -38,6 +40,9 @@ namespace thrift {
 // Forward declaration of classes
 class Cpp2Connection;
 class ThriftServer;
+namespace rocket {
+class RocketServerConnection;
+} // namespace rocket
 
 /**
  * Cpp2Worker drives the actual I/O for ThriftServer connections.
@@ -129,6 +134,61 @@ class Cpp2Worker : public wangle::Acceptor,
     return stopping_;
   }
 
+  // Connections of this worker, can be read from any thread
+  size_t getNumConnections() const {
+    return numConnections_.load(std::memory_order_relaxed);
+  }
+
+  // Requests received by this worker so far
+  uint64_t getNumRequests() const {
+    return numRequests_.load(std::memory_order_relaxed);
+  }
+
+  void countRequest() {
+    numRequests_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Called from the IO thread of the worker
+  void addMigratableConnection(MigratableConnection* connection) {
+    migratableConnections_.insert(connection);
+  }
+  void removeMigratableConnection(MigratableConnection* connection) {
+    migratableConnections_.erase(connection);
+  }
+
+  /**
+   * Move to `target` up to `maxConnections` of the migratable connections of
+   * this worker, busiest first, as long as the connections moved carry at
+   * most `maxShare` of the requests this worker received since the previous
+   * call: a connection busier than that would only move the hot spot.
+   */
+  void migrateConnections(
+      std::shared_ptr<Cpp2Worker> target,
+      size_t maxConnections,
+      double maxShare);
+
+  // Called from the IO thread of the worker, once the connection received
+  // its SETUP frame
+  void addRocketConnection(rocket::RocketServerConnection* connection);
+  void removeRocketConnection(rocket::RocketServerConnection* connection);
+
+  /**
+   * Send a drain notice over the rocket connections of this worker, and the
+   * ones set up from now on, see RocketServerConnection::sendDrainNotice().
+   * The server counts them until they close, see
+   * ThriftServer::drainRocketConnections().
+   */
+  void sendDrainNotices();
+
+  // Connections migrated to this worker so far
+  uint64_t getNumMigratedConnections() const {
+    return numMigratedConnections_.load(std::memory_order_relaxed);
+  }
+
+  void countMigratedConnection() {
+    numMigratedConnections_.fetch_add(1, std::memory_order_relaxed);
+  }
+
   struct ActiveRequestsDecrement {
     void operator()(Cpp2Worker* worker) {
       if (--worker->activeRequests_ == 0 && worker->stopping_) {
@@ -174,6 +234,14 @@ class Cpp2Worker : public wangle::Acceptor,
     }
   }
 
+  // Keep getNumConnections() up to date, also as connections migrate
+  void onConnectionAdded(const wangle::ManagedConnection*) override {
+    numConnections_.fetch_add(1, std::memory_order_relaxed);
+  }
+  void onConnectionRemoved(const wangle::ManagedConnection*) override {
+    numConnections_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
   void onNewConnection(
       folly::AsyncTransportWrapper::UniquePtr,
       const folly::SocketAddress*,
@@ -181,6 +249,29 @@ class Cpp2Worker : public wangle::Acceptor,
       wangle::SecureTransportType,
       const wangle::TransportInfo&) override;
 
+  /**
+   * Serve a new connection on this worker, once steerToNumaNode() left it
+   * here.
+   */
+  void handleNewConnection(
+      folly::AsyncTransportWrapper::UniquePtr sock,
+      const folly::SocketAddress* addr,
+      const std::string& nextProtocolName,
+      wangle::SecureTransportType secureTransportType,
+      const wangle::TransportInfo& tinfo);
+
+  /**
+   * Count whether a new connection is received on the NUMA node of this
+   * worker, and if not and steering is enabled, hand it over to a worker of
+   * that node. Returns true if the connection was handed over.
+   */
+  bool steerToNumaNode(
+      folly::AsyncTransportWrapper::UniquePtr& sock,
+      const folly::SocketAddress* addr,
+      const std::string& nextProtocolName,
+      wangle::SecureTransportType secureTransportType,
+      const wangle::TransportInfo& tinfo);
+
   virtual std::shared_ptr<folly::AsyncTransportWrapper> createThriftTransport(
       folly::AsyncTransportWrapper::UniquePtr);
 
@@ -246,8 +337,23 @@ class Cpp2Worker : public wangle::Acceptor,
 
   uint32_t activeRequests_;
   RequestsRegistry* requestsRegistry_;
-  bool stopping_{false};
+  // Written from the IO thread, read by the other workers before they hand
+  // a connection over
+  std::atomic<bool> stopping_{false};
   folly::Baton<> stopBaton_;
+  std::atomic<size_t> numConnections_{0};
+  std::atomic<uint64_t> numRequests_{0};
+  std::atomic<uint64_t> numMigratedConnections_{0};
+  std::unordered_set<MigratableConnection*> migratableConnections_;
+  // Set up rocket connections, and the ones of them sent a drain notice
+  std::unordered_set<rocket::RocketServerConnection*> rocketConnections_;
+  std::unordered_set<rocket::RocketServerConnection*> drainingConnections_;
+  bool sendingDrainNotices_{false};
+
+  void sendDrainNotice(rocket::RocketServerConnection& connection);
+  // NUMA node the IO thread of this worker is bound to, -1 if the server
+  // isn't NUMA aware, set by ThriftServer::setupNumaWorkers()
+  int numaNode_{-1};
 
   void initRequestsRegistry();
 
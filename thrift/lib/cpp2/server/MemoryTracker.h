@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Counts the bytes buffered on behalf of a connection, a client or a whole
+ * server, against an optional limit.
+ *
+ * Trackers form a chain: every increment and decrement of a tracker is also
+ * applied to its parent, so that the usage of the server tracker is the sum of
+ * the usage of all the connections, and that of a client tracker the sum over
+ * the connections of that client. Usage is broken down by MemoryUse so that
+ * the gauges tell what the bytes are held for.
+ *
+ * The counters may be updated and read from any thread, setParent() must only
+ * be called by the thread owning the tracker.
+ */
+class MemoryTracker {
+ public:
+  enum class MemoryUse : size_t {
+    // Read buffers of the frame parsers
+    READ_BUFFER,
+    // Fragments of requests and sink payloads not fully received yet
+    PARTIAL_FRAMES,
+    // Payloads of the requests being queued or processed
+    REQUESTS,
+    // Responses waiting for the socket to accept them
+    WRITES,
+    NUM_USES,
+  };
+
+  explicit MemoryTracker(
+      size_t limit = 0,
+      std::shared_ptr<MemoryTracker> parent = nullptr)
+      : limit_(limit), parent_(std::move(parent)) {}
+
+  MemoryTracker(const MemoryTracker&) = delete;
+  MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+  void increment(MemoryUse use, size_t bytes) {
+    for (auto tracker = this; tracker; tracker = tracker->parent_.get()) {
+      tracker->usage_.fetch_add(bytes, std::memory_order_relaxed);
+      tracker->usageByUse_[static_cast<size_t>(use)].fetch_add(
+          bytes, std::memory_order_relaxed);
+    }
+  }
+
+  void decrement(MemoryUse use, size_t bytes) {
+    for (auto tracker = this; tracker; tracker = tracker->parent_.get()) {
+      tracker->usage_.fetch_sub(bytes, std::memory_order_relaxed);
+      tracker->usageByUse_[static_cast<size_t>(use)].fetch_sub(
+          bytes, std::memory_order_relaxed);
+    }
+  }
+
+  size_t getUsage() const {
+    return usage_.load(std::memory_order_relaxed);
+  }
+
+  size_t getUsage(MemoryUse use) const {
+    return usageByUse_[static_cast<size_t>(use)].load(
+        std::memory_order_relaxed);
+  }
+
+  // 0 means no limit
+  size_t getLimit() const {
+    return limit_.load(std::memory_order_relaxed);
+  }
+
+  void setLimit(size_t limit) {
+    limit_.store(limit, std::memory_order_relaxed);
+  }
+
+  bool exceeded() const {
+    auto limit = getLimit();
+    return limit != 0 && getUsage() > limit;
+  }
+
+  // Connections of this tracker not reading from their socket because a
+  // limit was exceeded
+  void incPausedConnections() {
+    for (auto tracker = this; tracker; tracker = tracker->parent_.get()) {
+      tracker->pausedConnections_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void decPausedConnections() {
+    for (auto tracker = this; tracker; tracker = tracker->parent_.get()) {
+      tracker->pausedConnections_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  size_t getPausedConnections() const {
+    return pausedConnections_.load(std::memory_order_relaxed);
+  }
+
+  const std::shared_ptr<MemoryTracker>& getParent() const {
+    return parent_;
+  }
+
+  /**
+   * Move the current usage of this tracker from its parent chain to the one
+   * of the new parent, e.g. once the client of a connection is known.
+   */
+  void setParent(std::shared_ptr<MemoryTracker> parent) {
+    for (size_t i = 0; i < usageByUse_.size(); i++) {
+      auto use = static_cast<MemoryUse>(i);
+      auto bytes = getUsage(use);
+      if (parent_) {
+        parent_->decrement(use, bytes);
+      }
+      if (parent) {
+        parent->increment(use, bytes);
+      }
+    }
+    parent_ = std::move(parent);
+  }
+
+  static const char* useName(MemoryUse use) {
+    switch (use) {
+      case MemoryUse::READ_BUFFER:
+        return "read_buffer";
+      case MemoryUse::PARTIAL_FRAMES:
+        return "partial_frames";
+      case MemoryUse::REQUESTS:
+        return "requests";
+      case MemoryUse::WRITES:
+        return "writes";
+      default:
+        return "unknown";
+    }
+  }
+
+ private:
+  std::atomic<size_t> usage_{0};
+  std::array<
+      std::atomic<size_t>,
+      static_cast<size_t>(MemoryUse::NUM_USES)>
+      usageByUse_{};
+  std::atomic<size_t> pausedConnections_{0};
+  std::atomic<size_t> limit_;
+  std::shared_ptr<MemoryTracker> parent_;
+};
+
+} // namespace thrift
+} // namespace apache
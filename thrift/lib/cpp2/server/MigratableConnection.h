@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace apache {
+namespace thrift {
+
+class Cpp2Worker;
+
+/**
+ * A connection which can be moved to the IO thread of another Cpp2Worker,
+ * see Cpp2Worker::migrateConnections(). Its methods are called from the IO
+ * thread of the worker it currently belongs to.
+ */
+class MigratableConnection {
+ public:
+  virtual ~MigratableConnection() = default;
+
+  // Requests received since the previous call
+  virtual uint64_t takeRecentRequests() = 0;
+
+  /**
+   * Move the connection to `worker` as soon as it has nothing in flight.
+   * The connection stays where it is if it closes, or can't be detached,
+   * before then.
+   */
+  virtual void migrateTo(std::shared_ptr<Cpp2Worker> worker) = 0;
+};
+
+} // namespace thrift
+} // namespace apache
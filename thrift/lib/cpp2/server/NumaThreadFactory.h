@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <thrift/lib/cpp/concurrency/NumaTopology.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Thread factory for the IO and acceptor pools of a NUMA aware ThriftServer:
+ * binds the threads it creates to the NUMA nodes in turn, so that a pool of
+ * N threads gets N / numNodes threads on each node.
+ */
+class NumaThreadFactory : public folly::NamedThreadFactory {
+ public:
+  explicit NumaThreadFactory(
+      folly::StringPiece prefix,
+      const concurrency::NumaTopology& topology =
+          concurrency::NumaTopology::get())
+      : folly::NamedThreadFactory(prefix), topology_(topology) {}
+
+  std::thread newThread(folly::Func&& func) override {
+    size_t node = nextNode_++ % topology_.numNodes();
+    return folly::NamedThreadFactory::newThread(
+        [&topology = topology_, node, func = std::move(func)]() mutable {
+          topology.bindCurrentThread(node);
+          func();
+        });
+  }
+
+ private:
+  const concurrency::NumaTopology& topology_;
+  std::atomic<size_t> nextNode_{0};
+};
+
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/ReusePortSteering.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <numeric>
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#include <sys/socket.h>
+#endif
+
+namespace apache {
+namespace thrift {
+
+namespace {
+// Classic BPF opcodes, see linux/filter.h
+constexpr uint16_t kLdAbsW = 0x20; // BPF_LD | BPF_W | BPF_ABS
+constexpr uint16_t kModK = 0x94; // BPF_ALU | BPF_MOD | BPF_K
+constexpr uint16_t kJeqK = 0x15; // BPF_JMP | BPF_JEQ | BPF_K
+constexpr uint16_t kRetK = 0x06; // BPF_RET | BPF_K
+// SKF_AD_OFF + SKF_AD_CPU: load the id of the CPU running the program
+constexpr uint32_t kCpuOffset = static_cast<uint32_t>(-0x1000) + 36;
+} // namespace
+
+ReusePortSteering::ReusePortSteering(size_t numListeners, size_t numBuckets)
+    : numListeners_(std::max<size_t>(1, numListeners)) {
+  numBuckets = std::min(std::max<size_t>(1, numBuckets), kMaxBuckets);
+  buckets_.resize(numBuckets);
+  for (size_t i = 0; i < numBuckets; i++) {
+    buckets_[i] = i % numListeners_;
+  }
+}
+
+std::vector<ReusePortSteering::Instruction> ReusePortSteering::program()
+    const {
+  std::vector<Instruction> program;
+  program.push_back({kLdAbsW, 0, 0, kCpuOffset});
+  program.push_back({kModK, 0, 0, static_cast<uint32_t>(buckets_.size())});
+  for (size_t i = 0; i + 1 < buckets_.size(); i++) {
+    // if (A == i) return buckets_[i];
+    program.push_back({kJeqK, 0, 1, static_cast<uint32_t>(i)});
+    program.push_back({kRetK, 0, 0, buckets_[i]});
+  }
+  program.push_back({kRetK, 0, 0, buckets_.back()});
+  return program;
+}
+
+bool ReusePortSteering::attach(int fd) const {
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  static_assert(
+      sizeof(Instruction) == sizeof(sock_filter),
+      "Instruction must match struct sock_filter");
+  auto instructions = program();
+  sock_fprog prog;
+  prog.len = instructions.size();
+  prog.filter = reinterpret_cast<sock_filter*>(instructions.data());
+  return setsockopt(
+             fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) ==
+      0;
+#else
+  (void)fd;
+  errno = ENOTSUP;
+  return false;
+#endif
+}
+
+bool ReusePortSteering::rebalance(
+    const std::vector<uint64_t>& loads,
+    double threshold) {
+  if (loads.size() != numListeners_ || numListeners_ < 2) {
+    return false;
+  }
+  auto total = std::accumulate(loads.begin(), loads.end(), uint64_t(0));
+  if (total == 0) {
+    return false;
+  }
+  double average = static_cast<double>(total) / numListeners_;
+  auto hot = std::max_element(loads.begin(), loads.end()) - loads.begin();
+  auto cold = std::min_element(loads.begin(), loads.end()) - loads.begin();
+  if (loads[hot] <= average * (1 + threshold)) {
+    return false;
+  }
+  // The last bucket of the hottest listener goes to the coldest one. The
+  // hottest listener may be left without buckets, it then only serves the
+  // connections it already has until its load drops.
+  for (size_t i = buckets_.size(); i-- > 0;) {
+    if (buckets_[i] == static_cast<uint32_t>(hot)) {
+      buckets_[i] = cold;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace thrift
+} // namespace apache
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * Steering of new connections across a SO_REUSEPORT group of listeners, one
+ * per IO thread, by the CPU which received the connection.
+ *
+ * The CPUs are split in buckets, bucket i holding the CPUs c with
+ * c % numBuckets == i, and each bucket is assigned to a listener. A classic
+ * BPF program attached to the group (SO_ATTACH_REUSEPORT_CBPF) returns the
+ * listener of the bucket of the receiving CPU, so that a connection is
+ * accepted by the IO thread its CPU is assigned to instead of by the one the
+ * kernel hash picks. rebalance() moves buckets away from the listeners whose
+ * IO thread is loaded more than the others, after which the program must be
+ * attached again.
+ */
+class ReusePortSteering {
+ public:
+  // Layout of struct sock_filter
+  struct Instruction {
+    uint16_t code;
+    uint8_t jt;
+    uint8_t jf;
+    uint32_t k;
+  };
+
+  // numBuckets is usually the number of CPUs
+  ReusePortSteering(size_t numListeners, size_t numBuckets);
+
+  size_t numListeners() const {
+    return numListeners_;
+  }
+
+  // Listener of each bucket, in the order listeners joined the group
+  const std::vector<uint32_t>& getBuckets() const {
+    return buckets_;
+  }
+
+  std::vector<Instruction> program() const;
+
+  /**
+   * Attach the program to the reuseport group of the listening socket `fd`.
+   * Returns false, with errno set, if the kernel doesn't support it.
+   */
+  bool attach(int fd) const;
+
+  /**
+   * Move a bucket from the most loaded listener to the least loaded one if
+   * the load of the former exceeds the average by more than `threshold`
+   * (e.g. 0.25 for 25%). A single bucket is moved per call, so that the
+   * effect of a move is measured before the next one. Returns true if a
+   * bucket was moved.
+   */
+  bool rebalance(const std::vector<uint64_t>& loads, double threshold);
+
+  // Upper bound of the buckets to keep the program under BPF_MAXINSNS
+  static constexpr size_t kMaxBuckets = 1024;
+
+ private:
+  size_t numListeners_;
+  std::vector<uint32_t> buckets_;
+};
+
+} // namespace thrift
+} // namespace apache
@@ -102,6 +102,14 @@ class SLAViolationController : public AdmissionController {
     innerController_.returnedResponse(latency);
   }
 
+  void consumedCpuTime(std::chrono::nanoseconds cpuTime) override {
+    innerController_.consumedCpuTime(cpuTime);
+  }
+
+  bool needsCpuTime() const override {
+    return innerController_.needsCpuTime();
+  }
+
  private:
   InnerAdmissionController innerController_;
   const std::chrono::nanoseconds sla_;
@@ -18,22 +18,31 @@
 
 #include <fcntl.h>
 #include <signal.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
+#include <numeric>
 #include <random>
 
 #include <folly/Conv.h>
+#include <folly/ExceptionWrapper.h>
 #include <folly/Memory.h>
 #include <folly/ScopeGuard.h>
+#include <folly/String.h>
 #include <folly/io/GlobalShutdownSocketSet.h>
 #include <folly/portability/Sockets.h>
 #include <glog/logging.h>
+#include <thrift/lib/cpp/concurrency/NumaThreadManager.h>
+#include <thrift/lib/cpp/concurrency/NumaTopology.h>
 #include <thrift/lib/cpp/concurrency/PosixThreadFactory.h>
 #include <thrift/lib/cpp/concurrency/Thread.h>
 #include <thrift/lib/cpp/concurrency/ThreadManager.h>
 #include <thrift/lib/cpp/server/TServerObserver.h>
 #include <thrift/lib/cpp2/server/Cpp2Connection.h>
 #include <thrift/lib/cpp2/server/Cpp2Worker.h>
+#include <thrift/lib/cpp2/server/NumaThreadFactory.h>
 #include <thrift/lib/cpp2/server/ServerInstrumentation.h>
 #include <wangle/ssl/SSLContextManager.h>
 
@@ -55,6 +64,8 @@ using namespace apache::thrift::server;
 using namespace apache::thrift::transport;
 using namespace apache::thrift::async;
 using namespace std;
+using apache::thrift::concurrency::NumaThreadManager;
+using apache::thrift::concurrency::NumaTopology;
 using apache::thrift::concurrency::PosixThreadFactory;
 using apache::thrift::concurrency::PriorityThreadManager;
 using apache::thrift::concurrency::Runnable;
@@ -66,6 +77,21 @@ using RequestSnapshot = ThriftServer::RequestSnapshot;
 using std::shared_ptr;
 using wangle::TLSCredProcessor;
 
+namespace {
+// The value of the client header ends up in metric names
+std::string sanitizeClientKey(folly::StringPiece key) {
+  constexpr size_t kMaxClientKeyLength = 64;
+  std::string sanitized = key.subpiece(0, kMaxClientKeyLength).str();
+  for (auto& c : sanitized) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' &&
+        c != '_') {
+      c = '_';
+    }
+  }
+  return sanitized;
+}
+} // namespace
+
 class ThriftAcceptorFactory : public wangle::AcceptorFactory {
  public:
   explicit ThriftAcceptorFactory(ThriftServer* server) : server_(server) {}
@@ -199,6 +225,24 @@ void ThriftServer::IdleServerAction::timeoutExpired() noexcept {
   }
 }
 
+ThriftServer::WorkerLoadAction::WorkerLoadAction(
+    ThriftServer& server,
+    void (ThriftServer::*action)(),
+    folly::HHWheelTimer& timer,
+    std::chrono::milliseconds interval)
+    : server_(server), action_(action), timer_(timer), interval_(interval) {
+  timer_.scheduleTimeout(this, interval_);
+}
+
+void ThriftServer::WorkerLoadAction::timeoutExpired() noexcept {
+  try {
+    (server_.*action_)();
+  } catch (std::exception const& e) {
+    LOG(ERROR) << e.what();
+  }
+  timer_.scheduleTimeout(this, interval_);
+}
+
 std::chrono::steady_clock::time_point ThriftServer::lastRequestTime() const
     noexcept {
   return std::chrono::steady_clock::time_point(
@@ -287,12 +331,29 @@ void ThriftServer::setup() {
         ServerBootstrap::socketConfig.fastOpenQueueSize = fastOpenQueueSize_;
       }
 
+      if (numaAware_) {
+        // Bind the IO threads to the nodes before they are started
+        auto factory = std::dynamic_pointer_cast<NamedThreadFactory>(
+            ioThreadPool_->getThreadFactory());
+        if (!std::dynamic_pointer_cast<NumaThreadFactory>(factory)) {
+          ioThreadPool_->setThreadFactory(std::make_shared<NumaThreadFactory>(
+              factory ? factory->getNamePrefix() : "ThriftIO"));
+        }
+      }
+
       // Resize the IO pool
       ioThreadPool_->setNumThreads(nWorkers);
       if (!acceptPool_) {
-        acceptPool_ = std::make_shared<folly::IOThreadPoolExecutor>(
-            nAcceptors_,
-            std::make_shared<folly::NamedThreadFactory>("Acceptor Thread"));
+        if (numaAware_) {
+          // One acceptor thread per node at least
+          acceptPool_ = std::make_shared<folly::IOThreadPoolExecutor>(
+              std::max<size_t>(nAcceptors_, NumaTopology::get().numNodes()),
+              std::make_shared<NumaThreadFactory>("Acceptor Thread"));
+        } else {
+          acceptPool_ = std::make_shared<folly::IOThreadPoolExecutor>(
+              nAcceptors_,
+              std::make_shared<folly::NamedThreadFactory>("Acceptor Thread"));
+        }
       }
 
       // Resize the SSL handshake pool
@@ -308,8 +369,13 @@ void ThriftServer::setup() {
         std::lock_guard<std::mutex> lock(ioGroupMutex_);
         ServerBootstrap::group(acceptPool_, ioThreadPool_);
       }
+      if (numaAware_) {
+        setupNumaWorkers();
+      }
       if (socket_) {
         ServerBootstrap::bind(std::move(socket_));
+      } else if (reusePortSteering_) {
+        bindWorkerListeners();
       } else if (port_ != -1) {
         ServerBootstrap::bind(port_);
       } else {
@@ -319,7 +385,22 @@ void ThriftServer::setup() {
       // (This is needed if we were supplied a pre-bound socket, or if
       // address_'s port was set to 0, so an ephemeral port was chosen by
       // the kernel.)
-      ServerBootstrap::getSockets()[0]->getAddress(&address_);
+      getSockets()[0]->getAddress(&address_);
+      if (!workerListeners_.empty() &&
+          steeringRebalanceInterval_.count() > 0) {
+        steeringRebalancer_.emplace(
+            *this,
+            &ThriftServer::rebalanceWorkerListeners,
+            serveEventBase_.load()->timer(),
+            steeringRebalanceInterval_);
+      }
+      if (connectionMigrationInterval_.count() > 0) {
+        connectionMigrator_.emplace(
+            *this,
+            &ThriftServer::migrateWorkerConnections,
+            serveEventBase_.load()->timer(),
+            connectionMigrationInterval_);
+      }
 
       // we enable zerocopy for the server socket if the
       // zeroCopyEnableFunc_ is valid
@@ -364,10 +445,21 @@ void ThriftServer::setupThreadManager() {
   if (!threadManager_) {
     auto nPoolThreads = getNumCPUWorkerThreads();
     int numThreads = nPoolThreads > 0 ? nPoolThreads : getNumIOWorkerThreads();
-    std::shared_ptr<apache::thrift::concurrency::ThreadManager> threadManager(
-        PriorityThreadManager::newPriorityThreadManager(
-            numThreads, true /*stats*/));
+    std::shared_ptr<apache::thrift::concurrency::ThreadManager> threadManager;
+    if (fairQueueHeader_) {
+      threadManager = ThreadManager::newFairQueueThreadManager(
+          numThreads, *fairQueueHeader_, fairQueueWeights_, true /*stats*/);
+    } else if (numaAware_) {
+      threadManager =
+          NumaThreadManager::newNumaThreadManager(numThreads, true /*stats*/);
+    } else {
+      threadManager = PriorityThreadManager::newPriorityThreadManager(
+          numThreads, true /*stats*/);
+    }
     threadManager->enableCodel(getEnableCodel());
+    if (adaptiveLifo_) {
+      threadManager->enableAdaptiveLifo(true);
+    }
     // If a thread factory has been specified, use it.
     if (threadFactory_) {
       threadManager->threadFactory(threadFactory_);
@@ -434,6 +526,8 @@ void ThriftServer::cleanUp() {
   // It is users duty to make sure that setup() call
   // should have returned before doing this cleanup
   idleServer_.reset();
+  steeringRebalancer_.reset();
+  connectionMigrator_.reset();
   serveEventBase_ = nullptr;
   stopListening();
 
@@ -498,13 +592,39 @@ void ThriftServer::stopWorkers() {
     return;
   }
   DCHECK(!duplexWorker_);
+  closeWorkerListeners();
   ServerBootstrap::stop();
   ServerBootstrap::join();
   sslHandshakePool_->join();
   configMutable_ = true;
 }
 
+void ThriftServer::drainRocketConnections() {
+  if (drainNoticePeriod_.count() == 0) {
+    return;
+  }
+  // The workers count the connections they send a notice to, and count
+  // them down as they close. Hold one count until all the notices are sent,
+  // so that the baton isn't posted while they are.
+  rocketConnectionsDrained_.reset();
+  drainingRocketConnections_.store(1);
+  forEachWorker([&](wangle::Acceptor* acceptor) {
+    if (auto worker = dynamic_cast<Cpp2Worker*>(acceptor)) {
+      worker->sendDrainNotices();
+    }
+  });
+  onRocketConnectionDrained();
+
+  if (!rocketConnectionsDrained_.try_wait_for(drainNoticePeriod_)) {
+    LOG(WARNING) << drainingRocketConnections_.load()
+                 << " rocket connections still open after the drain notice "
+                 << "period";
+  }
+}
+
 void ThriftServer::stopCPUWorkers() {
+  drainRocketConnections();
+
   forEachWorker([&](wangle::Acceptor* acceptor) {
     if (auto worker = dynamic_cast<Cpp2Worker*>(acceptor)) {
       worker->requestStop();
@@ -545,10 +665,13 @@ void ThriftServer::stopCPUWorkers() {
 }
 
 void ThriftServer::handleSetupFailure(void) {
+  closeWorkerListeners();
   ServerBootstrap::stop();
 
   // avoid crash on stop()
   idleServer_.reset();
+  steeringRebalancer_.reset();
+  connectionMigrator_.reset();
   serveEventBase_ = nullptr;
 }
 
@@ -632,6 +755,11 @@ bool ThriftServer::isOverloaded(
     return true;
   }
 
+  if (UNLIKELY(memoryTracker_ && memoryTracker_->exceeded())) {
+    memoryShedRequests_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
   uint32_t maxRequests = getMaxRequests();
   if (maxRequests > 0) {
     return static_cast<uint32_t>(getActiveRequests()) >= maxRequests;
@@ -640,6 +768,323 @@ bool ThriftServer::isOverloaded(
   return false;
 }
 
+std::shared_ptr<MemoryTracker> ThriftServer::getClientMemoryTracker(
+    const transport::THeader::StringToStringMap& headers) {
+  if (!clientMemoryHeader_) {
+    return nullptr;
+  }
+  auto it = headers.find(*clientMemoryHeader_);
+  if (it == headers.end() || it->second.empty()) {
+    return nullptr;
+  }
+  auto key = sanitizeClientKey(it->second);
+
+  {
+    auto trackers = clientMemoryTrackers_->rlock();
+    auto found = trackers->find(key);
+    if (found != trackers->end()) {
+      if (auto tracker = found->second.lock()) {
+        return tracker;
+      }
+    }
+  }
+
+  auto trackers = clientMemoryTrackers_->wlock();
+  auto found = trackers->find(key);
+  if (found != trackers->end()) {
+    if (auto tracker = found->second.lock()) {
+      return tracker;
+    }
+  } else if (trackers->size() >= maxMemoryClients_) {
+    return otherClientsMemoryTracker_;
+  }
+  // Erase the entry of the client once its last connection is gone, unless
+  // a new tracker replaced it meanwhile
+  std::shared_ptr<MemoryTracker> tracker(
+      new MemoryTracker(clientMemoryLimit_, memoryTracker_),
+      [weakTrackers = std::weak_ptr<ClientMemoryTrackers>(
+           clientMemoryTrackers_),
+       key](MemoryTracker* released) {
+        delete released;
+        if (auto sharedTrackers = weakTrackers.lock()) {
+          auto lockedTrackers = sharedTrackers->wlock();
+          auto entry = lockedTrackers->find(key);
+          if (entry != lockedTrackers->end() && entry->second.expired()) {
+            lockedTrackers->erase(entry);
+          }
+        }
+      });
+  (*trackers)[key] = tracker;
+  return tracker;
+}
+
+void ThriftServer::reportMemoryMetrics(
+    const AdmissionController::MetricReportFn& report,
+    const std::string& prefix) {
+  if (!memoryTracker_) {
+    return;
+  }
+
+  auto reportTracker = [&](const std::string& trackerPrefix,
+                           const MemoryTracker& tracker) {
+    report(trackerPrefix + "usage_bytes", tracker.getUsage());
+    report(trackerPrefix + "limit_bytes", tracker.getLimit());
+    report(
+        trackerPrefix + "paused_connections", tracker.getPausedConnections());
+    for (size_t i = 0;
+         i < static_cast<size_t>(MemoryTracker::MemoryUse::NUM_USES);
+         i++) {
+      auto use = static_cast<MemoryTracker::MemoryUse>(i);
+      report(
+          trackerPrefix + MemoryTracker::useName(use) + "_bytes",
+          tracker.getUsage(use));
+    }
+  };
+
+  reportTracker(prefix + "memory.", *memoryTracker_);
+  report(
+      prefix + "memory.shed_requests",
+      memoryShedRequests_.load(std::memory_order_relaxed));
+
+  if (otherClientsMemoryTracker_) {
+    reportTracker(
+        prefix + "memory.other_clients.", *otherClientsMemoryTracker_);
+  }
+
+  // Released outside of the lock, which the last one of a client takes
+  std::vector<std::pair<std::string, std::shared_ptr<MemoryTracker>>>
+      clientTrackers;
+  clientMemoryTrackers_->withRLock([&](const auto& trackers) {
+    for (const auto& entry : trackers) {
+      if (auto tracker = entry.second.lock()) {
+        clientTrackers.emplace_back(entry.first, std::move(tracker));
+      }
+    }
+  });
+  for (const auto& entry : clientTrackers) {
+    reportTracker(prefix + "memory.client." + entry.first + ".", *entry.second);
+  }
+}
+
+void ThriftServer::bindWorkerListeners() {
+  std::vector<std::shared_ptr<Cpp2Worker>> workers;
+  forEachWorker([&](wangle::Acceptor* acceptor) {
+    if (auto worker = dynamic_cast<Cpp2Worker*>(acceptor)) {
+      workers.push_back(worker->shared_from_this());
+    }
+  });
+
+  for (auto& worker : workers) {
+    auto* evb = worker->getEventBase();
+    std::shared_ptr<folly::AsyncServerSocket> socket;
+    folly::exception_wrapper ex;
+    evb->runImmediatelyOrRunInEventBaseThreadAndWait([&] {
+      try {
+        socket = folly::AsyncServerSocket::newSocket(evb);
+        socket->setReusePortEnabled(true);
+        // The listeners after the first one join its reuseport group
+        if (port_ != -1) {
+          socket->bind(workerListeners_.empty() ? port_ : address_.getPort());
+        } else {
+          socket->bind(address_);
+        }
+        if (workerListeners_.empty()) {
+          socket->getAddress(&address_);
+        }
+        // The index of a listener in the group is the order of listen()
+        socket->listen(socketConfig.acceptBacklog);
+        socket->setMaxNumMessagesInQueue(
+            socketConfig.maxNumPendingConnectionsPerWorker);
+        if (enableTFO_.value_or(false)) {
+          socket->setTFOEnabled(true, fastOpenQueueSize_);
+        }
+        socket->addAcceptCallback(worker.get(), evb);
+        socket->startAccepting();
+      } catch (...) {
+        ex = folly::exception_wrapper(std::current_exception());
+      }
+    });
+    if (ex) {
+      ex.throw_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock(workerListenersMutex_);
+      workerListeners_.push_back(std::move(socket));
+    }
+    listenerWorkers_.push_back(worker);
+  }
+
+  steering_ = std::make_unique<ReusePortSteering>(
+      workerListeners_.size(), sysconf(_SC_NPROCESSORS_CONF));
+  lastListenerRequests_.assign(workerListeners_.size(), 0);
+  attachSteering();
+}
+
+void ThriftServer::attachSteering() {
+  if (workerListeners_.empty() || !steering_) {
+    return;
+  }
+  // One reuseport group per address family
+  for (auto fd : workerListeners_[0]->getNetworkSockets()) {
+    if (!steering_->attach(fd.toFd())) {
+      LOG(WARNING) << "Failed to attach the listener steering program, "
+                   << "connections are spread by the kernel hash: "
+                   << folly::errnoStr(errno);
+    }
+  }
+}
+
+void ThriftServer::rebalanceWorkerListeners() {
+  if (!steering_) {
+    return;
+  }
+  std::vector<uint64_t> loads;
+  for (size_t i = 0; i < listenerWorkers_.size(); i++) {
+    auto worker = listenerWorkers_[i].lock();
+    uint64_t requests = worker ? worker->getNumRequests() : 0;
+    loads.push_back(requests - lastListenerRequests_[i]);
+    lastListenerRequests_[i] = requests;
+  }
+  if (steering_->rebalance(loads, steeringRebalanceThreshold_)) {
+    ++steeringRebalances_;
+    attachSteering();
+  }
+}
+
+void ThriftServer::closeWorkerListeners() {
+  std::vector<std::shared_ptr<folly::AsyncServerSocket>> listeners;
+  {
+    std::lock_guard<std::mutex> lock(workerListenersMutex_);
+    listeners.swap(workerListeners_);
+  }
+  for (auto& socket : listeners) {
+    // The listener must be destroyed in its thread
+    socket->getEventBase()->runImmediatelyOrRunInEventBaseThreadAndWait([&] {
+      socket->stopAccepting();
+      socket.reset();
+    });
+  }
+  listenerWorkers_.clear();
+  steering_.reset();
+}
+
+void ThriftServer::migrateWorkerConnections() {
+  std::vector<std::shared_ptr<Cpp2Worker>> workers;
+  forEachWorker([&](wangle::Acceptor* acceptor) {
+    if (auto worker = dynamic_cast<Cpp2Worker*>(acceptor)) {
+      workers.push_back(worker->shared_from_this());
+    }
+  });
+  lastMigrationRequests_.resize(workers.size(), 0);
+  std::vector<uint64_t> loads;
+  for (size_t i = 0; i < workers.size(); i++) {
+    auto requests = workers[i]->getNumRequests();
+    loads.push_back(requests - lastMigrationRequests_[i]);
+    lastMigrationRequests_[i] = requests;
+  }
+  if (workers.size() < 2) {
+    return;
+  }
+  auto total = std::accumulate(loads.begin(), loads.end(), uint64_t(0));
+  if (total == 0) {
+    return;
+  }
+  double average = static_cast<double>(total) / workers.size();
+  auto hot = std::max_element(loads.begin(), loads.end()) - loads.begin();
+  auto cold = std::min_element(loads.begin(), loads.end()) - loads.begin();
+  if (loads[hot] <= average * (1 + connectionMigrationThreshold_)) {
+    return;
+  }
+  ++connectionMigrationRounds_;
+  workers[hot]->migrateConnections(
+      workers[cold],
+      connectionMigrationMaxConnections_,
+      static_cast<double>(loads[hot] - loads[cold]) / (2 * loads[hot]));
+}
+
+void ThriftServer::reportWorkerMetrics(
+    const AdmissionController::MetricReportFn& report,
+    const std::string& prefix) {
+  size_t index = 0;
+  forEachWorker([&](wangle::Acceptor* acceptor) {
+    auto worker = dynamic_cast<Cpp2Worker*>(acceptor);
+    if (!worker) {
+      return;
+    }
+    auto workerPrefix = folly::to<std::string>(prefix, "worker.", index++, ".");
+    report(workerPrefix + "connections", worker->getNumConnections());
+    report(workerPrefix + "requests", worker->getNumRequests());
+    report(
+        workerPrefix + "migrated_connections",
+        worker->getNumMigratedConnections());
+  });
+  report(
+      prefix + "worker.steering_rebalances",
+      steeringRebalances_.load(std::memory_order_relaxed));
+  report(
+      prefix + "worker.connection_migrations",
+      connectionMigrationRounds_.load(std::memory_order_relaxed));
+}
+
+void ThriftServer::setupNumaWorkers() {
+  numaWorkers_.clear();
+  numaWorkers_.resize(NumaTopology::get().numNodes());
+  forEachWorker([&](wangle::Acceptor* acceptor) {
+    auto worker = dynamic_cast<Cpp2Worker*>(acceptor);
+    if (!worker) {
+      return;
+    }
+    // Threads the pool started before setup() are bound to no node, their
+    // workers are left out
+    int node = -1;
+    worker->getEventBase()->runImmediatelyOrRunInEventBaseThreadAndWait(
+        [&] { node = NumaTopology::boundNode(); });
+    worker->numaNode_ = node;
+    if (node >= 0) {
+      numaWorkers_[node].push_back(worker->shared_from_this());
+    }
+  });
+}
+
+std::shared_ptr<Cpp2Worker> ThriftServer::pickNumaWorker(int node) {
+  if (node < 0 || static_cast<size_t>(node) >= numaWorkers_.size() ||
+      numaWorkers_[node].empty()) {
+    return nullptr;
+  }
+  const auto& workers = numaWorkers_[node];
+  auto i = numaNextWorker_.fetch_add(1, std::memory_order_relaxed);
+  return workers[i % workers.size()].lock();
+}
+
+void ThriftServer::reportNumaMetrics(
+    const AdmissionController::MetricReportFn& report,
+    const std::string& prefix) {
+  report(
+      prefix + "numa.local_connections",
+      numaLocalConnections_.load(std::memory_order_relaxed));
+  report(
+      prefix + "numa.cross_node_connections",
+      numaCrossNodeConnections_.load(std::memory_order_relaxed));
+  report(
+      prefix + "numa.steered_connections",
+      numaSteeredConnections_.load(std::memory_order_relaxed));
+
+  auto numaThreadManager =
+      std::dynamic_pointer_cast<NumaThreadManager>(threadManager_);
+  if (!numaThreadManager) {
+    return;
+  }
+  for (size_t node = 0; node < numaThreadManager->numNodes(); node++) {
+    report(
+        folly::to<std::string>(prefix, "numa.node", node, ".tasks"),
+        numaThreadManager->getNodeTaskCount(node));
+  }
+  // Requests handed over by threads bound to no node, e.g. IO threads the
+  // pool started before setup()
+  report(
+      prefix + "numa.unbound_tasks", numaThreadManager->getUnboundTaskCount());
+}
+
 std::string ThriftServer::getLoadInfo(int64_t load) const {
   auto ioGroup = getIOGroupSafe();
   auto workerFactory = ioGroup != nullptr
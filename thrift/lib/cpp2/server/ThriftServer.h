@@ -22,17 +22,21 @@
 #include <cstdlib>
 #include <map>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <folly/Memory.h>
 #include <folly/Singleton.h>
 #include <folly/SocketAddress.h>
+#include <folly/Synchronized.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/experimental/observer/Observer.h>
 #include <folly/io/ShutdownSocketSet.h>
 #include <folly/io/async/AsyncServerSocket.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/EventBaseManager.h>
+#include <folly/synchronization/Baton.h>
 #include <thrift/lib/cpp/concurrency/PosixThreadFactory.h>
 #include <thrift/lib/cpp/concurrency/ThreadManager.h>
 #include <thrift/lib/cpp/server/TServerObserver.h>
@@ -40,8 +44,11 @@
 #include <thrift/lib/cpp2/Thrift.h>
 #include <thrift/lib/cpp2/async/AsyncProcessor.h>
 #include <thrift/lib/cpp2/async/HeaderServerChannel.h>
+#include <thrift/lib/cpp2/server/AdmissionController.h>
 #include <thrift/lib/cpp2/server/BaseThriftServer.h>
+#include <thrift/lib/cpp2/server/MemoryTracker.h>
 #include <thrift/lib/cpp2/server/RequestsRegistry.h>
+#include <thrift/lib/cpp2/server/ReusePortSteering.h>
 #include <thrift/lib/cpp2/server/TransportRoutingHandler.h>
 #include <thrift/lib/cpp2/transport/core/ThriftProcessor.h>
 #include <wangle/acceptor/ServerSocketConfig.h>
@@ -165,6 +172,117 @@ class ThriftServer : public apache::thrift::BaseThriftServer,
 
   bool stopWorkersOnStopListening_ = true;
   std::chrono::seconds workersJoinTimeout_{30};
+  // See setDrainNoticePeriod()
+  std::chrono::milliseconds drainNoticePeriod_{0};
+  // Rocket connections sent a drain notice and not closed yet, plus one while
+  // drainRocketConnections() sends the notices. Posts the baton at 0.
+  std::atomic<size_t> drainingRocketConnections_{0};
+  folly::Baton<> rocketConnectionsDrained_;
+
+  // Called by the workers from their IO thread
+  void onRocketConnectionDraining() {
+    drainingRocketConnections_.fetch_add(1, std::memory_order_relaxed);
+  }
+  void onRocketConnectionDrained() {
+    if (drainingRocketConnections_.fetch_sub(1, std::memory_order_acq_rel) ==
+        1) {
+      rocketConnectionsDrained_.post();
+    }
+  }
+
+  // If set, the default thread manager serves the requests in turn for each
+  // value of this header, see setFairQueuing()
+  folly::Optional<std::string> fairQueueHeader_;
+  std::unordered_map<std::string, uint32_t> fairQueueWeights_;
+
+  // Whether the default thread manager serves the requests newest first
+  // under overload, see setAdaptiveLifo()
+  bool adaptiveLifo_{false};
+
+  // Bytes buffered by the rocket connections of the server, nullptr unless
+  // one of the memory limits is set, see setServerMemoryLimit()
+  std::shared_ptr<MemoryTracker> memoryTracker_;
+  size_t connectionMemoryLimit_{0};
+  folly::Optional<std::string> clientMemoryHeader_;
+  size_t clientMemoryLimit_{0};
+  size_t maxMemoryClients_{0};
+  // Trackers of the clients with connections, keyed by the sanitized value
+  // of the client header. A tracker erases its entry once released, hence
+  // the shared_ptr: the last connections may outlive the server.
+  using ClientMemoryTrackers = folly::Synchronized<
+      std::unordered_map<std::string, std::weak_ptr<MemoryTracker>>>;
+  std::shared_ptr<ClientMemoryTrackers> clientMemoryTrackers_{
+      std::make_shared<ClientMemoryTrackers>()};
+  // Shared by the clients past maxMemoryClients_
+  std::shared_ptr<MemoryTracker> otherClientsMemoryTracker_;
+  mutable std::atomic<uint64_t> memoryShedRequests_{0};
+
+  MemoryTracker& getOrCreateMemoryTracker() {
+    if (!memoryTracker_) {
+      memoryTracker_ = std::make_shared<MemoryTracker>();
+    }
+    return *memoryTracker_;
+  }
+
+  // Whether the IO, acceptor and CPU threads are partitioned by NUMA node,
+  // see setNumaAware()
+  bool numaAware_{false};
+  bool numaSteering_{false};
+  // Cpp2Workers whose IO thread is bound to each node, filled by setup()
+  std::vector<std::vector<std::weak_ptr<Cpp2Worker>>> numaWorkers_;
+  std::atomic<size_t> numaNextWorker_{0};
+  std::atomic<uint64_t> numaLocalConnections_{0};
+  std::atomic<uint64_t> numaCrossNodeConnections_{0};
+  std::atomic<uint64_t> numaSteeredConnections_{0};
+
+  void setupNumaWorkers();
+
+  // A Cpp2Worker whose IO thread is bound to `node`, nullptr if none
+  std::shared_ptr<Cpp2Worker> pickNumaWorker(int node);
+
+  // Runs `action` on the serve EventBase every `interval`
+  struct WorkerLoadAction : public folly::HHWheelTimer::Callback {
+    WorkerLoadAction(
+        ThriftServer& server,
+        void (ThriftServer::*action)(),
+        folly::HHWheelTimer& timer,
+        std::chrono::milliseconds interval);
+
+    void timeoutExpired() noexcept override;
+
+    ThriftServer& server_;
+    void (ThriftServer::*action_)();
+    folly::HHWheelTimer& timer_;
+    std::chrono::milliseconds interval_;
+  };
+
+  // One SO_REUSEPORT listener per IO thread, see setReusePortSteering().
+  // workerListeners_[i] is served by listenerWorkers_[i] only.
+  bool reusePortSteering_{false};
+  std::chrono::milliseconds steeringRebalanceInterval_{0};
+  double steeringRebalanceThreshold_{0};
+  // Only changed by the serve thread, which may read it without the mutex.
+  // Other threads read it through getSockets().
+  std::vector<std::shared_ptr<folly::AsyncServerSocket>> workerListeners_;
+  mutable std::mutex workerListenersMutex_;
+  std::vector<std::weak_ptr<Cpp2Worker>> listenerWorkers_;
+  std::unique_ptr<ReusePortSteering> steering_;
+  std::vector<uint64_t> lastListenerRequests_;
+  std::atomic<uint64_t> steeringRebalances_{0};
+  folly::Optional<WorkerLoadAction> steeringRebalancer_;
+
+  void bindWorkerListeners();
+  void attachSteering();
+  void rebalanceWorkerListeners();
+  void closeWorkerListeners();
+
+  // See setConnectionMigration()
+  std::chrono::milliseconds connectionMigrationInterval_{0};
+  double connectionMigrationThreshold_{0};
+  size_t connectionMigrationMaxConnections_{0};
+  std::vector<uint64_t> lastMigrationRequests_;
+  std::atomic<uint64_t> connectionMigrationRounds_{0};
+  folly::Optional<WorkerLoadAction> connectionMigrator_;
 
   folly::AsyncWriter::ZeroCopyEnableFunc zeroCopyEnableFunc_;
 
@@ -630,6 +748,13 @@ class ThriftServer : public apache::thrift::BaseThriftServer,
    */
   void stopCPUWorkers();
 
+  /**
+   * Send a drain notice over the rocket connections and wait for their
+   * clients to close them, for up to setDrainNoticePeriod(). Called by
+   * stopCPUWorkers().
+   */
+  void drainRocketConnections();
+
   /**
    * Set whether to stop io workers when stopListening() is called (we do stop
    * them by default).
@@ -646,6 +771,19 @@ class ThriftServer : public apache::thrift::BaseThriftServer,
     return stopWorkersOnStopListening_;
   }
 
+  /**
+   * When stopping, first send a drain notice over every rocket connection
+   * and keep serving requests normally for up to `period`, or until the
+   * clients closed all these connections, before rejecting new requests.
+   * Clients which handle the notice, e.g. through ReconnectingRequestChannel,
+   * move their new requests to another connection meanwhile instead of
+   * failing them. 0, the default, stops without notice.
+   */
+  void setDrainNoticePeriod(std::chrono::milliseconds period) {
+    CHECK(configMutable());
+    drainNoticePeriod_ = period;
+  }
+
   /**
    * Sets the timeout for joining workers
    */
@@ -703,6 +841,216 @@ class ThriftServer : public apache::thrift::BaseThriftServer,
    */
   void setupThreadManager();
 
+  /**
+   * Have the default thread manager serve the queued requests in turn for
+   * each value of the request header `headerName` (e.g. a client id) instead
+   * of in arrival order, so that a client flooding the server doesn't hold
+   * up the others. The requests of a value with weight N are served N at a
+   * time; values missing from `weights`, and requests without the header,
+   * have weight 1. Request priorities are ignored in that mode.
+   * Must be called before the thread manager is set up.
+   */
+  void setFairQueuing(
+      const std::string& headerName,
+      std::unordered_map<std::string, uint32_t> weights = {}) {
+    CHECK(configMutable());
+    CHECK(!threadManager_);
+    fairQueueHeader_ = headerName;
+    fairQueueWeights_ = std::move(weights);
+  }
+
+  /**
+   * Have the default thread manager serve the queued requests newest first
+   * while CoDel detects a standing queue, and drop the requests whose client
+   * timeout passed from the other end of the queue, so that under overload
+   * the server keeps answering some requests in time instead of answering
+   * all of them too late. See ThreadManager::enableAdaptiveLifo().
+   * Not supported together with setFairQueuing().
+   * Must be called before the thread manager is set up.
+   */
+  void setAdaptiveLifo(bool enabled) {
+    CHECK(configMutable());
+    CHECK(!threadManager_);
+    adaptiveLifo_ = enabled;
+  }
+
+  /**
+   * Bound the bytes a rocket connection buffers for its requests and
+   * responses: its read buffer, the fragments of requests not fully
+   * received, the payloads of the requests being queued or processed and the
+   * responses the socket hasn't taken yet. Past the limit, the connection
+   * stops reading from its socket until the usage drops back under it.
+   * 0 means no limit.
+   */
+  void setConnectionMemoryLimit(size_t bytes) {
+    CHECK(configMutable());
+    getOrCreateMemoryTracker();
+    connectionMemoryLimit_ = bytes;
+  }
+
+  /**
+   * Same as setConnectionMemoryLimit(), over all the connections whose
+   * requests carry the same value of the header `headerName` (e.g. a client
+   * id). A connection is attributed to the client of the first of its
+   * requests with the header. The header is client input: only its first 64
+   * characters count, other characters than letters, digits, '-' and '_'
+   * are replaced with '_', and past `maxClients` clients with connections,
+   * the connections of new clients share a single budget of `bytes`.
+   */
+  void setClientMemoryLimit(
+      const std::string& headerName,
+      size_t bytes,
+      size_t maxClients = 1000) {
+    CHECK(configMutable());
+    getOrCreateMemoryTracker();
+    clientMemoryHeader_ = headerName;
+    clientMemoryLimit_ = bytes;
+    maxMemoryClients_ = maxClients;
+    otherClientsMemoryTracker_ =
+        std::make_shared<MemoryTracker>(bytes, memoryTracker_);
+  }
+
+  /**
+   * Bound the bytes buffered over all the rocket connections of the server.
+   * Past the limit, new requests are rejected as if the server was
+   * overloaded, see isOverloaded(). 0 means no limit, the usage is then only
+   * tracked for the gauges of reportMemoryMetrics().
+   */
+  void setServerMemoryLimit(size_t bytes) {
+    CHECK(configMutable());
+    getOrCreateMemoryTracker().setLimit(bytes);
+  }
+
+  /**
+   * Tracker for the memory of a new rocket connection, nullptr if no memory
+   * limit was set.
+   */
+  std::shared_ptr<MemoryTracker> newConnectionMemoryTracker() const {
+    if (!memoryTracker_) {
+      return nullptr;
+    }
+    return std::make_shared<MemoryTracker>(
+        connectionMemoryLimit_, memoryTracker_);
+  }
+
+  /**
+   * Tracker shared by the connections of the client identified by `headers`,
+   * nullptr if there is no client memory limit or the client header is
+   * missing.
+   */
+  std::shared_ptr<MemoryTracker> getClientMemoryTracker(
+      const transport::THeader::StringToStringMap& headers);
+
+  /**
+   * Report the memory usage of the server, broken down by use, and of each
+   * client with connections, the clients past the maximum of
+   * setClientMemoryLimit() being reported together as other_clients.
+   */
+  void reportMemoryMetrics(
+      const AdmissionController::MetricReportFn& report,
+      const std::string& prefix);
+
+  /**
+   * Partition the server by NUMA node: the IO threads, the acceptor threads
+   * and the threads of the default thread manager are spread evenly over the
+   * nodes and bound to the CPUs of their node, and a request is processed by
+   * a thread of the node of the IO thread which read it (see
+   * NumaThreadManager), so that it stays on one node from accept through
+   * response. The IO thread pool must not have started its threads yet.
+   * Must be called before the thread manager is set up.
+   */
+  void setNumaAware(bool enabled) {
+    CHECK(configMutable());
+    CHECK(!threadManager_);
+    numaAware_ = enabled;
+  }
+
+  bool isNumaAware() const {
+    return numaAware_;
+  }
+
+  /**
+   * In NUMA mode, hand each new plaintext connection over to an IO thread of
+   * the node of the CPU its packets are received on (SO_INCOMING_CPU), when
+   * it was accepted by an IO thread of another node. Without it, those
+   * connections are only counted, see reportNumaMetrics().
+   */
+  void setNumaSteering(bool enabled) {
+    CHECK(configMutable());
+    numaSteering_ = enabled;
+  }
+
+  /**
+   * Listen with one SO_REUSEPORT socket per IO thread, each serving its own
+   * thread only, instead of with the sockets of the acceptor threads, and
+   * attach a BPF program to the group which picks the listener by the CPU
+   * receiving the connection. Connections are then accepted and served by the
+   * same IO thread, and spread over the IO threads as the NIC spreads them
+   * over the CPUs rather than by the kernel hash.
+   *
+   * Every `rebalanceInterval` (0 to never rebalance), if the requests an IO
+   * thread received during the interval exceed the average by more than
+   * `threshold`, one of its CPUs is assigned to the least loaded IO thread
+   * instead. This only moves new connections, the established ones stay on
+   * their IO thread.
+   *
+   * Ignored with useExistingSocket(). Without kernel support for the BPF
+   * program, the kernel hash picks the listener.
+   */
+  void setReusePortSteering(
+      bool enabled,
+      std::chrono::milliseconds rebalanceInterval = std::chrono::seconds(1),
+      double threshold = 0.25) {
+    CHECK(configMutable());
+    reusePortSteering_ = enabled;
+    steeringRebalanceInterval_ = rebalanceInterval;
+    steeringRebalanceThreshold_ = threshold;
+  }
+
+  /**
+   * Every `interval` (0 to disable), if the requests an IO thread received
+   * during the interval exceed the average by more than `threshold`, move up
+   * to `maxConnections` of its rocket connections to the least loaded IO
+   * thread. A connection moves once it has no request, stream or write in
+   * flight; those carrying more than half of the gap between the two IO
+   * threads stay, as moving them would only move the hot spot. Connections
+   * set up by a custom SetupFrameHandler and header connections never move.
+   */
+  void setConnectionMigration(
+      std::chrono::milliseconds interval,
+      double threshold = 0.25,
+      size_t maxConnections = 1) {
+    CHECK(configMutable());
+    connectionMigrationInterval_ = interval;
+    connectionMigrationThreshold_ = threshold;
+    connectionMigrationMaxConnections_ = maxConnections;
+  }
+
+  /**
+   * Check the load of the IO threads and migrate connections as configured
+   * by setConnectionMigration(), as its timer does. Call from the serve
+   * thread.
+   */
+  void migrateWorkerConnections();
+
+  /**
+   * Report the connections, the requests received so far and the
+   * connections migrated in of each IO thread, as worker.<index>.*, and how
+   * many times the listeners were rebalanced and connections were migrated.
+   */
+  void reportWorkerMetrics(
+      const AdmissionController::MetricReportFn& report,
+      const std::string& prefix);
+
+  /**
+   * Report how many connections were accepted on the node their packets are
+   * received on, on another node, and how many of the latter were steered,
+   * as well as the tasks the NUMA thread manager ran on each node.
+   */
+  void reportNumaMetrics(
+      const AdmissionController::MetricReportFn& report,
+      const std::string& prefix);
+
   /**
    * Kill the workers and wait for listeners to quit
    */
@@ -803,6 +1151,9 @@ class ThriftServer : public apache::thrift::BaseThriftServer,
       serverSockets.push_back(
           std::dynamic_pointer_cast<folly::AsyncServerSocket>(socket));
     }
+    std::lock_guard<std::mutex> lock(workerListenersMutex_);
+    serverSockets.insert(
+        serverSockets.end(), workerListeners_.begin(), workerListeners_.end());
     return serverSockets;
   }
 
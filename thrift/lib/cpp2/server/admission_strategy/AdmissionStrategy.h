@@ -26,7 +26,13 @@ namespace thrift {
 
 class AdmissionStrategy {
  public:
-  enum Type { ACCEPT_ALL = 0, GLOBAL = 1, PER_CLIENT_ID = 2, PRIORITY = 3 };
+  enum Type {
+    ACCEPT_ALL = 0,
+    GLOBAL = 1,
+    PER_CLIENT_ID = 2,
+    PRIORITY = 3,
+    COST = 4,
+  };
 
   using MetricReportFn =
       folly::Function<void(const std::string&, double) const>;
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+
+#include <folly/Synchronized.h>
+
+#include <thrift/lib/cpp2/server/AdmissionController.h>
+#include <thrift/lib/cpp2/server/CostAdmissionController.h>
+#include <thrift/lib/cpp2/server/admission_strategy/AdmissionStrategy.h>
+
+namespace apache {
+namespace thrift {
+
+/**
+ * CostAdmissionStrategy gives each clientId a budget of queued CPU time, and
+ * admits the requests of the client based on the estimated cost of their
+ * method (see CostAdmissionController).
+ *
+ * For instance, a map like this one:
+ * {"web": 10ms, "batch": 100ms, "*": 20ms}
+ * lets "web" queue up to 10ms of work, "batch" up to 100ms, and any other
+ * clientId up to 20ms (in a budget shared by all of them).
+ * If "*" is not specified, all requests with a non-recognized clientId will
+ * be rejected.
+ *
+ * The cost of a method is learned from the CPU time its requests take in the
+ * thread manager, whichever client sent them.
+ */
+template <class Clock = std::chrono::steady_clock>
+class CostAdmissionStrategy : public AdmissionStrategy {
+  using Controller = CostAdmissionController<Clock>;
+  using ControllerMap =
+      std::unordered_map<std::string, std::shared_ptr<AdmissionController>>;
+
+  struct Client {
+    Client(
+        std::chrono::nanoseconds limit,
+        std::shared_ptr<typename Controller::MethodCost> otherMethodsCost)
+        : budget(std::make_shared<typename Controller::Budget>(limit)),
+          otherMethods(std::make_shared<Controller>(
+              budget,
+              std::move(otherMethodsCost))) {}
+
+    std::shared_ptr<typename Controller::Budget> budget;
+    // One controller per method called by the client, among the methods
+    // which have a cost of their own
+    folly::Synchronized<ControllerMap> controllers;
+    // Controller of the methods beyond maxMethods
+    std::shared_ptr<AdmissionController> otherMethods;
+  };
+
+ public:
+  using Duration = typename Clock::duration;
+
+  /**
+   * Create a CostAdmissionStrategy
+   *
+   * `budgets` is a map of clientId to queued CPU time budget.
+   * `clientIdHeaderName` is the header read from request headers to
+   * identify a client
+   * `window` is the window of the EWMA of the method costs
+   * `initialCost` is the cost assumed for a method until its first request
+   * has run
+   * `maxMethods` is the number of methods which get a cost of their own. The
+   * method name comes from the request before the processor checks it, so
+   * any further names share one cost, which bounds the memory a client
+   * sending made up names can use.
+   */
+  CostAdmissionStrategy(
+      const std::unordered_map<std::string, std::chrono::nanoseconds>& budgets,
+      const std::string& clientIdHeaderName,
+      Duration window = std::chrono::seconds(10),
+      std::chrono::nanoseconds initialCost = std::chrono::milliseconds(1),
+      size_t maxMethods = 1000)
+      : clientIdHeaderName_(clientIdHeaderName),
+        window_(window),
+        initialCost_(initialCost),
+        maxMethods_(maxMethods),
+        otherMethodsCost_(std::make_shared<typename Controller::MethodCost>(
+            window,
+            initialCost)),
+        denyAdmissionController_(
+            std::make_shared<DenyAllAdmissionController>()) {
+    for (const auto& entry : budgets) {
+      clients_.emplace(
+          entry.first,
+          std::make_unique<Client>(entry.second, otherMethodsCost_));
+    }
+  }
+
+  ~CostAdmissionStrategy() {}
+
+  /**
+   * Select an AdmissionController to be used for this specific request.
+   * It returns one shared AdmissionController per clientId and method, or
+   * per clientId for the methods beyond maxMethods.
+   */
+  std::shared_ptr<AdmissionController> select(
+      const std::string& methodName,
+      const transport::THeader* theader) override {
+    auto* client = getClient(theader);
+    if (client == nullptr) {
+      return denyAdmissionController_;
+    }
+
+    {
+      // Fast path
+      auto controllers = client->controllers.rlock();
+      auto it = controllers->find(methodName);
+      if (it != controllers->end()) {
+        return it->second;
+      }
+    }
+
+    // Slow path, initialization of the admission controller
+    auto methodCost = getMethodCost(methodName);
+    if (!methodCost) {
+      return client->otherMethods;
+    }
+    auto controllers = client->controllers.wlock();
+    auto it = controllers->find(methodName);
+    if (it != controllers->end()) {
+      return it->second;
+    }
+    auto controller =
+        std::make_shared<Controller>(client->budget, std::move(methodCost));
+    controllers->insert({methodName, controller});
+    return controller;
+  }
+
+  void reportMetrics(
+      const AdmissionStrategy::MetricReportFn& report,
+      const std::string& prefix) override {
+    for (const auto& entry : clients_) {
+      const auto newPrefix = prefix + "cost." + entry.first + ".";
+      const auto& budget = *entry.second->budget;
+      report(newPrefix + "queue_size", budget.getQueueSize());
+      report(newPrefix + "pending_ns", budget.getPending());
+      report(newPrefix + "budget_ns", budget.getLimit());
+    }
+
+    auto methodCosts = methodCosts_.rlock();
+    for (const auto& entry : *methodCosts) {
+      report(
+          prefix + "cost.method." + entry.first + ".estimate_ns",
+          entry.second->estimate());
+    }
+    report(
+        prefix + "cost.other_methods.estimate_ns",
+        otherMethodsCost_->estimate());
+  }
+
+  Type getType() override {
+    return AdmissionStrategy::COST;
+  }
+
+ private:
+  Client* getClient(const transport::THeader* theader) {
+    if (theader != nullptr) {
+      const auto& headers = theader->getHeaders();
+      auto clientIdIt = headers.find(clientIdHeaderName_);
+      if (clientIdIt != headers.end()) {
+        auto it = clients_.find(clientIdIt->second);
+        if (it != clients_.end()) {
+          return it->second.get();
+        }
+      }
+    }
+    auto it = clients_.find(kWildcard);
+    return it == clients_.end() ? nullptr : it->second.get();
+  }
+
+  std::shared_ptr<typename Controller::MethodCost> getMethodCost(
+      const std::string& methodName) {
+    {
+      auto methodCosts = methodCosts_.rlock();
+      auto it = methodCosts->find(methodName);
+      if (it != methodCosts->end()) {
+        return it->second;
+      }
+    }
+    auto methodCosts = methodCosts_.wlock();
+    auto it = methodCosts->find(methodName);
+    if (it != methodCosts->end()) {
+      return it->second;
+    }
+    if (methodCosts->size() >= maxMethods_) {
+      return nullptr;
+    }
+    auto methodCost = std::make_shared<typename Controller::MethodCost>(
+        window_, initialCost_);
+    methodCosts->emplace(methodName, methodCost);
+    return methodCost;
+  }
+
+  const std::string clientIdHeaderName_;
+  const Duration window_;
+  const std::chrono::nanoseconds initialCost_;
+  const size_t maxMethods_;
+  // Shared by the methods beyond maxMethods_
+  const std::shared_ptr<typename Controller::MethodCost> otherMethodsCost_;
+  // Only modified in the constructor
+  std::unordered_map<std::string, std::unique_ptr<Client>> clients_;
+  folly::Synchronized<std::unordered_map<
+      std::string,
+      std::shared_ptr<typename Controller::MethodCost>>>
+      methodCosts_;
+  std::shared_ptr<AdmissionController> denyAdmissionController_;
+};
+
+} // namespace thrift
+} // namespace apache
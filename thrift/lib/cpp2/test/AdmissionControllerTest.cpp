@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <thrift/lib/cpp2/server/CostAdmissionController.h>
 #include <thrift/lib/cpp2/server/QIAdmissionController.h>
 #include <thrift/lib/cpp2/server/SLAViolationController.h>
 
@@ -281,5 +282,76 @@ TEST_F(AdmissionControllerTest, SLAViolationControllerDecayTest) {
   EXPECT_TRUE(controller.admit());
 }
 
+TEST_F(AdmissionControllerTest, costBudget) {
+  using Controller = CostAdmissionController<FakeClock>;
+  auto budget = std::make_shared<Controller::Budget>(milliseconds(100));
+  Controller scan(
+      budget,
+      std::make_shared<Controller::MethodCost>(seconds(1), milliseconds(50)));
+  Controller lookup(
+      budget,
+      std::make_shared<Controller::MethodCost>(seconds(1), microseconds(50)));
+
+  // two scans fill the budget, leaving no room even for a lookup
+  ASSERT_TRUE(scan.admit());
+  ASSERT_TRUE(scan.admit());
+  ASSERT_FALSE(scan.admit());
+  ASSERT_FALSE(lookup.admit());
+
+  // but the room of one scan holds a thousand lookups
+  scan.dequeue();
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_TRUE(lookup.admit());
+  }
+  ASSERT_FALSE(lookup.admit());
+  ASSERT_EQ(budget->getQueueSize(), 1001);
+
+  scan.dequeue();
+  for (int i = 0; i < 1000; i++) {
+    lookup.dequeue();
+  }
+  ASSERT_EQ(budget->getQueueSize(), 0);
+  ASSERT_EQ(budget->getPending(), 0);
+
+  // a request costing more than the budget is admitted in an empty queue
+  Controller huge(
+      budget, std::make_shared<Controller::MethodCost>(seconds(1), seconds(1)));
+  ASSERT_TRUE(huge.admit());
+  ASSERT_FALSE(lookup.admit());
+  huge.dequeue();
+  ASSERT_TRUE(lookup.admit());
+}
+
+TEST_F(AdmissionControllerTest, costLearned) {
+  using Controller = CostAdmissionController<FakeClock>;
+  auto budget = std::make_shared<Controller::Budget>(milliseconds(100));
+  auto methodCost =
+      std::make_shared<Controller::MethodCost>(seconds(1), milliseconds(1));
+  Controller scan(budget, methodCost);
+  // only controllers which learn from the CPU time make requests measure it
+  ASSERT_TRUE(scan.needsCpuTime());
+  ASSERT_FALSE(AcceptAllAdmissionController().needsCpuTime());
+
+  // unknown yet, the scans are admitted at their initial cost
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(scan.admit());
+  }
+  ASSERT_FALSE(scan.admit());
+
+  // each of them takes 50ms of CPU, and also waits 1s for a downstream
+  // service, which doesn't count
+  for (int i = 0; i < 100; i++) {
+    scan.dequeue();
+    FakeClock::advance(milliseconds(50));
+    scan.consumedCpuTime(milliseconds(50));
+    scan.returnedResponse(milliseconds(1050));
+  }
+  ASSERT_NEAR(methodCost->estimate(), 50e6, 5e6);
+
+  ASSERT_TRUE(scan.admit());
+  ASSERT_TRUE(scan.admit());
+  ASSERT_FALSE(scan.admit());
+}
+
 } // namespace thrift
 } // namespace apache
@@ -18,12 +18,14 @@
 
 #include <thrift/lib/cpp2/server/Cpp2ConnContext.h>
 #include <thrift/lib/cpp2/server/QIAdmissionController.h>
+#include <thrift/lib/cpp2/server/admission_strategy/CostAdmissionStrategy.h>
 #include <thrift/lib/cpp2/server/admission_strategy/GlobalAdmissionStrategy.h>
 #include <thrift/lib/cpp2/server/admission_strategy/PerClientIdAdmissionStrategy.h>
 #include <thrift/lib/cpp2/server/admission_strategy/PriorityAdmissionStrategy.h>
 #include <thrift/lib/cpp2/server/admission_strategy/WhitelistAdmissionStrategy.h>
 
 #include <chrono>
+#include <deque>
 
 #include <gtest/gtest.h>
 
@@ -280,5 +282,165 @@ TEST_F(AdmissionControllerSelectorTest, priorityMetricsAggregated) {
   ASSERT_EQ(metrics.at("my_prefix.priority.*.priority"), priorities["*"]);
 }
 
+TEST_F(AdmissionControllerSelectorTest, costClientBudgets) {
+  CostAdmissionStrategy<FakeClock> selector(
+      {{"A", milliseconds(10)}}, kClientId, seconds(1), milliseconds(5));
+
+  THeader headerA;
+  headerA.setReadHeaders({{kClientId, "A"}});
+  THeader headerB;
+  headerB.setReadHeaders({{kClientId, "B"}});
+
+  // one controller per method, sharing the budget of the client
+  auto controller1 = selector.select("method1", &headerA);
+  auto controller2 = selector.select("method2", &headerA);
+  ASSERT_EQ(controller1, selector.select("method1", &headerA));
+  ASSERT_NE(controller1, controller2);
+  ASSERT_TRUE(controller1->admit());
+  ASSERT_TRUE(controller2->admit());
+  ASSERT_FALSE(controller1->admit());
+
+  // no wildcard, unknown clients are rejected
+  ASSERT_FALSE(selector.select("method1", &headerB)->admit());
+  ASSERT_FALSE(selector.select("method1", nullptr)->admit());
+
+  std::unordered_map<std::string, double> metrics;
+  selector.reportMetrics(
+      [&metrics](auto key, auto value) { metrics.emplace(key, value); },
+      "my_prefix.");
+  ASSERT_EQ(metrics.at("my_prefix.cost.A.queue_size"), 2);
+  ASSERT_EQ(metrics.at("my_prefix.cost.A.pending_ns"), 10e6);
+  ASSERT_EQ(metrics.at("my_prefix.cost.A.budget_ns"), 10e6);
+  ASSERT_EQ(metrics.at("my_prefix.cost.method.method1.estimate_ns"), 5e6);
+  ASSERT_EQ(metrics.at("my_prefix.cost.method.method2.estimate_ns"), 5e6);
+}
+
+TEST_F(AdmissionControllerSelectorTest, costMethodLimit) {
+  CostAdmissionStrategy<FakeClock> selector(
+      {{"A", milliseconds(10)}, {"B", milliseconds(10)}},
+      kClientId,
+      seconds(1),
+      milliseconds(5),
+      2);
+
+  THeader headerA;
+  headerA.setReadHeaders({{kClientId, "A"}});
+  THeader headerB;
+  headerB.setReadHeaders({{kClientId, "B"}});
+
+  auto controller1 = selector.select("method1", &headerA);
+  auto controller2 = selector.select("method2", &headerA);
+  ASSERT_NE(controller1, controller2);
+
+  // the methods beyond the limit share one controller per client
+  auto other = selector.select("method3", &headerA);
+  ASSERT_NE(other, controller1);
+  ASSERT_NE(other, controller2);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(other, selector.select(std::to_string(i), &headerA));
+  }
+  ASSERT_NE(other, selector.select("method3", &headerB));
+  ASSERT_EQ(controller1, selector.select("method1", &headerA));
+
+  std::unordered_map<std::string, double> metrics;
+  selector.reportMetrics(
+      [&metrics](auto key, auto value) { metrics.emplace(key, value); }, "");
+  ASSERT_EQ(metrics.count("cost.method.method1.estimate_ns"), 1);
+  ASSERT_EQ(metrics.count("cost.method.method2.estimate_ns"), 1);
+  ASSERT_EQ(metrics.count("cost.method.method3.estimate_ns"), 0);
+  ASSERT_EQ(metrics.at("cost.other_methods.estimate_ns"), 5e6);
+  ASSERT_EQ(metrics.size(), 9);
+}
+
+TEST_F(AdmissionControllerSelectorTest, costSimulation) {
+  // One worker serves the 50us lookups of "web", one every millisecond, and
+  // the 50ms scans of "batch", one every 10ms: five times more scans than it
+  // can process.
+  CostAdmissionStrategy<FakeClock> selector(
+      {{"web", milliseconds(10)}, {"batch", milliseconds(100)}},
+      kClientId,
+      milliseconds(100),
+      milliseconds(10));
+  THeader web;
+  web.setReadHeaders({{kClientId, "web"}});
+  THeader batch;
+  batch.setReadHeaders({{kClientId, "batch"}});
+
+  struct Request {
+    std::shared_ptr<AdmissionController> controller;
+    nanoseconds cost;
+    FakeClock::time_point admitted;
+  };
+  std::deque<Request> queue;
+  Request running;
+  bool busy = false;
+  nanoseconds remaining(0);
+
+  struct Stats {
+    int offered{0};
+    int admitted{0};
+    nanoseconds maxWait{0};
+  };
+  Stats lookups;
+  Stats scans;
+
+  const auto tick = microseconds(50);
+  const auto warmup = seconds(3);
+  for (nanoseconds t(0); t < seconds(13); t += tick) {
+    const bool measuring = t >= warmup;
+    auto arrive = [&](const THeader& header,
+                      const std::string& method,
+                      nanoseconds cost,
+                      Stats& stats) {
+      auto controller = selector.select(method, &header);
+      const bool admitted = controller->admit();
+      if (admitted) {
+        queue.push_back({std::move(controller), cost, FakeClock::now()});
+      }
+      if (measuring) {
+        stats.offered++;
+        stats.admitted += admitted;
+      }
+    };
+    if (t % milliseconds(1) == nanoseconds(0)) {
+      arrive(web, "lookup", microseconds(50), lookups);
+    }
+    if (t % milliseconds(10) == nanoseconds(0)) {
+      arrive(batch, "scan", milliseconds(50), scans);
+    }
+
+    if (!busy && !queue.empty()) {
+      running = std::move(queue.front());
+      queue.pop_front();
+      running.controller->dequeue();
+      busy = true;
+      remaining = running.cost;
+      if (measuring) {
+        auto& stats = running.cost < milliseconds(1) ? lookups : scans;
+        stats.maxWait = std::max<nanoseconds>(
+            stats.maxWait, FakeClock::now() - running.admitted);
+      }
+    }
+    if (busy) {
+      remaining -= tick;
+      if (remaining <= nanoseconds(0)) {
+        running.controller->consumedCpuTime(running.cost);
+        running.controller->returnedResponse(running.cost);
+        busy = false;
+      }
+    }
+    FakeClock::advance(tick);
+  }
+
+  // The worker spends 5% of its time on lookups, the rest is enough for 19
+  // of the 100 scans offered every second.
+  EXPECT_EQ(lookups.admitted, lookups.offered);
+  EXPECT_NEAR(scans.admitted, 0.19 * scans.offered, 0.02 * scans.offered);
+  // Requests wait at most for the budget of the scans queued before them
+  // and for the scan in progress.
+  EXPECT_LE(lookups.maxWait, milliseconds(160));
+  EXPECT_LE(scans.maxWait, milliseconds(160));
+}
+
 } // namespace thrift
 } // namespace apache
@@ -42,6 +42,50 @@ Shallow makeShallow() {
   return data;
 }
 
+// Sets every other field of a Sparse or SparseReversed.
+template <typename T>
+T makeSparse() {
+  T data;
+  int32_t i = 0;
+  data.f1_ref() = ++i;
+  data.f7_ref() = ++i;
+  data.f20_ref() = ++i;
+  data.f45_ref() = ++i;
+  data.f77_ref() = ++i;
+  data.f128_ref() = ++i;
+  data.f256_ref() = ++i;
+  data.f1000_ref() = ++i;
+  return data;
+}
+
+Dense makeDense() {
+  Dense data;
+  data.a_ref() = 750ll << 22;
+  data.b_ref() = 750;
+  data.c_ref() = 0.75;
+  data.d_ref() = true;
+  data.e_ref() = 75;
+  data.f_ref() = -750;
+  data.g_ref() = 7;
+  data.h_ref() = 1 << 20;
+  return data;
+}
+
+template <typename Serializer, typename T, typename U>
+void deserializeBench(size_t kiters, const U& data) {
+  BenchmarkSuspender braces;
+  size_t iters = kiters << kMultExp;
+  IOBufQueue bufq;
+  Serializer::serialize(data, &bufq);
+  auto buf = bufq.move();
+  braces.dismiss();
+  while (iters--) {
+    T out;
+    Serializer::deserialize(buf.get(), out);
+  }
+  braces.rehire();
+}
+
 Deep makeDeep(size_t triplesz) {
   Deep data;
   for (size_t i = 0; i < triplesz; ++i) {
@@ -198,6 +242,27 @@ BENCHMARK(CompactProtocolWriter_serialize_deep, kiters) {
   braces.rehire();
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(CompactProtocolReader_deserialize_sparse_in_order, kiters) {
+  deserializeBench<CompactSerializer, Sparse>(kiters, makeSparse<Sparse>());
+}
+
+// fields are dispatched through the table
+BENCHMARK_RELATIVE(CompactProtocolReader_deserialize_sparse_reversed, kiters) {
+  deserializeBench<CompactSerializer, Sparse>(
+      kiters, makeSparse<SparseReversed>());
+}
+
+BENCHMARK(CompactProtocolReader_deserialize_dense, kiters) {
+  deserializeBench<CompactSerializer, Dense>(kiters, makeDense());
+}
+
+// fields are read through the fused fast path
+BENCHMARK_RELATIVE(BinaryProtocolReader_deserialize_dense, kiters) {
+  deserializeBench<BinarySerializer, Dense>(kiters, makeDense());
+}
+
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   google::InitGoogleLogging(argv[0]);
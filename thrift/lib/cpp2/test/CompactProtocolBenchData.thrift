@@ -33,3 +33,56 @@ struct Deep1 {
 struct Deep {
   1: list<Deep1> deeps;
 }
+
+// Optional fields with sparse ids, which generated readers look up in a field
+// dispatch table when they arrive out of order.
+struct Sparse {
+  1: optional i32 f1;
+  3: optional i32 f3;
+  7: optional i32 f7;
+  12: optional i32 f12;
+  20: optional i32 f20;
+  31: optional i32 f31;
+  45: optional i32 f45;
+  60: optional i32 f60;
+  77: optional i32 f77;
+  99: optional i32 f99;
+  128: optional i32 f128;
+  200: optional i32 f200;
+  256: optional i32 f256;
+  512: optional i32 f512;
+  1000: optional i32 f1000;
+  2047: optional i32 f2047;
+}
+
+// Sparse with its fields declared, and so written, in reverse order.
+struct SparseReversed {
+  2047: optional i32 f2047;
+  1000: optional i32 f1000;
+  512: optional i32 f512;
+  256: optional i32 f256;
+  200: optional i32 f200;
+  128: optional i32 f128;
+  99: optional i32 f99;
+  77: optional i32 f77;
+  60: optional i32 f60;
+  45: optional i32 f45;
+  31: optional i32 f31;
+  20: optional i32 f20;
+  12: optional i32 f12;
+  7: optional i32 f7;
+  3: optional i32 f3;
+  1: optional i32 f1;
+}
+
+// Fixed size fields only, which fully populated have a fixed Binary layout.
+struct Dense {
+  1: i64 a;
+  2: i32 b;
+  3: double c;
+  4: bool d;
+  5: i16 e;
+  6: i64 f;
+  7: byte g;
+  8: i32 h;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/MemoryTracker.h>
+#include <folly/portability/GTest.h>
+
+using namespace apache::thrift;
+using MemoryUse = MemoryTracker::MemoryUse;
+
+TEST(MemoryTrackerTest, chain) {
+  auto server = std::make_shared<MemoryTracker>(1000);
+  auto client = std::make_shared<MemoryTracker>(100, server);
+  MemoryTracker connection(10, client);
+
+  connection.increment(MemoryUse::REQUESTS, 8);
+  connection.increment(MemoryUse::WRITES, 4);
+  EXPECT_EQ(connection.getUsage(), 12);
+  EXPECT_EQ(connection.getUsage(MemoryUse::REQUESTS), 8);
+  EXPECT_EQ(client->getUsage(), 12);
+  EXPECT_EQ(server->getUsage(MemoryUse::WRITES), 4);
+  EXPECT_TRUE(connection.exceeded());
+  EXPECT_FALSE(client->exceeded());
+
+  connection.decrement(MemoryUse::REQUESTS, 8);
+  EXPECT_FALSE(connection.exceeded());
+  EXPECT_EQ(server->getUsage(), 4);
+  EXPECT_EQ(server->getUsage(MemoryUse::REQUESTS), 0);
+}
+
+TEST(MemoryTrackerTest, noLimit) {
+  MemoryTracker tracker;
+  tracker.increment(MemoryUse::READ_BUFFER, 1 << 30);
+  EXPECT_FALSE(tracker.exceeded());
+  tracker.setLimit(1 << 20);
+  EXPECT_TRUE(tracker.exceeded());
+}
+
+TEST(MemoryTrackerTest, setParent) {
+  auto server = std::make_shared<MemoryTracker>();
+  auto client = std::make_shared<MemoryTracker>(0, server);
+  MemoryTracker connection(0, server);
+
+  connection.increment(MemoryUse::PARTIAL_FRAMES, 5);
+  connection.incPausedConnections();
+  EXPECT_EQ(server->getUsage(), 5);
+  EXPECT_EQ(client->getUsage(), 0);
+  EXPECT_EQ(server->getPausedConnections(), 1);
+
+  connection.decPausedConnections();
+  connection.setParent(client);
+  connection.incPausedConnections();
+  EXPECT_EQ(server->getUsage(MemoryUse::PARTIAL_FRAMES), 5);
+  EXPECT_EQ(client->getUsage(MemoryUse::PARTIAL_FRAMES), 5);
+  EXPECT_EQ(client->getPausedConnections(), 1);
+  EXPECT_EQ(server->getPausedConnections(), 1);
+
+  connection.decPausedConnections();
+  connection.setParent(nullptr);
+  EXPECT_EQ(connection.getUsage(), 5);
+  EXPECT_EQ(client->getUsage(), 0);
+  EXPECT_EQ(server->getUsage(), 0);
+  EXPECT_EQ(server->getPausedConnections(), 0);
+}
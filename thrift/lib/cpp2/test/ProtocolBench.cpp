@@ -29,6 +29,12 @@ using namespace folly;
 using namespace apache::thrift;
 using namespace thrift::benchmark;
 
+DEFINE_bool(
+    print_sizes,
+    false,
+    "Print the serialized size of each struct, by which iters/s multiply "
+    "to MB/s");
+
 // The benckmark is to measure single struct use case, the iteration here is
 // more like a benchmark artifact, so avoid doing optimizationon iteration
 // usecase in this benchmark (e.g. move string definition out of while loop)
@@ -64,6 +70,32 @@ void readBench(size_t iters) {
   susp.rehire();
 }
 
+// Reads the input split into 4KB IOBufs, as it arrives from the network,
+// rather than coalesced.
+template <typename Serializer, typename Struct>
+void readChainedBench(size_t iters) {
+  BenchmarkSuspender susp;
+  auto strct = create<Struct>();
+  IOBufQueue q;
+  Serializer::serialize(strct, &q);
+  auto whole = q.move();
+  whole->coalesce();
+  const size_t kPieceSize = 4096;
+  for (size_t offset = 0; offset < whole->length(); offset += kPieceSize) {
+    q.append(IOBuf::copyBuffer(
+        whole->data() + offset,
+        std::min(kPieceSize, whole->length() - offset)));
+  }
+  auto buf = q.move();
+  susp.dismiss();
+
+  while (iters--) {
+    Struct data;
+    Serializer::deserialize(buf.get(), data);
+  }
+  susp.rehire();
+}
+
 #define X1(proto, rdwr, bench)                         \
   BENCHMARK(proto##Protocol_##rdwr##_##bench, iters) { \
     rdwr##Bench<proto##Serializer, bench>(iters);      \
@@ -73,32 +105,64 @@ void readBench(size_t iters) {
   X1(proto, write, bench) \
   X1(proto, read, bench)
 
-#define X(proto)             \
-  X2(proto, Empty)           \
-  X2(proto, SmallInt)        \
-  X2(proto, BigInt)          \
-  X2(proto, SmallString)     \
-  X2(proto, BigString)       \
-  X2(proto, BigBinary)       \
-  X2(proto, LargeBinary)     \
-  X2(proto, Mixed)           \
-  X2(proto, MixedInt)        \
-  X2(proto, SmallListInt)    \
-  X2(proto, BigListInt)      \
-  X2(proto, BigListMixed)    \
-  X2(proto, BigListMixedInt) \
-  X2(proto, LargeListMixed)  \
-  X2(proto, LargeMapInt)     \
-  X2(proto, NestedMap)       \
-  X2(proto, ComplexStruct)
+#define STRUCTS(F, proto)   \
+  F(proto, Empty)           \
+  F(proto, SmallInt)        \
+  F(proto, BigInt)          \
+  F(proto, SmallString)     \
+  F(proto, BigString)       \
+  F(proto, BigBinary)       \
+  F(proto, LargeBinary)     \
+  F(proto, Mixed)           \
+  F(proto, MixedInt)        \
+  F(proto, SmallListInt)    \
+  F(proto, BigListInt)      \
+  F(proto, BigListMixed)    \
+  F(proto, BigListMixedInt) \
+  F(proto, LargeListMixed)  \
+  F(proto, LargeMapInt)     \
+  F(proto, NestedMap)       \
+  F(proto, ComplexStruct)
+
+#define X(proto) STRUCTS(X2, proto)
 
 X(Binary)
 X(Compact)
 X(Nimble)
+X(JSON)
+X(SimpleJSON)
+
+#define Y(proto)                          \
+  X1(proto, readChained, BigString)       \
+  X1(proto, readChained, BigListInt)      \
+  X1(proto, readChained, BigListMixedInt) \
+  X1(proto, readChained, LargeListMixed)  \
+  X1(proto, readChained, LargeMapInt)     \
+  X1(proto, readChained, ComplexStruct)
+
+Y(Compact)
+Y(Nimble)
+
+template <typename Serializer, typename Struct>
+void printSize(const char* name) {
+  IOBufQueue q;
+  Serializer::serialize(create<Struct>(), &q);
+  LOG(INFO) << name << ": " << q.chainLength() << " bytes";
+}
+
+#define PRINT_SIZE(proto, bench) \
+  printSize<proto##Serializer, bench>(#proto "Protocol_" #bench);
 
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   google::InitGoogleLogging(argv[0]);
+  if (FLAGS_print_sizes) {
+    STRUCTS(PRINT_SIZE, Binary)
+    STRUCTS(PRINT_SIZE, Compact)
+    STRUCTS(PRINT_SIZE, Nimble)
+    STRUCTS(PRINT_SIZE, JSON)
+    STRUCTS(PRINT_SIZE, SimpleJSON)
+  }
   runBenchmarks();
   return 0;
 }
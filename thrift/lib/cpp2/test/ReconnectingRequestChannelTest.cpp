@@ -15,11 +15,18 @@
  */
 
 #include <thrift/lib/cpp2/async/ReconnectingRequestChannel.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/test/ScopedBoundPort.h>
 #include <thrift/lib/cpp/async/TAsyncSocket.h>
 #include <thrift/lib/cpp2/async/HeaderClientChannel.h>
 #include <thrift/lib/cpp2/async/RocketClientChannel.h>
+#include <thrift/lib/cpp2/server/ThriftServer.h>
 #include <thrift/lib/cpp2/test/gen-cpp2/TestService.h>
 #include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
 
@@ -100,3 +107,75 @@ void ReconnectingRequestChannelTest::runReconnect(
   EXPECT_EQ(client.sync_echoInt(4), 4);
   EXPECT_EQ(connection_count_, 2);
 }
+
+namespace {
+class EchoIntHandler : public TestServiceSvIf {
+ public:
+  int32_t echoInt(int32_t value) override {
+    return value;
+  }
+};
+
+std::unique_ptr<ScopedServerInterfaceThread> makeDrainingServer() {
+  return std::make_unique<ScopedServerInterfaceThread>(
+      std::make_shared<EchoIntHandler>(), "::1", 0, [](ThriftServer& server) {
+        server.setDrainNoticePeriod(std::chrono::seconds(10));
+      });
+}
+} // namespace
+
+TEST_F(ReconnectingRequestChannelTest, RollingRestartUnderLoad) {
+  std::vector<std::unique_ptr<ScopedServerInterfaceThread>> servers;
+  servers.push_back(makeDrainingServer());
+  servers.push_back(makeDrainingServer());
+  std::mutex mutex;
+  std::vector<folly::SocketAddress> addresses{servers[0]->getAddress(),
+                                              servers[1]->getAddress()};
+  size_t nextServer = 0;
+
+  auto channel = ReconnectingRequestChannel::newChannel(
+      *eb, [&](folly::EventBase& eb) mutable {
+        std::lock_guard<std::mutex> lock(mutex);
+        connection_count_++;
+        return RocketClientChannel::newChannel(TAsyncSocket::UniquePtr(
+            new TAsyncSocket(&eb, addresses[nextServer++ % addresses.size()])));
+      });
+  TestServiceAsyncClient client(std::move(channel));
+  EXPECT_EQ(client.sync_echoInt(0), 0);
+
+  // Replace the servers one by one, the replacement is up before the old
+  // server drains its clients and stops
+  std::atomic<bool> restarted{false};
+  std::thread restarter([&] {
+    for (size_t i = 0; i < servers.size(); i++) {
+      auto replacement = makeDrainingServer();
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        addresses[i] = replacement->getAddress();
+      }
+      std::swap(servers[i], replacement);
+      auto stopStart = std::chrono::steady_clock::now();
+      replacement.reset();
+      // The clients closed their connections well before the drain notice
+      // period
+      EXPECT_LT(
+          std::chrono::steady_clock::now() - stopStart,
+          std::chrono::seconds(5));
+    }
+    restarted = true;
+  });
+
+  int32_t requests = 1;
+  while (!restarted) {
+    try {
+      EXPECT_EQ(client.sync_echoInt(requests), requests);
+    } catch (const std::exception& ex) {
+      ADD_FAILURE() << "Request " << requests << " failed: " << ex.what();
+    }
+    ++requests;
+  }
+  restarter.join();
+
+  EXPECT_GT(requests, 1);
+  EXPECT_GE(connection_count_, 2);
+}
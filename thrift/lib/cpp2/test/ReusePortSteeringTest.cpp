@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thrift/lib/cpp2/server/ReusePortSteering.h>
+#include <folly/portability/GTest.h>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <linux/filter.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace apache::thrift;
+
+TEST(ReusePortSteeringTest, buckets) {
+  ReusePortSteering steering(3, 8);
+  EXPECT_EQ(
+      steering.getBuckets(), (std::vector<uint32_t>{0, 1, 2, 0, 1, 2, 0, 1}));
+
+  ReusePortSteering many(2, 100000);
+  EXPECT_EQ(many.getBuckets().size(), ReusePortSteering::kMaxBuckets);
+}
+
+TEST(ReusePortSteeringTest, rebalance) {
+  ReusePortSteering steering(3, 6);
+
+  // Within the threshold
+  EXPECT_FALSE(steering.rebalance({100, 110, 90}, 0.25));
+  EXPECT_FALSE(steering.rebalance({0, 0, 0}, 0.25));
+  EXPECT_FALSE(steering.rebalance({1, 2}, 0.25));
+
+  // Listener 1 is hot, its last bucket goes to listener 2
+  EXPECT_TRUE(steering.rebalance({100, 300, 50}, 0.25));
+  EXPECT_EQ(steering.getBuckets(), (std::vector<uint32_t>{0, 1, 2, 0, 2, 2}));
+  EXPECT_TRUE(steering.rebalance({100, 300, 50}, 0.25));
+  EXPECT_EQ(steering.getBuckets(), (std::vector<uint32_t>{0, 2, 2, 0, 2, 2}));
+  // No bucket left to move
+  EXPECT_FALSE(steering.rebalance({100, 300, 50}, 0.25));
+}
+
+#if defined(__linux__)
+TEST(ReusePortSteeringTest, program) {
+  ReusePortSteering steering(2, 3);
+  auto program = steering.program();
+  ASSERT_EQ(program.size(), 7);
+  EXPECT_EQ(program[0].code, BPF_LD | BPF_W | BPF_ABS);
+  EXPECT_EQ(program[0].k, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU));
+  EXPECT_EQ(program[1].code, BPF_ALU | BPF_MOD | BPF_K);
+  EXPECT_EQ(program[1].k, 3);
+  EXPECT_EQ(program[2].code, BPF_JMP | BPF_JEQ | BPF_K);
+  EXPECT_EQ(program[2].k, 0);
+  EXPECT_EQ(program[3].code, BPF_RET | BPF_K);
+  EXPECT_EQ(program[3].k, 0);
+  EXPECT_EQ(program[5].k, 1);
+  EXPECT_EQ(program[6].code, BPF_RET | BPF_K);
+  EXPECT_EQ(program[6].k, 0);
+}
+
+TEST(ReusePortSteeringTest, steerLoopbackConnection) {
+  // Loopback connections are received on the CPU of the connecting thread
+  cpu_set_t oldCpus;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(oldCpus), &oldCpus), 0);
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(0, &cpus);
+  if (!CPU_ISSET(0, &oldCpus) ||
+      sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+    GTEST_SKIP() << "Can't run on CPU 0";
+  }
+
+  constexpr size_t kListeners = 3;
+  std::vector<int> listeners;
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  for (size_t i = 0; i < kListeners; i++) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    int one = 1;
+    ASSERT_EQ(setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)), 0);
+    ASSERT_EQ(bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(listen(fd, 16), 0);
+    socklen_t len = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    listeners.push_back(fd);
+  }
+
+  // Send the connections of CPU 0 to the last listener
+  ReusePortSteering steering(kListeners, 4);
+  ASSERT_TRUE(steering.rebalance({10, 0, 0}, 0.25));
+  ASSERT_TRUE(steering.rebalance({10, 0, 0}, 0.25));
+  ASSERT_EQ(steering.getBuckets()[0], 1);
+  if (!steering.attach(listeners[0])) {
+    GTEST_SKIP() << "SO_ATTACH_REUSEPORT_CBPF not supported";
+  }
+
+  int client = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_EQ(
+      connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+  std::vector<pollfd> fds;
+  for (int fd : listeners) {
+    fds.push_back({fd, POLLIN, 0});
+  }
+  ASSERT_EQ(poll(fds.data(), fds.size(), 1000), 1);
+  EXPECT_EQ(fds[0].revents, 0);
+  EXPECT_EQ(fds[1].revents, POLLIN);
+  EXPECT_EQ(fds[2].revents, 0);
+
+  close(client);
+  for (int fd : listeners) {
+    close(fd);
+  }
+  sched_setaffinity(0, sizeof(oldCpus), &oldCpus);
+}
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+
+#include <folly/Benchmark.h>
+#include <folly/portability/GFlags.h>
+#include <glog/logging.h>
+#include <thrift/lib/cpp/protocol/TProtocolTypes.h>
+#include <thrift/lib/cpp2/async/HeaderClientChannel.h>
+#include <thrift/lib/cpp2/async/RocketClientChannel.h>
+#include <thrift/lib/cpp2/test/gen-cpp2/TestService.h>
+#include <thrift/lib/cpp2/test/util/TestInterface.h>
+#include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
+
+using namespace apache::thrift;
+using namespace apache::thrift::test;
+
+// Round trips of an echo request over header and rocket, with each protocol.
+// Both transports dispatch to the same statically typed protocol readers and
+// writers, so the difference is the cost of the transports themselves.
+
+namespace {
+
+enum class Transport { HEADER, ROCKET };
+
+ScopedServerInterfaceThread& server() {
+  static ScopedServerInterfaceThread ssit(std::make_shared<TestInterface>());
+  return ssit;
+}
+
+std::unique_ptr<TestServiceAsyncClient> makeClient(
+    Transport transport,
+    protocol::PROTOCOL_TYPES protocol) {
+  return server().newClient<TestServiceAsyncClient>(
+      nullptr, [=](auto socket) -> ClientChannel::Ptr {
+        if (transport == Transport::HEADER) {
+          auto channel = HeaderClientChannel::newChannel(std::move(socket));
+          channel->setProtocolId(protocol);
+          return channel;
+        }
+        auto channel = RocketClientChannel::newChannel(std::move(socket));
+        channel->setProtocolId(protocol);
+        return channel;
+      });
+}
+
+void echo(
+    size_t iters,
+    Transport transport,
+    protocol::PROTOCOL_TYPES protocol,
+    size_t size) {
+  folly::BenchmarkSuspender susp;
+  auto client = makeClient(transport, protocol);
+  std::string request(size, 'x');
+  std::string response;
+  // connect before measuring
+  client->sync_echoRequest(response, request);
+  susp.dismiss();
+
+  while (iters--) {
+    client->sync_echoRequest(response, request);
+  }
+  susp.rehire();
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(
+    echo,
+    header_compact_16,
+    Transport::HEADER,
+    protocol::T_COMPACT_PROTOCOL,
+    16)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    echo,
+    rocket_compact_16,
+    Transport::ROCKET,
+    protocol::T_COMPACT_PROTOCOL,
+    16)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(
+    echo,
+    header_compact_16384,
+    Transport::HEADER,
+    protocol::T_COMPACT_PROTOCOL,
+    16384)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    echo,
+    rocket_compact_16384,
+    Transport::ROCKET,
+    protocol::T_COMPACT_PROTOCOL,
+    16384)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(
+    echo,
+    header_binary_16,
+    Transport::HEADER,
+    protocol::T_BINARY_PROTOCOL,
+    16)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    echo,
+    rocket_binary_16,
+    Transport::ROCKET,
+    protocol::T_BINARY_PROTOCOL,
+    16)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(
+    echo,
+    header_binary_16384,
+    Transport::HEADER,
+    protocol::T_BINARY_PROTOCOL,
+    16384)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    echo,
+    rocket_binary_16384,
+    Transport::ROCKET,
+    protocol::T_BINARY_PROTOCOL,
+    16384)
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  folly::runBenchmarks();
+  return 0;
+}
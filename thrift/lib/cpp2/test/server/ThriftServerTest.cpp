@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <map>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include <boost/cast.hpp>
 #include <boost/lexical_cast.hpp>
@@ -45,6 +49,7 @@
 #include <thrift/lib/cpp2/async/RequestChannel.h>
 #include <thrift/lib/cpp2/async/RocketClientChannel.h>
 #include <thrift/lib/cpp2/server/Cpp2Connection.h>
+#include <thrift/lib/cpp2/server/Cpp2Worker.h>
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 #include <thrift/lib/cpp2/test/gen-cpp2/TestService.h>
 #include <thrift/lib/cpp2/test/util/TestHeaderClientChannelFactory.h>
@@ -753,6 +758,30 @@ TEST(ThriftServer, ClientTimeoutTest) {
   EXPECT_EQ(cbCall, cbCtor);
 }
 
+TEST(ThriftServer, QueuedRequestsDontExpireWithoutAdaptiveLifo) {
+  ScopedServerInterfaceThread runner(
+      std::make_shared<TestInterface>(), "::1", 0, [](ThriftServer& server) {
+        server.setNumCPUWorkerThreads(1);
+        server.setEnableCodel(true);
+      });
+  folly::EventBase base;
+  auto client = runner.newClient<TestServiceAsyncClient>(&base);
+
+  // The requests wait in the queue well over the CoDel target for several
+  // intervals, but well within their timeout
+  RpcOptions options;
+  options.setTimeout(std::chrono::seconds(10));
+  std::vector<folly::Future<std::string>> responses;
+  for (int i = 0; i < 20; i++) {
+    responses.push_back(client->future_sendResponse(options, 20000));
+  }
+  for (auto& response : responses) {
+    EXPECT_EQ("test20000", std::move(response).getVia(&base));
+  }
+  EXPECT_EQ(
+      0, runner.getThriftServer().getThreadManager()->expiredTaskCount());
+}
+
 TEST(ThriftServer, ConnectionIdleTimeoutTest) {
   TestThriftServerFactory<TestInterface> factory;
   auto server = factory.create();
@@ -1406,3 +1435,187 @@ TEST(ThriftServer, ClientOnlyTimeouts) {
   }
   base.loop();
 }
+
+namespace {
+std::vector<std::shared_ptr<Cpp2Worker>> getWorkers(ThriftServer& server) {
+  std::vector<std::shared_ptr<Cpp2Worker>> workers;
+  server.forEachWorker([&](wangle::Acceptor* acceptor) {
+    if (auto worker = dynamic_cast<Cpp2Worker*>(acceptor)) {
+      workers.push_back(worker->shared_from_this());
+    }
+  });
+  return workers;
+}
+
+uint64_t getNumMigratedConnections(ThriftServer& server) {
+  uint64_t migrated = 0;
+  for (auto& worker : getWorkers(server)) {
+    migrated += worker->getNumMigratedConnections();
+  }
+  return migrated;
+}
+
+// Sends requests over a rocket connection until destroyed
+class RocketTraffic {
+ public:
+  explicit RocketTraffic(const ScopedServerInterfaceThread& runner)
+      : thread_([&runner, this] {
+          folly::EventBase base;
+          TAsyncSocket::UniquePtr socket(
+              new TAsyncSocket(&base, runner.getAddress()));
+          TestServiceAsyncClient client(
+              RocketClientChannel::newChannel(std::move(socket)));
+          while (!stop_) {
+            std::string response;
+            try {
+              client.sync_sendResponse(response, 64);
+              EXPECT_EQ(response, "test64");
+              ++succeeded_;
+            } catch (const std::exception& ex) {
+              ADD_FAILURE() << ex.what();
+              ++failed_;
+            }
+          }
+        }) {}
+
+  ~RocketTraffic() {
+    stop_ = true;
+    thread_.join();
+  }
+
+  uint64_t succeeded() const {
+    return succeeded_;
+  }
+
+  uint64_t failed() const {
+    return failed_;
+  }
+
+ private:
+  std::atomic<bool> stop_{false};
+  std::atomic<uint64_t> succeeded_{0};
+  std::atomic<uint64_t> failed_{0};
+  std::thread thread_;
+};
+} // namespace
+
+TEST(ThriftServer, ConnectionMigrationUnderTraffic) {
+  ScopedServerInterfaceThread runner(
+      std::make_shared<TestInterface>(), "::1", 0, [](ThriftServer& server) {
+        server.setNumIOWorkerThreads(2);
+      });
+  auto& server = dynamic_cast<ThriftServer&>(runner.getThriftServer());
+  auto workers = getWorkers(server);
+  ASSERT_EQ(workers.size(), 2);
+
+  RocketTraffic traffic(runner);
+  // Bounce the connection between the IO threads, whichever has it moves it
+  // to the other one once it is between two requests
+  uint64_t lastMigrated = 0;
+  size_t migrations = 0;
+  for (int i = 0; i < 200 && migrations < 20; i++) {
+    workers[0]->migrateConnections(workers[1], 1, 1.0);
+    workers[1]->migrateConnections(workers[0], 1, 1.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto migrated = getNumMigratedConnections(server);
+    if (migrated != lastMigrated) {
+      lastMigrated = migrated;
+      ++migrations;
+    }
+  }
+  auto succeeded = traffic.succeeded();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  EXPECT_GT(migrations, 1);
+  EXPECT_EQ(traffic.failed(), 0);
+  // The connection keeps serving requests on its last IO thread
+  EXPECT_GT(traffic.succeeded(), succeeded);
+}
+
+TEST(ThriftServer, ConnectionMigrationKeepsHotSpotConnection) {
+  ScopedServerInterfaceThread runner(
+      std::make_shared<TestInterface>(), "::1", 0, [](ThriftServer& server) {
+        server.setNumIOWorkerThreads(2);
+        server.setConnectionMigration(std::chrono::milliseconds(10), 0.25, 1);
+      });
+  auto& server = dynamic_cast<ThriftServer&>(runner.getThriftServer());
+
+  {
+    // All the load is on one connection, moving it wouldn't help
+    RocketTraffic traffic(runner);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_GT(traffic.succeeded(), 0);
+    EXPECT_EQ(traffic.failed(), 0);
+  }
+
+  std::map<std::string, double> metrics;
+  server.reportWorkerMetrics(
+      [&](const std::string& name, double value) { metrics[name] = value; },
+      "");
+  EXPECT_GT(metrics["worker.connection_migrations"], 0);
+  EXPECT_EQ(getNumMigratedConnections(server), 0);
+}
+
+TEST(ThriftServer, WorkerMetricsCountConnections) {
+  ScopedServerInterfaceThread runner(
+      std::make_shared<TestInterface>(), "::1", 0, [](ThriftServer& server) {
+        server.setNumIOWorkerThreads(2);
+      });
+  auto& server = dynamic_cast<ThriftServer&>(runner.getThriftServer());
+  auto getConnections = [&] {
+    std::map<std::string, double> metrics;
+    server.reportWorkerMetrics(
+        [&](const std::string& name, double value) { metrics[name] = value; },
+        "");
+    return metrics["worker.0.connections"] + metrics["worker.1.connections"];
+  };
+
+  folly::EventBase base;
+  std::shared_ptr<TAsyncSocket> socket(
+      TAsyncSocket::newSocket(&base, runner.getAddress()));
+  TestServiceAsyncClient client(HeaderClientChannel::newChannel(socket));
+  EXPECT_EQ(client.sync_sendResponse(64), "test64");
+  // Counted from the first report on
+  EXPECT_EQ(getConnections(), 1);
+}
+
+TEST(ThriftServer, ClientMemoryTrackers) {
+  ThriftServer server;
+  server.setClientMemoryLimit("client_id", 1000, 2);
+  auto getTracker = [&](const std::string& clientId) {
+    return server.getClientMemoryTracker({{"client_id", clientId}});
+  };
+  auto getMetrics = [&] {
+    std::map<std::string, double> metrics;
+    server.reportMemoryMetrics(
+        [&](const std::string& name, double value) { metrics[name] = value; },
+        "");
+    return metrics;
+  };
+
+  EXPECT_EQ(getTracker(""), nullptr);
+  auto a = getTracker("a.b");
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(getTracker("a_b"), a);
+  auto b = getTracker("b");
+  ASSERT_NE(b, nullptr);
+  EXPECT_NE(b, a);
+
+  // Past 2 clients, the new ones share a tracker
+  auto c = getTracker("c");
+  EXPECT_EQ(getTracker("d"), c);
+  EXPECT_NE(c, a);
+  EXPECT_NE(c, b);
+  auto metrics = getMetrics();
+  EXPECT_EQ(metrics.count("memory.client.a_b.usage_bytes"), 1);
+  EXPECT_EQ(metrics.count("memory.client.b.usage_bytes"), 1);
+  EXPECT_EQ(metrics.count("memory.other_clients.usage_bytes"), 1);
+
+  // Releasing a client makes room for another one
+  a.reset();
+  auto e = getTracker("e");
+  EXPECT_NE(e, c);
+  metrics = getMetrics();
+  EXPECT_EQ(metrics.count("memory.client.a_b.usage_bytes"), 0);
+  EXPECT_EQ(metrics.count("memory.client.e.usage_bytes"), 1);
+}
@@ -57,6 +57,10 @@ RequestRpcMetadata makeRequestRpcMetadata(
   if (header.getCrc32c().has_value()) {
     metadata.crc32c_ref() = header.getCrc32c().value();
   }
+  if (kind == RpcKind::SINGLE_REQUEST_STREAMING_RESPONSE &&
+      rpcOptions.getStreamBatching()) {
+    metadata.streamBatching_ref() = *rpcOptions.getStreamBatching();
+  }
 
   auto writeHeaders = header.releaseWriteHeaders();
   if (auto* eh = header.getExtraWriteHeaders()) {
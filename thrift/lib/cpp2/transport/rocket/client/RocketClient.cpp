@@ -134,10 +134,7 @@ void RocketClient::handleFrame(std::unique_ptr<folly::IOBuf> frame) {
     }
   }
   if (frameType == FrameType::METADATA_PUSH && streamId == StreamId{0}) {
-    // constructing the METADATA_PUSH frame for validation
-    MetadataPushFrame mdPushFrame(std::move(frame));
-    LOG(WARNING) << "Dropping METADATA_PUSH frame";
-    return;
+    return handleMetadataPushFrame(std::move(frame));
   }
 
   if (auto* ctx = queue_.getRequestResponseContext(streamId)) {
@@ -148,6 +145,26 @@ void RocketClient::handleFrame(std::unique_ptr<folly::IOBuf> frame) {
   handleStreamChannelFrame(streamId, frameType, std::move(frame));
 }
 
+void RocketClient::handleMetadataPushFrame(
+    std::unique_ptr<folly::IOBuf> frame) {
+  MetadataPushFrame mdPushFrame(std::move(frame));
+  ServerPushMetadata metadata;
+  try {
+    unpackCompact(metadata, std::move(mdPushFrame).metadata());
+  } catch (const std::exception& ex) {
+    FB_LOG_EVERY_MS(WARNING, 10000)
+        << "Dropping METADATA_PUSH frame: " << folly::exceptionStr(ex);
+    return;
+  }
+  if (metadata.drainNotification_ref().value_or(false) && !serverDraining_) {
+    serverDraining_ = true;
+    if (auto onServerDrain = std::move(onServerDrain_)) {
+      onServerDrain_ = nullptr;
+      onServerDrain();
+    }
+  }
+}
+
 void RocketClient::handleRequestResponseFrame(
     RequestContext& ctx,
     FrameType frameType,
@@ -130,6 +130,17 @@ class RocketClient : public folly::DelayedDestruction,
     return state_ == ConnectionState::CONNECTED;
   }
 
+  // Whether the server sent a drain notice, new requests should go over
+  // another connection. Requests can still be sent.
+  bool isServerDraining() const {
+    return serverDraining_;
+  }
+
+  // Called once, when the server sends a drain notice
+  void setOnServerDrain(folly::Function<void()> onServerDrain) {
+    onServerDrain_ = std::move(onServerDrain);
+  }
+
   size_t streams() const {
     return streams_.size();
   }
@@ -414,6 +425,8 @@ class RocketClient : public folly::DelayedDestruction,
   };
   OnEventBaseDestructionCallback eventBaseDestructionCallback_;
   folly::Function<void()> closeCallback_;
+  folly::Function<void()> onServerDrain_;
+  bool serverDraining_{false};
 
   RocketClient(
       folly::EventBase& evb,
@@ -449,6 +462,8 @@ class RocketClient : public folly::DelayedDestruction,
   void freeStream(StreamId streamId);
 
   void handleFrame(std::unique_ptr<folly::IOBuf> frame);
+  // Client read buffers aren't accounted
+  void readBufferResized(size_t) {}
   void handleRequestResponseFrame(
       RequestContext& ctx,
       FrameType frameType,
@@ -485,6 +500,8 @@ class RocketClient : public folly::DelayedDestruction,
 
   void writeScheduledRequestsToSocket() noexcept;
 
+  void handleMetadataPushFrame(std::unique_ptr<folly::IOBuf> frame);
+
   void scheduleFirstResponseTimeout(
       StreamId streamId,
       std::chrono::milliseconds timeout);
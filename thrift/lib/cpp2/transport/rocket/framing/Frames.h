@@ -518,6 +518,13 @@ class MetadataPushFrame {
  public:
   explicit MetadataPushFrame(std::unique_ptr<folly::IOBuf> frame);
 
+  static MetadataPushFrame makeFromMetadata(
+      std::unique_ptr<folly::IOBuf> metadata) {
+    MetadataPushFrame frame;
+    frame.metadata_ = std::move(metadata);
+    return frame;
+  }
+
   static constexpr FrameType frameType() {
     return FrameType::METADATA_PUSH;
   }
@@ -535,6 +542,8 @@ class MetadataPushFrame {
 
  private:
   std::unique_ptr<folly::IOBuf> metadata_;
+
+  MetadataPushFrame() = default;
 };
 
 class KeepAliveFrame {
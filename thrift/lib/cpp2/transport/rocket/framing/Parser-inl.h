@@ -82,6 +82,7 @@ void Parser<T>::readDataAvailable(size_t nbytes) noexcept {
           readBuffer_.reserve(
               0 /* minHeadroom */,
               bufferSize_ - readBuffer_.length() /* minTailroom */);
+          owner_.readBufferResized(readBuffer_.capacity());
         }
         return;
       }
@@ -137,6 +138,7 @@ void Parser<T>::resizeBuffer() {
         /* tailroom */ kMaxBufferSize - readBuffer_.length());
     resizeBufferTimer_ = now;
     bufferSize_ = kMaxBufferSize;
+    owner_.readBufferResized(readBuffer_.capacity());
   }
 }
 
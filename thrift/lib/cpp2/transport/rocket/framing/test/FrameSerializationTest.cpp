@@ -324,6 +324,8 @@ TEST(FrameSerialization, MetadataPushSanity) {
 
   validate(makeMetadataPushFrame());
   validate(serializeAndDeserialize(makeMetadataPushFrame()));
+  validate(serializeAndDeserialize(
+      MetadataPushFrame::makeFromMetadata(folly::IOBuf::copyBuffer(kMeta))));
 }
 
 TEST(FrameSerialization, KeepAliveSanity) {
@@ -28,6 +28,7 @@ class FakeOwner : public folly::DelayedDestruction {
  public:
   void handleFrame(std::unique_ptr<folly::IOBuf>) {}
   void close(folly::exception_wrapper) noexcept {}
+  void readBufferResized(size_t) {}
 };
 
 TEST(ParserTest, resizeBufferTest) {
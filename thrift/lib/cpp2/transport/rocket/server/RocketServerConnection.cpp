@@ -49,21 +49,31 @@ namespace rocket {
 constexpr std::chrono::milliseconds
     RocketServerConnection::SocketDrainer::kRetryInterval;
 constexpr std::chrono::seconds RocketServerConnection::SocketDrainer::kTimeout;
+constexpr std::chrono::milliseconds
+    RocketServerConnection::ReadResumer::kRetryInterval;
 
 RocketServerConnection::RocketServerConnection(
     folly::AsyncTransportWrapper::UniquePtr socket,
     std::shared_ptr<RocketServerHandler> frameHandler,
     std::chrono::milliseconds streamStarvationTimeout,
     std::chrono::milliseconds writeBatchingInterval,
-    size_t writeBatchingSize)
-    : evb_(*socket->getEventBase()),
+    size_t writeBatchingSize,
+    std::shared_ptr<MemoryTracker> memoryTracker)
+    : evb_(socket->getEventBase()),
       socket_(std::move(socket)),
       frameHandler_(std::move(frameHandler)),
+      memoryTracker_(std::move(memoryTracker)),
       streamStarvationTimeout_(streamStarvationTimeout),
       writeBatcher_(*this, writeBatchingInterval, writeBatchingSize),
-      socketDrainer_(*this) {
+      socketDrainer_(*this),
+      readResumer_(*this),
+      detachableLoopCallback_(*this) {
   CHECK(socket_);
   CHECK(frameHandler_);
+  if (memoryTracker_) {
+    readBufferBytes_ = parser_.getReadBuffer().capacity();
+    trackMemory(MemoryUse::READ_BUFFER, readBufferBytes_);
+  }
   socket_->setReadCB(&parser_);
 }
 
@@ -89,12 +99,16 @@ RocketSinkClientCallback& RocketServerConnection::createSinkClientCallback(
 }
 
 void RocketServerConnection::send(std::unique_ptr<folly::IOBuf> data) {
-  evb_.dcheckIsInEventBaseThread();
+  evb_->dcheckIsInEventBaseThread();
 
   if (state_ != ConnectionState::ALIVE && state_ != ConnectionState::DRAINING) {
     return;
   }
 
+  if (memoryTracker_) {
+    trackMemory(MemoryUse::WRITES, data->computeChainDataLength());
+    maybePauseReads();
+  }
   writeBatcher_.enqueueWrite(std::move(data));
 }
 
@@ -103,9 +117,162 @@ RocketServerConnection::~RocketServerConnection() {
   DCHECK(inflightWrites_ == 0);
   DCHECK(inflightSinkFinalResponses_ == 0);
   DCHECK(writeBatcher_.empty());
+  if (memoryTracker_) {
+    if (readsPaused_) {
+      memoryTracker_->decPausedConnections();
+    }
+    // Release what is left, e.g. partial frames, from the client and server
+    // trackers
+    memoryTracker_->setParent(nullptr);
+  }
   socket_.reset();
 }
 
+void RocketServerConnection::setClientMemoryTracker(
+    std::shared_ptr<MemoryTracker> clientTracker) {
+  if (!memoryTracker_ || clientMemoryTracker_ || !clientTracker) {
+    return;
+  }
+
+  if (readsPaused_) {
+    memoryTracker_->decPausedConnections();
+  }
+  memoryTracker_->setParent(clientTracker);
+  clientMemoryTracker_ = std::move(clientTracker);
+  if (readsPaused_) {
+    memoryTracker_->incPausedConnections();
+  }
+  checkMemoryLimits();
+}
+
+void RocketServerConnection::readBufferResized(size_t capacity) {
+  if (!memoryTracker_) {
+    return;
+  }
+
+  if (capacity > readBufferBytes_) {
+    trackMemory(MemoryUse::READ_BUFFER, capacity - readBufferBytes_);
+    readBufferBytes_ = capacity;
+    checkMemoryLimits();
+  } else {
+    // Shrinking happens from getReadBuffer(), leave the read callback alone
+    memoryTracker_->decrement(
+        MemoryUse::READ_BUFFER, readBufferBytes_ - capacity);
+    readBufferBytes_ = capacity;
+  }
+}
+
+void RocketServerConnection::checkMemoryLimits() {
+  if (!memoryTracker_ ||
+      (state_ != ConnectionState::ALIVE &&
+       state_ != ConnectionState::DRAINING)) {
+    return;
+  }
+
+  // Fragments are only released once the rest of the request is read, so
+  // there is no point waiting for them to go away.
+  const auto limit = memoryTracker_->getLimit();
+  if (UNLIKELY(
+          limit != 0 &&
+          memoryTracker_->getUsage(MemoryUse::PARTIAL_FRAMES) > limit)) {
+    return close(folly::make_exception_wrapper<RocketException>(
+        ErrorCode::CONNECTION_ERROR,
+        fmt::format(
+            "Fragmented requests exceed the connection memory limit of {} "
+            "bytes",
+            limit)));
+  }
+
+  maybePauseReads();
+}
+
+bool RocketServerConnection::shouldPauseReads() const {
+  // Pausing reads only helps if some of the memory gets released without
+  // reading more, i.e. requests complete or responses get written.
+  auto releasable = [](const MemoryTracker& tracker) {
+    return tracker.getUsage(MemoryUse::REQUESTS) +
+        tracker.getUsage(MemoryUse::WRITES) !=
+        0;
+  };
+  return (memoryTracker_->exceeded() && releasable(*memoryTracker_)) ||
+      (clientMemoryTracker_ && clientMemoryTracker_->exceeded() &&
+       releasable(*clientMemoryTracker_));
+}
+
+void RocketServerConnection::maybePauseReads() {
+  if (readsPaused_ ||
+      (state_ != ConnectionState::ALIVE &&
+       state_ != ConnectionState::DRAINING) ||
+      !shouldPauseReads()) {
+    return;
+  }
+
+  socket_->setReadCB(nullptr);
+  readsPaused_ = true;
+  memoryTracker_->incPausedConnections();
+  readResumer_.schedule();
+}
+
+void RocketServerConnection::maybeResumeReads() {
+  if (!readsPaused_ || shouldPauseReads()) {
+    return;
+  }
+
+  readsPaused_ = false;
+  memoryTracker_->decPausedConnections();
+  readResumer_.cancel();
+  // Reads stay off once the connection is closing
+  if (state_ == ConnectionState::ALIVE ||
+      state_ == ConnectionState::DRAINING) {
+    socket_->setReadCB(&parser_);
+  }
+}
+
+bool RocketServerConnection::isDetachable() const {
+  return state_ == ConnectionState::ALIVE && !drainNoticeSent_ &&
+      !readsPaused_ && !isBusy() && streams_.empty() &&
+      partialRequestFrames_.empty() && bufferedFragments_.empty() &&
+      parser_.getReadBuffer().empty();
+}
+
+bool RocketServerConnection::detachEventBase() {
+  DCHECK(getDestructorGuardCount() == 0);
+  DCHECK(isDetachable());
+  evb_->dcheckIsInEventBaseThread();
+
+  // A socket with a read callback is registered with its EventBase
+  socket_->setReadCB(nullptr);
+  if (!socket_->isDetachable()) {
+    socket_->setReadCB(&parser_);
+    return false;
+  }
+  detachableLoopCallback_.cancelLoopCallback();
+  // Idle timeout of the ConnectionManager
+  cancelTimeout();
+  socket_->detachEventBase();
+  evb_ = nullptr;
+  return true;
+}
+
+void RocketServerConnection::attachEventBase(folly::EventBase& evb) {
+  DCHECK(!evb_);
+  evb.dcheckIsInEventBaseThread();
+
+  evb_ = &evb;
+  socket_->attachEventBase(evb_);
+  socket_->setReadCB(&parser_);
+}
+
+void RocketServerConnection::DetachableLoopCallback::
+    runLoopCallback() noexcept {
+  if (connection_.onDetachable_ && connection_.isDetachable()) {
+    // The function may detach, or destroy, the connection
+    auto onDetachable = std::move(connection_.onDetachable_);
+    connection_.onDetachable_ = nullptr;
+    onDetachable();
+  }
+}
+
 void RocketServerConnection::closeIfNeeded() {
   if (state_ == ConnectionState::DRAINING && inflightRequests_ == 0 &&
       inflightSinkFinalResponses_ == 0) {
@@ -162,6 +329,10 @@ void RocketServerConnection::handleFrame(std::unique_ptr<folly::IOBuf> frame) {
     return;
   }
 
+  SCOPE_EXIT {
+    checkMemoryLimits();
+  };
+
   // Entire payloads may be chained, but the parser ensures each fragment is
   // coalesced.
   DCHECK(!frame->isChained());
@@ -279,9 +450,20 @@ void RocketServerConnection::handleUntrackedFrame(
 
       PayloadFrame payloadFrame(streamId, flags, cursor, std::move(frame));
       const bool hasFollows = payloadFrame.hasFollows();
+      if (memoryTracker_) {
+        trackMemory(
+            MemoryUse::PARTIAL_FRAMES,
+            payloadFrame.payload().metadataAndDataSize());
+      }
       folly::variant_match(it->second, [&](auto& requestFrame) {
         requestFrame.payload().append(std::move(payloadFrame.payload()));
         if (!hasFollows) {
+          if (memoryTracker_) {
+            // Accounted to the request from now on
+            untrackMemory(
+                MemoryUse::PARTIAL_FRAMES,
+                requestFrame.payload().metadataAndDataSize());
+          }
           RocketServerFrameContext(*this, streamId)
               .onFullFrame(std::move(requestFrame));
           partialRequestFrames_.erase(streamId);
@@ -556,9 +738,15 @@ void RocketServerConnection::closeWhenIdle() {
 }
 
 void RocketServerConnection::writeSuccess() noexcept {
+  DestructorGuard dg(this);
   DCHECK(inflightWrites_ != 0);
   --inflightWrites_;
+  if (memoryTracker_) {
+    untrackMemory(MemoryUse::WRITES, inflightWriteBytes_.front());
+    inflightWriteBytes_.pop_front();
+  }
   closeIfNeeded();
+  notifyIfDetachable();
 }
 
 void RocketServerConnection::writeErr(
@@ -567,6 +755,10 @@ void RocketServerConnection::writeErr(
   DestructorGuard dg(this);
   DCHECK(inflightWrites_ != 0);
   --inflightWrites_;
+  if (memoryTracker_) {
+    untrackMemory(MemoryUse::WRITES, inflightWriteBytes_.front());
+    inflightWriteBytes_.pop_front();
+  }
   close(folly::make_exception_wrapper<std::runtime_error>(fmt::format(
       "Failed to write to remote endpoint. Wrote {} bytes."
       " AsyncSocketException: {}",
@@ -577,7 +769,7 @@ void RocketServerConnection::writeErr(
 void RocketServerConnection::scheduleStreamTimeout(
     folly::HHWheelTimer::Callback* timeoutCallback) {
   if (streamStarvationTimeout_ != std::chrono::milliseconds::zero()) {
-    evb_.timer().scheduleTimeout(timeoutCallback, streamStarvationTimeout_);
+    evb_->timer().scheduleTimeout(timeoutCallback, streamStarvationTimeout_);
   }
 }
 
@@ -585,7 +777,7 @@ void RocketServerConnection::scheduleSinkTimeout(
     folly::HHWheelTimer::Callback* timeoutCallback,
     std::chrono::milliseconds timeout) {
   if (timeout != std::chrono::milliseconds::zero()) {
-    evb_.timer().scheduleTimeout(timeoutCallback, timeout);
+    evb_->timer().scheduleTimeout(timeoutCallback, timeout);
   }
 }
 
@@ -598,6 +790,11 @@ folly::Optional<Payload> RocketServerConnection::bufferOrGetFullPayload(
   const auto it = bufferedFragments_.find(streamId);
 
   if (hasFollows) {
+    if (memoryTracker_) {
+      trackMemory(
+          MemoryUse::PARTIAL_FRAMES,
+          payloadFrame.payload().metadataAndDataSize());
+    }
     if (it != bufferedFragments_.end()) {
       auto& firstFragments = it->second;
       firstFragments.append(std::move(payloadFrame.payload()));
@@ -608,6 +805,10 @@ folly::Optional<Payload> RocketServerConnection::bufferOrGetFullPayload(
     if (it != bufferedFragments_.end()) {
       auto firstFragments = std::move(it->second);
       bufferedFragments_.erase(it);
+      if (memoryTracker_) {
+        untrackMemory(
+            MemoryUse::PARTIAL_FRAMES, firstFragments.metadataAndDataSize());
+      }
       firstFragments.append(std::move(payloadFrame.payload()));
       fullPayload = std::move(firstFragments);
     } else {
@@ -639,6 +840,19 @@ void RocketServerConnection::sendCancel(StreamId streamId) {
   send(CancelFrame(streamId).serialize());
 }
 
+bool RocketServerConnection::sendDrainNotice() {
+  if (state_ != ConnectionState::ALIVE || !setupFrameReceived_ ||
+      drainNoticeSent_) {
+    return false;
+  }
+  drainNoticeSent_ = true;
+  ServerPushMetadata metadata;
+  metadata.drainNotification_ref() = true;
+  send(MetadataPushFrame::makeFromMetadata(packCompact(std::move(metadata)))
+           .serialize());
+  return true;
+}
+
 void RocketServerConnection::sendExt(
     StreamId streamId,
     Payload&& payload,
@@ -650,7 +864,14 @@ void RocketServerConnection::sendExt(
 void RocketServerConnection::freeStream(StreamId streamId) {
   DestructorGuard dg(this);
 
-  bufferedFragments_.erase(streamId);
+  auto fragmentsIt = bufferedFragments_.find(streamId);
+  if (fragmentsIt != bufferedFragments_.end()) {
+    if (memoryTracker_) {
+      untrackMemory(
+          MemoryUse::PARTIAL_FRAMES, fragmentsIt->second.metadataAndDataSize());
+    }
+    bufferedFragments_.erase(fragmentsIt);
+  }
 
   auto it = streams_.find(streamId);
   if (it != streams_.end()) {
@@ -660,6 +881,7 @@ void RocketServerConnection::freeStream(StreamId streamId) {
     streams_.erase(it);
     frameHandler_->streamingRequestComplete();
   }
+  notifyIfDetachable();
 }
 
 } // namespace rocket
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <chrono>
+#include <deque>
 #include <memory>
 #include <ostream>
 #include <unordered_map>
@@ -25,6 +26,7 @@
 #include <boost/variant.hpp>
 
 #include <folly/ExceptionWrapper.h>
+#include <folly/Function.h>
 #include <folly/container/F14Map.h>
 #include <folly/io/IOBuf.h>
 #include <folly/io/async/AsyncSocket.h>
@@ -35,6 +37,7 @@
 
 #include <wangle/acceptor/ManagedConnection.h>
 
+#include <thrift/lib/cpp2/server/MemoryTracker.h>
 #include <thrift/lib/cpp2/transport/rocket/RocketException.h>
 #include <thrift/lib/cpp2/transport/rocket/framing/Parser.h>
 #include <thrift/lib/cpp2/transport/rocket/server/RocketServerFrameContext.h>
@@ -62,10 +65,28 @@ class RocketServerConnection final
       std::chrono::milliseconds streamStarvationTimeout,
       std::chrono::milliseconds writeBatchingInterval =
           std::chrono::milliseconds::zero(),
-      size_t writeBatchingSize = 0);
+      size_t writeBatchingSize = 0,
+      std::shared_ptr<MemoryTracker> memoryTracker = nullptr);
 
   void send(std::unique_ptr<folly::IOBuf> data);
 
+  /**
+   * Account the memory of this connection to the tracker of its client as
+   * well, see ThriftServer::setClientMemoryLimit(). Only the first call has
+   * an effect.
+   */
+  void setClientMemoryTracker(std::shared_ptr<MemoryTracker> clientTracker);
+
+  bool hasClientMemoryTracker() const {
+    return clientMemoryTracker_ != nullptr;
+  }
+
+  // Whether reading from the socket is paused because a memory limit is
+  // exceeded
+  bool readsPaused() const {
+    return readsPaused_;
+  }
+
   RocketStreamClientCallback& createStreamClientCallback(
       StreamId streamId,
       RocketServerConnection& connection,
@@ -78,6 +99,7 @@ class RocketServerConnection final
   // Parser callbacks
   void handleFrame(std::unique_ptr<folly::IOBuf> frame);
   void close(folly::exception_wrapper ew);
+  void readBufferResized(size_t capacity);
 
   // AsyncTransportWrapper::WriteCallback implementation
   void writeSuccess() noexcept final;
@@ -86,7 +108,46 @@ class RocketServerConnection final
       const folly::AsyncSocketException& ex) noexcept final;
 
   folly::EventBase& getEventBase() const {
-    return evb_;
+    return *evb_;
+  }
+
+  /**
+   * Whether the connection can be moved to another EventBase: it is alive,
+   * reading and wasn't sent a drain notice, and has no request, stream,
+   * partially received frame or write in flight.
+   */
+  bool isDetachable() const;
+
+  /**
+   * Stop reading and detach the connection from its EventBase, so that it
+   * can be attached to the EventBase of another IO thread. The connection
+   * must be detachable; the caller moves it to the ConnectionManager of the
+   * new EventBase. Returns false, leaving the connection as it was, if the
+   * socket can't be detached.
+   */
+  bool detachEventBase();
+  void attachEventBase(folly::EventBase& evb);
+
+  /**
+   * Run `onDetachable` once, from a loop callback, as soon as the connection
+   * is detachable. Replaces the previous function if any, nullptr cancels.
+   */
+  void setOnDetachable(folly::Function<void()> onDetachable) {
+    onDetachable_ = std::move(onDetachable);
+    notifyIfDetachable();
+  }
+
+  /**
+   * Tell the client that the server is about to shut down, so that it sends
+   * its new requests over another connection and closes this one once it
+   * received the responses it waits for. Requests keep being served
+   * meanwhile. Returns false, sending nothing, before the SETUP frame, once
+   * draining or if the notice was already sent.
+   */
+  bool sendDrainNotice();
+
+  bool isDrainNoticeSent() const {
+    return drainNoticeSent_;
   }
 
   size_t getNumStreams() const {
@@ -139,14 +200,14 @@ class RocketServerConnection final
   }
 
  private:
-  // Note that attachEventBase()/detachEventBase() are not supported in server
-  // code
-  folly::EventBase& evb_;
+  // nullptr while the connection is detached, see detachEventBase()
+  folly::EventBase* evb_;
   folly::AsyncTransportWrapper::UniquePtr socket_;
 
   Parser<RocketServerConnection> parser_{*this};
   const std::shared_ptr<RocketServerHandler> frameHandler_;
   bool setupFrameReceived_{false};
+  bool drainNoticeSent_{false};
   folly::F14NodeMap<
       StreamId,
       boost::variant<
@@ -157,6 +218,17 @@ class RocketServerConnection final
       partialRequestFrames_;
   folly::F14FastMap<StreamId, Payload> bufferedFragments_;
 
+  using MemoryUse = MemoryTracker::MemoryUse;
+  // Bytes buffered by this connection, nullptr if the server has no memory
+  // limit. Its parent is the tracker of the client of the connection once
+  // known, the one of the server until then.
+  const std::shared_ptr<MemoryTracker> memoryTracker_;
+  std::shared_ptr<MemoryTracker> clientMemoryTracker_;
+  size_t readBufferBytes_{0};
+  // Size of each write passed to the socket and not completed yet, in order
+  std::deque<size_t> inflightWriteBytes_;
+  bool readsPaused_{false};
+
   // Total number of active Request* frames ("streams" in protocol parlance)
   size_t inflightRequests_{0};
   // Total number of inflight writes to the underlying transport, i.e., writes
@@ -270,7 +342,7 @@ class RocketServerConnection final
         connection_.destroy();
         return;
       }
-      connection_.evb_.timer().scheduleTimeout(this, kRetryInterval);
+      connection_.evb_->timer().scheduleTimeout(this, kRetryInterval);
     }
 
     bool shouldClose() {
@@ -305,14 +377,77 @@ class RocketServerConnection final
   };
   SocketDrainer socketDrainer_;
 
+  // Checks the memory limits while reads are paused, as the other connections
+  // of the same client release memory without notifying this one
+  class ReadResumer : private folly::HHWheelTimer::Callback {
+   public:
+    explicit ReadResumer(RocketServerConnection& connection)
+        : connection_(connection) {}
+
+    void schedule() {
+      connection_.evb_->timer().scheduleTimeout(this, kRetryInterval);
+    }
+
+    void cancel() {
+      cancelTimeout();
+    }
+
+   private:
+    void timeoutExpired() noexcept final {
+      connection_.maybeResumeReads();
+      if (connection_.readsPaused_) {
+        schedule();
+      }
+    }
+
+    RocketServerConnection& connection_;
+    static constexpr std::chrono::milliseconds kRetryInterval{10};
+  };
+  ReadResumer readResumer_;
+
+  class DetachableLoopCallback : public folly::EventBase::LoopCallback {
+   public:
+    explicit DetachableLoopCallback(RocketServerConnection& connection)
+        : connection_(connection) {}
+    void runLoopCallback() noexcept override;
+
+   private:
+    RocketServerConnection& connection_;
+  };
+  DetachableLoopCallback detachableLoopCallback_;
+  folly::Function<void()> onDetachable_;
+
+  void notifyIfDetachable() {
+    if (!onDetachable_ || !isDetachable() ||
+        detachableLoopCallback_.isLoopCallbackScheduled()) {
+      return;
+    }
+    evb_->runInLoop(&detachableLoopCallback_);
+  }
+
   ~RocketServerConnection();
 
   void closeIfNeeded();
   void flushWrites(std::unique_ptr<folly::IOBuf> writes) {
     ++inflightWrites_;
+    if (memoryTracker_) {
+      inflightWriteBytes_.push_back(writes->computeChainDataLength());
+    }
     socket_->writeChain(this, std::move(writes));
   }
 
+  void trackMemory(MemoryUse use, size_t bytes) {
+    memoryTracker_->increment(use, bytes);
+  }
+  void untrackMemory(MemoryUse use, size_t bytes) {
+    memoryTracker_->decrement(use, bytes);
+    maybeResumeReads();
+  }
+  void checkMemoryLimits();
+  bool shouldPauseReads() const;
+  void maybePauseReads();
+  void maybeResumeReads();
+
   void timeoutExpired() noexcept final;
   void describe(std::ostream&) const final {}
   bool isBusy() const final;
@@ -346,6 +481,10 @@ class RocketServerConnection final
   void handleRequestFrame(RequestFrame&& frame) {
     auto streamId = frame.streamId();
     if (UNLIKELY(frame.hasFollows())) {
+      if (memoryTracker_) {
+        trackMemory(
+            MemoryUse::PARTIAL_FRAMES, frame.payload().metadataAndDataSize());
+      }
       partialRequestFrames_.emplace(
           streamId, std::forward<RequestFrame>(frame));
     } else {
@@ -359,8 +498,10 @@ class RocketServerConnection final
   }
 
   void decInflightRequests() {
+    DestructorGuard dg(this);
     --inflightRequests_;
     closeIfNeeded();
+    notifyIfDetachable();
   }
 
   friend class RocketServerFrameContext;
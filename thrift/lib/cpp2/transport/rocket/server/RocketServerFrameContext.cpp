@@ -42,16 +42,35 @@ RocketServerFrameContext::RocketServerFrameContext(
 
 RocketServerFrameContext::RocketServerFrameContext(
     RocketServerFrameContext&& other) noexcept
-    : connection_(other.connection_), streamId_(other.streamId_) {
+    : connection_(other.connection_),
+      streamId_(other.streamId_),
+      payloadBytes_(other.payloadBytes_) {
   other.connection_ = nullptr;
+  other.payloadBytes_ = 0;
 }
 
 RocketServerFrameContext::~RocketServerFrameContext() {
   if (connection_) {
+    untrackPayload();
     connection_->decInflightRequests();
   }
 }
 
+void RocketServerFrameContext::untrackPayload() {
+  if (connection_ && payloadBytes_ != 0) {
+    connection_->untrackMemory(
+        MemoryTracker::MemoryUse::REQUESTS, std::exchange(payloadBytes_, 0));
+  }
+}
+
+void RocketServerFrameContext::trackPayload(const Payload& payload) {
+  if (connection_->memoryTracker_) {
+    payloadBytes_ = payload.metadataAndDataSize();
+    connection_->trackMemory(
+        MemoryTracker::MemoryUse::REQUESTS, payloadBytes_);
+  }
+}
+
 folly::EventBase& RocketServerFrameContext::getEventBase() const {
   DCHECK(connection_);
   return connection_->getEventBase();
@@ -70,17 +89,20 @@ void RocketServerFrameContext::sendError(RocketException&& rex) {
 
 void RocketServerFrameContext::onFullFrame(
     RequestResponseFrame&& fullFrame) && {
+  trackPayload(fullFrame.payload());
   auto& frameHandler = *connection_->frameHandler_;
   frameHandler.handleRequestResponseFrame(
       std::move(fullFrame), std::move(*this));
 }
 
 void RocketServerFrameContext::onFullFrame(RequestFnfFrame&& fullFrame) && {
+  trackPayload(fullFrame.payload());
   auto& frameHandler = *connection_->frameHandler_;
   frameHandler.handleRequestFnfFrame(std::move(fullFrame), std::move(*this));
 }
 
 void RocketServerFrameContext::onFullFrame(RequestStreamFrame&& fullFrame) && {
+  trackPayload(fullFrame.payload());
   auto& connection = *connection_;
   auto& frameHandler = *connection.frameHandler_;
   auto& clientCallback = connection.createStreamClientCallback(
@@ -90,6 +112,7 @@ void RocketServerFrameContext::onFullFrame(RequestStreamFrame&& fullFrame) && {
 }
 
 void RocketServerFrameContext::onFullFrame(RequestChannelFrame&& fullFrame) && {
+  trackPayload(fullFrame.payload());
   auto& connection = *connection_;
   if (fullFrame.initialRequestN() != 2) {
     connection.close(
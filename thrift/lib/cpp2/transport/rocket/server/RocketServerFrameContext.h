@@ -51,6 +51,10 @@ class RocketServerFrameContext {
 
   folly::EventBase& getEventBase() const;
 
+  // Stop accounting the request payload to the connection, e.g. once a
+  // stream or sink sent its first response and no longer needs it
+  void untrackPayload();
+
   StreamId streamId() const {
     return streamId_;
   }
@@ -68,6 +72,11 @@ class RocketServerFrameContext {
  private:
   RocketServerConnection* connection_{nullptr};
   const StreamId streamId_;
+  // Bytes of the request payload accounted to the connection memory tracker
+  // until the request is gone or untrackPayload() is called
+  size_t payloadBytes_{0};
+
+  void trackPayload(const Payload& payload);
 };
 
 } // namespace rocket
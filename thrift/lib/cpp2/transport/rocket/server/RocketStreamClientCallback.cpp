@@ -16,6 +16,8 @@
 
 #include <thrift/lib/cpp2/transport/rocket/server/RocketStreamClientCallback.h>
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -30,6 +32,7 @@
 
 #include <thrift/lib/cpp/TApplicationException.h>
 #include <thrift/lib/cpp2/async/StreamCallbacks.h>
+#include <thrift/lib/cpp2/async/StreamPayloadBatch.h>
 #include <thrift/lib/cpp2/protocol/CompactProtocol.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <thrift/lib/cpp2/transport/rocket/PayloadUtils.h>
@@ -56,12 +59,77 @@ class TimeoutCallback : public folly::HHWheelTimer::Callback {
   RocketStreamClientCallback& parent_;
 };
 
+// Collects the elements of a stream until a batch is full or its delay has
+// passed. Limits which aren't positive don't apply, and without a delay the
+// batch is sent at the end of the event loop iteration.
+class StreamElementBatcher : private folly::EventBase::LoopCallback,
+                             private folly::HHWheelTimer::Callback {
+ public:
+  StreamElementBatcher(
+      RocketStreamClientCallback& parent,
+      folly::EventBase& evb,
+      const StreamBatchingConfig& config)
+      : parent_(parent),
+        evb_(evb),
+        maxElements_(std::max(*config.maxElements_ref(), 0)),
+        maxBytes_(std::max(*config.maxBytes_ref(), 0)),
+        maxDelay_((std::max(*config.maxDelayUs_ref(), 0) + 999) / 1000) {}
+
+  void append(std::unique_ptr<folly::IOBuf> element) {
+    writer_.append(std::move(element));
+  }
+
+  size_t elements() const {
+    return writer_.elements();
+  }
+
+  bool full() const {
+    return (maxElements_ && writer_.elements() >= maxElements_) ||
+        (maxBytes_ && writer_.bytes() >= maxBytes_);
+  }
+
+  void scheduleFlush() {
+    if (isLoopCallbackScheduled() || isScheduled()) {
+      return;
+    }
+    if (maxDelay_ != std::chrono::milliseconds::zero()) {
+      evb_.timer().scheduleTimeout(this, maxDelay_);
+    } else {
+      evb_.runInLoop(this, true /* thisIteration */);
+    }
+  }
+
+  StreamPayload finish() {
+    cancelLoopCallback();
+    cancelTimeout();
+    return writer_.finish();
+  }
+
+ private:
+  void runLoopCallback() noexcept final {
+    parent_.flushBatch();
+  }
+
+  void timeoutExpired() noexcept final {
+    parent_.flushBatch();
+  }
+
+  RocketStreamClientCallback& parent_;
+  folly::EventBase& evb_;
+  const size_t maxElements_;
+  const size_t maxBytes_;
+  const std::chrono::milliseconds maxDelay_;
+  thrift::detail::StreamPayloadBatchWriter writer_;
+};
+
 RocketStreamClientCallback::RocketStreamClientCallback(
     StreamId streamId,
     RocketServerConnection& connection,
     uint32_t initialRequestN)
     : streamId_(streamId), connection_(connection), tokens_(initialRequestN) {}
 
+RocketStreamClientCallback::~RocketStreamClientCallback() = default;
+
 bool RocketStreamClientCallback::onFirstResponse(
     FirstResponsePayload&& firstResponse,
     folly::EventBase* /* unused */,
@@ -126,10 +194,30 @@ void RocketStreamClientCallback::onFirstResponseError(
 
 bool RocketStreamClientCallback::onStreamNext(StreamPayload&& payload) {
   DCHECK(tokens_ != 0);
-  if (!--tokens_) {
+  bool starved = !--tokens_;
+  if (starved) {
     scheduleTimeout();
   }
 
+  // elements with metadata of their own are sent alone
+  if (batcher_ && !payload.metadata.otherMetadata_ref() &&
+      !payload.metadata.compression_ref()) {
+    batcher_->append(std::move(payload.payload));
+    // the client won't send credits for elements it hasn't received
+    if (starved || batcher_->full()) {
+      flushBatch();
+    } else {
+      batcher_->scheduleFlush();
+    }
+    return true;
+  }
+
+  flushBatch();
+  sendStreamPayload(std::move(payload));
+  return true;
+}
+
+void RocketStreamClientCallback::sendStreamPayload(StreamPayload&& payload) {
   // compress the payload if needed
   folly::Optional<CompressionAlgorithm> compression =
       connection_.getNegotiatedCompressionAlgorithm();
@@ -141,10 +229,16 @@ bool RocketStreamClientCallback::onStreamNext(StreamPayload&& payload) {
 
   connection_.sendPayload(
       streamId_, pack(std::move(payload)).value(), Flags::none().next(true));
-  return true;
+}
+
+void RocketStreamClientCallback::flushBatch() {
+  if (batcher_ && batcher_->elements()) {
+    sendStreamPayload(batcher_->finish());
+  }
 }
 
 void RocketStreamClientCallback::onStreamComplete() {
+  flushBatch();
   connection_.sendPayload(
       streamId_,
       Payload::makeFromData(std::unique_ptr<folly::IOBuf>{}),
@@ -153,6 +247,7 @@ void RocketStreamClientCallback::onStreamComplete() {
 }
 
 void RocketStreamClientCallback::onStreamError(folly::exception_wrapper ew) {
+  flushBatch();
   ew.handle(
       [this](RocketException& rex) {
         connection_.sendError(
@@ -174,6 +269,7 @@ void RocketStreamClientCallback::onStreamError(folly::exception_wrapper ew) {
 }
 
 bool RocketStreamClientCallback::onStreamHeaders(HeadersPayload&& payload) {
+  flushBatch();
   connection_.sendExt(
       streamId_,
       pack(payload).value(),
@@ -222,6 +318,12 @@ void RocketStreamClientCallback::setProtoId(protocol::PROTOCOL_TYPES protoId) {
   protoId_ = protoId;
 }
 
+void RocketStreamClientCallback::setBatching(
+    const StreamBatchingConfig& config) {
+  batcher_ = std::make_unique<StreamElementBatcher>(
+      *this, connection_.getEventBase(), config);
+}
+
 StreamServerCallback& RocketStreamClientCallback::getStreamServerCallback() {
   DCHECK(serverCallbackReady());
   return *serverCallback();
@@ -30,13 +30,15 @@ namespace apache {
 namespace thrift {
 namespace rocket {
 
+class StreamElementBatcher;
+
 class RocketStreamClientCallback final : public StreamClientCallback {
  public:
   RocketStreamClientCallback(
       StreamId streamId,
       RocketServerConnection& connection,
       uint32_t initialRequestN);
-  ~RocketStreamClientCallback() override = default;
+  ~RocketStreamClientCallback() override;
 
   bool onFirstResponse(
       FirstResponsePayload&& firstResponse,
@@ -58,6 +60,9 @@ class RocketStreamClientCallback final : public StreamClientCallback {
   StreamServerCallback& getStreamServerCallback();
   void timeoutExpired() noexcept;
   void setProtoId(protocol::PROTOCOL_TYPES);
+  // Packs stream elements into batches, as requested by the client.
+  void setBatching(const StreamBatchingConfig& config);
+  void flushBatch();
   bool serverCallbackReady() const {
     return serverCallbackOrCancelled_ != kCancelledFlag && serverCallback();
   }
@@ -78,7 +83,9 @@ class RocketStreamClientCallback final : public StreamClientCallback {
   uint64_t tokens_{0};
   std::unique_ptr<folly::HHWheelTimer::Callback> timeoutCallback_;
   protocol::PROTOCOL_TYPES protoId_;
+  std::unique_ptr<StreamElementBatcher> batcher_;
 
+  void sendStreamPayload(StreamPayload&& payload);
   void scheduleTimeout();
   void cancelTimeout();
 };
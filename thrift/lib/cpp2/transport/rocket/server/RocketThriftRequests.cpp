@@ -182,6 +182,8 @@ bool ThriftServerRequestStream::sendStreamThriftResponse(
     ResponseRpcMetadata&& metadata,
     std::unique_ptr<folly::IOBuf> data,
     StreamServerCallbackPtr stream) noexcept {
+  // The stream outlives its request payload
+  context_.untrackPayload();
   if (!stream) {
     sendSerializedError(std::move(metadata), std::move(data));
     return false;
@@ -198,6 +200,7 @@ void ThriftServerRequestStream::sendStreamThriftResponse(
     ResponseRpcMetadata&& metadata,
     std::unique_ptr<folly::IOBuf> data,
     apache::thrift::detail::ServerStreamFactory&& stream) noexcept {
+  context_.untrackPayload();
   clientCallback_->setProtoId(getProtoId());
   stream(
       apache::thrift::FirstResponsePayload{std::move(data),
@@ -209,6 +212,7 @@ void ThriftServerRequestStream::sendStreamThriftResponse(
 void ThriftServerRequestStream::sendSerializedError(
     ResponseRpcMetadata&&,
     std::unique_ptr<folly::IOBuf> exbuf) noexcept {
+  context_.untrackPayload();
   std::exchange(clientCallback_, nullptr)
       ->onFirstResponseError(
           folly::make_exception_wrapper<thrift::detail::EncodedError>(
@@ -251,6 +255,7 @@ void ThriftServerRequestSink::sendThriftResponse(
 void ThriftServerRequestSink::sendSerializedError(
     ResponseRpcMetadata&&,
     std::unique_ptr<folly::IOBuf> exbuf) noexcept {
+  context_.untrackPayload();
   std::exchange(clientCallback_, nullptr)
       ->onFirstResponseError(
           folly::make_exception_wrapper<thrift::detail::EncodedError>(
@@ -262,6 +267,8 @@ void ThriftServerRequestSink::sendSinkThriftResponse(
     ResponseRpcMetadata&& metadata,
     std::unique_ptr<folly::IOBuf> data,
     apache::thrift::detail::SinkConsumerImpl&& sinkConsumer) noexcept {
+  // The sink outlives its request payload
+  context_.untrackPayload();
   if (sinkConsumer) {
     auto* executor = sinkConsumer.executor.get();
     clientCallback_->setProtoId(getProtoId());
@@ -165,7 +165,7 @@ class ThriftServerRequestStream final : public ThriftRequestCore {
 
  private:
   folly::EventBase& evb_;
-  const RocketServerFrameContext context_;
+  RocketServerFrameContext context_;
   RocketStreamClientCallback* clientCallback_;
 
   const std::shared_ptr<AsyncProcessor> cpp2Processor_;
@@ -217,7 +217,7 @@ class ThriftServerRequestSink final : public ThriftRequestCore {
 
  private:
   folly::EventBase& evb_;
-  const RocketServerFrameContext context_;
+  RocketServerFrameContext context_;
   RocketSinkClientCallback* clientCallback_;
 
   const std::shared_ptr<AsyncProcessor> cpp2Processor_;
@@ -29,6 +29,7 @@
 #include <rsocket/RSocketParameters.h>
 
 #include <thrift/lib/cpp/TApplicationException.h>
+#include <thrift/lib/cpp/transport/TTransportException.h>
 #include <thrift/lib/cpp2/protocol/CompactProtocol.h>
 #include <thrift/lib/cpp2/server/Cpp2ConnContext.h>
 #include <thrift/lib/cpp2/server/Cpp2Worker.h>
@@ -89,6 +90,13 @@ ThriftRocketServerHandler::ThriftRocketServerHandler(
       setupFrameHandlers_(handlers) {}
 
 ThriftRocketServerHandler::~ThriftRocketServerHandler() {
+  // No worker while the connection migrates, see migrateTo()
+  if (connection_ && worker_) {
+    worker_->removeRocketConnection(connection_);
+  }
+  if (migratable_ && worker_) {
+    worker_->removeMigratableConnection(this);
+  }
   if (serverConfigs_) {
     if (auto* observer = serverConfigs_->getObserver()) {
       observer->connClosed();
@@ -138,6 +146,8 @@ void ThriftRocketServerHandler::handleSetupFrame(
           "Error deserializing SETUP payload: underflow"));
     }
     eventBase_ = connContext_.getTransport()->getEventBase();
+    connection_ = &connection;
+    worker_->addRocketConnection(connection_);
     for (const auto& h : setupFrameHandlers_) {
       auto processorInfo = h->tryHandle(*meta);
       if (processorInfo) {
@@ -160,6 +170,8 @@ void ThriftRocketServerHandler::handleSetupFrame(
     threadManager_ = worker_->getServer()->getThreadManager();
     serverConfigs_ = worker_->getServer();
     requestsRegistry_ = worker_->getRequestsRegistry();
+    migratable_ = true;
+    worker_->addMigratableConnection(this);
     // add sampleRate
     if (serverConfigs_) {
       if (auto* observer = serverConfigs_->getObserver()) {
@@ -198,7 +210,9 @@ void ThriftRocketServerHandler::handleRequestResponseFrame(
   };
 
   handleRequestCommon(
-      std::move(frame.payload()), std::move(makeRequestResponse));
+      std::move(frame.payload()),
+      context.connection(),
+      std::move(makeRequestResponse));
 }
 
 void ThriftRocketServerHandler::handleRequestFnfFrame(
@@ -222,7 +236,10 @@ void ThriftRocketServerHandler::handleRequestFnfFrame(
         [keepAlive = cpp2Processor_] {});
   };
 
-  handleRequestCommon(std::move(frame.payload()), std::move(makeRequestFnf));
+  handleRequestCommon(
+      std::move(frame.payload()),
+      context.connection(),
+      std::move(makeRequestFnf));
 }
 
 void ThriftRocketServerHandler::handleRequestStreamFrame(
@@ -232,6 +249,9 @@ void ThriftRocketServerHandler::handleRequestStreamFrame(
   auto makeRequestStream = [&](RequestRpcMetadata&& md,
                                std::unique_ptr<folly::IOBuf> debugPayload,
                                const folly::RequestContext* ctx) {
+    if (auto batching = md.streamBatching_ref()) {
+      clientCallback->setBatching(*batching);
+    }
     serverConfigs_->incActiveRequests();
     return RequestsRegistry::makeRequest<ThriftServerRequestStream>(
         *eventBase_,
@@ -246,7 +266,10 @@ void ThriftRocketServerHandler::handleRequestStreamFrame(
         cpp2Processor_);
   };
 
-  handleRequestCommon(std::move(frame.payload()), std::move(makeRequestStream));
+  handleRequestCommon(
+      std::move(frame.payload()),
+      context.connection(),
+      std::move(makeRequestStream));
 }
 
 void ThriftRocketServerHandler::handleRequestChannelFrame(
@@ -270,13 +293,19 @@ void ThriftRocketServerHandler::handleRequestChannelFrame(
         cpp2Processor_);
   };
 
-  handleRequestCommon(std::move(frame.payload()), std::move(makeRequestSink));
+  handleRequestCommon(
+      std::move(frame.payload()),
+      context.connection(),
+      std::move(makeRequestSink));
 }
 
 template <class F>
 void ThriftRocketServerHandler::handleRequestCommon(
     Payload&& payload,
+    RocketServerConnection& connection,
     F&& makeRequest) {
+  worker_->countRequest();
+  ++recentRequests_;
   auto baseReqCtx = cpp2Processor_->getBaseContextForRequest();
   auto rootid = requestsRegistry_->genRootId();
   auto reqCtx = baseReqCtx
@@ -307,6 +336,14 @@ void ThriftRocketServerHandler::handleRequestCommon(
         std::move(metadata), std::move(debugPayload), reqCtx.get()));
     return;
   }
+  // attribute the memory of the connection to its client, if tracked
+  if (UNLIKELY(
+          !connection.hasClientMemoryTracker() &&
+          metadata.otherMetadata_ref())) {
+    connection.setClientMemoryTracker(
+        worker_->getServer()->getClientMemoryTracker(
+            *metadata.otherMetadata_ref()));
+  }
   // check if server is overloaded
   if (UNLIKELY(serverConfigs_->isOverloaded(
           metadata.otherMetadata_ref() ? &*metadata.otherMetadata_ref()
@@ -430,6 +467,59 @@ void ThriftRocketServerHandler::handleServerShutdown(
       kQueueOverloadedErrorCode);
 }
 
+void ThriftRocketServerHandler::migrateTo(std::shared_ptr<Cpp2Worker> worker) {
+  connection_->setOnDetachable([this, worker = std::move(worker)]() mutable {
+    if (worker_->isStopping() || worker->isStopping() ||
+        !connection_->detachEventBase()) {
+      return;
+    }
+    if (auto* manager = connection_->getConnectionManager()) {
+      manager->removeConnection(connection_);
+    }
+    worker_->removeRocketConnection(connection_);
+    worker_->removeMigratableConnection(this);
+    connectionGuard_.reset();
+    worker_.reset();
+    // Until the target attaches it, the connection belongs to the hand-off
+    // function, which drops it if the target EventBase never runs it. The
+    // handler is owned by the connection.
+    std::unique_ptr<
+        RocketServerConnection,
+        folly::DelayedDestruction::Destructor>
+        connection(connection_);
+    auto* evb = worker->getEventBase();
+    evb->runInEventBaseThread([this,
+                               connection = std::move(connection),
+                               worker = std::move(worker)]() mutable {
+      connection.release();
+      attachToWorker(std::move(worker));
+    });
+  });
+}
+
+void ThriftRocketServerHandler::attachToWorker(
+    std::shared_ptr<Cpp2Worker> worker) {
+  worker_ = std::move(worker);
+  eventBase_ = worker_->getEventBase();
+  requestsRegistry_ = worker_->getRequestsRegistry();
+  connection_->attachEventBase(*eventBase_);
+  worker_->getConnectionManager()->addConnection(connection_, true);
+  if (worker_->isStopping()) {
+    // Don't keep the new worker from stopping, not migratable anymore
+    migratable_ = false;
+    connection_->close(
+        folly::make_exception_wrapper<transport::TTransportException>(
+            transport::TTransportException::TTransportExceptionType::
+                INTERRUPTED,
+            "Closing due to imminent shutdown"));
+    return;
+  }
+  connectionGuard_ = worker_->getActiveRequestsGuard();
+  worker_->addRocketConnection(connection_);
+  worker_->addMigratableConnection(this);
+  worker_->countMigratedConnection();
+}
+
 void ThriftRocketServerHandler::streamingRequestComplete() {
   serverConfigs_->decActiveRequests();
 }
@@ -17,12 +17,14 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <folly/Function.h>
 #include <folly/SocketAddress.h>
 
 #include <thrift/lib/cpp/server/TServerObserver.h>
+#include <thrift/lib/cpp2/server/MigratableConnection.h>
 #include <thrift/lib/cpp2/server/RequestsRegistry.h>
 #include <thrift/lib/cpp2/transport/rocket/server/RocketServerHandler.h>
 #include <thrift/lib/cpp2/transport/rocket/server/SetupFrameHandler.h>
@@ -61,7 +63,8 @@ class SetupFrame;
 class RocketServerConnection;
 class RocketServerFrameContext;
 
-class ThriftRocketServerHandler : public RocketServerHandler {
+class ThriftRocketServerHandler : public RocketServerHandler,
+                                  private MigratableConnection {
  public:
   ThriftRocketServerHandler(
       std::shared_ptr<Cpp2Worker> worker,
@@ -93,8 +96,10 @@ class ThriftRocketServerHandler : public RocketServerHandler {
   void streamingRequestComplete() final;
 
  private:
-  const std::shared_ptr<Cpp2Worker> worker_;
-  const std::shared_ptr<void> connectionGuard_;
+  // Both change when the connection migrates to another worker, worker_ is
+  // null until the target worker attaches it
+  std::shared_ptr<Cpp2Worker> worker_;
+  std::shared_ptr<void> connectionGuard_;
   const folly::SocketAddress clientAddress_;
   Cpp2ConnContext connContext_;
   const std::vector<std::unique_ptr<SetupFrameHandler>>& setupFrameHandlers_;
@@ -104,12 +109,21 @@ class ThriftRocketServerHandler : public RocketServerHandler {
   server::ServerConfigs* serverConfigs_ = nullptr;
   RequestsRegistry* requestsRegistry_ = nullptr;
   folly::EventBase* eventBase_;
+  // Set once the SETUP frame is received
+  RocketServerConnection* connection_{nullptr};
+  // Whether the connection uses the processor of the server, only such
+  // connections can migrate
+  bool migratable_{false};
+  uint64_t recentRequests_{0};
 
   uint32_t sampleRate_{0};
   static thread_local uint32_t sample_;
 
   template <class F>
-  void handleRequestCommon(Payload&& payload, F&& makeRequest);
+  void handleRequestCommon(
+      Payload&& payload,
+      RocketServerConnection& connection,
+      F&& makeRequest);
 
   FOLLY_NOINLINE void handleRequestWithBadMetadata(
       ThriftRequestCoreUniquePtr request);
@@ -121,6 +135,12 @@ class ThriftRocketServerHandler : public RocketServerHandler {
       ThriftRequestCoreUniquePtr request,
       std::string&& reason);
   FOLLY_NOINLINE void handleServerShutdown(ThriftRequestCoreUniquePtr request);
+
+  uint64_t takeRecentRequests() final {
+    return std::exchange(recentRequests_, 0);
+  }
+  void migrateTo(std::shared_ptr<Cpp2Worker> worker) final;
+  void attachToWorker(std::shared_ptr<Cpp2Worker> worker);
 };
 
 } // namespace rocket
@@ -96,7 +96,8 @@ void RSRoutingHandler::handleConnection(
           worker, *address, sockPtr, setupFrameHandlers_),
       server->getStreamExpireTime(),
       server->getWriteBatchingInterval(),
-      server->getWriteBatchingSize());
+      server->getWriteBatchingSize(),
+      server->newConnectionMemoryTracker());
   // set compression algorithm to be used on this connection
   auto compression = static_cast<FizzPeeker*>(worker->getFizzPeeker())
                          ->getNegotiatedParameters()
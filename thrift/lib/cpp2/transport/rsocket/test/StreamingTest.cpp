@@ -516,6 +516,160 @@ TEST_F(StreamingTest, FutureSimpleStream) {
   });
 }
 
+TEST_F(StreamingTest, ByteFlowControl) {
+  connectToServer([](std::unique_ptr<StreamServiceAsyncClient> client) {
+    // streamBlobs() sends 32KB strings, a few of which fill the window
+    const size_t kBlobSize = 32 << 10;
+    StreamFlowControlOptions options;
+    options.minWindowBytes = 4 * kBlobSize;
+    options.initialWindowBytes = 4 * kBlobSize;
+    options.maxWindowBytes = 8 * kBlobSize;
+
+    RpcOptions rpcOptions;
+    rpcOptions.setChunkBufferSize(1);
+    auto stream = client->sync_streamBlobs(rpcOptions, 100);
+    stream.setFlowControl(options);
+    auto stats = stream.getBufferStats();
+
+    int count = 0;
+    std::move(stream).subscribeInline([&](auto&& next) {
+      if (next.hasValue()) {
+        EXPECT_EQ(kBlobSize, next->size());
+        ++count;
+        // a consumer slower than the server, so messages are buffered
+        /* sleep override */
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      } else if (next.hasException()) {
+        FAIL() << "Should not call onError: " << next.exception().what();
+      }
+    });
+    EXPECT_EQ(100, count);
+    EXPECT_EQ(100, stats->consumedMessages.load());
+    EXPECT_GE(stats->consumedBytes.load(), 100 * kBlobSize);
+    EXPECT_EQ(0, stats->bufferedBytes.load());
+    EXPECT_GT(stats->peakBufferedBytes.load(), 0);
+    // credits may overshoot the window by a message
+    EXPECT_LE(
+        stats->peakBufferedBytes.load(),
+        options.maxWindowBytes + 2 * (kBlobSize + 1024));
+    EXPECT_GE(stats->windowBytes.load(), options.minWindowBytes);
+    EXPECT_LE(stats->windowBytes.load(), options.maxWindowBytes);
+  });
+}
+
+TEST_F(StreamingTest, ByteFlowControlSmallMessages) {
+  connectToServer([this](std::unique_ptr<StreamServiceAsyncClient> client) {
+    // a window of many small messages grants credits in bulk
+    auto stream = client->sync_range(0, 10000);
+    StreamFlowControlOptions options;
+    options.minWindowBytes = 1024;
+    options.initialWindowBytes = 1024;
+    stream.setFlowControl(options);
+    auto stats = stream.getBufferStats();
+
+    int j = 0;
+    auto subscription =
+        std::move(stream).subscribeExTry(&executor_, [&j](auto&& next) {
+          if (next.hasValue()) {
+            EXPECT_EQ(j++, *next);
+          } else if (next.hasException()) {
+            FAIL() << "Should not call onError: " << next.exception().what();
+          }
+        });
+    std::move(subscription).join();
+    EXPECT_EQ(10000, j);
+    EXPECT_EQ(10000, stats->consumedMessages.load());
+    EXPECT_EQ(0, stats->bufferedBytes.load());
+  });
+
+#if FOLLY_HAS_COROUTINES
+  connectToServer([](std::unique_ptr<StreamServiceAsyncClient> client) {
+    auto stream = client->sync_range(0, 1000);
+    stream.setFlowControl(StreamFlowControlOptions());
+    auto gen = std::move(stream).toAsyncGenerator();
+    folly::coro::blockingWait([&]() -> folly::coro::Task<void> {
+      int j = 0;
+      while (auto t = co_await gen.next()) {
+        EXPECT_EQ(j++, *t);
+      }
+      EXPECT_EQ(1000, j);
+    }());
+  });
+#endif // FOLLY_HAS_COROUTINES
+}
+
+TEST_F(StreamingTest, BufferStatsCountingMessages) {
+  connectToServer([this](std::unique_ptr<StreamServiceAsyncClient> client) {
+    auto stream = client->sync_range(0, 10);
+    auto stats = stream.getBufferStats();
+    int j = 0;
+    auto subscription =
+        std::move(stream).subscribeExTry(&executor_, [&j](auto&& next) {
+          if (next.hasValue()) {
+            EXPECT_EQ(j++, *next);
+          }
+        });
+    std::move(subscription).join();
+    EXPECT_EQ(10, j);
+    EXPECT_EQ(10, stats->consumedMessages.load());
+    EXPECT_GT(stats->consumedBytes.load(), 0);
+    EXPECT_EQ(0, stats->bufferedBytes.load());
+    EXPECT_GT(stats->peakBufferedBytes.load(), 0);
+    EXPECT_EQ(0, stats->windowBytes.load());
+  });
+}
+
+TEST_F(StreamingTest, BatchedPayloads) {
+  connectToServer([this](std::unique_ptr<StreamServiceAsyncClient> client) {
+    StreamBatchingConfig batching;
+    batching.maxElements_ref() = 64;
+    batching.maxDelayUs_ref() = 1000;
+    // fewer credits than elements per batch, which sends partial batches
+    for (int32_t bufferSize : {1000, 10}) {
+      RpcOptions rpcOptions;
+      rpcOptions.setChunkBufferSize(bufferSize);
+      rpcOptions.setStreamBatching(batching);
+      auto stream = client->sync_range(rpcOptions, 0, 10000);
+      auto stats = stream.getBufferStats();
+
+      int j = 0;
+      auto subscription =
+          std::move(stream).subscribeExTry(&executor_, [&j](auto&& next) {
+            if (next.hasValue()) {
+              EXPECT_EQ(j++, *next);
+            } else if (next.hasException()) {
+              FAIL() << "Should not call onError: " << next.exception().what();
+            }
+          });
+      std::move(subscription).join();
+      EXPECT_EQ(10000, j);
+      EXPECT_EQ(10000, stats->consumedMessages.load());
+      EXPECT_EQ(0, stats->bufferedBytes.load());
+    }
+  });
+
+  connectToServer([](std::unique_ptr<StreamServiceAsyncClient> client) {
+    // byte limits and byte-based flow control count elements, not batches
+    StreamBatchingConfig batching;
+    batching.maxBytes_ref() = 64 << 10;
+    RpcOptions rpcOptions;
+    rpcOptions.setStreamBatching(batching);
+    auto stream = client->sync_streamBlobs(rpcOptions, 100);
+    stream.setFlowControl(StreamFlowControlOptions());
+
+    int count = 0;
+    std::move(stream).subscribeInline([&](auto&& next) {
+      if (next.hasValue()) {
+        EXPECT_EQ(32 << 10, next->size());
+        ++count;
+      } else if (next.hasException()) {
+        FAIL() << "Should not call onError: " << next.exception().what();
+      }
+    });
+    EXPECT_EQ(100, count);
+  });
+}
+
 TEST_F(StreamingTest, ChecksummingRequest) {
   // TODO (T61528332) why does this fail??
   return;
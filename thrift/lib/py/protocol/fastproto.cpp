@@ -19,6 +19,8 @@
 
 #include <stdint.h>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include <thrift/lib/cpp2/protocol/BinaryProtocol.h>
 #include <thrift/lib/cpp2/protocol/CompactProtocol.h>
@@ -27,8 +29,10 @@
 #include <folly/Range.h>
 #include <folly/ScopeGuard.h>
 
+using apache::thrift::BinaryProtocolReader;
 using apache::thrift::BinaryProtocolReaderWithRefill;
 using apache::thrift::BinaryProtocolWriter;
+using apache::thrift::CompactProtocolReader;
 using apache::thrift::CompactProtocolReaderWithRefill;
 using apache::thrift::CompactProtocolWriter;
 using apache::thrift::protocol::TType;
@@ -605,14 +609,214 @@ static PyObject* decode_val(
     int utf8strings,
     StructTypeArgs* args);
 
+static PyObject* make_string(const char* data, size_t len, bool unicode) {
+  if (unicode) {
+    return PyUnicode_FromStringAndSize(data, len);
+  }
+#if PY_MAJOR_VERSION >= 3
+  return PyBytes_FromStringAndSize(data, len);
+#else
+  return PyString_FromStringAndSize(data, len);
+#endif
+}
+
+template <typename Reader>
+static PyObject* decode_string(Reader* reader, bool unicode) {
+  std::string s;
+  reader->readString(s);
+  return make_string(s.data(), s.length(), unicode);
+}
+
+// Readers over a contiguous buffer share it, so the string is only copied
+// into the Python object.
+template <typename Reader>
+static PyObject* decode_shared_string(Reader* reader, bool unicode) {
+  folly::IOBuf s;
+  reader->readBinary(s);
+  s.coalesce(); // a no-op as the input is a single buffer
+  return make_string(
+      reinterpret_cast<const char*>(s.data()), s.length(), unicode);
+}
+
+static PyObject* decode_string(BinaryProtocolReader* reader, bool unicode) {
+  return decode_shared_string(reader, unicode);
+}
+
+static PyObject* decode_string(CompactProtocolReader* reader, bool unicode) {
+  return decode_shared_string(reader, unicode);
+}
+
+static inline bool is_primitive(TType type) {
+  switch (type) {
+    case TType::T_BOOL:
+    case TType::T_I08:
+    case TType::T_I16:
+    case TType::T_I32:
+    case TType::T_I64:
+    case TType::T_DOUBLE:
+    case TType::T_FLOAT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T, typename Reader, typename Read, typename Convert>
+static bool decode_list_items(
+    Reader* reader,
+    PyObject* list,
+    uint32_t len,
+    Read read,
+    Convert convert) {
+  for (auto i = 0u; i < len; i++) {
+    T v;
+    read(reader, v);
+    PyObject* item = convert(v);
+    if (!item) {
+      return false;
+    }
+    PyList_SET_ITEM(list, i, item);
+  }
+  return true;
+}
+
+// Fills a list of 'len' elements of a primitive type, switching on the type
+// once rather than going through decode_val for every element.
+template <typename Reader>
+static bool decode_primitive_list(
+    Reader* reader,
+    TType type,
+    PyObject* list,
+    uint32_t len) {
+  switch (type) {
+    case TType::T_BOOL:
+      return decode_list_items<bool>(
+          reader,
+          list,
+          len,
+          [](Reader* r, bool& v) { r->readBool(v); },
+          [](bool v) {
+            PyObject* ret = v ? Py_True : Py_False;
+            Py_INCREF(ret);
+            return ret;
+          });
+    case TType::T_I08:
+      return decode_list_items<int8_t>(
+          reader,
+          list,
+          len,
+          [](Reader* r, int8_t& v) { r->readByte(v); },
+          [](int8_t v) { return FROM_LONG(v); });
+    case TType::T_I16:
+      return decode_list_items<int16_t>(
+          reader,
+          list,
+          len,
+          [](Reader* r, int16_t& v) { r->readI16(v); },
+          [](int16_t v) { return FROM_LONG(v); });
+    case TType::T_I32:
+      return decode_list_items<int32_t>(
+          reader,
+          list,
+          len,
+          [](Reader* r, int32_t& v) { r->readI32(v); },
+          [](int32_t v) { return FROM_LONG(v); });
+    case TType::T_I64:
+      return decode_list_items<int64_t>(
+          reader,
+          list,
+          len,
+          [](Reader* r, int64_t& v) { r->readI64(v); },
+          [](int64_t v) {
+            if (CHECK_RANGE(v, LONG_MIN, LONG_MAX)) {
+              return FROM_LONG((long)v);
+            }
+            return PyLong_FromLongLong(v);
+          });
+    case TType::T_DOUBLE:
+      return decode_list_items<double>(
+          reader,
+          list,
+          len,
+          [](Reader* r, double& v) { r->readDouble(v); },
+          [](double v) { return PyFloat_FromDouble(v); });
+    case TType::T_FLOAT:
+      return decode_list_items<float>(
+          reader,
+          list,
+          len,
+          [](Reader* r, float& v) { r->readFloat(v); },
+          [](float v) { return PyFloat_FromDouble((double)v); });
+    default:
+      PyErr_SetString(PyExc_TypeError, "Unexpected TType");
+      return false;
+  }
+}
+
+// Item specs of a struct type, parsed and with their field names interned
+// once rather than for every field decoded. Indexed by field id minus the tag
+// of the first item; attrname is null where the thrift_spec has None.
+typedef struct {
+  int first_tag;
+  std::vector<StructItemSpec> items;
+} ParsedStructSpec;
+
+// Keyed by thrift_spec tuple, which is never released so that its address
+// can't be reused. Only accessed with the GIL held.
+static std::unordered_map<PyObject*, ParsedStructSpec> parsed_struct_specs;
+
+static const ParsedStructSpec* get_parsed_struct_spec(PyObject* spec) {
+  auto it = parsed_struct_specs.find(spec);
+  if (it != parsed_struct_specs.end()) {
+    return &it->second;
+  }
+
+  Py_ssize_t speclen = PyTuple_Size(spec);
+  if (speclen == -1) {
+    return nullptr;
+  }
+
+  ParsedStructSpec parsed = {0, std::vector<StructItemSpec>(speclen)};
+  for (Py_ssize_t i = 0; i < speclen; i++) {
+    PyObject* itemspec = PyTuple_GET_ITEM(spec, i);
+    if (itemspec == Py_None) {
+      continue;
+    }
+    if (!parse_struct_item_spec(&parsed.items[i], itemspec)) {
+      for (Py_ssize_t j = 0; j < i; j++) {
+        Py_XDECREF(parsed.items[j].attrname);
+      }
+      return nullptr;
+    }
+    PyObject* attrname = parsed.items[i].attrname;
+    Py_INCREF(attrname);
+#if PY_MAJOR_VERSION >= 3
+    if (PyUnicode_CheckExact(attrname)) {
+      PyUnicode_InternInPlace(&attrname);
+    }
+#else
+    if (PyString_CheckExact(attrname)) {
+      PyString_InternInPlace(&attrname);
+    }
+#endif
+    parsed.items[i].attrname = attrname;
+  }
+  if (speclen > 0 && parsed.items[0].attrname) {
+    parsed.first_tag = parsed.items[0].tag;
+  }
+
+  Py_INCREF(spec);
+  return &parsed_struct_specs.emplace(spec, std::move(parsed)).first->second;
+}
+
 template <typename Reader>
 static bool decode_struct(
     Reader* reader,
     PyObject* value,
     StructTypeArgs* args,
     int utf8strings) {
-  int speclen = PyTuple_Size(args->spec);
-  if (speclen == -1) {
+  const ParsedStructSpec* spec = get_parsed_struct_spec(args->spec);
+  if (!spec) {
     return false;
   }
 
@@ -622,13 +826,6 @@ static bool decode_struct(
   std::string fname;
   TType ftype;
   int16_t fid;
-  PyObject* itemspec;
-  StructItemSpec parsedspec;
-
-  int first_tag = 0;
-  bool first_tag_read = false;
-  PyObject* first_item_spec;
-  StructItemSpec first_parsed_spec;
 
   while (true) {
     PyObject* fieldval = nullptr;
@@ -637,48 +834,20 @@ static bool decode_struct(
       break;
     }
 
-    if (!first_tag_read) {
-      first_tag_read = true;
-      if (speclen == 0) { // Empty struct and all fields will be skipped
-        first_item_spec = Py_None;
-      } else {
-        first_item_spec = PyTuple_GET_ITEM(args->spec, 0);
-        if (first_item_spec != Py_None) {
-          if (!parse_struct_item_spec(&first_parsed_spec, first_item_spec)) {
-            return false;
-          }
-          first_tag = first_parsed_spec.tag;
-        }
-      }
+    int index = fid - spec->first_tag;
+    const StructItemSpec* itemspec = nullptr;
+    if (index >= 0 && index < static_cast<int>(spec->items.size()) &&
+        spec->items[index].attrname) {
+      itemspec = &spec->items[index];
     }
 
-    fid -= first_tag;
-    if (fid > 0 && fid < speclen) {
-      itemspec = PyTuple_GET_ITEM(args->spec, fid);
-    } else if (fid == 0) {
-      itemspec = first_item_spec;
-    } else {
-      itemspec = Py_None;
-    }
-
-    if (itemspec == Py_None) {
-      reader->skip(ftype);
-      continue;
-    }
-
-    if (fid == 0) {
-      parsedspec = first_parsed_spec;
-    } else if (!parse_struct_item_spec(&parsedspec, itemspec)) {
-      return false;
-    }
-
-    if (parsedspec.type != ftype) {
+    if (!itemspec || itemspec->type != ftype) {
       reader->skip(ftype);
       continue;
     }
 
     fieldval = decode_val(
-        reader, parsedspec.type, parsedspec.typeargs, utf8strings, args);
+        reader, itemspec->type, itemspec->typeargs, utf8strings, args);
     if (!fieldval) {
       return false;
     }
@@ -716,7 +885,7 @@ static bool decode_struct(
       }
       Py_DECREF(valueobj);
 
-      PyObject* tagobj = FROM_LONG(parsedspec.tag);
+      PyObject* tagobj = FROM_LONG(itemspec->tag);
       if (!tagobj) {
         return false;
       }
@@ -728,7 +897,7 @@ static bool decode_struct(
       }
       Py_DECREF(tagobj);
     } else {
-      if (PyObject_SetAttr(value, parsedspec.attrname, fieldval) == -1) {
+      if (PyObject_SetAttr(value, itemspec->attrname, fieldval) == -1) {
         Py_DECREF(fieldval);
         return false;
       }
@@ -792,17 +961,7 @@ static PyObject* decode_val(
       return PyFloat_FromDouble((double)v);
     }
     case TType::T_STRING: {
-      std::string s;
-      reader->readString(s);
-      if (utf8strings && PyObject_IsTrue(typeargs)) {
-        return PyUnicode_FromStringAndSize(s.data(), s.length());
-      } else {
-#if PY_MAJOR_VERSION >= 3
-        return PyBytes_FromStringAndSize(s.data(), s.length());
-#else
-        return PyString_FromStringAndSize(s.data(), s.length());
-#endif
-      }
+      return decode_string(reader, utf8strings && PyObject_IsTrue(typeargs));
     }
     case TType::T_LIST:
     case TType::T_SET: {
@@ -826,18 +985,25 @@ static PyObject* decode_val(
         return nullptr;
       }
 
-      for (auto i = 0u; i < len; i++) {
-        PyObject* item = decode_val(
-            reader,
-            parsedargs.element_type,
-            parsedargs.typeargs,
-            utf8strings,
-            args);
-        if (!item) {
+      if (is_primitive(ttype)) {
+        if (!decode_primitive_list(reader, ttype, ret, len)) {
           Py_DECREF(ret);
           return nullptr;
         }
-        PyList_SET_ITEM(ret, i, item);
+      } else {
+        for (auto i = 0u; i < len; i++) {
+          PyObject* item = decode_val(
+              reader,
+              parsedargs.element_type,
+              parsedargs.typeargs,
+              utf8strings,
+              args);
+          if (!item) {
+            Py_DECREF(ret);
+            return nullptr;
+          }
+          PyList_SET_ITEM(ret, i, item);
+        }
       }
 
       reader->readListEnd();
@@ -861,7 +1027,8 @@ static PyObject* decode_val(
       reader->readMapBegin(ktype, vtype, len);
       if (ktype != parsedargs.ktype || vtype != parsedargs.vtype) {
         if (len == 0 &&
-            std::is_same<Reader, CompactProtocolReaderWithRefill>::value) {
+            (std::is_same<Reader, CompactProtocolReaderWithRefill>::value ||
+             std::is_same<Reader, CompactProtocolReader>::value)) {
           reader->readMapEnd();
           return PyDict_New();
         }
@@ -1019,6 +1186,29 @@ static bool decodeT(
   }
 }
 
+// Decodes from a buffer holding the whole struct, which the readers share
+// rather than copy. Returns the number of bytes read, or -1 on error.
+template <typename Reader>
+static Py_ssize_t decodeBufferT(
+    const Py_buffer& input,
+    PyObject* dec_obj,
+    StructTypeArgs* args,
+    int utf8strings) {
+  auto buf = folly::IOBuf::wrapBufferAsValue(input.buf, input.len);
+  Reader reader(apache::thrift::SHARE_EXTERNAL_BUFFER);
+  reader.setInput(&buf);
+
+  try {
+    if (!decode_struct(&reader, dec_obj, args, utf8strings)) {
+      return -1;
+    }
+    return reader.getCursorPosition();
+  } catch (const std::exception& e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return -1;
+  }
+}
+
 static PyObject* encode(PyObject* /*self*/, PyObject* args, PyObject* kws) {
   PyObject* enc_obj;
   PyObject* spec;
@@ -1112,12 +1302,75 @@ static PyObject* decode(PyObject* /*self*/, PyObject* args, PyObject* kws) {
   Py_RETURN_NONE;
 }
 
+static PyObject*
+decode_buffer(PyObject* /*self*/, PyObject* args, PyObject* kws) {
+  PyObject* dec_obj;
+  Py_buffer input;
+  PyObject* spec;
+  int utf8strings = 0;
+  int protoid = 0;
+  StructTypeArgs parsedargs;
+
+  static char* kwlist[] = {(char*)"dec",
+                           (char*)"buf",
+                           (char*)"spec",
+                           (char*)"utf8strings",
+                           (char*)"protoid",
+                           nullptr};
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args,
+          kws,
+#if PY_MAJOR_VERSION >= 3
+          "Oy*O|ii",
+#else
+          "Os*O|ii",
+#endif
+          kwlist,
+          &dec_obj,
+          &input,
+          &spec,
+          &utf8strings,
+          &protoid)) {
+    return nullptr;
+  }
+
+  SCOPE_EXIT {
+    PyBuffer_Release(&input);
+  };
+
+  if (!parse_struct_args(&parsedargs, spec)) {
+    return nullptr;
+  }
+
+  Py_ssize_t read;
+  if (protoid == 0) {
+    read = decodeBufferT<BinaryProtocolReader>(
+        input, dec_obj, &parsedargs, utf8strings);
+  } else if (protoid == 2) {
+    read = decodeBufferT<CompactProtocolReader>(
+        input, dec_obj, &parsedargs, utf8strings);
+  } else {
+    PyErr_SetString(PyExc_TypeError, "Unexpected proto id");
+    return nullptr;
+  }
+
+  if (read == -1) {
+    return nullptr;
+  }
+  return PyLong_FromSsize_t(read);
+}
+
 /* -- PYTHON MODULE SETUP STUFF --- */
 
 static PyMethodDef ThriftFastProtoMethods[] = {
 
     {"encode", (PyCFunction)encode, METH_VARARGS | METH_KEYWORDS, ""},
     {"decode", (PyCFunction)decode, METH_VARARGS | METH_KEYWORDS, ""},
+    {"decode_buffer",
+     (PyCFunction)decode_buffer,
+     METH_VARARGS | METH_KEYWORDS,
+     ""},
 
     {nullptr, nullptr, 0, nullptr} /* Sentinel */
 };
@@ -39,6 +39,16 @@ cdef extern from "<thrift/lib/cpp2/protocol/Serializer.h>" nogil:
     uint32_t CompactJSONDeserialize "apache::thrift::JSONSerializer::deserialize"[T](const cIOBuf* buf, T& obj, cExternalBufferSharing) except+
 
 
+cdef extern from "<utility>" namespace "std" nogil:
+    cdef unique_ptr[cIOBuf] move_iobuf "std::move"(unique_ptr[cIOBuf])
+
+
+cdef extern from "folly/io/Cursor.h" namespace "folly::io" nogil:
+    cdef cppclass cCursor "folly::io::Cursor":
+        cCursor(const cIOBuf*)
+        void pull(void* buf, size_t len) except +
+
+
 cdef extern from "thrift/lib/cpp/transport/THeader.h" namespace "apache::thrift::transport::THeader":
     cpdef enum Transform "apache::thrift::transport::THeader::TRANSFORMS":
         NONE,
@@ -51,5 +61,5 @@ cdef extern from "thrift/lib/cpp/transport/THeader.h" namespace "apache::thrift:
         void setProtocolId(PROTOCOL_TYPES)
         uint16_t getProtocolId()
         void setTransform(Transform)
-        unique_ptr[cIOBuf] addHeader(unique_ptr[cIOBuf], map[string, string])
-        unique_ptr[cIOBuf] removeHeader(cIOBufQueue*, size_t&, map[string, string])
+        unique_ptr[cIOBuf] addHeader(unique_ptr[cIOBuf], map[string, string]) nogil except +
+        unique_ptr[cIOBuf] removeHeader(cIOBufQueue*, size_t&, map[string, string]) nogil except +
@@ -14,6 +14,7 @@
 
 from thrift.py3.types cimport Struct
 from thrift.py3.types import Struct
+from cpython.bytes cimport PyBytes_AS_STRING, PyBytes_FromStringAndSize
 from libcpp.memory cimport unique_ptr
 from folly.iobuf import IOBuf
 from folly.iobuf cimport IOBuf
@@ -25,8 +26,22 @@ from thrift.py3.common import Protocol
 from thrift.py3.common cimport Protocol2PROTOCOL_TYPES
 
 
+cdef bytes iobuf_to_bytes(IOBuf iobuf):
+    """
+    Copies the chain into one bytes object with the GIL released, rather than
+    joining a memoryview per buffer.
+    """
+    cdef _iobuf.cIOBuf* buf = iobuf._this
+    cdef size_t length = buf.computeChainDataLength()
+    cdef bytes out = PyBytes_FromStringAndSize(NULL, length)
+    cdef char* data = PyBytes_AS_STRING(out)
+    with nogil:
+        cCursor(buf).pull(data, length)
+    return out
+
+
 def serialize(tstruct, protocol=Protocol.COMPACT):
-    return b''.join(serialize_iobuf(tstruct, protocol))
+    return iobuf_to_bytes(serialize_iobuf(tstruct, protocol))
 
 
 def serialize_iobuf(Struct tstruct not None, protocol=Protocol.COMPACT):
@@ -54,16 +69,20 @@ def deserialize(structKlass, buf not None, protocol=Protocol.COMPACT):
     return deserialize_with_length(structKlass, buf, protocol)[0]
 
 def serialize_with_header(tstruct, protocol=Protocol.COMPACT, transform=Transform.NONE):
-    return b''.join(serialize_with_header_iobuf(tstruct, protocol, transform))
+    return iobuf_to_bytes(serialize_with_header_iobuf(tstruct, protocol, transform))
 
 def serialize_with_header_iobuf(Struct tstruct not None, protocol=Protocol.COMPACT, Transform transform=Transform.NONE):
     cdef cTHeader header
     cdef map[string, string] pheaders
     cdef IOBuf buf = <IOBuf>serialize_iobuf(tstruct, protocol)
+    cdef unique_ptr[_iobuf.cIOBuf] cbuf = _iobuf.move(buf._ours)
     header.setProtocolId(Protocol2PROTOCOL_TYPES(protocol))
     if transform is not Transform.NONE:
         header.setTransform(transform)
-    return _iobuf.from_unique_ptr(header.addHeader(_iobuf.move(buf._ours), pheaders))
+    # the transforms compress large payloads, don't hold the GIL meanwhile
+    with nogil:
+        cbuf = header.addHeader(move_iobuf(cbuf), pheaders)
+    return _iobuf.from_unique_ptr(_iobuf.move(cbuf))
 
 
 def deserialize_from_header(structKlass, buf not None):
@@ -74,7 +93,9 @@ def deserialize_from_header(structKlass, buf not None):
     cdef cTHeader header
     cdef map[string, string] pheaders
     cdef size_t needed = 0
-    cbuf = header.removeHeader(&queue, needed, pheaders)
+    cdef unique_ptr[_iobuf.cIOBuf] cbuf
+    with nogil:
+        cbuf = header.removeHeader(&queue, needed, pheaders)
     protoid = <PROTOCOL_TYPES>header.getProtocolId()
     if protoid == PROTOCOL_TYPES.T_COMPACT_PROTOCOL:
         protocol = Protocol.COMPACT
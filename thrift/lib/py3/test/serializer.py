@@ -200,3 +200,28 @@ class SerializerTests(unittest.TestCase):
             self.assertIsInstance(decoded, type(control))
             self.assertEqual(decoded, control)
             self.assertEqual(length, len(encoded))
+
+    def test_serialize_large_matches_iobuf(self) -> None:
+        control = easy(val=1, val_list=list(range(100000)), name="x" * 100000)
+        for proto in Protocol:
+            iobuf = serialize_iobuf(control, protocol=proto)
+            encoded = serialize(control, protocol=proto)
+            self.assertEqual(encoded, b"".join(iobuf))
+            self.assertEqual(control, deserialize(easy, encoded, protocol=proto))
+            self.assertEqual(control, deserialize(easy, iobuf, protocol=proto))
+
+    def test_with_header_large_from_threads(self) -> None:
+        control = easy(val=1, val_list=list(range(100000)))
+        loop = asyncio.get_event_loop()
+
+        async def roundtrip() -> None:
+            buf = await loop.run_in_executor(
+                None, serialize_with_header, control, Protocol.COMPACT,
+                Transform.ZSTD_TRANSFORM
+            )
+            decoded = await loop.run_in_executor(
+                None, deserialize_from_header, easy, buf
+            )
+            self.assertEqual(control, decoded)
+
+        loop.run_until_complete(asyncio.gather(*(roundtrip() for _ in range(4))))
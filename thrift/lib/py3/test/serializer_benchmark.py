@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+# Copyright (c) Facebook, Inc. and its affiliates.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Serialize/deserialize throughput of a large struct, alone and from several
+threads while another thread keeps running Python code, so the time spent
+holding the GIL shows up as lost throughput.
+"""
+
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from typing import Callable
+
+from testing.types import easy
+from thrift.py3 import Protocol, deserialize, serialize
+from thrift.py3.serializer import (
+    Transform,
+    deserialize_from_header,
+    serialize_iobuf,
+    serialize_with_header,
+)
+
+
+ITERS = 200
+THREADS = 4
+
+large = easy(val=1, val_list=list(range(100000)), name="x" * 1000000)
+encoded = serialize(large)
+encoded_iobuf = serialize_iobuf(large)
+encoded_header = serialize_with_header(large, transform=Transform.ZSTD_TRANSFORM)
+
+
+def busy_python(stop: threading.Event, counter: list) -> None:
+    while not stop.is_set():
+        counter[0] += 1
+
+
+def run(name: str, op: Callable[[], object]) -> None:
+    start = time.perf_counter()
+    for _ in range(ITERS):
+        op()
+    single = ITERS / (time.perf_counter() - start)
+
+    stop = threading.Event()
+    counter = [0]
+    spinner = threading.Thread(target=busy_python, args=(stop, counter))
+    spinner.start()
+    start = time.perf_counter()
+    with ThreadPoolExecutor(THREADS) as pool:
+        for _ in pool.map(lambda _: op(), range(ITERS * THREADS)):
+            pass
+    elapsed = time.perf_counter() - start
+    stop.set()
+    spinner.join()
+
+    print(
+        f"{name:<32} {single:10.1f} ops/s alone, "
+        f"{ITERS * THREADS / elapsed:10.1f} ops/s from {THREADS} threads, "
+        f"{counter[0] / elapsed:12.1f} spins/s meanwhile"
+    )
+
+
+def main() -> None:
+    run("serialize", lambda: serialize(large))
+    run("serialize_iobuf", lambda: serialize_iobuf(large))
+    run("serialize_with_header(zstd)", lambda: serialize_with_header(
+        large, transform=Transform.ZSTD_TRANSFORM))
+    run("serialize(binary)", lambda: serialize(large, Protocol.BINARY))
+    run("deserialize(bytes)", lambda: deserialize(easy, encoded))
+    run("deserialize(iobuf)", lambda: deserialize(easy, encoded_iobuf))
+    run("deserialize_from_header(zstd)", lambda: deserialize_from_header(
+        easy, encoded_header))
+
+
+if __name__ == "__main__":
+    main()
@@ -27,6 +27,9 @@ enum ProtocolId {
   COMPACT = 2,
   // Deprecated.
   // FROZEN2 = 6,
+  // Generated clients and processors don't dispatch it yet; only requests in
+  // BINARY or COMPACT are served.
+  NIMBLE = 7,
 }
 
 enum RpcKind {
@@ -70,6 +73,18 @@ enum RequestRpcMetadataFlags {
   QUERY_SERVER_LOAD = 0x1,
 }
 
+// Sent by clients accepting stream elements in batches, several to a
+// payload, with the limits of those batches.
+struct StreamBatchingConfig {
+  // The most elements in a batch.
+  1: i32 maxElements = 0;
+  // A batch is sent once its elements take this many bytes.
+  2: i32 maxBytes = 0;
+  // How long the server may hold elements to batch them with later ones.  If
+  // 0, only elements produced in the same event loop iteration are batched.
+  3: i32 maxDelayUs = 0;
+}
+
 // RPC metadata sent from the client to the server.  The lifetime of
 // objects of this type starts at the call to the generated client
 // code, and ends at the generated server code.
@@ -119,6 +134,8 @@ struct RequestRpcMetadata {
   13: optional string loadMetric;
   // The CompressionAlgorithm used to compress requests (if any)
   14: optional CompressionAlgorithm compression;
+  // Set by streaming clients accepting batched stream payloads.
+  15: optional StreamBatchingConfig streamBatching;
 }
 
 // RPC metadata sent from the server to the client.  The lifetime of
@@ -157,6 +174,9 @@ struct StreamPayloadMetadata {
   // Any frequently used key-value pair in this map should be replaced
   // by a field in this struct.
   2: optional map<string, string> otherMetadata;
+  // Set if the payload is a batch of this many stream elements, each preceded
+  // by its 4 byte big-endian length.
+  3: optional i32 elementCount;
 }
 
 // Setup metadata sent from the client to the server at the time
@@ -173,6 +193,14 @@ struct RequestSetupMetadata {
   2: optional InterfaceKind interfaceKind;
 }
 
+// Sent by the server in a METADATA_PUSH frame
+struct ServerPushMetadata {
+  // The server is about to shut down. The client should send its new
+  // requests over another connection and close this one once it received
+  // the responses it waits for.
+  1: optional bool drainNotification;
+}
+
 struct HeadersPayloadContent {
   // A string to string map that can be populated by the server
   // handler and further populated by plugins on the server side
@@ -32,7 +32,13 @@ struct Layout {
   4: string typeName;
 }
 
-const i32 kCurrentFrozenFileVersion = 1;
+// Files declare the oldest version able to read the layouts they contain, so
+// files not using newer layouts remain readable by older versions.
+const i32 kCurrentFrozenFileVersion = 3;
+// Grouped hash tables (frozen::GroupedHashMap and GroupedHashSet)
+const i32 kGroupedHashTableFileVersion = 2;
+// Columnar lists of structs (frozen::VectorColumnar)
+const i32 kColumnarListFileVersion = 3;
 
 struct Schema {
   // File format version, incremented on breaking changes to Frozen2
@@ -42,4 +48,7 @@ struct Schema {
   1: bool relaxTypeChecks = 0;
   2: map<i16, Layout> layouts;
   3: i16 rootLayout = 0;
+  // Ignored, pads the schema so the data following it in a file starts at an
+  // aligned offset.  Older versions skip it as an unknown field.
+  5: optional binary padding;
 }
@@ -38,6 +38,11 @@ DEFINE_int32(terminate_sec, 0, "How long to run client (0 means forever)");
 // Operations Settings
 DEFINE_bool(sync, false, "Perform synchronous calls to the server");
 DEFINE_int32(max_outstanding_ops, 100, "Max number of outstanding async ops");
+DEFINE_int32(
+    target_qps,
+    0,
+    "Calls per second of each client regardless of the replies "
+    "(0 makes a new call on each reply)");
 
 // Operations - Match with OP_TYPE enum
 DEFINE_int32(noop_weight, 0, "Test with a no operation");
@@ -47,9 +52,15 @@ DEFINE_int32(timeout_weight, 0, "Test for timeout functionality");
 DEFINE_int32(download_weight, 0, "Test for download functionality");
 DEFINE_int32(upload_weight, 0, "Test for upload functionality");
 DEFINE_int32(stream_weight, 0, "Test stream download functionality");
+DEFINE_int32(sink_weight, 0, "Test sink upload functionality");
+DEFINE_int32(raw_sink_weight, 0, "Test sink upload of unparsed chunks");
 
 DEFINE_uint32(chunk_size, 1024, "Number of bytes per chunk");
 DEFINE_uint32(batch_size, 16, "Flow control batch size");
+DEFINE_bool(stream_batching, false, "Pack several stream elements per payload");
+DEFINE_int32(stream_batch_elements, 0, "Max elements per stream payload");
+DEFINE_int32(stream_batch_bytes, 0, "Max bytes per stream payload");
+DEFINE_int32(stream_batch_delay_us, 0, "Max delay of a stream payload");
 
 /*
  * This starts num_clients threads with a unique client in each thread.
@@ -85,7 +96,9 @@ int main(int argc, char** argv) {
                                           FLAGS_timeout_weight,
                                           FLAGS_download_weight,
                                           FLAGS_upload_weight,
-                                          FLAGS_stream_weight};
+                                          FLAGS_stream_weight,
+                                          FLAGS_sink_weight,
+                                          FLAGS_raw_sink_weight};
       int32_t sum = std::accumulate(weights.begin(), weights.end(), 0);
       if (sum == 0) {
         weights[0] = 1;
@@ -99,7 +112,11 @@ int main(int argc, char** argv) {
           std::move(ops),
           std::move(distribution),
           FLAGS_max_outstanding_ops);
-      r->run();
+      if (FLAGS_target_qps > 0) {
+        r->runAtRate(FLAGS_target_qps);
+      } else {
+        r->run();
+      }
 
       // Run eventbase loop for async operations
       if (!FLAGS_sync) {
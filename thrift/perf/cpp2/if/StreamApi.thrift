@@ -27,4 +27,9 @@ service StreamBenchmark extends Api.Benchmark {
   void upload(1: ApiBase.Chunk2 chunk);
 
   stream<ApiBase.Chunk2> streamDownload();
+
+  // Both write the chunks they receive to --sink_file, the first decoding
+  // them into strings and the second into the buffers they were received in.
+  sink<binary, i64> streamUpload();
+  sink<ApiBase.IOBuf, i64> rawStreamUpload();
 }
@@ -16,13 +16,18 @@
 
 #pragma once
 
+#include <folly/Exception.h>
+#include <folly/File.h>
+#include <folly/FileUtil.h>
 #include <folly/system/ThreadName.h>
 #include <rsocket/internal/ScheduledSubscriber.h>
+#include <thrift/lib/cpp2/async/SinkFileWriter.h>
 #include <thrift/perf/cpp2/if/gen-cpp2/StreamBenchmark.h>
 #include <thrift/perf/cpp2/util/QPSStats.h>
 
 DEFINE_uint32(chunk_size, 1024, "Number of bytes per chunk");
 DEFINE_uint32(batch_size, 16, "Flow control batch size");
+DEFINE_string(sink_file, "/dev/null", "File stream uploads are written to");
 
 namespace facebook {
 namespace thrift {
@@ -31,10 +36,12 @@ namespace benchmarks {
 using apache::thrift::HandlerCallback;
 using apache::thrift::HandlerCallbackBase;
 using apache::thrift::ServerStream;
+using apache::thrift::SinkConsumer;
 
 class BenchmarkHandler : virtual public StreamBenchmarkSvIf {
  public:
-  explicit BenchmarkHandler(QPSStats* stats) : stats_(stats) {
+  explicit BenchmarkHandler(QPSStats* stats)
+      : stats_(stats), sinkFile_(FLAGS_sink_file, O_WRONLY | O_CREAT) {
     stats_->registerCounter(kNoop_);
     stats_->registerCounter(kSum_);
     stats_->registerCounter(kTimeout_);
@@ -42,6 +49,8 @@ class BenchmarkHandler : virtual public StreamBenchmarkSvIf {
     stats->registerCounter(kUpload_);
     stats_->registerCounter(ks_Download_);
     stats_->registerCounter(ks_Upload_);
+    stats_->registerCounter(ks_UploadTyped_);
+    stats_->registerCounter(ks_UploadRaw_);
 
     chunk_.data.unshare();
     chunk_.data.reserve(0, FLAGS_chunk_size);
@@ -98,6 +107,41 @@ class BenchmarkHandler : virtual public StreamBenchmarkSvIf {
         });
   }
 
+  SinkConsumer<std::string, int64_t> streamUpload() override {
+    return SinkConsumer<std::string, int64_t>{
+        [this](folly::coro::AsyncGenerator<std::string&&> chunks)
+            -> folly::coro::Task<int64_t> {
+          int64_t written = 0;
+          while (auto chunk = co_await chunks.next()) {
+            auto fd = sinkFile_.fd();
+            if (folly::writeFull(fd, chunk->data(), chunk->size()) < 0) {
+              folly::throwSystemError("write failed");
+            }
+            written += chunk->size();
+            stats_->add(ks_UploadTyped_);
+          }
+          co_return written;
+        },
+        static_cast<uint64_t>(FLAGS_batch_size)};
+  }
+
+  SinkConsumer<folly::IOBuf, int64_t> rawStreamUpload() override {
+    return SinkConsumer<folly::IOBuf, int64_t>{
+        [this](folly::coro::AsyncGenerator<folly::IOBuf&&> chunks) {
+          return apache::thrift::writeSinkToFd(
+              folly::coro::co_invoke(
+                  [this, chunks = std::move(chunks)]() mutable
+                  -> folly::coro::AsyncGenerator<folly::IOBuf&&> {
+                    while (auto chunk = co_await chunks.next()) {
+                      co_yield std::move(*chunk);
+                      stats_->add(ks_UploadRaw_);
+                    }
+                  }),
+              sinkFile_.fd());
+        },
+        static_cast<uint64_t>(FLAGS_batch_size)};
+  }
+
  private:
   QPSStats* stats_;
   std::string kNoop_ = "noop";
@@ -107,7 +151,10 @@ class BenchmarkHandler : virtual public StreamBenchmarkSvIf {
   std::string kUpload_ = "upload";
   std::string ks_Download_ = "s_download";
   std::string ks_Upload_ = "s_upload";
+  std::string ks_UploadTyped_ = "s_upload_typed";
+  std::string ks_UploadRaw_ = "s_upload_raw";
   Chunk2 chunk_;
+  folly::File sinkFile_;
 };
 
 } // namespace benchmarks
@@ -36,6 +36,11 @@ DEFINE_int32(cpu_threads, 0, "Number of CPU threads (0 means number of cores)");
 DEFINE_int32(stats_interval_sec, 1, "Seconds between stats");
 DEFINE_int32(terminate_sec, 0, "How long to run server (0 means forever)");
 DEFINE_bool(use_admission_control, false, "Enable admission control");
+DEFINE_bool(enable_codel, false, "Drop the requests queued for too long");
+DEFINE_bool(
+    adaptive_lifo,
+    false,
+    "Serve the queued requests newest first under overload");
 
 using apache::thrift::GlobalAdmissionStrategy;
 using apache::thrift::HTTP2RoutingHandler;
@@ -82,6 +87,8 @@ int main(int argc, char** argv) {
   server->setNumIOWorkerThreads(FLAGS_io_threads);
   server->setNumCPUWorkerThreads(FLAGS_cpu_threads);
   server->setProcessorFactory(cpp2PFac);
+  server->setEnableCodel(FLAGS_enable_codel);
+  server->setAdaptiveLifo(FLAGS_adaptive_lifo);
 
   server->addRoutingHandler(
       std::make_unique<apache::thrift::RSRoutingHandler>());
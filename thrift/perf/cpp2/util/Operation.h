@@ -40,6 +40,8 @@ enum OP_TYPE {
   DOWNLOAD = 4,
   UPLOAD = 5,
   STREAM = 6,
+  SINK = 7,
+  RAW_SINK = 8,
 };
 
 template <typename AsyncClient>
@@ -56,7 +58,15 @@ class Operation {
         upload_(std::make_unique<Upload<AsyncClient>>(stats, FLAGS_chunk_size)),
         stream_(std::make_unique<StreamDownload<AsyncClient>>(
             stats,
-            FLAGS_chunk_size))
+            FLAGS_chunk_size)),
+        sink_(std::make_unique<StreamUpload<AsyncClient>>(
+            stats,
+            FLAGS_chunk_size,
+            false)),
+        rawSink_(std::make_unique<StreamUpload<AsyncClient>>(
+            stats,
+            FLAGS_chunk_size,
+            true))
 #endif
   {
   }
@@ -92,6 +102,12 @@ class Operation {
       case STREAM:
         stream_->async(client_.get(), std::move(cb), outstanding_ops_);
         break;
+      case SINK:
+        sink_->async(client_.get(), std::move(cb), outstanding_ops_);
+        break;
+      case RAW_SINK:
+        rawSink_->async(client_.get(), std::move(cb), outstanding_ops_);
+        break;
 #endif
       default:
         break;
@@ -175,6 +191,8 @@ class Operation {
   std::unique_ptr<Download<AsyncClient>> download_;
   std::unique_ptr<Upload<AsyncClient>> upload_;
   std::unique_ptr<StreamDownload<AsyncClient>> stream_;
+  std::unique_ptr<StreamUpload<AsyncClient>> sink_;
+  std::unique_ptr<StreamUpload<AsyncClient>> rawSink_;
 #endif
 
   int32_t outstanding_ops_{0};
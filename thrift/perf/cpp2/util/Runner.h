@@ -22,6 +22,8 @@
 #include <thrift/perf/cpp2/util/Operation.h>
 #include <thrift/perf/cpp2/util/QPSStats.h>
 #include <thrift/perf/cpp2/util/Util.h>
+#include <algorithm>
+#include <chrono>
 #include <random>
 
 using apache::thrift::ClientConnectionIf;
@@ -50,15 +52,43 @@ class Runner {
   void run() {
     // TODO: Implement sync calls.
     while (ops_->outstandingOps() < max_outstanding_ops_) {
-      auto op = static_cast<OP_TYPE>((*d_)(gen_));
-      auto cb =
-          std::make_unique<LoadCallback<AsyncClient>>(this, ops_.get(), op);
-      ops_->async(op, std::move(cb));
+      runOne();
     }
   }
 
+  /*
+   * Open loop: performs qps calls per second whether or not the server keeps
+   * up with them, e.g. to overload it, as long as fewer than
+   * max_outstanding_ops are outstanding.
+   */
+  void runAtRate(int32_t qps) {
+    // The timer wakes us up later than asked, so the calls due are counted
+    // from the time elapsed since the last wake up. The backlog is capped so
+    // that a stalled event base does not send a burst afterwards.
+    constexpr double kMaxBacklogSeconds = 0.1;
+    auto now = std::chrono::steady_clock::now();
+    if (qps_ == 0) {
+      lastRun_ = now;
+    }
+    qps_ = qps;
+    std::chrono::duration<double> elapsed = now - lastRun_;
+    lastRun_ = now;
+    credit_ = std::min(
+        credit_ + qps * elapsed.count(),
+        std::max(1.0, qps * kMaxBacklogSeconds));
+    while (credit_ >= 1) {
+      credit_ -= 1;
+      if (ops_->outstandingOps() < max_outstanding_ops_) {
+        runOne();
+      }
+    }
+    evb_->runAfterDelay([this, qps] { runAtRate(qps); }, 1);
+  }
+
   void finishCall() {
-    run(); // Attempt to perform more async calls
+    if (qps_ == 0) {
+      run(); // Attempt to perform more async calls
+    }
   }
 
  private:
@@ -66,8 +96,17 @@ class Runner {
   std::unique_ptr<Operation<AsyncClient>> ops_;
   std::unique_ptr<std::discrete_distribution<int32_t>> d_;
   int32_t max_outstanding_ops_;
+  int32_t qps_{0};
+  double credit_{0};
+  std::chrono::steady_clock::time_point lastRun_;
 
   std::mt19937 gen_{std::random_device()()};
+
+  void runOne() {
+    auto op = static_cast<OP_TYPE>((*d_)(gen_));
+    auto cb = std::make_unique<LoadCallback<AsyncClient>>(this, ops_.get(), op);
+    ops_->async(op, std::move(cb));
+  }
 };
 
 template <typename AsyncClient>
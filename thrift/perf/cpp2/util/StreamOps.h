@@ -17,6 +17,8 @@
 #pragma once
 
 #include <folly/GLog.h>
+#include <folly/experimental/coro/AsyncGenerator.h>
+#include <folly/experimental/coro/Task.h>
 #include <folly/system/ThreadName.h>
 #include <thrift/lib/cpp2/async/RequestChannel.h>
 #include <thrift/perf/cpp2/if/gen-cpp2/ApiBase_types.h>
@@ -25,6 +27,10 @@
 
 DECLARE_uint32(chunk_size);
 DECLARE_uint32(batch_size);
+DECLARE_bool(stream_batching);
+DECLARE_int32(stream_batch_elements);
+DECLARE_int32(stream_batch_bytes);
+DECLARE_int32(stream_batch_delay_us);
 
 using apache::thrift::ClientReceiveState;
 using apache::thrift::RequestCallback;
@@ -179,6 +185,13 @@ class StreamDownload {
     rpcOptions.setQueueTimeout(std::chrono::seconds(10));
     rpcOptions.setTimeout(std::chrono::seconds(10));
     rpcOptions.setChunkBufferSize(FLAGS_batch_size);
+    if (FLAGS_stream_batching) {
+      apache::thrift::StreamBatchingConfig batching;
+      batching.maxElements_ref() = FLAGS_stream_batch_elements;
+      batching.maxBytes_ref() = FLAGS_stream_batch_bytes;
+      batching.maxDelayUs_ref() = FLAGS_stream_batch_delay_us;
+      rpcOptions.setStreamBatching(batching);
+    }
 
     client->sync_streamDownload(rpcOptions)
         .subscribeExTry(
@@ -213,3 +226,73 @@ class StreamDownload {
   std::string fatal_ = "fatal";
   Chunk2 chunk_;
 };
+
+// Uploads chunks through a sink until it fails, either as strings or, if
+// 'raw', as IOBufs the server receives without copying.
+template <typename AsyncClient>
+class StreamUpload {
+ public:
+  StreamUpload(QPSStats* stats, uint32_t chunkSize, bool raw)
+      : stats_(stats),
+        upload_(raw ? "s_upload_raw" : "s_upload_typed"),
+        raw_(raw) {
+    stats_->registerCounter(upload_);
+    stats_->registerCounter(fatal_);
+    std::string data(chunkSize, 0);
+    for (uint32_t i = 0; i < chunkSize; ++i) {
+      data[i] = (char)(rand() % 26 + 'A');
+    }
+    chunk_ = folly::IOBuf(folly::IOBuf::COPY_BUFFER, data);
+    data_ = std::move(data);
+  }
+  ~StreamUpload() = default;
+
+  void async(
+      AsyncClient* client,
+      std::unique_ptr<RequestCallback>,
+      int32_t& outstandingOps) {
+    folly::coro::co_invoke([this, client]() -> folly::coro::Task<void> {
+      apache::thrift::RpcOptions rpcOptions;
+      rpcOptions.setQueueTimeout(std::chrono::seconds(10));
+      rpcOptions.setTimeout(std::chrono::seconds(10));
+      if (raw_) {
+        auto sink = co_await client->co_rawStreamUpload(rpcOptions);
+        co_await sink.sink(
+            folly::coro::co_invoke(
+                [this]() -> folly::coro::AsyncGenerator<folly::IOBuf&&> {
+                  while (true) {
+                    co_yield folly::IOBuf(chunk_);
+                    stats_->add(upload_);
+                  }
+                }));
+      } else {
+        auto sink = co_await client->co_streamUpload(rpcOptions);
+        co_await sink.sink(
+            folly::coro::co_invoke(
+                [this]() -> folly::coro::AsyncGenerator<std::string&&> {
+                  while (true) {
+                    co_yield folly::copy(data_);
+                    stats_->add(upload_);
+                  }
+                }));
+      }
+    })
+        .scheduleOn(folly::EventBaseManager::get()->getEventBase())
+        .start([this, &outstandingOps](folly::Try<folly::Unit>&& t) {
+          if (t.hasException()) {
+            FB_LOG_EVERY_MS(INFO, 1000) << "Error is: " << t.exception().what();
+            stats_->add(fatal_);
+          }
+          --outstandingOps;
+        });
+  }
+
+ private:
+  QPSStats* stats_;
+  std::string upload_;
+  std::string fatal_ = "fatal";
+  const bool raw_;
+  // the same data, sent by the raw and typed sinks respectively
+  folly::IOBuf chunk_;
+  std::string data_;
+};
@@ -57,6 +57,20 @@ proto = TCompactProtocol.TCompactProtocol(trans)
 ooe.write(proto)
 compact_buf = trans.getvalue()
 
+large = OneOfEach()
+large.aList = list(range(100000))
+large.aMap = {("key%d" % i).encode(): i for i in range(10000)}
+
+trans = TTransport.TMemoryBuffer()
+proto = TBinaryProtocol.TBinaryProtocol(trans)
+large.write(proto)
+large_binary_buf = trans.getvalue()
+
+trans = TTransport.TMemoryBuffer()
+proto = TCompactProtocol.TCompactProtocol(trans)
+large.write(proto)
+large_compact_buf = trans.getvalue()
+
 class TDevNullTransport(TTransport.TTransportBase):
     def __init__(self):
         pass
@@ -108,6 +122,32 @@ def doReadCompact():
     print("Fastproto compact read = {}".format(
         timeit.Timer("doReadCompact()", setup_read).timeit(number=iters)))
 
+def benchmark_large_containers():
+    setup = """
+from __main__ import large_binary_buf, large_compact_buf
+from FastProto.ttypes import OneOfEach
+from thrift.protocol import fastproto
+from thrift.transport import TTransport
+
+spec = [OneOfEach, OneOfEach.thrift_spec, False]
+
+def doRead(buf, protoid):
+    trans = TTransport.TMemoryBuffer(buf)
+    fastproto.decode(OneOfEach(), trans, spec, utf8strings=0, protoid=protoid)
+
+def doReadBuffer(buf, protoid):
+    fastproto.decode_buffer(
+        OneOfEach(), memoryview(buf), spec, utf8strings=0, protoid=protoid)
+"""
+    large_iters = 100
+    for name, buf, protoid in (("binary", "large_binary_buf", 0),
+                               ("compact", "large_compact_buf", 2)):
+        for method in ("doRead", "doReadBuffer"):
+            print("Fastproto {} large containers {} = {}".format(
+                name, method,
+                timeit.Timer("{}({}, {})".format(method, buf, protoid), setup)
+                    .timeit(number=large_iters)))
+
 def fastproto_encode(q, protoid):
     hp = hpy()
     trans = TDevNullTransport()
@@ -176,5 +216,6 @@ def memory_usage_fastproto():
 if __name__ == "__main__":
     print("Starting Benchmarks")
     benchmark_fastproto()
+    benchmark_large_containers()
     if hpy is not None:
         memory_usage_fastproto()
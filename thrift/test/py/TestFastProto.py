@@ -88,6 +88,21 @@ class AbstractTest():
         if split != 1.0:
             self.assertEqual(1, trans.refill_called)
 
+    def decode_buffer_helper(self, obj, wrap=bytes):
+        trans = TMemoryBuffer()
+        proto = self.createProto(trans)
+        obj.write(proto)
+        buf = trans.getvalue()
+
+        obj_new = obj.__class__()
+        # trailing bytes are left unread
+        read = fastproto.decode_buffer(
+            obj_new, wrap(buf + b"\x00\x01"),
+            [obj.__class__, obj.thrift_spec, obj.isUnion()],
+            utf8strings=0, protoid=self.PROTO)
+        self.assertEqual(obj, obj_new)
+        self.assertEqual(len(buf), read)
+
     def encode_and_decode(self, obj):
         trans = TMemoryBuffer()
         if self.PROTO == 0:
@@ -178,6 +193,30 @@ class AbstractTest():
         self.encode_helper(OneOfEach(aSet=set(), aList=[], aMap={}))
         self.decode_helper(OneOfEach(aSet=set(), aList=[], aMap={}))
 
+    def test_decode_buffer(self):
+        self.decode_buffer_helper(self.buildOneOfEachB())
+        self.decode_buffer_helper(self.buildOneOfEachB(), wrap=bytearray)
+        self.decode_buffer_helper(self.buildOneOfEachB(), wrap=memoryview)
+        self.decode_buffer_helper(OneOfEach(aSet=set(), aList=[], aMap={}))
+        self.decode_buffer_helper(NegativeFieldId(anInteger=344444,
+                                                  aString=b'hello again',
+                                                  aDouble=1.34566))
+        u = TestUnion(list_field=[b"hello", b"world"])
+        self.decode_buffer_helper(StructWithUnion(aUnion=u, aString=b"!"))
+
+    def test_decode_buffer_large_list(self):
+        self.decode_buffer_helper(OneOfEach(aList=list(range(-50000, 50000))))
+
+    def test_decode_buffer_truncated(self):
+        trans = TMemoryBuffer()
+        self.buildOneOfEachB().write(self.createProto(trans))
+        buf = trans.getvalue()
+        with self.assertRaises(RuntimeError):
+            fastproto.decode_buffer(
+                OneOfEach(), buf[:len(buf) // 2],
+                [OneOfEach, OneOfEach.thrift_spec, False],
+                utf8strings=0, protoid=self.PROTO)
+
     def test_required(self):
         # "required" fields aren't enforced anymore and should not throw any exceptions
 